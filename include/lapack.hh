@@ -20,5 +20,18 @@ const char* lapackpp_id();
 }  // namespace lapack
 
 #include "lapack/wrappers.hh"
+#include "lapack/arena.hh"
+#include "lapack/query_cache.hh"
+#include "lapack/batch.hh"
+#include "lapack/fixed.hh"
+#include "lapack/instrument.hh"
+#include "lapack/method.hh"
+#include "lapack/ooc.hh"
+#include "lapack/factor.hh"
+#include "lapack/update.hh"
+#include "lapack/slice.hh"
+#include "lapack/randomized.hh"
+#include "lapack/polar.hh"
+#include "lapack/subspace.hh"
 
 #endif // LAPACK_HH
@@ -0,0 +1,88 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_ARENA_HH
+#define LAPACK_ARENA_HH
+
+#include "lapack/util.hh"
+
+#include <cstddef>  // std::size_t
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Sets the size of the calling thread's workspace arena.
+///
+/// By default, each LAPACK++ routine allocates its temporary arrays
+/// (work, iwork, rwork, 32-bit copies of pivots, etc.) from the heap.
+/// Once a thread has an arena, those temporaries are instead carved from
+/// the arena's buffer and released in LIFO order when the routine returns,
+/// avoiding malloc/free in each call. This mainly benefits many calls on
+/// small matrices. Temporaries that do not fit in the remaining arena
+/// fall back to the heap, so a too-small arena is slower but not an error.
+///
+/// The arena is thread-local: each thread that wants one must call
+/// arena_set_size. Each temporary takes 64 bytes beyond its size for
+/// bookkeeping, which records the arena it came from, so a temporary
+/// released on another thread returns to its own arena. The buffer is
+/// freed when the thread exits, or later, when the last temporary from
+/// it is released.
+///
+/// @param[in] size
+///     Size of the arena, in bytes. The buffer is 64-byte aligned.
+///     Use 0 to free the arena and return to heap allocation.
+///
+/// Throws Error if temporaries from the arena, or counted as its overflows,
+/// are still live, which can happen only if called from a callback inside
+/// a routine, or while another thread holds such a temporary.
+///
+/// @see arena_high_water to choose a size.
+///
+/// @ingroup workspace
+void arena_set_size( size_t size );
+
+//------------------------------------------------------------------------------
+/// @return size of the calling thread's workspace arena, in bytes;
+/// 0 if the thread has no arena.
+///
+/// @ingroup workspace
+size_t arena_size();
+
+//------------------------------------------------------------------------------
+/// @return bytes of the calling thread's workspace arena currently in use.
+/// Outside of LAPACK++ routines, this is 0.
+///
+/// @ingroup workspace
+size_t arena_used();
+
+//------------------------------------------------------------------------------
+/// @return the largest total of temporaries that were live at once on the
+/// calling thread since the arena was sized or last reset, in bytes.
+/// This includes temporaries that did not fit and fell back to the heap,
+/// so running a representative workload with a small arena and then
+/// calling arena_set_size( arena_high_water() ) sizes it adequately.
+///
+/// @ingroup workspace
+size_t arena_high_water();
+
+//------------------------------------------------------------------------------
+/// @return number of temporaries on the calling thread that did not fit in
+/// the arena and were allocated from the heap, since the arena was sized
+/// or last reset.
+///
+/// @ingroup workspace
+size_t arena_overflows();
+
+//------------------------------------------------------------------------------
+/// Resets the calling thread's arena statistics: the high-water mark is
+/// set to the current usage and the overflow count to 0.
+/// The arena's size and contents are not affected.
+///
+/// @ingroup workspace
+void arena_reset();
+
+}  // namespace lapack
+
+#endif  // LAPACK_ARENA_HH
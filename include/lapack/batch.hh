@@ -0,0 +1,168 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_BATCH_HH
+#define LAPACK_BATCH_HH
+
+#include "lapack/util.hh"
+
+// Batched host routines apply a LAPACK routine to batch_count independent
+// matrices of the same size. Each has two forms:
+//
+// - X_batch takes arrays of pointers, one pointer per matrix,
+//   e.g., Aarray[ i ] is the i-th matrix A.
+//
+// - X_strided_batch takes one pointer per argument and a stride between
+//   consecutive matrices, e.g., the i-th matrix A starts at A + i*strideA.
+//
+// Matrices are processed in parallel over OpenMP threads, if OpenMP is
+// enabled, with the vendor library (MKL or OpenBLAS) set to single-thread
+// mode for the duration of the call; with one thread, the vendor library
+// keeps its own threading. Hence these are intended for many
+// small matrices; for a few large matrices, loop over the non-batched
+// routine, which uses the vendor library's multi-threading.
+//
+// info[ i ] is the return value of the non-batched routine for the i-th
+// matrix, so one singular or indefinite matrix does not stop the others.
+// Invalid arguments, which are the same for all matrices, throw Error.
+//
+// sturm_batch instead takes tridiagonal matrices interleaved, as a structure
+// of arrays, so it vectorizes across matrices.
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf_batch(
+    int64_t m, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    int64_t* const* ipiv_array,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void getrf_strided_batch(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrs_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* const* Aarray, int64_t lda,
+    int64_t const* const* ipiv_array,
+    scalar_t* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void getrs_strided_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    int64_t* info, int64_t batch_count );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrf_batch(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void potrf_strided_batch(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    int64_t* info, int64_t batch_count );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrs_batch(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* const* Aarray, int64_t lda,
+    scalar_t* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void potrs_strided_batch(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    int64_t* info, int64_t batch_count );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrf_batch(
+    int64_t m, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    scalar_t* const* tau_array,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void geqrf_strided_batch(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    scalar_t* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void heevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    blas::real_type<scalar_t>* const* Warray,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void heevd_strided_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t>* W, int64_t strideW,
+    int64_t* info, int64_t batch_count );
+
+//------------------------------------------------------------------------------
+/// syevd_batch alias to heevd_batch, for real matrices.
+/// @ingroup heev
+template <typename scalar_t>
+inline void syevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    scalar_t* const* Warray,
+    int64_t* info, int64_t batch_count )
+{
+    static_assert( ! blas::is_complex<scalar_t>::value,
+                   "syevd_batch requires real matrices; use heevd_batch" );
+    heevd_batch( jobz, uplo, n, Aarray, lda, Warray, info, batch_count );
+}
+
+/// syevd_strided_batch alias to heevd_strided_batch, for real matrices.
+/// @ingroup heev
+template <typename scalar_t>
+inline void syevd_strided_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    scalar_t* W, int64_t strideW,
+    int64_t* info, int64_t batch_count )
+{
+    static_assert( ! blas::is_complex<scalar_t>::value,
+                   "syevd_strided_batch requires real matrices; use heevd_strided_batch" );
+    heevd_strided_batch( jobz, uplo, n, A, lda, strideA, W, strideW,
+                         info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sturm_batch(
+    int64_t n,
+    scalar_t const* diag, scalar_t const* offd, int64_t ldd,
+    int64_t nshift,
+    scalar_t const* u, int64_t ldu,
+    int64_t* count, int64_t ldc,
+    int64_t batch_count );
+
+}  // namespace lapack
+
+#endif  // LAPACK_BATCH_HH
@@ -11,6 +11,8 @@
 
 #if defined(LAPACK_HAVE_CUBLAS)
     #include <cusolverDn.h>
+#elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+    #include <functional>
 #endif
 
 namespace lapack {
@@ -34,8 +36,33 @@ namespace lapack {
     typedef int64_t device_pivot_int;  ///< int type for pivot vector (getrf, etc.)
 #endif
 
+#if ! (defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+namespace internal {
+
+class HostQueue;
+
+}  // namespace internal
+#endif
+
 //------------------------------------------------------------------------------
-class Queue: public blas::Queue
+/// Queue for device routines.
+///
+/// Without a GPU backend (CUDA, ROCm, or SYCL), the device routines are
+/// implemented on the host: "device" memory is host memory, and each
+/// routine is enqueued to run asynchronously, in order, on host LAPACK in
+/// a worker thread owned by the queue. sync() waits for enqueued routines.
+/// This lets code written for the device API run, and overlap compute with
+/// other host work, on CPU-only machines. Since blas::Queue::sync does not
+/// wait for the worker, in this case blas::Queue is a protected base, and
+/// blas_queue() gives access to it after waiting; blas::device_malloc,
+/// device_memcpy, etc. have overloads for lapack::Queue that use host
+/// memory and run on the worker.
+class Queue:
+    #if defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL)
+        public blas::Queue
+    #else
+        protected blas::Queue
+    #endif
 {
 public:
     Queue()
@@ -45,6 +72,8 @@ public:
             #if CUSOLVER_VERSION >= 11000
                 , solver_params_( nullptr )
             #endif
+        #elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+            , host_queue_( nullptr )
         #endif
     {}
 
@@ -55,6 +84,8 @@ public:
             #if CUSOLVER_VERSION >= 11000
                 , solver_params_( nullptr )
             #endif
+        #elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+            , host_queue_( nullptr )
         #endif
     {}
 
@@ -70,6 +101,8 @@ public:
             #if CUSOLVER_VERSION >= 11000
                 , solver_params_( nullptr )
             #endif
+        #elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+            , host_queue_( nullptr )
         #endif
     {}
     #pragma GCC diagnostic pop
@@ -89,6 +122,8 @@ public:
                 cusolverDnDestroy( solver_ );
                 solver_ = nullptr;
             }
+        #elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+            host_queue_free();
         #endif
     }
 
@@ -96,6 +131,18 @@ public:
     Queue( Queue const& ) = delete;
     Queue& operator=( Queue const& ) = delete;
 
+    /// @return this queue as a blas::Queue, for passing to BLAS++.
+    /// Without a GPU backend, first waits for enqueued routines, as
+    /// blas::Queue::sync does not; routines enqueued after this call
+    /// are not ordered with BLAS++ calls on the returned queue.
+    blas::Queue& blas_queue()
+    {
+        #if ! (defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+            sync();
+        #endif
+        return *this;
+    }
+
     #if defined(LAPACK_HAVE_CUBLAS)
         /// @return cuSolver handle, allocating it on first use.
         cusolverDnHandle_t solver()
@@ -128,6 +175,17 @@ public:
                 return solver_params_;
             }
         #endif
+
+    #elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+        /// Enqueues task to run on the queue's worker thread, after all
+        /// previously enqueued tasks. The worker starts on first use.
+        void enqueue( std::function< void () > task );
+
+        /// Waits for all enqueued tasks to finish. If any task threw an
+        /// exception, rethrows the first one.
+        void sync();
+
+        using blas::Queue::device;
     #endif
 
 private:
@@ -136,9 +194,32 @@ private:
         #if CUSOLVER_VERSION >= 11000
             cusolverDnParams_t solver_params_;
         #endif
+
+    #elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+        void host_queue_free();
+
+        internal::HostQueue* host_queue_;
     #endif
 };
 
+#if ! (defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+namespace internal {
+
+void* host_device_malloc( size_t bytes );
+
+void host_device_free( void* ptr, lapack::Queue& queue );
+
+void host_device_memset(
+    void* ptr, int value, size_t bytes, lapack::Queue& queue );
+
+void host_device_memcpy_2d(
+    void* dst, size_t dst_pitch,
+    void const* src, size_t src_pitch,
+    size_t width, int64_t height, lapack::Queue& queue );
+
+}  // namespace internal
+#endif
+
 //------------------------------------------------------------------------------
 template <typename scalar_t>
 void potrf(
@@ -196,4 +277,83 @@ void heevd(
 
 }  // namespace lapack
 
+#if ! (defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL))
+//==============================================================================
+// Without a GPU backend, BLAS++ device memory routines throw. These overloads
+// for lapack::Queue, with the same signatures, use host memory instead, so
+// code written for the device API builds and runs unchanged. As on a GPU,
+// memset, copies, and free are enqueued on the queue's worker, after
+// routines already enqueued; sync the queue before using copied data.
+namespace blas {
+
+//------------------------------------------------------------------------------
+template <typename T>
+T* device_malloc( int64_t nelements, lapack::Queue& queue )
+{
+    return static_cast<T*>(
+        lapack::internal::host_device_malloc( nelements * sizeof(T) ) );
+}
+
+//------------------------------------------------------------------------------
+inline void device_free( void* ptr, lapack::Queue& queue )
+{
+    lapack::internal::host_device_free( ptr, queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void device_memset(
+    T* ptr, int value, int64_t nelements, lapack::Queue& queue )
+{
+    lapack::internal::host_device_memset(
+        ptr, value, nelements * sizeof(T), queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void device_memcpy(
+    T* dst, T const* src, int64_t nelements, lapack::Queue& queue )
+{
+    lapack::internal::host_device_memcpy_2d(
+        dst, 0, src, 0, nelements * sizeof(T), 1, queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void device_memcpy_2d(
+    T* dst, int64_t dst_pitch,
+    T const* src, int64_t src_pitch,
+    int64_t width, int64_t height, lapack::Queue& queue )
+{
+    lapack::internal::host_device_memcpy_2d(
+        dst, dst_pitch * sizeof(T), src, src_pitch * sizeof(T),
+        width * sizeof(T), height, queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void device_copy_matrix(
+    int64_t m, int64_t n,
+    T const* src, int64_t ld_src,
+    T*       dst, int64_t ld_dst, lapack::Queue& queue )
+{
+    device_memcpy_2d( dst, ld_dst, src, ld_src, m, n, queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void device_copy_vector(
+    int64_t n,
+    T const* src, int64_t inc_src,
+    T*       dst, int64_t inc_dst, lapack::Queue& queue )
+{
+    if (inc_src == 1 && inc_dst == 1)
+        device_memcpy( dst, src, n, queue );
+    else
+        device_memcpy_2d( dst, inc_dst, src, inc_src, 1, n, queue );
+}
+
+}  // namespace blas
+#endif
+
 #endif // LAPACK_DEVICE_HH
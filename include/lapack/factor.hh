@@ -0,0 +1,268 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_FACTOR_HH
+#define LAPACK_FACTOR_HH
+
+#include "lapack/util.hh"
+
+#include <vector>
+
+// Factorization objects factor a matrix once, then solve with it any number
+// of times. Each owns a copy of the factors, the pivots in the integer type
+// of the linked LAPACK (lapack_int), so solves pass them straight through
+// without the 64-to-32-bit copy the int64_t pivot routines make, and any
+// workspace its solves need, allocated once. The norm of A is saved, so
+// rcond() needs no copy of A; it is computed on first use and cached.
+//
+// The input matrix is not modified. An object whose factorization failed
+// (info() > 0) can still report info() and rcond() = 0, but solve throws
+// Error. Objects are copyable and movable. solve() and rcond() of one
+// object must not be called concurrently from several threads, since they
+// update cached state; use one object per thread.
+//
+// Available for scalar_t = `float`, `double`, `std::complex<float>`,
+// and `std::complex<double>`.
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// LU factorization with partial pivoting, $A = P L U$, of an n-by-n
+/// matrix A, computed by getrf; solves use getrs, rcond uses gecon.
+///
+/// @ingroup gesv
+template <typename scalar_t>
+class LUFactor
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    /// Copies and factors the n-by-n matrix A, stored in an lda-by-n array.
+    LUFactor( int64_t n, scalar_t const* A, int64_t lda );
+
+    /// Solves $op(A) X = B$, where B is n-by-nrhs, stored in an
+    /// ldb-by-nrhs array, and is overwritten by X.
+    /// Throws Error if A is exactly singular.
+    void solve( int64_t nrhs, scalar_t* B, int64_t ldb,
+                lapack::Op trans = lapack::Op::NoTrans ) const;
+
+    /// Solves $op(A) x = b$ for one vector b of length n, overwritten by x.
+    void solve( scalar_t* b, lapack::Op trans = lapack::Op::NoTrans ) const
+        { solve( 1, b, blas::max( 1, n_ ), trans ); }
+
+    /// @return estimate of the reciprocal condition number of A in the
+    /// 1-norm, $1 / (||A||_1 ||A^{-1}||_1)$; 0 if A is exactly singular.
+    real_t rcond();
+
+    int64_t n() const { return n_; }
+
+    /// @return getrf's info: 0, or i > 0 if U(i,i) is exactly zero.
+    int64_t info() const { return info_; }
+
+    /// @return the factors L and U, in an n-by-n array with lda = max(1,n).
+    scalar_t const* data() const { return LU_.data(); }
+
+    /// @return the pivots, as from getrf (1-based).
+    lapack_int const* ipiv() const { return ipiv_.data(); }
+
+private:
+    int64_t n_;
+    int64_t info_;
+    real_t anorm_;
+    real_t rcond_;  // < 0 until computed
+    std::vector< scalar_t > LU_;
+    std::vector< lapack_int > ipiv_;
+};
+
+//------------------------------------------------------------------------------
+/// Cholesky factorization, $A = L L^H$ or $A = U^H U$, of an n-by-n
+/// Hermitian positive definite matrix A, computed by potrf;
+/// solves use potrs, rcond uses pocon.
+///
+/// @ingroup posv
+template <typename scalar_t>
+class CholeskyFactor
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    /// Copies and factors the n-by-n matrix A, stored in an lda-by-n array,
+    /// of which only the uplo triangle is referenced.
+    CholeskyFactor( lapack::Uplo uplo, int64_t n,
+                    scalar_t const* A, int64_t lda );
+
+    /// Solves $A X = B$, where B is n-by-nrhs, stored in an ldb-by-nrhs
+    /// array, and is overwritten by X.
+    /// Throws Error if A is not positive definite.
+    void solve( int64_t nrhs, scalar_t* B, int64_t ldb ) const;
+
+    /// Solves $A x = b$ for one vector b of length n, overwritten by x.
+    void solve( scalar_t* b ) const
+        { solve( 1, b, blas::max( 1, n_ ) ); }
+
+    /// @return estimate of the reciprocal condition number of A in the
+    /// 1-norm; 0 if A is not positive definite.
+    real_t rcond();
+
+    lapack::Uplo uplo() const { return uplo_; }
+    int64_t n() const { return n_; }
+
+    /// @return potrf's info: 0, or i > 0 if the leading minor of order i
+    /// is not positive definite.
+    int64_t info() const { return info_; }
+
+    /// @return the factor L or U, in an n-by-n array with lda = max(1,n).
+    scalar_t const* data() const { return LLt_.data(); }
+
+private:
+    lapack::Uplo uplo_;
+    int64_t n_;
+    int64_t info_;
+    real_t anorm_;
+    real_t rcond_;
+    std::vector< scalar_t > LLt_;
+};
+
+//------------------------------------------------------------------------------
+/// Symmetric indefinite factorization, $A = P L D L^H P^T$ or
+/// $A = P U D U^H P^T$, of an n-by-n Hermitian matrix A
+/// (symmetric, if real), with the pivoting given by pivot:
+///
+/// - LDLPivot::BunchKaufman: hetrf; D is block diagonal, 1-by-1 and 2-by-2.
+/// - LDLPivot::Rook: hetrf_rook; bounded rook pivoting, which bounds the
+///   entries of L, making it more accurate than Bunch-Kaufman for some
+///   matrices, at the cost of more comparisons. LAPACK >= 3.5.
+/// - LDLPivot::RK: hetrf_rk; rook pivoting, with D's off-diagonal stored
+///   separately in E, which allows BLAS-3 solves. LAPACK >= 3.7.
+/// - LDLPivot::Aasen: hetrf_aa; Aasen's algorithm, D is tridiagonal.
+///   LAPACK >= 3.7.
+///
+/// Solves use the matching hetrs variant. rcond estimates $||A^{-1}||_1$
+/// with lacn2, solving with the factors, as hecon does; this works for all
+/// variants.
+///
+/// @ingroup hesv
+template <typename scalar_t>
+class LDLFactor
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    /// Copies and factors the n-by-n matrix A, stored in an lda-by-n array,
+    /// of which only the uplo triangle is referenced.
+    /// Throws Error if pivot is not available in the linked LAPACK.
+    LDLFactor( lapack::Uplo uplo, int64_t n,
+               scalar_t const* A, int64_t lda,
+               lapack::LDLPivot pivot = lapack::LDLPivot::BunchKaufman );
+
+    /// Solves $A X = B$, where B is n-by-nrhs, stored in an ldb-by-nrhs
+    /// array, and is overwritten by X.
+    /// Throws Error if A is exactly singular.
+    void solve( int64_t nrhs, scalar_t* B, int64_t ldb );
+
+    /// Solves $A x = b$ for one vector b of length n, overwritten by x.
+    void solve( scalar_t* b )
+        { solve( 1, b, blas::max( 1, n_ ) ); }
+
+    /// @return estimate of the reciprocal condition number of A in the
+    /// 1-norm; 0 if A is exactly singular.
+    real_t rcond();
+
+    lapack::Uplo uplo() const { return uplo_; }
+    lapack::LDLPivot pivot() const { return pivot_; }
+    int64_t n() const { return n_; }
+
+    /// @return hetrf's info: 0, or i > 0 if D(i,i) is exactly zero.
+    int64_t info() const { return info_; }
+
+    /// @return the factors, in an n-by-n array with lda = max(1,n),
+    /// as from the hetrf variant.
+    scalar_t const* data() const { return LDL_.data(); }
+
+    /// @return the pivots, as from the hetrf variant (1-based).
+    lapack_int const* ipiv() const { return ipiv_.data(); }
+
+private:
+    lapack::Uplo uplo_;
+    lapack::LDLPivot pivot_;
+    int64_t n_;
+    int64_t info_;
+    real_t anorm_;
+    real_t rcond_;
+    std::vector< scalar_t > LDL_;
+    std::vector< scalar_t > E_;     // RK only
+    std::vector< lapack_int > ipiv_;
+    std::vector< scalar_t > work_;  // Aasen only
+};
+
+//------------------------------------------------------------------------------
+/// QR factorization, $A = Q R$, of an m-by-n matrix A with m >= n,
+/// computed by geqrf. Solves apply Q with unmqr and R with trsm, as gels
+/// does; rcond uses trcon on R.
+///
+/// @ingroup gels
+template <typename scalar_t>
+class QRFactor
+{
+public:
+    using real_t = blas::real_type< scalar_t >;
+
+    /// Copies and factors the m-by-n matrix A, stored in an lda-by-n array.
+    /// Requires m >= n.
+    QRFactor( int64_t m, int64_t n, scalar_t const* A, int64_t lda );
+
+    /// Solves with the m-by-nrhs matrix B, stored in an ldb-by-nrhs array,
+    /// ldb >= max(1,m), as gels does:
+    ///
+    /// - trans = NoTrans: on entry, B's m rows hold the right-hand sides;
+    ///   on exit, its first n rows hold the least squares solution X of
+    ///   $\min_X ||B - A X||_F$, and rows n+1 to m the residual,
+    ///   rotated by $Q^H$; the norm of its column j is that of
+    ///   $b_j - A x_j$.
+    /// - trans = ConjTrans (or Trans, if real): on entry, B's first n rows
+    ///   hold the right-hand sides; on exit, its m rows hold the minimum
+    ///   norm solution X of $A^H X = B$.
+    ///
+    /// Throws Error if A is rank deficient, i.e., R(i,i) is exactly zero.
+    void solve( int64_t nrhs, scalar_t* B, int64_t ldb,
+                lapack::Op trans = lapack::Op::NoTrans );
+
+    /// Solves with one vector b of length m; see above.
+    void solve( scalar_t* b, lapack::Op trans = lapack::Op::NoTrans )
+        { solve( 1, b, blas::max( 1, m_ ), trans ); }
+
+    /// @return estimate of the reciprocal condition number of R in the
+    /// 1-norm. As Q is unitary, $\kappa_2(A) = \kappa_2(R)$, which is
+    /// within a factor n of the 1-norm one. 0 if A is rank deficient.
+    real_t rcond();
+
+    int64_t m() const { return m_; }
+    int64_t n() const { return n_; }
+
+    /// @return 0, or i > 0 if R(i,i) is exactly zero, so A is rank deficient.
+    int64_t info() const { return info_; }
+
+    /// @return R and the Householder vectors of Q, in an m-by-n array with
+    /// lda = max(1,m), as from geqrf.
+    scalar_t const* data() const { return QR_.data(); }
+
+    /// @return the scalar factors of the Householder reflectors, as from
+    /// geqrf.
+    scalar_t const* tau() const { return tau_.data(); }
+
+private:
+    int64_t m_;
+    int64_t n_;
+    int64_t info_;
+    real_t rcond_;
+    std::vector< scalar_t > QR_;
+    std::vector< scalar_t > tau_;
+    std::vector< scalar_t > work_;  // unmqr; grows with nrhs
+    int64_t work_nrhs_;             // largest nrhs work_ was queried for
+};
+
+}  // namespace lapack
+
+#endif  // LAPACK_FACTOR_HH
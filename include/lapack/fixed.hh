@@ -0,0 +1,454 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_FIXED_HH
+#define LAPACK_FIXED_HH
+
+#include "lapack/util.hh"
+
+#include <algorithm>  // std::max, std::swap
+#include <cmath>
+#include <limits>
+
+namespace lapack {
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return |x|^2, without the square root of std::abs.
+template <typename scalar_t>
+inline blas::real_type<scalar_t> abs2( scalar_t x )
+{
+    return std::real( x )*std::real( x ) + std::imag( x )*std::imag( x );
+}
+
+//------------------------------------------------------------------------------
+/// @return |re(x)| + |im(x)|, as used by i_amax to choose pivots.
+template <typename scalar_t>
+inline blas::real_type<scalar_t> abs1( scalar_t x )
+{
+    return std::abs( std::real( x ) ) + std::abs( std::imag( x ) );
+}
+
+//------------------------------------------------------------------------------
+/// Solves op(A) x = b in place, for N-by-N triangular A stored with
+/// leading dimension N. Same as BLAS trsv, with compile-time sizes.
+template <int N, typename scalar_t>
+inline void fixed_trsv(
+    lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag,
+    scalar_t const* a, scalar_t* x )
+{
+    bool nonunit = (diag == Diag::NonUnit);
+    if (trans == Op::NoTrans) {
+        if (uplo == Uplo::Lower) {
+            for (int j = 0; j < N; ++j) {
+                if (nonunit)
+                    x[ j ] /= a[ j + j*N ];
+                for (int i = j+1; i < N; ++i)
+                    x[ i ] -= a[ i + j*N ] * x[ j ];
+            }
+        }
+        else {
+            for (int j = N-1; j >= 0; --j) {
+                if (nonunit)
+                    x[ j ] /= a[ j + j*N ];
+                for (int i = 0; i < j; ++i)
+                    x[ i ] -= a[ i + j*N ] * x[ j ];
+            }
+        }
+    }
+    else {
+        using blas::conj;
+        bool conjugate = (trans == Op::ConjTrans);
+        if (uplo == Uplo::Lower) {
+            for (int j = N-1; j >= 0; --j) {
+                scalar_t t = x[ j ];
+                for (int i = j+1; i < N; ++i) {
+                    scalar_t aij = conjugate ? conj( a[ i + j*N ] ) : a[ i + j*N ];
+                    t -= aij * x[ i ];
+                }
+                if (nonunit)
+                    t /= (conjugate ? conj( a[ j + j*N ] ) : a[ j + j*N ]);
+                x[ j ] = t;
+            }
+        }
+        else {
+            for (int j = 0; j < N; ++j) {
+                scalar_t t = x[ j ];
+                for (int i = 0; i < j; ++i) {
+                    scalar_t aij = conjugate ? conj( a[ i + j*N ] ) : a[ i + j*N ];
+                    t -= aij * x[ i ];
+                }
+                if (nonunit)
+                    t /= (conjugate ? conj( a[ j + j*N ] ) : a[ j + j*N ]);
+                x[ j ] = t;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Generates an elementary reflector H such that H^H [alpha; x] = [beta; 0],
+/// overwriting alpha with beta and x with v(2:n). Same as LAPACK larfg,
+/// with compile-time length n = M + 1.
+template <int M, typename scalar_t>
+inline void fixed_larfg( scalar_t* alpha, scalar_t* x, scalar_t* tau )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    const real_t safmin = std::numeric_limits<real_t>::min()
+                        / (std::numeric_limits<real_t>::epsilon() / 2);
+    const real_t rsafmn = 1 / safmin;
+
+    // scaled 2-norm of x and of [alpha; x]
+    auto nrm2 = [x]( real_t a0, real_t a1 ) {
+        real_t scale = std::max( std::abs( a0 ), std::abs( a1 ) );
+        for (int i = 0; i < M; ++i)
+            scale = std::max( scale, abs1( x[ i ] ) );
+        if (scale == 0)
+            return real_t( 0 );
+        real_t sum = (a0/scale)*(a0/scale) + (a1/scale)*(a1/scale);
+        for (int i = 0; i < M; ++i)
+            sum += abs2( x[ i ] / scale );
+        return scale * std::sqrt( sum );
+    };
+
+    real_t xnorm = nrm2( 0, 0 );
+    real_t alphr = std::real( *alpha );
+    real_t alphi = std::imag( *alpha );
+    if (xnorm == 0 && alphi == 0) {
+        *tau = 0;
+        return;
+    }
+
+    real_t beta = -std::copysign( nrm2( alphr, alphi ), alphr );
+    int knt = 0;
+    if (std::abs( beta ) < safmin) {
+        // xnorm, beta may be inaccurate; scale x and recompute them
+        do {
+            knt += 1;
+            for (int i = 0; i < M; ++i)
+                x[ i ] *= rsafmn;
+            beta  *= rsafmn;
+            alphr *= rsafmn;
+            alphi *= rsafmn;
+        } while (std::abs( beta ) < safmin && knt < 20);
+        for (int k = 0; k < knt; ++k)
+            *alpha *= rsafmn;
+        xnorm = nrm2( 0, 0 );
+        beta = -std::copysign( nrm2( alphr, alphi ), alphr );
+    }
+    *tau = (scalar_t( beta ) - *alpha) / beta;
+    scalar_t scal = scalar_t( 1 ) / (*alpha - beta);
+    for (int i = 0; i < M; ++i)
+        x[ i ] *= scal;
+    for (int k = 0; k < knt; ++k)
+        beta *= safmin;
+    *alpha = beta;
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// Kernels for N-by-N matrices with N fixed at compile time.
+///
+/// Every loop bound is a compile-time constant the compiler can unroll and
+/// vectorize; most kernels also copy A into a local N-by-N array so the
+/// leading dimension is constant. No BLAS is called. For tiny matrices this avoids the call
+/// overhead, argument checking, blocking logic, and workspace queries of
+/// the LAPACK path. Results use the same storage conventions as LAPACK,
+/// so they can be mixed with the rest of LAPACK++; they may differ from
+/// LAPACK in rounding.
+///
+/// potrf, getrf, geqrf, getrs, and potrs dispatch square problems to these
+/// kernels automatically for n <= LAPACK_FIXED_SIZE_MAX, set when LAPACK++
+/// is built (default 12, about where an optimized LAPACK starts to win).
+/// Calling them directly with a literal N avoids even that dispatch.
+/// Arguments are not checked.
+///
+/// @tparam N
+///     Order of A. Intended for N <= 32; the local copies live on the stack.
+///
+/// @ingroup fixed
+template <int N>
+class fixed
+{
+public:
+    static_assert( N > 0, "fixed<N> requires N > 0" );
+
+    //--------------------------------------------------------------------------
+    /// Cholesky factorization, as `lapack::potrf`.
+    /// @return 0 on success; i > 0 if the leading minor of order i is not
+    /// positive definite.
+    template <typename scalar_t>
+    static int64_t potrf(
+        lapack::Uplo uplo, scalar_t* A, int64_t lda )
+    {
+        using blas::conj;
+        using real_t = blas::real_type<scalar_t>;
+
+        // Left-looking, in place: column j of L (row j of U) is updated by
+        // the previous columns, then scaled. Unlike the right-looking
+        // update, this touches only the columns already computed.
+        int64_t info = 0;
+        if (uplo == Uplo::Lower) {
+            for (int j = 0; j < N; ++j) {
+                for (int k = 0; k < j; ++k) {
+                    scalar_t ajk = conj( A[ j + k*lda ] );
+                    for (int i = j; i < N; ++i)
+                        A[ i + j*lda ] -= A[ i + k*lda ] * ajk;
+                }
+                real_t d = std::real( A[ j + j*lda ] );
+                if (! (d > 0)) {  // also NaN
+                    A[ j + j*lda ] = d;
+                    info = j + 1;
+                    break;
+                }
+                d = std::sqrt( d );
+                A[ j + j*lda ] = d;
+                real_t r = 1 / d;
+                for (int i = j+1; i < N; ++i)
+                    A[ i + j*lda ] *= r;
+            }
+        }
+        else {
+            for (int j = 0; j < N; ++j) {
+                for (int k = 0; k < j; ++k) {
+                    scalar_t akj = conj( A[ k + j*lda ] );
+                    for (int i = j; i < N; ++i)
+                        A[ j + i*lda ] -= A[ k + i*lda ] * akj;
+                }
+                real_t d = std::real( A[ j + j*lda ] );
+                if (! (d > 0)) {  // also NaN
+                    A[ j + j*lda ] = d;
+                    info = j + 1;
+                    break;
+                }
+                d = std::sqrt( d );
+                A[ j + j*lda ] = d;
+                real_t r = 1 / d;
+                for (int i = j+1; i < N; ++i)
+                    A[ j + i*lda ] *= r;
+            }
+        }
+        return info;
+    }
+
+    //--------------------------------------------------------------------------
+    /// LU factorization with partial pivoting, as `lapack::getrf`.
+    /// pivot_t is int64_t or lapack_int.
+    /// @return 0 on success; i > 0 if U(i,i) is exactly zero.
+    template <typename scalar_t, typename pivot_t>
+    static int64_t getrf(
+        scalar_t* A, int64_t lda, pivot_t* ipiv )
+    {
+        using real_t = blas::real_type<scalar_t>;
+        const real_t sfmin = std::numeric_limits<real_t>::min();
+
+        scalar_t a[ N*N ];
+        for (int j = 0; j < N; ++j)
+            for (int i = 0; i < N; ++i)
+                a[ i + j*N ] = A[ i + j*lda ];
+
+        int64_t info = 0;
+        for (int j = 0; j < N; ++j) {
+            int p = j;
+            real_t amax = internal::abs1( a[ j + j*N ] );
+            for (int i = j+1; i < N; ++i) {
+                real_t aij = internal::abs1( a[ i + j*N ] );
+                if (aij > amax) {
+                    amax = aij;
+                    p = i;
+                }
+            }
+            ipiv[ j ] = pivot_t( p + 1 );
+
+            if (a[ p + j*N ] != scalar_t( 0 )) {
+                if (p != j) {
+                    for (int k = 0; k < N; ++k)
+                        std::swap( a[ j + k*N ], a[ p + k*N ] );
+                }
+                scalar_t ajj = a[ j + j*N ];
+                if (std::abs( ajj ) >= sfmin) {
+                    scalar_t r = scalar_t( 1 ) / ajj;
+                    for (int i = j+1; i < N; ++i)
+                        a[ i + j*N ] *= r;
+                }
+                else {
+                    for (int i = j+1; i < N; ++i)
+                        a[ i + j*N ] /= ajj;
+                }
+            }
+            else if (info == 0) {
+                info = j + 1;
+            }
+
+            for (int k = j+1; k < N; ++k) {
+                scalar_t ajk = a[ j + k*N ];
+                for (int i = j+1; i < N; ++i)
+                    a[ i + k*N ] -= a[ i + j*N ] * ajk;
+            }
+        }
+
+        for (int j = 0; j < N; ++j)
+            for (int i = 0; i < N; ++i)
+                A[ i + j*lda ] = a[ i + j*N ];
+        return info;
+    }
+
+    //--------------------------------------------------------------------------
+    /// QR factorization, as `lapack::geqrf`.
+    /// @return 0.
+    template <typename scalar_t>
+    static int64_t geqrf(
+        scalar_t* A, int64_t lda, scalar_t* tau )
+    {
+        using blas::conj;
+
+        scalar_t a[ N*N ];
+        for (int j = 0; j < N; ++j)
+            for (int i = 0; i < N; ++i)
+                a[ i + j*N ] = A[ i + j*lda ];
+
+        for (int j = 0; j < N; ++j) {
+            // Column j, rows j+1:N, has N-1-j entries; the kernel is
+            // instantiated for the full length and masked by the loops.
+            larfg_column( j, a, &tau[ j ] );
+
+            // Apply H^H = I - conj(tau) v v^H from the left to the trailing
+            // columns, with v = [ 1; a(j+1:N, j) ].
+            scalar_t ctau = conj( tau[ j ] );
+            for (int k = j+1; k < N; ++k) {
+                scalar_t w = a[ j + k*N ];
+                for (int i = j+1; i < N; ++i)
+                    w += conj( a[ i + j*N ] ) * a[ i + k*N ];
+                w *= ctau;
+                a[ j + k*N ] -= w;
+                for (int i = j+1; i < N; ++i)
+                    a[ i + k*N ] -= a[ i + j*N ] * w;
+            }
+        }
+
+        for (int j = 0; j < N; ++j)
+            for (int i = 0; i < N; ++i)
+                A[ i + j*lda ] = a[ i + j*N ];
+        return 0;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Triangular solve op(A) X = B, for N-by-N triangular A and
+    /// N-by-nrhs B; same as BLAS trsm with side = Left and alpha = 1.
+    template <typename scalar_t>
+    static void trsm(
+        lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag,
+        int64_t nrhs,
+        scalar_t const* A, int64_t lda,
+        scalar_t* B, int64_t ldb )
+    {
+        scalar_t a[ N*N ];
+        for (int j = 0; j < N; ++j) {
+            int ibegin = (uplo == Uplo::Lower ? j : 0);
+            int iend   = (uplo == Uplo::Lower ? N : j + 1);
+            for (int i = ibegin; i < iend; ++i)
+                a[ i + j*N ] = A[ i + j*lda ];
+        }
+
+        scalar_t x[ N ];
+        for (int64_t k = 0; k < nrhs; ++k) {
+            scalar_t* b = &B[ k*ldb ];
+            for (int i = 0; i < N; ++i)
+                x[ i ] = b[ i ];
+            internal::fixed_trsv<N>( uplo, trans, diag, a, x );
+            for (int i = 0; i < N; ++i)
+                b[ i ] = x[ i ];
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Solves op(A) X = B using the LU factors from getrf,
+    /// as `lapack::getrs`. pivot_t is int64_t or lapack_int.
+    template <typename scalar_t, typename pivot_t>
+    static void getrs(
+        lapack::Op trans, int64_t nrhs,
+        scalar_t const* A, int64_t lda, pivot_t const* ipiv,
+        scalar_t* B, int64_t ldb )
+    {
+        scalar_t a[ N*N ];
+        for (int j = 0; j < N; ++j)
+            for (int i = 0; i < N; ++i)
+                a[ i + j*N ] = A[ i + j*lda ];
+
+        scalar_t x[ N ];
+        for (int64_t k = 0; k < nrhs; ++k) {
+            scalar_t* b = &B[ k*ldb ];
+            for (int i = 0; i < N; ++i)
+                x[ i ] = b[ i ];
+            if (trans == Op::NoTrans) {
+                for (int i = 0; i < N; ++i)
+                    std::swap( x[ i ], x[ ipiv[ i ] - 1 ] );
+                internal::fixed_trsv<N>( Uplo::Lower, trans, Diag::Unit, a, x );
+                internal::fixed_trsv<N>( Uplo::Upper, trans, Diag::NonUnit, a, x );
+            }
+            else {
+                internal::fixed_trsv<N>( Uplo::Upper, trans, Diag::NonUnit, a, x );
+                internal::fixed_trsv<N>( Uplo::Lower, trans, Diag::Unit, a, x );
+                for (int i = N-1; i >= 0; --i)
+                    std::swap( x[ i ], x[ ipiv[ i ] - 1 ] );
+            }
+            for (int i = 0; i < N; ++i)
+                b[ i ] = x[ i ];
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Solves A X = B using the Cholesky factor from potrf,
+    /// as `lapack::potrs`.
+    template <typename scalar_t>
+    static void potrs(
+        lapack::Uplo uplo, int64_t nrhs,
+        scalar_t const* A, int64_t lda,
+        scalar_t* B, int64_t ldb )
+    {
+        Op trans1 = (uplo == Uplo::Lower ? Op::NoTrans : Op::ConjTrans);
+        Op trans2 = (uplo == Uplo::Lower ? Op::ConjTrans : Op::NoTrans);
+
+        scalar_t a[ N*N ];
+        for (int j = 0; j < N; ++j) {
+            int ibegin = (uplo == Uplo::Lower ? j : 0);
+            int iend   = (uplo == Uplo::Lower ? N : j + 1);
+            for (int i = ibegin; i < iend; ++i)
+                a[ i + j*N ] = A[ i + j*lda ];
+        }
+
+        scalar_t x[ N ];
+        for (int64_t k = 0; k < nrhs; ++k) {
+            scalar_t* b = &B[ k*ldb ];
+            for (int i = 0; i < N; ++i)
+                x[ i ] = b[ i ];
+            internal::fixed_trsv<N>( uplo, trans1, Diag::NonUnit, a, x );
+            internal::fixed_trsv<N>( uplo, trans2, Diag::NonUnit, a, x );
+            for (int i = 0; i < N; ++i)
+                b[ i ] = x[ i ];
+        }
+    }
+
+private:
+    /// Householder reflector for column j of the local array a,
+    /// dispatching to the compile-time length N-1-j.
+    template <int J = 0, typename scalar_t>
+    static void larfg_column( int j, scalar_t* a, scalar_t* tau )
+    {
+        if constexpr (J < N) {
+            if (j == J)
+                internal::fixed_larfg<N-1-J>( &a[ J + J*N ], &a[ J+1 + J*N ], tau );
+            else
+                larfg_column<J+1>( j, a, tau );
+        }
+    }
+};
+
+}  // namespace lapack
+
+#endif  // LAPACK_FIXED_HH
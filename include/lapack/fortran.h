@@ -20382,6 +20382,16 @@ void LAPACK_zunhr_col(
     lapack_complex_double* T, lapack_int const* ldt,
     lapack_complex_double* D, lapack_int* info );
 
+#define LAPACK_ilaenv_base LAPACK_GLOBAL( ilaenv, ILAENV )
+lapack_int LAPACK_ilaenv_base(
+    lapack_int const* ispec, char const* name, char const* opts,
+    lapack_int const* n1, lapack_int const* n2,
+    lapack_int const* n3, lapack_int const* n4
+    #ifdef LAPACK_FORTRAN_STRLEN_END
+    , size_t name_len, size_t opts_len
+    #endif
+    );
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,133 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_INSTRUMENT_HH
+#define LAPACK_INSTRUMENT_HH
+
+#include "lapack/util.hh"
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// One call to an instrumented routine, passed to instrument callbacks.
+///
+/// @ingroup instrument
+struct InstrumentEvent
+{
+    char const* routine;    ///< LAPACK++ routine name, e.g., "getrf".
+    char type;              ///< Precision: 's', 'd', 'c', or 'z'.
+    int64_t m, n, k;        ///< Dimensions; see InstrumentRecord.
+    double gflop;           ///< Gflop from flops.hh, or 0 if unknown.
+    double time;            ///< Wall time in seconds; 0 in the begin callback.
+};
+
+//------------------------------------------------------------------------------
+/// Totals over calls to one routine, precision, and dimensions.
+/// Dimensions are m, n of the matrix and k = nrhs for solves,
+/// or k = number of reflectors for ungqr, unmqr, etc.
+///
+/// @ingroup instrument
+struct InstrumentRecord
+{
+    std::string routine;
+    char type;
+    int64_t m, n, k;
+    int64_t calls;
+    double time;            ///< Total wall time in seconds.
+    double gflop;           ///< Total Gflop, or 0 if unknown.
+};
+
+using InstrumentCallback = std::function< void ( InstrumentEvent const& ) >;
+
+//------------------------------------------------------------------------------
+/// @return true if LAPACK++ was built with instrumentation, i.e., with
+/// CMake `-Dinstrument=yes` or `CXXFLAGS += -DLAPACK_INSTRUMENT`.
+/// Otherwise, the wrappers contain no instrumentation code and
+/// instrument_enable has no effect.
+///
+/// @ingroup instrument
+bool instrument_available();
+
+//------------------------------------------------------------------------------
+/// Enables or disables instrumentation of LAPACK++ routines.
+///
+/// When enabled, each call to an instrumented routine records its
+/// wall time, dimensions, and flops (from lapack::Gflop in flops.hh),
+/// accumulated per routine, precision, and dimensions, and calls the
+/// callbacks set by instrument_set_callbacks. When disabled, the cost
+/// per call is one atomic load. It is disabled by default.
+///
+/// Instrumented routines are the LU, Cholesky, symmetric indefinite,
+/// QR/LQ, least squares, reduction, eigenvalue, and SVD drivers:
+/// gesv, gesv_mixed, getrf, getrs, getri,
+/// posv, posv_mixed, potrf, potrs, potri,
+/// sysv/hesv, sytrf/hetrf, sytrs/hetrs,
+/// geqrf, gelqf, geqlf, gerqf, ungqr/orgqr, unglq/orglq,
+/// unmqr/ormqr, unmlq/ormlq, gels, trtri, gehrd, hetrd/sytrd, gebrd,
+/// heev/syev, heevd/syevd, heevr/syevr, geev, gesvd, gesdd.
+/// Time excludes workspace allocated by overloads that have
+/// `*_work_size_bytes` variants; routines that call other
+/// instrumented routines, e.g., batched routines, record both.
+///
+/// @param[in] enable
+///     Whether to enable instrumentation. Disabling it keeps the records.
+///
+/// @ingroup instrument
+void instrument_enable( bool enable );
+
+//------------------------------------------------------------------------------
+/// @return true if instrumentation is available and enabled.
+///
+/// @ingroup instrument
+bool instrument_enabled();
+
+//------------------------------------------------------------------------------
+/// Removes all instrumentation records.
+///
+/// @ingroup instrument
+void instrument_reset();
+
+//------------------------------------------------------------------------------
+/// @return copy of the instrumentation records, sorted by decreasing time.
+///
+/// @ingroup instrument
+std::vector< InstrumentRecord > instrument_records();
+
+//------------------------------------------------------------------------------
+/// Prints instrumentation records: a summary per routine and precision,
+/// then each routine, precision, and dimensions, sorted by decreasing time.
+///
+/// @param[in] file
+///     Output file, e.g., stdout or stderr.
+///
+/// @ingroup instrument
+void instrument_dump( FILE* file = stdout );
+
+//------------------------------------------------------------------------------
+/// Sets functions called at the beginning and end of each call to an
+/// instrumented routine, for instance, to forward events to a tracing
+/// system. Callbacks are called only while instrumentation is enabled,
+/// on the calling thread, possibly concurrently from several threads.
+/// Callbacks may be replaced at any time; a routine already running may
+/// still call the previous callbacks.
+///
+/// @param[in] begin
+///     Called before the routine runs, with time = 0. May be empty.
+///
+/// @param[in] end
+///     Called after the routine returns or throws, with its time. May be empty.
+///
+/// @ingroup instrument
+void instrument_set_callbacks(
+    InstrumentCallback begin, InstrumentCallback end );
+
+}  // namespace lapack
+
+#endif  // LAPACK_INSTRUMENT_HH
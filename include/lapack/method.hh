@@ -0,0 +1,214 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_METHOD_HH
+#define LAPACK_METHOD_HH
+
+#include "lapack/util.hh"
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Selects the implementation used by lapack::getrf.
+///
+/// - Method::Vendor (default): calls the linked LAPACK library's getrf.
+///   Whether it uses multiple cores depends on that library.
+///
+/// - Method::Native: LAPACK++'s own recursive, blocked LU with partial
+///   pivoting, on top of BLAS++ gemm and trsm. Block columns are
+///   OpenMP tasks: after panel k is factored, panel k+1 is updated and
+///   factored first (look-ahead), overlapping the update of the
+///   remaining columns. Panels are factored recursively, as in getrf2.
+///   Each task calls the BLAS with one thread, so it scales with
+///   OpenMP threads (OMP_NUM_THREADS) even with a single-threaded
+///   reference BLAS. Without OpenMP, it runs sequentially.
+///
+/// The factors and pivots satisfy the same definition as LAPACK's, but
+/// may differ in rounding. The setting is process-wide. Tiny matrices
+/// handled by fixed-size kernels (see lapack::fixed) are not affected.
+///
+/// @param[in] method
+///     Implementation to use.
+///
+/// @ingroup gesv_computational
+void getrf_set_method( Method method );
+
+//------------------------------------------------------------------------------
+/// @return implementation used by lapack::getrf; see getrf_set_method.
+///
+/// @ingroup gesv_computational
+Method getrf_method();
+
+//------------------------------------------------------------------------------
+/// Sets the block size (panel width) of the native getrf.
+///
+/// @param[in] nb
+///     Block size, nb >= 1. Default 128.
+///
+/// @ingroup gesv_computational
+void getrf_set_block_size( int64_t nb );
+
+//------------------------------------------------------------------------------
+/// @return block size of the native getrf; see getrf_set_block_size.
+///
+/// @ingroup gesv_computational
+int64_t getrf_block_size();
+
+//------------------------------------------------------------------------------
+/// Selects the implementation used by the Cholesky routines
+/// lapack::potrf, potrs, potri, and posv (without iter).
+///
+/// - Method::Vendor (default): calls the linked LAPACK library.
+///
+/// - Method::Native: LAPACK++'s own tiled Cholesky. The matrix is split
+///   into square tiles, and each tile operation (potrf2, trsm, herk, gemm,
+///   trtri, trmm, lauum on one tile) is an OpenMP task, with dependencies
+///   on the tiles it reads and writes. The OpenMP runtime runs tasks as
+///   soon as their inputs are ready, so there is no barrier between steps.
+///   Each task calls the BLAS with one thread.
+///   posv runs the factorization and solve in one task graph, so the
+///   solve of the first block rows overlaps the factorization of the rest;
+///   potri likewise overlaps the triangular inverse and the product
+///   $L^H L$ (or $U U^H$). If posv finds A is not positive definite,
+///   B may be partly overwritten.
+///
+/// The results satisfy the same definitions as LAPACK's, but may differ
+/// in rounding. The setting is process-wide. Tiny matrices handled by
+/// fixed-size kernels are not affected.
+///
+/// @param[in] method
+///     Implementation to use.
+///
+/// @ingroup posv_computational
+void potrf_set_method( Method method );
+
+//------------------------------------------------------------------------------
+/// @return implementation used by lapack::potrf, potrs, potri, and posv;
+/// see potrf_set_method.
+///
+/// @ingroup posv_computational
+Method potrf_method();
+
+//------------------------------------------------------------------------------
+/// Sets the tile size of the native Cholesky routines.
+///
+/// @param[in] nb
+///     Tile size, nb >= 0. If nb = 0 (default), it is chosen from n and
+///     the number of OpenMP threads: n is split into about
+///     $2 \sqrt{threads}$ (at least 4) tiles, of size 128 to 512.
+///
+/// @ingroup posv_computational
+void potrf_set_block_size( int64_t nb );
+
+//------------------------------------------------------------------------------
+/// @return tile size set by potrf_set_block_size; 0 means automatic.
+///
+/// @ingroup posv_computational
+int64_t potrf_block_size();
+
+//------------------------------------------------------------------------------
+/// Selects the implementation used by lapack::geqr, for m >= n.
+///
+/// - Method::Vendor (default): calls the linked LAPACK library's geqr,
+///   which for tall-skinny matrices uses a sequential flat-tree TSQR
+///   (latsqr).
+///
+/// - Method::Native: LAPACK++'s parallel TSQR. A is split into row
+///   blocks; each is factored with geqrt, as one OpenMP task, then the
+///   R factors are merged pairwise in a binary tree with tpqrt, in
+///   parallel at each level. lapack::gemqr recognizes the resulting T
+///   and applies Q in parallel, regardless of this setting.
+///   getsqrhrt converts the result to Householder (geqrt) form.
+///
+/// R satisfies the same definition as LAPACK's, but may differ in sign
+/// and rounding. The setting is process-wide.
+///
+/// @param[in] method
+///     Implementation to use.
+///
+/// @ingroup geqrf
+void geqr_set_method( Method method );
+
+//------------------------------------------------------------------------------
+/// @return implementation used by lapack::geqr; see geqr_set_method.
+///
+/// @ingroup geqrf
+Method geqr_method();
+
+//------------------------------------------------------------------------------
+/// Sets the row block size of the native geqr.
+///
+/// @param[in] mb
+///     Row block size, mb >= 0; it is increased to n if needed.
+///     If mb = 0 (default), blocks have about $2^{17}$ elements
+///     and at most m / 64 rows, but at least 2n rows. The layout, and
+///     hence the tsize query, does not depend on the number of threads.
+///
+/// @ingroup geqrf
+void geqr_set_block_size( int64_t mb );
+
+//------------------------------------------------------------------------------
+/// @return row block size set by geqr_set_block_size; 0 means automatic.
+///
+/// @ingroup geqrf
+int64_t geqr_block_size();
+
+//------------------------------------------------------------------------------
+/// Selects the implementation used by the two-stage eigensolvers
+/// lapack::heev_2stage, heevd_2stage, syev_2stage, and syevd_2stage.
+///
+/// - Method::Vendor (default): calls the linked LAPACK library, whose
+///   band-to-tridiagonal stage is often sequential, and which does not
+///   compute eigenvectors (jobz = Vec).
+///
+/// - Method::Native: LAPACK++'s own two-stage reduction. Stage 1 reduces
+///   A to a band of width kd with level 3 BLAS (hemm, her2k). Stage 2
+///   chases the bulges from the band to tridiagonal form in compact band
+///   storage: sweeps are spread over OpenMP threads, and each sweep
+///   follows the one before it a few kd-by-kd blocks behind, so the
+///   threads work in a window of the band that stays in cache.
+///   Eigenvectors are supported: the tridiagonal eigenvectors are
+///   back-transformed through stage 2 with the reflectors of kd
+///   consecutive sweeps grouped into one larfb, over column blocks in
+///   parallel, then through stage 1 with unmqr.
+///
+/// The results satisfy the same definitions as LAPACK's, but may differ
+/// in rounding. The setting is process-wide. hetrd_2stage and
+/// sytrd_2stage, whose outputs follow the vendor's storage format,
+/// always call the vendor library.
+///
+/// @param[in] method
+///     Implementation to use.
+///
+/// @ingroup heev
+void heev_2stage_set_method( Method method );
+
+//------------------------------------------------------------------------------
+/// @return implementation used by lapack::heev_2stage, heevd_2stage,
+/// syev_2stage, and syevd_2stage; see heev_2stage_set_method.
+///
+/// @ingroup heev
+Method heev_2stage_method();
+
+//------------------------------------------------------------------------------
+/// Sets the bandwidth kd of the intermediate band matrix in the native
+/// two-stage eigensolvers.
+///
+/// @param[in] kd
+///     Bandwidth, kd >= 0; it is reduced to n - 1 if needed.
+///     If kd = 0 (default), kd = 32 for n < 2000, otherwise 64.
+///
+/// @ingroup heev
+void heev_2stage_set_block_size( int64_t kd );
+
+//------------------------------------------------------------------------------
+/// @return bandwidth set by heev_2stage_set_block_size; 0 means automatic.
+///
+/// @ingroup heev
+int64_t heev_2stage_block_size();
+
+}  // namespace lapack
+
+#endif  // LAPACK_METHOD_HH
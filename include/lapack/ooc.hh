@@ -0,0 +1,271 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_OOC_HH
+#define LAPACK_OOC_HH
+
+#include "lapack/util.hh"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+// Out-of-core routines operate on matrices too large for memory, which are
+// read from a file or supplied by the application a block at a time.
+// Their memory use depends on the block size, not the matrix size.
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Supplies rows of a tall matrix A and right-hand sides B to the
+/// streaming routines, a row block at a time.
+///
+/// Called as read( i, mb, A, lda, B, ldb ), it copies up to mb rows of A
+/// and B, starting at row i, into the mb-by-n array A and mb-by-nrhs
+/// array B, and returns the number of rows copied. Returning 0 marks the
+/// end of the data; returning fewer than mb rows does not.
+/// If nrhs = 0, B is null. Calls are sequential, with increasing i, but
+/// may come from a thread other than the caller's, so reading the next
+/// block overlaps computing on the current one.
+///
+/// @ingroup ooc
+template <typename scalar_t>
+using RowBlockReader = std::function< int64_t (
+    int64_t i, int64_t mb,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb ) >;
+
+//------------------------------------------------------------------------------
+/// @return a RowBlockReader for an m-by-n matrix A and m-by-nrhs matrix B
+/// stored as raw binary files, memory-mapped read-only.
+/// Pages are released as rows are consumed, so resident memory stays
+/// bounded. The files are unmapped when the last copy of the reader is
+/// destroyed.
+///
+/// @param[in] layout
+///     Storage of both files: ColMajor (column after column, as in
+///     Fortran) or RowMajor (row after row, as typical for data
+///     exported one record per row). RowMajor reads contiguously.
+///
+/// @param[in] m
+///     Number of rows of A and B.
+///
+/// @param[in] n
+///     Number of columns of A.
+///
+/// @param[in] nrhs
+///     Number of columns of B.
+///
+/// @param[in] path_A
+///     File with the m*n elements of A, of type scalar_t.
+///
+/// @param[in] path_B
+///     File with the m*nrhs elements of B. Ignored if nrhs = 0.
+///
+/// Throws Error if a file cannot be opened or mapped or is too small.
+///
+/// @ingroup ooc
+template <typename scalar_t>
+RowBlockReader< scalar_t > mmap_row_reader(
+    blas::Layout layout, int64_t m, int64_t n, int64_t nrhs,
+    std::string const& path_A, std::string const& path_B = "" );
+
+//------------------------------------------------------------------------------
+/// Solves the least squares problem $\min_X || B - A X ||_F$ for a
+/// tall m-by-n matrix A of full rank, streaming A and B row block by
+/// row block. Only R, $Q^H B$, and two row blocks are in memory at once,
+/// so memory is $O( n^2 + n \cdot nrhs + mb (n + nrhs) )$, independent
+/// of m, which need not be known in advance.
+///
+/// Each row block is folded into the triangular factor R with tpqrt,
+/// and its Householder reflectors are applied to the accumulated
+/// $Q^H B$ with tpmqrt, so Q is never stored. The rows of $Q^H B$ that
+/// fall below R are the residual; only their norms are kept.
+/// The next block is read on a separate thread while the current one
+/// is folded in.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in] nrhs
+///     Number of columns of B and X. nrhs >= 0.
+///
+/// @param[in] read
+///     Reader that supplies the rows of A and B; see RowBlockReader.
+///
+/// @param[out] R
+///     The n-by-n array R, in an ldr-by-n array. On exit, the upper
+///     triangular factor R of $A = QR$; the strictly lower part is zero.
+///     $(R^H R)^{-1}$ is, for instance, the unscaled covariance of X.
+///
+/// @param[in] ldr
+///     Leading dimension of R. ldr >= max(1,n).
+///
+/// @param[out] X
+///     The n-by-nrhs array X, in an ldx-by-nrhs array. On successful exit,
+///     the least squares solution. Not referenced if nrhs = 0.
+///
+/// @param[in] ldx
+///     Leading dimension of X. ldx >= max(1,n).
+///
+/// @param[out] resid
+///     Vector of length nrhs. On exit, resid[ j ] = $|| B_j - A X_j ||_2$
+///     for column j. May be null.
+///
+/// @param[in] mb
+///     Rows per block, mb >= 0. If mb = 0, blocks have about $2^{20}$
+///     elements, and at least n rows.
+///
+/// @return = 0: successful exit.
+/// @return > 0: if return value = i, R(i,i) is exactly zero, so A does
+///     not have full rank and X is not computed. R and resid are set.
+///
+/// Exceptions thrown by read are propagated.
+///
+/// @ingroup ooc
+template <typename scalar_t>
+int64_t gels_stream(
+    int64_t n, int64_t nrhs,
+    RowBlockReader< scalar_t > const& read,
+    scalar_t* R, int64_t ldr,
+    scalar_t* X, int64_t ldx,
+    blas::real_type< scalar_t >* resid,
+    int64_t mb = 0 );
+
+//------------------------------------------------------------------------------
+/// Computes the triangular factor R of the QR factorization of a tall
+/// m-by-n matrix A, streaming A row block by row block; see gels_stream,
+/// which this calls with nrhs = 0. The read callback gets B = null.
+///
+/// @return 0.
+///
+/// @ingroup ooc
+template <typename scalar_t>
+int64_t geqr_stream(
+    int64_t n,
+    RowBlockReader< scalar_t > const& read,
+    scalar_t* R, int64_t ldr,
+    int64_t mb = 0 );
+
+//------------------------------------------------------------------------------
+/// Storage backend for out-of-core matrices, such as potrf_ooc's.
+/// Holds bytes addressed by offset, e.g., a file. Applications can derive
+/// from it to use other stores (a remote object, a compressed file, ...).
+///
+/// read and write may be called concurrently from several threads, but
+/// never on overlapping ranges at the same time. A read must see the
+/// data of any write to the same range that completed before it.
+///
+/// @ingroup ooc
+class OocStorage
+{
+public:
+    virtual ~OocStorage() {}
+
+    /// Reads bytes [offset, offset + size) into buffer.
+    virtual void read( int64_t offset, int64_t size, void* buffer ) = 0;
+
+    /// Writes buffer to bytes [offset, offset + size).
+    virtual void write( int64_t offset, int64_t size, void const* buffer ) = 0;
+};
+
+//------------------------------------------------------------------------------
+/// @return storage backed by a memory-mapped file.
+/// Reads and writes are memory copies; pages are released afterwards,
+/// so the operating system can evict them and resident memory stays
+/// bounded. Best when the file system caches well, e.g., local SSD.
+///
+/// @param[in] path
+///     File name. It is created if needed, and extended to size bytes
+///     if shorter. Existing contents are kept.
+///
+/// @param[in] size
+///     Size of the store, in bytes.
+///
+/// Throws Error if the file cannot be opened or mapped.
+///
+/// @ingroup ooc
+std::shared_ptr< OocStorage > mmap_storage(
+    std::string const& path, int64_t size );
+
+//------------------------------------------------------------------------------
+/// @return storage backed by a file, accessed with pread and pwrite.
+/// Avoids page-table overhead and works on file systems where
+/// memory-mapping is slow or unsupported, e.g., some network file systems.
+///
+/// @param[in] path
+///     File name. It is created if needed, and extended to size bytes
+///     if shorter. Existing contents are kept.
+///
+/// @param[in] size
+///     Size of the store, in bytes.
+///
+/// Throws Error if the file cannot be opened; read and write throw
+/// Error on I/O errors.
+///
+/// @ingroup ooc
+std::shared_ptr< OocStorage > pread_storage(
+    std::string const& path, int64_t size );
+
+//------------------------------------------------------------------------------
+/// Computes the Cholesky factorization of a Hermitian positive definite
+/// n-by-n matrix A stored out-of-core, in column-major order with leading
+/// dimension lda, i.e., element (i, j) at byte offset
+/// (i + j*lda) * sizeof( scalar_t ) of storage A:
+///     $A = L L^H$ if uplo = Lower, or $A = U^H U$ if uplo = Upper.
+/// Only the uplo triangle is read and overwritten with the factor;
+/// the other triangle, outside the diagonal blocks, is not accessed.
+///
+/// The algorithm is left-looking by block columns of width nb (block rows
+/// for Upper). For each block column k, it reads A_k, subtracts the
+/// contributions of block columns 0, ..., k-1 of L, read back one at a time,
+/// then factors it with potrf and trsm and writes it back. I/O is double
+/// buffered and asynchronous: the next block column of L is read, and the
+/// previous result written, on helper threads while the current update
+/// runs on the calling thread, which keeps the BLAS threads. Block column
+/// k-1 is used from memory, not read back.
+///
+/// Memory is 4 n nb elements. I/O is about $n^3 / (3 nb)$ elements
+/// read, so nb should be as large as memory allows. Lower reads whole
+/// column segments; Upper reads nb elements per column, so Lower is
+/// faster for most storage.
+///
+/// Available for scalar_t = `float`, `double`, `std::complex<float>`,
+/// and `std::complex<double>`, which must be given explicitly,
+/// e.g., potrf_ooc< double >( uplo, n, storage, lda ).
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of A is stored;
+///     - lapack::Uplo::Lower: Lower triangle of A is stored.
+///
+/// @param[in] n
+///     The order of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     Storage holding A. On successful exit, the factor L or U.
+///
+/// @param[in] lda
+///     The leading dimension of A in storage. lda >= max(1,n).
+///
+/// @param[in] nb
+///     Block size, nb >= 0. If nb = 0, uses 256.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, the leading minor of order i is not
+///     positive definite, and the factorization could not be completed.
+///     Block columns before the one containing i are written.
+///
+/// Exceptions thrown by the storage are propagated.
+///
+/// @ingroup ooc
+template <typename scalar_t>
+int64_t potrf_ooc(
+    lapack::Uplo uplo, int64_t n,
+    OocStorage& A, int64_t lda,
+    int64_t nb = 0 );
+
+}  // namespace lapack
+
+#endif  // LAPACK_OOC_HH
@@ -0,0 +1,176 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_POLAR_HH
+#define LAPACK_POLAR_HH
+
+#include "lapack/util.hh"
+
+// The polar decomposition by QDWH (QR-based dynamically weighted Halley
+// iteration), and the spectral divide and conquer eigensolver and SVD
+// built on it. These use only geqrf, ungqr, potrf, and level 3 BLAS, so
+// they avoid the bandwidth-bound reduction to tridiagonal or bidiagonal
+// form of heevd and gesdd, at the cost of more operations: they are
+// intended for large matrices on many cores.
+//
+// Available for scalar_t = `float`, `double`, `std::complex<float>`,
+// and `std::complex<double>`.
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Computes the polar decomposition of an m-by-n matrix A, m >= n,
+/// \[
+///     A = U H,
+/// \]
+/// with U m-by-n with orthonormal columns and H n-by-n Hermitian positive
+/// semidefinite, by QDWH iterations, after Nakatsukasa, Bai, and Gygi,
+/// SIAM J. Matrix Anal. Appl., 2010. Each iteration is
+///     X_{k+1} = (b_k/c_k) X_k + (a_k - b_k/c_k) X_k (I + c_k X_k^H X_k)^{-1},
+/// computed by the QR factorization of [ sqrt(c_k) X_k; I ] (geqrf, ungqr)
+/// while c_k is large, then by Cholesky (potrf). At most 6 iterations are
+/// needed in double precision.
+/// If A is rank deficient, U is not unique; its columns for the null space
+/// of A are completed to an orthonormal basis.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. 0 <= n <= m.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On exit, the polar factor U.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] H
+///     The n-by-n Hermitian positive semidefinite factor H, stored in an
+///     ldh-by-n array, with both triangles.
+///
+/// @param[in] ldh
+///     The leading dimension of the array H. ldh >= max(1,n).
+///
+/// @return = 0: successful exit.
+/// @return = 1: the iteration did not converge.
+///
+/// @ingroup gesvd
+template <typename scalar_t>
+int64_t qdwh(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* H, int64_t ldh );
+
+//------------------------------------------------------------------------------
+/// Computes all eigenvalues and, optionally, eigenvectors of a Hermitian
+/// matrix A, as heevd does, by QDWH-based spectral divide and conquer,
+/// after Nakatsukasa and Higham, SIAM J. Sci. Comput., 2013.
+///
+/// With sigma the median of diag( A ), the polar factor of A - sigma I
+/// gives the spectral projector onto the eigenvalues of A > sigma, whose
+/// range splits A into two smaller Hermitian matrices, solved recursively;
+/// small subproblems use heevd. All eigenvectors are computed internally,
+/// also for jobz = NoVec.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: Compute eigenvalues only;
+///     - lapack::Job::Vec: Compute eigenvalues and eigenvectors.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of A is stored;
+///     - lapack::Uplo::Lower: Lower triangle of A is stored.
+///
+/// @param[in] n
+///     The order of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n matrix A, stored in an lda-by-n array.
+///     On entry, the Hermitian matrix A, in its uplo triangle.
+///     On exit, if jobz = Vec, A contains the orthonormal eigenvectors
+///     of A; if jobz = NoVec, A is not modified.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,n).
+///
+/// @param[out] W
+///     The vector W of length n.
+///     The eigenvalues in ascending order.
+///
+/// @return = 0: successful exit.
+/// @return > 0: heevd failed on a subproblem, or QDWH did not converge.
+///
+/// @ingroup heev
+template <typename scalar_t>
+int64_t heevd_qdwh(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* W );
+
+//------------------------------------------------------------------------------
+/// Computes the singular value decomposition (SVD) of an m-by-n matrix A,
+/// \[
+///     A = U \Sigma V^H,
+/// \]
+/// as gesdd does with jobz = NoVec or SomeVec, from the polar decomposition
+/// A = Up H by qdwh, and the eigendecomposition H = V Sigma V^H by
+/// heevd_qdwh, so U = Up V. If m < n, A^H is decomposed instead.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: compute singular values only;
+///     - lapack::Job::SomeVec: compute singular values, and the first
+///       min(m,n) left and right singular vectors.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On exit, the contents of A are destroyed.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] S
+///     The vector S of length min(m,n).
+///     The singular values of A, S(i) >= S(i+1).
+///
+/// @param[out] U
+///     The m-by-min(m,n) matrix U, stored in an ldu-by-min(m,n) array.
+///     If jobz = SomeVec, the left singular vectors.
+///     If jobz = NoVec, U is not referenced.
+///
+/// @param[in] ldu
+///     The leading dimension of the array U. ldu >= 1;
+///     if jobz = SomeVec, ldu >= m.
+///
+/// @param[out] VT
+///     The min(m,n)-by-n matrix V^H, stored in an ldvt-by-n array.
+///     If jobz = SomeVec, the right singular vectors, as rows.
+///     If jobz = NoVec, VT is not referenced.
+///
+/// @param[in] ldvt
+///     The leading dimension of the array VT. ldvt >= 1;
+///     if jobz = SomeVec, ldvt >= min(m,n).
+///
+/// @return = 0: successful exit.
+/// @return > 0: qdwh or heevd_qdwh failed.
+///
+/// @ingroup gesvd
+template <typename scalar_t>
+int64_t gesvd_qdwh(
+    lapack::Job jobz, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt );
+
+}  // namespace lapack
+
+#endif  // LAPACK_POLAR_HH
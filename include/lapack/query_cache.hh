@@ -0,0 +1,72 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_QUERY_CACHE_HH
+#define LAPACK_QUERY_CACHE_HH
+
+#include "lapack/util.hh"
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Enables or disables the workspace query cache.
+///
+/// Routines that find their workspace size with a LAPACK query
+/// (lwork = -1) make an extra Fortran call each time. With the cache
+/// enabled, the resulting workspace size is remembered, keyed by routine,
+/// precision, dimensions, leading dimensions, and job flags, so repeated
+/// calls with the same shape skip the query. The cache is process-wide
+/// and thread-safe. It is disabled by default.
+///
+/// Currently used by the routines that have `*_work_size_bytes` variants:
+/// geqrf, gelqf, gehrd, gels, gelsd, geev, gesvd, gesdd, gesvdx,
+/// syevd/heevd, syevr/heevr, sytrd/hetrd, sytrf/hetrf, ormqr/unmqr.
+///
+/// Entries are never evicted; call query_cache_clear if the set of
+/// shapes is unbounded, or if the LAPACK library's tuning changes,
+/// e.g., its block size.
+///
+/// @param[in] enable
+///     Whether to enable the cache. Disabling it keeps existing entries.
+///
+/// @ingroup workspace
+void query_cache_enable( bool enable );
+
+//------------------------------------------------------------------------------
+/// @return true if the workspace query cache is enabled.
+///
+/// @ingroup workspace
+bool query_cache_enabled();
+
+//------------------------------------------------------------------------------
+/// Removes all entries from the workspace query cache and resets
+/// its hit and miss counters.
+///
+/// @ingroup workspace
+void query_cache_clear();
+
+//------------------------------------------------------------------------------
+/// @return number of lookups in the workspace query cache that found an
+/// entry, since the cache was last cleared.
+///
+/// @ingroup workspace
+int64_t query_cache_hits();
+
+//------------------------------------------------------------------------------
+/// @return number of lookups in the workspace query cache that did not find
+/// an entry, hence did a LAPACK query, since the cache was last cleared.
+///
+/// @ingroup workspace
+int64_t query_cache_misses();
+
+//------------------------------------------------------------------------------
+/// @return number of entries in the workspace query cache.
+///
+/// @ingroup workspace
+int64_t query_cache_size();
+
+}  // namespace lapack
+
+#endif  // LAPACK_QUERY_CACHE_HH
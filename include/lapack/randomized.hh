@@ -0,0 +1,216 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_RANDOMIZED_HH
+#define LAPACK_RANDOMIZED_HH
+
+#include "lapack/util.hh"
+
+// Randomized algorithms compute low-rank approximations and
+// factorizations from a random sketch of the matrix, a product with a
+// random matrix of a few more columns than the rank sought. Sketches are
+// either Gaussian, drawn by larnv, or subsampled randomized Hadamard
+// transforms (SRHT), which are cheaper to apply to large matrices.
+// Results depend on the random seed iseed, as in larnv, which is updated
+// on exit so repeated calls draw different sketches.
+//
+// Available for scalar_t = `float`, `double`, `std::complex<float>`,
+// and `std::complex<double>`.
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Computes a rank-k approximation of the singular value decomposition
+/// (SVD) of an m-by-n matrix A,
+/// \[
+///     A \approx U \Sigma V^H,
+/// \]
+/// by a randomized range finder, as an alternative to gesvd, gesdd, and
+/// gesvdx when only the leading singular triplets are needed:
+///
+/// 1. Y = A Omega, with Omega an n-by-l random sketch, l = k + oversample,
+///    and Q = orth( Y ), by geqrf and ungqr.
+/// 2. power subspace iterations, Q = orth( A orth( A^H Q ) ),
+///    orthogonalizing in between to keep small singular values.
+/// 3. A^H Q = Qb R by geqrf, so A \approx Q R^H Qb^H, and the small
+///    l-by-l SVD R^H = Ur Sigma Vr^H by gesdd.
+/// 4. U = Q Ur( :, 1:k ) and V = Qb Vr( :, 1:k ), by gemm and unmqr.
+///
+/// This takes $O( m n l )$ operations per pass over A, with
+/// 2 (power + 1) passes, compared to $O( m n \min(m, n) )$ for a full SVD.
+/// The error is close to that of the best rank-k approximation when the
+/// singular values decay; more power iterations improve it when they
+/// decay slowly.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: compute singular values only;
+///     - lapack::Job::Vec: compute singular values and the first k
+///       left and right singular vectors.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in] k
+///     The target rank. 0 <= k <= min(m,n).
+///
+/// @param[in] A
+///     The m-by-n matrix A, stored in an lda-by-n array. Not modified.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] rank
+///     The number of singular values returned: k, or if tol > 0, the
+///     number of computed singular values S(i) > tol S(1), at most k.
+///
+/// @param[out] S
+///     The vector S of length k.
+///     The approximate leading singular values of A, S(i) >= S(i+1).
+///     Entries after rank are set to zero.
+///
+/// @param[out] U
+///     The m-by-k matrix U, stored in an ldu-by-k array.
+///     If jobz = Vec, the approximate left singular vectors; the first
+///     rank columns are the ones for S(1:rank).
+///     If jobz = NoVec, U is not referenced.
+///
+/// @param[in] ldu
+///     The leading dimension of the array U. ldu >= 1;
+///     if jobz = Vec, ldu >= m.
+///
+/// @param[out] VT
+///     The k-by-n matrix V^H, stored in an ldvt-by-n array.
+///     If jobz = Vec, the approximate right singular vectors, as rows;
+///     the first rank rows are the ones for S(1:rank).
+///     If jobz = NoVec, VT is not referenced.
+///
+/// @param[in] ldvt
+///     The leading dimension of the array VT. ldvt >= 1;
+///     if jobz = Vec, ldvt >= k.
+///
+/// @param[in,out] iseed
+///     The vector iseed of length 4, the seed of the random sketch, as in
+///     larnv. Elements must be between 0 and 4095, and iseed(4) must be
+///     odd. On exit, the seed is updated.
+///
+/// @param[in] tol
+///     Relative truncation tolerance. If tol > 0, singular values
+///     S(i) <= tol S(1) are dropped from rank. Default 0.
+///
+/// @param[in] oversample
+///     The number of extra sketch columns, p. l = min( k + p, m, n ).
+///     oversample >= 0. Default 10.
+///
+/// @param[in] power
+///     The number of power iterations. power >= 0. Default 2.
+///
+/// @param[in] sketch
+///     The random sketch Omega:
+///     - lapack::Sketch::Gaussian: normally distributed entries;
+///     - lapack::Sketch::SRHT: subsampled randomized Hadamard transform,
+///       which applies to A in $O( m n \log n )$ operations.
+///     Default Gaussian.
+///
+/// @return = 0: successful exit.
+/// @return > 0: gesdd on the small l-by-l matrix did not converge.
+///
+/// @ingroup gesvd
+template <typename scalar_t>
+int64_t gesvd_rand(
+    lapack::Job jobz, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    int64_t* rank,
+    blas::real_type< scalar_t >* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    int64_t* iseed,
+    blas::real_type< scalar_t > tol = 0,
+    int64_t oversample = 10,
+    int64_t power = 2,
+    lapack::Sketch sketch = lapack::Sketch::Gaussian );
+
+//------------------------------------------------------------------------------
+/// Computes a QR factorization with column pivoting of an m-by-n matrix A,
+/// \[
+///     A P = Q R,
+/// \]
+/// with the same arguments and results as geqp3, but choosing pivots on a
+/// small random sketch of A (randomized QRCP). geqp3 updates column norms
+/// after every column, so runs largely at BLAS-2 speed. Here, for each
+/// panel of nb columns:
+///
+/// 1. pivots are chosen by geqp3 on the l-by-(n-j) sketch B = Omega A22
+///    of the trailing matrix, l = nb + oversample;
+/// 2. the pivot columns are swapped to the front, the panel is factored
+///    by geqrf, and the trailing matrix is updated by larfb (BLAS-3);
+/// 3. the sketch is updated to one of the new trailing matrix,
+///    B2 = B2 - B1 R11^{-1} R12, in $O( l \cdot nb \cdot n )$ operations,
+///    or, if R11 is ill-conditioned, computed again from A22.
+///
+/// The pivots usually reveal rank as well as those of geqp3, so A and jpvt
+/// on exit can be used in place of geqp3's, e.g., as in gelsy.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On exit, the upper triangle of the array contains the
+///     min(m,n)-by-n upper trapezoidal matrix R; the elements below
+///     the diagonal, together with the array tau, represent the
+///     unitary matrix Q as a product of min(m,n) elementary reflectors,
+///     as in geqrf.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[in,out] jpvt
+///     The vector jpvt of length n.
+///     On entry, if jpvt(j) != 0, the j-th column of A is permuted
+///     to the front of A P (a leading column); if jpvt(j) = 0,
+///     the j-th column of A is a free column.
+///     On exit, if jpvt(j) = k, then the j-th column of A P was
+///     the k-th column of A.
+///
+/// @param[out] tau
+///     The vector tau of length min(m,n).
+///     The scalar factors of the elementary reflectors.
+///
+/// @param[in,out] iseed
+///     The vector iseed of length 4, the seed of the random sketch, as in
+///     larnv. On exit, the seed is updated.
+///
+/// @param[in] nb
+///     The panel width. nb >= 1. Default 32.
+///
+/// @param[in] oversample
+///     The number of extra sketch rows, p. oversample >= 0. Default 8.
+///
+/// @param[in] sketch
+///     The random sketch Omega, as in gesvd_rand. Default Gaussian.
+///
+/// @return = 0: successful exit.
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+int64_t geqp3_rand(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* jpvt,
+    scalar_t* tau,
+    int64_t* iseed,
+    int64_t nb = 32,
+    int64_t oversample = 8,
+    lapack::Sketch sketch = lapack::Sketch::Gaussian );
+
+}  // namespace lapack
+
+#endif  // LAPACK_RANDOMIZED_HH
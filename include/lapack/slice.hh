@@ -0,0 +1,198 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_SLICE_HH
+#define LAPACK_SLICE_HH
+
+#include "lapack/util.hh"
+
+// Spectrum slicing eigensolvers compute selected eigenvalues and
+// eigenvectors of symmetric tridiagonal or Hermitian matrices with the
+// same arguments and results as stevx and heevx, but in parallel over
+// OpenMP threads, if OpenMP is enabled. Eigenvalues come from Sturm count
+// bisection (sturm_bisect); the selected eigenvalues are then divided
+// into slices, whose eigenvectors are computed independently by inverse
+// iteration (stein). Intended for selecting many eigenpairs, where the
+// vendor stevx and heevx are largely sequential.
+//
+// Available for scalar_t = `float`, `double`, and, for heevx_slice,
+// `std::complex<float>` and `std::complex<double>`.
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues and, optionally, eigenvectors of a real
+/// symmetric tridiagonal matrix T, as stevx does, by spectrum slicing.
+///
+/// The selected eigenvalues are computed by sturm_bisect, in parallel.
+/// With range = Value, the indices of the eigenvalues in (vl, vu] are
+/// found by Sturm counts at vl and vu. Eigenvalues are accurate to about
+/// eps ||T||, as with abstol = 0 in stevx.
+///
+/// Eigenvectors are computed by stein, in parallel over slices of
+/// consecutive eigenvalues. stein reorthogonalizes eigenvectors within
+/// each cluster of eigenvalues closer than 1e-3 ||T||_1 to their
+/// neighbors, so slices end between clusters where possible, which gives
+/// the same results as one call to stein. A cluster too large for one
+/// slice is split at its widest gap, and the eigenvectors of the later
+/// slice are reorthogonalized against the rest of the cluster.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: Compute eigenvalues only;
+///     - lapack::Job::Vec: Compute eigenvalues and eigenvectors.
+///
+/// @param[in] range
+///     - lapack::Range::All: all eigenvalues will be found.
+///     - lapack::Range::Value: all eigenvalues in the half-open interval
+///         (vl,vu] will be found.
+///     - lapack::Range::Index: the il-th through iu-th eigenvalues will be
+///         found.
+///
+/// @param[in] n
+///     The order of the matrix T. n >= 0.
+///
+/// @param[in] D
+///     The vector D of length n, the diagonal elements of T.
+///
+/// @param[in] E
+///     The vector E of length n-1, the off-diagonal elements of T.
+///
+/// @param[in] vl
+///     If range=Value, the lower bound of the interval to be searched for
+///     eigenvalues. vl < vu. Not referenced otherwise.
+///
+/// @param[in] vu
+///     If range=Value, the upper bound of the interval to be searched for
+///     eigenvalues. vl < vu. Not referenced otherwise.
+///
+/// @param[in] il
+///     If range=Index, the index of the smallest eigenvalue to be returned.
+///     1 <= il <= iu <= n, if n > 0; il = 1 and iu = 0 if n = 0.
+///     Not referenced otherwise.
+///
+/// @param[in] iu
+///     If range=Index, the index of the largest eigenvalue to be returned.
+///     Not referenced otherwise.
+///
+/// @param[out] nfound
+///     The total number of eigenvalues found. 0 <= nfound <= n.
+///
+/// @param[out] W
+///     The vector W of length n.
+///     The first nfound elements contain the selected eigenvalues in
+///     ascending order.
+///
+/// @param[out] Z
+///     The n-by-nfound array Z, in an ldz-by-n array.
+///     If jobz = Vec, then if successful, the first nfound columns of Z
+///     contain the orthonormal eigenvectors of T corresponding to the
+///     selected eigenvalues, the i-th column of Z holding the eigenvector
+///     associated with W(i). If an eigenvector fails to converge, then
+///     that column of Z contains the latest approximation, and its index
+///     is returned in ifail.
+///     If jobz = NoVec, Z is not referenced.
+///
+/// @param[in] ldz
+///     The leading dimension of the array Z. ldz >= 1, and if
+///     jobz = Vec, ldz >= max(1,n).
+///
+/// @param[out] ifail
+///     The vector ifail of length n.
+///     If jobz = Vec, then if successful, the first nfound elements of
+///     ifail are zero. If the return value is i > 0, then ifail contains
+///     the 1-based indices of the i eigenvectors that failed to converge.
+///     If jobz = NoVec, ifail is not referenced.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, then i eigenvectors failed to converge.
+///              Their indices are stored in array ifail.
+///
+/// @ingroup htev
+template <typename scalar_t>
+int64_t stevx_slice(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t const* D, scalar_t const* E,
+    scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail );
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues and, optionally, eigenvectors of a
+/// Hermitian matrix A, as heevx does, by spectrum slicing: A is reduced
+/// to tridiagonal form T by hetrd, whose selected eigenpairs are computed
+/// as in stevx_slice, and the eigenvectors are transformed back by unmtr.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: Compute eigenvalues only;
+///     - lapack::Job::Vec: Compute eigenvalues and eigenvectors.
+///
+/// @param[in] range
+///     - lapack::Range::All: all eigenvalues will be found.
+///     - lapack::Range::Value: all eigenvalues in the half-open interval
+///         (vl,vu] will be found.
+///     - lapack::Range::Index: the il-th through iu-th eigenvalues will be
+///         found.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of A is stored;
+///     - lapack::Uplo::Lower: Lower triangle of A is stored.
+///
+/// @param[in] n
+///     The order of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n matrix A, stored in an lda-by-n array.
+///     On entry, the Hermitian matrix A, in its uplo triangle.
+///     On exit, the uplo triangle, including the diagonal, is destroyed.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,n).
+///
+/// @param[in] vl, vu, il, iu
+///     The range of eigenvalues to find, as in stevx_slice.
+///
+/// @param[out] nfound
+///     The total number of eigenvalues found. 0 <= nfound <= n.
+///
+/// @param[out] W
+///     The vector W of length n.
+///     The first nfound elements contain the selected eigenvalues in
+///     ascending order.
+///
+/// @param[out] Z
+///     The n-by-nfound array Z, in an ldz-by-n array.
+///     If jobz = Vec, the first nfound columns of Z contain the
+///     orthonormal eigenvectors of A corresponding to the selected
+///     eigenvalues, as in stevx_slice.
+///     If jobz = NoVec, Z is not referenced.
+///
+/// @param[in] ldz
+///     The leading dimension of the array Z. ldz >= 1, and if
+///     jobz = Vec, ldz >= max(1,n).
+///
+/// @param[out] ifail
+///     The vector ifail of length n, as in stevx_slice.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, then i eigenvectors failed to converge.
+///              Their indices are stored in array ifail.
+///
+/// @ingroup heev
+template <typename scalar_t>
+int64_t heevx_slice(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t > vl, blas::real_type< scalar_t > vu,
+    int64_t il, int64_t iu,
+    int64_t* nfound,
+    blas::real_type< scalar_t >* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail );
+
+}  // namespace lapack
+
+#endif  // LAPACK_SLICE_HH
@@ -0,0 +1,138 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_SUBSPACE_HH
+#define LAPACK_SUBSPACE_HH
+
+#include "lapack/util.hh"
+
+// Subspace iteration computes a few eigenpairs of a Hermitian matrix by
+// repeated products with a block of vectors, in O(n^2 k) operations for
+// k eigenpairs, instead of the O(n^3) reduction to tridiagonal form of
+// heevd and heevr. It can start from any subspace, so for a sequence of
+// slowly changing matrices, as in time stepping, the eigenvectors of one
+// matrix are a good starting guess for the next, and few iterations
+// are needed.
+//
+// Available for scalar_t = `float`, `double`, `std::complex<float>`,
+// and `std::complex<double>`.
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Computes the k smallest eigenvalues and corresponding eigenvectors
+/// of a Hermitian matrix A, as heevr does with range = Index, il = 1,
+/// iu = k, by Chebyshev filtered subspace iteration, after Zhou, Saad,
+/// Tiago, and Chelikowsky, J. Comput. Phys., 2006.
+///
+/// The search subspace has l = min( n, k + max( 10, k/5 ) ) columns.
+/// Each iteration:
+///
+/// 1. Rayleigh--Ritz: with V an orthonormal basis of the subspace,
+///    the eigendecomposition of the small l-by-l matrix V^H A V by heev
+///    gives Ritz values theta and Ritz vectors V = V Q.
+/// 2. Locking: each of the k smallest Ritz pairs with residual
+///    ||A v - theta v||_2 <= tol ||A||_1 is locked; locked pairs are no
+///    longer updated, and the rest of the subspace is kept orthogonal
+///    to them.
+/// 3. Chebyshev filtering: the unlocked vectors are multiplied by the
+///    Chebyshev polynomial of the given degree that is bounded by 1 on
+///    [ theta_l, lambda_max ], which damps the unwanted part of the
+///    spectrum, then orthonormalized by geqrf and ungqr. An upper bound
+///    on lambda_max comes from a few Lanczos steps.
+///
+/// Each iteration takes degree + 1 products of A with at most l vectors,
+/// by hemm. The first nstart columns of X on entry are used as the
+/// starting subspace, typically the eigenvectors from a previous call for
+/// a nearby matrix; other columns start random. If l = n, heevd is used.
+///
+/// Cost: an iteration costs about 2 n^2 l (degree + 1) flops, against
+/// roughly (4/3) n^3 for the tridiagonal reduction in heevr, so the method
+/// wins only if iterations * (degree + 1) * l is well below n. The residual
+/// shrinks each iteration by a factor set by the gap between lambda_k and
+/// lambda_l relative to the width of the spectrum; a raised degree takes
+/// fewer iterations but about the same number of products, and degree 10
+/// balances that against the cost of the Rayleigh--Ritz and
+/// orthonormalization steps. An outlying lambda_max, as for matrices with
+/// entries of nonzero mean, widens the filter interval and slows
+/// convergence; use heevr then. The number of iterations grows with
+/// log( r_0 / (tol ||A||_1) ), for a starting residual r_0, so the
+/// saving of a warm start is largest when tol is no tighter than the
+/// application needs: the default n eps matches the accuracy of heevr,
+/// while, for instance, tol = 1e-10 in double precision typically halves
+/// the warm-start iterations after a small perturbation of A.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of A is stored;
+///     - lapack::Uplo::Lower: Lower triangle of A is stored.
+///
+/// @param[in] n
+///     The order of the matrix A. n >= 0.
+///
+/// @param[in] k
+///     The number of eigenpairs wanted. 0 <= k <= n.
+///
+/// @param[in] A
+///     The n-by-n Hermitian matrix A, stored in an lda-by-n array,
+///     in its uplo triangle. Not modified.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,n).
+///
+/// @param[out] W
+///     The vector W of length k.
+///     The k smallest eigenvalues of A, in ascending order.
+///
+/// @param[in,out] X
+///     The n-by-k matrix X, stored in an ldx-by-k array.
+///     On entry, the first nstart columns span the starting subspace;
+///     they need not be orthonormal. Other columns are ignored.
+///     On exit, the orthonormal eigenvectors for W.
+///
+/// @param[in] ldx
+///     The leading dimension of the array X. ldx >= max(1,n).
+///
+/// @param[in] nstart
+///     The number of starting vectors in X. 0 <= nstart <= k.
+///     Use nstart = 0 for a random start.
+///
+/// @param[out] iters
+///     The number of iterations (Rayleigh--Ritz steps) taken;
+///     0 if heevd was used. May be null.
+///
+/// @param[in] tol
+///     Convergence tolerance, relative to ||A||_1.
+///     If tol <= 0, n eps is used. Default 0. See cost above.
+///
+/// @param[in] degree
+///     The degree of the Chebyshev filter. degree >= 1. Default 10.
+///
+/// @param[in] maxiter
+///     The maximum number of iterations. maxiter >= 1. Default 100.
+///
+/// @return = 0: successful exit.
+/// @return 0 < i <= k: the number of eigenpairs that did not converge in
+///              maxiter iterations.
+///              W and X hold the current approximations.
+/// @return i > k: the eigensolver of the Rayleigh--Ritz step (heev, or
+///              heevd if l = n) failed with info = i - k.
+///              W and X are not modified.
+///
+/// @ingroup heev
+template <typename scalar_t>
+int64_t heev_subspace(
+    lapack::Uplo uplo, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    blas::real_type< scalar_t >* W,
+    scalar_t* X, int64_t ldx,
+    int64_t nstart,
+    int64_t* iters,
+    blas::real_type< scalar_t > tol = 0,
+    int64_t degree = 10,
+    int64_t maxiter = 100 );
+
+}  // namespace lapack
+
+#endif  // LAPACK_SUBSPACE_HH
@@ -0,0 +1,292 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_UPDATE_HH
+#define LAPACK_UPDATE_HH
+
+#include "lapack/util.hh"
+
+// Factorization updates modify a Cholesky or QR factorization after a
+// low-rank change to the matrix, in O(n^2) operations per rank-1 change,
+// instead of refactoring in O(n^3). They use plane rotations (lartg),
+// and Householder reflectors (larfg) where a whole column is eliminated.
+//
+// Indices of inserted or deleted rows and columns are 0-based.
+//
+// Available for scalar_t = `float`, `double`, `std::complex<float>`,
+// and `std::complex<double>`.
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Updates the Cholesky factorization of an n-by-n Hermitian positive
+/// definite matrix A after the rank-k change $\tilde{A} = A + X X^H$,
+/// in $O(k n^2)$ operations:
+///     $\tilde{A} = \tilde{L} \tilde{L}^H$ if uplo = Lower, or
+///     $\tilde{A} = \tilde{U}^H \tilde{U}$ if uplo = Upper.
+/// Each column x of X is folded into the factor with n plane rotations
+/// from lartg. The result is positive definite, so this cannot fail.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: A = U^H U; the upper triangle is referenced;
+///     - lapack::Uplo::Lower: A = L L^H; the lower triangle is referenced.
+///
+/// @param[in] n
+///     The order of A. n >= 0.
+///
+/// @param[in] k
+///     The number of columns of X. k >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n array A, in an lda-by-n array.
+///     On entry, the factor L or U of A, as from potrf.
+///     On exit, the factor of $\tilde{A}$. The other triangle is not
+///     referenced.
+///
+/// @param[in] lda
+///     The leading dimension of A. lda >= max(1,n).
+///
+/// @param[in,out] X
+///     The n-by-k matrix X, in an ldx-by-k array. Destroyed on exit.
+///
+/// @param[in] ldx
+///     The leading dimension of X. ldx >= max(1,n).
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrf_update(
+    lapack::Uplo uplo, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t* X, int64_t ldx );
+
+//------------------------------------------------------------------------------
+/// Downdates the Cholesky factorization of an n-by-n Hermitian positive
+/// definite matrix A after the rank-k change $\tilde{A} = A - X X^H$,
+/// in $O(k n^2)$ operations, as LINPACK's xCHDD does.
+/// For each column x of X, it solves $L p = x$ (or $U^H p = x$);
+/// $A - x x^H$ is positive definite iff $||p||_2 < 1$. If so, the
+/// rotations from lartg that reduce $[p; \sqrt{1 - ||p||^2}]$ to $e_{n+1}$,
+/// applied to $[L^H; 0]$, give the new factor. Unlike hyperbolic
+/// rotations, these are orthogonal, so the downdate is as stable as the
+/// problem's conditioning allows.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: A = U^H U; the upper triangle is referenced;
+///     - lapack::Uplo::Lower: A = L L^H; the lower triangle is referenced.
+///
+/// @param[in] n
+///     The order of A. n >= 0.
+///
+/// @param[in] k
+///     The number of columns of X. k >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n array A, in an lda-by-n array.
+///     On entry, the factor L or U of A, as from potrf.
+///     On successful exit, the factor of $\tilde{A}$.
+///
+/// @param[in] lda
+///     The leading dimension of A. lda >= max(1,n).
+///
+/// @param[in,out] X
+///     The n-by-k matrix X, in an ldx-by-k array. Destroyed on exit.
+///
+/// @param[in] ldx
+///     The leading dimension of X. ldx >= max(1,n).
+///
+/// @return = 0: successful exit.
+/// @return > 0: if return value = j, subtracting column j of X (1-based)
+///     would make the matrix not positive definite. A holds the factor
+///     after subtracting columns 1 to j-1, which is valid.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+int64_t potrf_downdate(
+    lapack::Uplo uplo, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t* X, int64_t ldx );
+
+//------------------------------------------------------------------------------
+/// Updates the QR factorization $A = Q R$ of an m-by-n matrix A after
+/// inserting the row $w^T$ before row i, so that rows i, ..., m-1 of A
+/// become rows i+1, ..., m of the (m+1)-by-n matrix $\tilde{A}$.
+/// With $w^T$ appended below R, min(m,n) rotations from lartg restore
+/// R to upper trapezoidal form, in $O(n^2)$ operations, plus $O(m^2)$
+/// to update Q.
+///
+/// For online least squares, where Q is not needed, pass Q = null and
+/// append the right-hand side b as column n of A. Then rows 0 to n-1 of
+/// R's last column hold $Q^H b$, for solving with trsm, and |R(n,n)| is
+/// the residual norm.
+///
+/// @param[in] m
+///     The number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of A. n >= 0.
+///
+/// @param[in] i
+///     The index of the inserted row in $\tilde{A}$. 0 <= i <= m.
+///
+/// @param[in,out] Q
+///     On entry, the m-by-m unitary matrix Q, e.g., from ungqr,
+///     in an ldq-by-(m+1) array.
+///     On exit, the (m+1)-by-(m+1) matrix $\tilde{Q}$.
+///     If null, Q is not updated and i is irrelevant.
+///
+/// @param[in] ldq
+///     The leading dimension of Q. ldq >= m+1 if Q is not null.
+///
+/// @param[in,out] R
+///     On entry, the m-by-n upper trapezoidal matrix R, in an ldr-by-n
+///     array, with zeros below the diagonal.
+///     On exit, the (m+1)-by-n matrix $\tilde{R}$, with zeros below
+///     the diagonal.
+///
+/// @param[in] ldr
+///     The leading dimension of R. ldr >= m+1.
+///
+/// @param[in] w
+///     The vector w of length n, with stride incw.
+///
+/// @param[in] incw
+///     The stride of w. incw > 0.
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf_insert_row(
+    int64_t m, int64_t n, int64_t i,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* R, int64_t ldr,
+    scalar_t const* w, int64_t incw );
+
+//------------------------------------------------------------------------------
+/// Updates the QR factorization $A = Q R$ of an m-by-n matrix A after
+/// deleting row i, giving the (m-1)-by-n matrix $\tilde{A}$.
+/// Rotations from lartg reduce row i of Q to a multiple of $e_1^T$,
+/// which makes R upper Hessenberg; dropping R's first row and Q's
+/// row i and first column leaves the factors of $\tilde{A}$.
+/// Takes $O(m^2 + m n)$ operations.
+///
+/// @param[in] m
+///     The number of rows of A. m >= 1.
+///
+/// @param[in] n
+///     The number of columns of A. n >= 0.
+///
+/// @param[in] i
+///     The index of the deleted row. 0 <= i < m.
+///
+/// @param[in,out] Q
+///     On entry, the m-by-m unitary matrix Q, in an ldq-by-m array.
+///     On exit, the (m-1)-by-(m-1) matrix $\tilde{Q}$, in the same array.
+///     Required; row i of Q is what determines the update.
+///
+/// @param[in] ldq
+///     The leading dimension of Q. ldq >= max(1,m).
+///
+/// @param[in,out] R
+///     On entry, the m-by-n upper trapezoidal matrix R, in an ldr-by-n
+///     array, with zeros below the diagonal.
+///     On exit, the (m-1)-by-n matrix $\tilde{R}$, with zeros below
+///     the diagonal.
+///
+/// @param[in] ldr
+///     The leading dimension of R. ldr >= max(1,m).
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf_delete_row(
+    int64_t m, int64_t n, int64_t i,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* R, int64_t ldr );
+
+//------------------------------------------------------------------------------
+/// Updates the QR factorization $A = Q R$ of an m-by-n matrix A after
+/// inserting the column a before column j, so that columns j, ..., n-1
+/// of A become columns j+1, ..., n of the m-by-(n+1) matrix $\tilde{A}$.
+/// The new column of R is $u = Q^H a$. One Householder reflector from
+/// larfg zeros u below row n, where R is zero, then rotations from lartg
+/// zero it up to row j+1, in $O(m^2)$ operations.
+///
+/// @param[in] m
+///     The number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of A. n >= 0.
+///
+/// @param[in] j
+///     The index of the inserted column in $\tilde{A}$. 0 <= j <= n.
+///
+/// @param[in,out] Q
+///     On entry, the m-by-m unitary matrix Q, in an ldq-by-m array.
+///     On exit, the updated matrix $\tilde{Q}$.
+///
+/// @param[in] ldq
+///     The leading dimension of Q. ldq >= max(1,m).
+///
+/// @param[in,out] R
+///     On entry, the m-by-n upper trapezoidal matrix R, in an
+///     ldr-by-(n+1) array, with zeros below the diagonal.
+///     On exit, the m-by-(n+1) matrix $\tilde{R}$, with zeros below
+///     the diagonal.
+///
+/// @param[in] ldr
+///     The leading dimension of R. ldr >= max(1,m).
+///
+/// @param[in] a
+///     The column a, of length m.
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf_insert_col(
+    int64_t m, int64_t n, int64_t j,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* R, int64_t ldr,
+    scalar_t const* a );
+
+//------------------------------------------------------------------------------
+/// Updates the QR factorization $A = Q R$ of an m-by-n matrix A after
+/// deleting column j, giving the m-by-(n-1) matrix $\tilde{A}$.
+/// Removing column j from R leaves it upper Hessenberg from column j on;
+/// rotations from lartg restore it, in $O(n^2)$ operations, plus $O(m n)$
+/// to update Q.
+///
+/// @param[in] m
+///     The number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of A. n >= 1.
+///
+/// @param[in] j
+///     The index of the deleted column. 0 <= j < n.
+///
+/// @param[in,out] Q
+///     On entry, the m-by-m unitary matrix Q, in an ldq-by-m array.
+///     On exit, the updated matrix $\tilde{Q}$.
+///     If null, Q is not updated.
+///
+/// @param[in] ldq
+///     The leading dimension of Q. ldq >= max(1,m) if Q is not null.
+///
+/// @param[in,out] R
+///     On entry, the m-by-n upper trapezoidal matrix R, in an ldr-by-n
+///     array, with zeros below the diagonal.
+///     On exit, the m-by-(n-1) matrix $\tilde{R}$, with zeros below
+///     the diagonal. Column n-1 of the array is not referenced on exit.
+///
+/// @param[in] ldr
+///     The leading dimension of R. ldr >= max(1,m).
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf_delete_col(
+    int64_t m, int64_t n, int64_t j,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* R, int64_t ldr );
+
+}  // namespace lapack
+
+#endif  // LAPACK_UPDATE_HH
@@ -869,6 +869,95 @@ inline const char* rowcol2str( lapack::RowCol rowcol )
     return "?";
 }
 
+// -----------------------------------------------------------------------------
+// getrf, potrf; selects vendor LAPACK or native LAPACK++ implementation
+enum class Method : char {
+    Vendor = 'V',
+    Native = 'N',
+};
+
+inline char method2char( lapack::Method method )
+{
+    return char( method );
+}
+
+inline lapack::Method char2method( char method )
+{
+    method = char( toupper( method ));
+    lapack_error_if( method != 'V' && method != 'N' );
+    return lapack::Method( method );
+}
+
+inline const char* method2str( lapack::Method method )
+{
+    switch (method) {
+        case lapack::Method::Vendor: return "vendor";
+        case lapack::Method::Native: return "native";
+    }
+    return "?";
+}
+
+// -----------------------------------------------------------------------------
+// LDLFactor; selects hetrf, hetrf_rook, hetrf_rk, or hetrf_aa
+enum class LDLPivot : char {
+    BunchKaufman = 'B',
+    Rook         = 'R',
+    RK           = 'K',
+    Aasen        = 'A',
+};
+
+inline char ldlpivot2char( lapack::LDLPivot pivot )
+{
+    return char( pivot );
+}
+
+inline lapack::LDLPivot char2ldlpivot( char pivot )
+{
+    pivot = char( toupper( pivot ));
+    lapack_error_if( pivot != 'B' && pivot != 'R' && pivot != 'K'
+                     && pivot != 'A' );
+    return lapack::LDLPivot( pivot );
+}
+
+inline const char* ldlpivot2str( lapack::LDLPivot pivot )
+{
+    switch (pivot) {
+        case lapack::LDLPivot::BunchKaufman: return "bk";
+        case lapack::LDLPivot::Rook:         return "rook";
+        case lapack::LDLPivot::RK:           return "rk";
+        case lapack::LDLPivot::Aasen:        return "aa";
+    }
+    return "?";
+}
+
+// -----------------------------------------------------------------------------
+// gesvd_rand; selects the random sketch
+enum class Sketch : char {
+    Gaussian = 'G',
+    SRHT     = 'H',
+};
+
+inline char sketch2char( lapack::Sketch sketch )
+{
+    return char( sketch );
+}
+
+inline lapack::Sketch char2sketch( char sketch )
+{
+    sketch = char( toupper( sketch ));
+    lapack_error_if( sketch != 'G' && sketch != 'H' );
+    return lapack::Sketch( sketch );
+}
+
+inline const char* sketch2str( lapack::Sketch sketch )
+{
+    switch (sketch) {
+        case lapack::Sketch::Gaussian: return "gaussian";
+        case lapack::Sketch::SRHT:     return "srht";
+    }
+    return "?";
+}
+
 //------------------------------------------------------------------------------
 // For %lld printf-style printing, cast to llong; guaranteed >= 64 bits.
 using llong = long long;
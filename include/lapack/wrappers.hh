@@ -800,6 +800,71 @@ int64_t geev(
     std::complex<double>* VL, int64_t ldvl,
     std::complex<double>* VR, int64_t ldvr );
 
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    float* A, int64_t lda,
+    std::complex<float>* W,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr,
+    void* host_work, size_t host_work_size );
+
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    double* A, int64_t lda,
+    std::complex<double>* W,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr,
+    void* host_work, size_t host_work_size );
+
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* W,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr,
+    void* host_work, size_t host_work_size );
+
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* W,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    float* A, int64_t lda,
+    std::complex<float>* W,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr,
+    size_t* host_work_size );
+
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    double* A, int64_t lda,
+    std::complex<double>* W,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr,
+    size_t* host_work_size );
+
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* W,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr,
+    size_t* host_work_size );
+
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* W,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t geevx(
     lapack::Balance balance, lapack::Job jobvl, lapack::Job jobvr, lapack::Sense sense, int64_t n,
@@ -874,6 +939,55 @@ int64_t gehrd(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* tau );
 
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* A, int64_t lda,
+    float* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* A, int64_t lda,
+    double* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* A, int64_t lda,
+    float* tau,
+    size_t* host_work_size );
+
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* A, int64_t lda,
+    double* tau,
+    size_t* host_work_size );
+
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    size_t* host_work_size );
+
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t gelq(
     int64_t m, int64_t n,
@@ -937,6 +1051,55 @@ int64_t gelqf(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* tau );
 
+int64_t gelqf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t gelqf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    size_t* host_work_size );
+
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    size_t* host_work_size );
+
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    size_t* host_work_size );
+
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t gels(
     lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
@@ -958,6 +1121,55 @@ int64_t gels(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* B, int64_t ldb );
 
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    void* host_work, size_t host_work_size );
+
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    void* host_work, size_t host_work_size );
+
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    void* host_work, size_t host_work_size );
+
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* host_work_size );
+
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    size_t* host_work_size );
+
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    size_t* host_work_size );
+
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t gelsd(
     int64_t m, int64_t n, int64_t nrhs,
@@ -987,6 +1199,71 @@ int64_t gelsd(
     double* S, double rcond,
     int64_t* rank );
 
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    void* host_work, size_t host_work_size );
+
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    void* host_work, size_t host_work_size );
+
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    void* host_work, size_t host_work_size );
+
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    size_t* host_work_size );
+
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    size_t* host_work_size );
+
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    size_t* host_work_size );
+
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t gelss(
     int64_t m, int64_t n, int64_t nrhs,
@@ -1250,6 +1527,55 @@ int64_t geqrf(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* tau );
 
+int64_t geqrf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t geqrf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t geqrf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t geqrf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void geqrf_work_size_bytes(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    size_t* host_work_size );
+
+void geqrf_work_size_bytes(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    size_t* host_work_size );
+
+void geqrf_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    size_t* host_work_size );
+
+void geqrf_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t geqrfp(
     int64_t m, int64_t n,
@@ -1507,6 +1833,71 @@ int64_t gesdd(
     std::complex<double>* U, int64_t ldu,
     std::complex<double>* VT, int64_t ldvt );
 
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    size_t* host_work_size );
+
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    size_t* host_work_size );
+
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    size_t* host_work_size );
+
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t gesv(
     int64_t n, int64_t nrhs,
@@ -1548,6 +1939,87 @@ int64_t gesv(
     std::complex<double>* X, int64_t ldx,
     int64_t* iter );
 
+#ifndef LAPACK_ILP64
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    lapack_int* ipiv,
+    float* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double>* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter );
+
+#endif  // LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+int64_t gesv_mixed(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter, int64_t itermax = 30 );
+
+int64_t gesv_mixed(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter, int64_t itermax = 30 );
+
+#ifndef LAPACK_ILP64
+
+int64_t gesv_mixed(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter, int64_t itermax = 30 );
+
+int64_t gesv_mixed(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter, int64_t itermax = 30 );
+
+#endif  // LAPACK_ILP64
+
 // -----------------------------------------------------------------------------
 int64_t gesvx(
     lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
@@ -1610,33 +2082,98 @@ int64_t gesvx(
     double* rpivotgrowth );
 
 // -----------------------------------------------------------------------------
-int64_t gesvd(
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt );
+
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt );
+
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt );
+
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt );
+
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void gesvd_work_size_bytes(
     lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
     float* A, int64_t lda,
     float* S,
     float* U, int64_t ldu,
-    float* VT, int64_t ldvt );
+    float* VT, int64_t ldvt,
+    size_t* host_work_size );
 
-int64_t gesvd(
+void gesvd_work_size_bytes(
     lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
     double* A, int64_t lda,
     double* S,
     double* U, int64_t ldu,
-    double* VT, int64_t ldvt );
+    double* VT, int64_t ldvt,
+    size_t* host_work_size );
 
-int64_t gesvd(
+void gesvd_work_size_bytes(
     lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
     std::complex<float>* A, int64_t lda,
     float* S,
     std::complex<float>* U, int64_t ldu,
-    std::complex<float>* VT, int64_t ldvt );
+    std::complex<float>* VT, int64_t ldvt,
+    size_t* host_work_size );
 
-int64_t gesvd(
+void gesvd_work_size_bytes(
     lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
     std::complex<double>* A, int64_t lda,
     double* S,
     std::complex<double>* U, int64_t ldu,
-    std::complex<double>* VT, int64_t ldvt );
+    std::complex<double>* VT, int64_t ldvt,
+    size_t* host_work_size );
 
 // -----------------------------------------------------------------------------
 int64_t gesvdx(
@@ -1671,6 +2208,79 @@ int64_t gesvdx(
     std::complex<double>* U, int64_t ldu,
     std::complex<double>* VT, int64_t ldvt );
 
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    size_t* host_work_size );
+
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    size_t* host_work_size );
+
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    size_t* host_work_size );
+
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t getf2(
     int64_t m, int64_t n,
@@ -1713,6 +2323,30 @@ int64_t getrf(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv );
+
+#endif  // LAPACK_ILP64
+
 // -----------------------------------------------------------------------------
 int64_t getrf2(
     int64_t m, int64_t n,
@@ -1755,6 +2389,30 @@ int64_t getri(
     std::complex<double>* A, int64_t lda,
     int64_t const* ipiv );
 
+#ifndef LAPACK_ILP64
+
+int64_t getri(
+    int64_t n,
+    float* A, int64_t lda,
+    lapack_int const* ipiv );
+
+int64_t getri(
+    int64_t n,
+    double* A, int64_t lda,
+    lapack_int const* ipiv );
+
+int64_t getri(
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int const* ipiv );
+
+int64_t getri(
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int const* ipiv );
+
+#endif  // LAPACK_ILP64
+
 // -----------------------------------------------------------------------------
 int64_t getrs(
     lapack::Op trans, int64_t n, int64_t nrhs,
@@ -1780,6 +2438,34 @@ int64_t getrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+
+#endif  // LAPACK_ILP64
+
 // -----------------------------------------------------------------------------
 int64_t getsls(
     lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
@@ -1801,6 +2487,27 @@ int64_t getsls(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* B, int64_t ldb );
 
+// -----------------------------------------------------------------------------
+int64_t getsqrhrt(
+    int64_t m, int64_t n, int64_t nb,
+    float* A, int64_t lda,
+    float* T, int64_t ldt );
+
+int64_t getsqrhrt(
+    int64_t m, int64_t n, int64_t nb,
+    double* A, int64_t lda,
+    double* T, int64_t ldt );
+
+int64_t getsqrhrt(
+    int64_t m, int64_t n, int64_t nb,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* T, int64_t ldt );
+
+int64_t getsqrhrt(
+    int64_t m, int64_t n, int64_t nb,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* T, int64_t ldt );
+
 // -----------------------------------------------------------------------------
 int64_t ggbak(
     lapack::Balance balance, lapack::Side side, int64_t n, int64_t ilo, int64_t ihi,
@@ -2823,6 +3530,31 @@ int64_t heevd(
     std::complex<double>* A, int64_t lda,
     double* W );
 
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* W,
+    void* host_work, size_t host_work_size );
+
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* W,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* W,
+    size_t* host_work_size );
+
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* W,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t heevd_2stage(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
@@ -2851,6 +3583,43 @@ int64_t heevr(
     std::complex<double>* Z, int64_t ldz,
     int64_t* isuppz );
 
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* nfound,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size );
+
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* nfound,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    int64_t* isuppz,
+    size_t* host_work_size );
+
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    int64_t* isuppz,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t heevr_2stage(
     lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
@@ -3122,33 +3891,105 @@ int64_t hetrd(
     double* E,
     std::complex<double>* tau );
 
+int64_t hetrd(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* D,
+    float* E,
+    std::complex<float>* tau,
+    void* host_work, size_t host_work_size );
+
+int64_t hetrd(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* D,
+    double* E,
+    std::complex<double>* tau,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void hetrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* D,
+    float* E,
+    std::complex<float>* tau,
+    size_t* host_work_size );
+
+void hetrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* D,
+    double* E,
+    std::complex<double>* tau,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t hetrd_2stage(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
     std::complex<float>* A, int64_t lda,
-    float* D,
-    float* E,
-    std::complex<float>* tau,
-    std::complex<float>* hous2, int64_t lhous2 );
+    float* D,
+    float* E,
+    std::complex<float>* tau,
+    std::complex<float>* hous2, int64_t lhous2 );
+
+int64_t hetrd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* D,
+    double* E,
+    std::complex<double>* tau,
+    std::complex<double>* hous2, int64_t lhous2 );
+
+// -----------------------------------------------------------------------------
+int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* ipiv );
+
+int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv );
+
+#ifndef LAPACK_ILP64
+
+int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
 
-int64_t hetrd_2stage(
-    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
     std::complex<double>* A, int64_t lda,
-    double* D,
-    double* E,
-    std::complex<double>* tau,
-    std::complex<double>* hous2, int64_t lhous2 );
+    lapack_int* ipiv );
+
+#endif  // LAPACK_ILP64
 
-// -----------------------------------------------------------------------------
 int64_t hetrf(
     lapack::Uplo uplo, int64_t n,
     std::complex<float>* A, int64_t lda,
-    int64_t* ipiv );
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size );
 
 int64_t hetrf(
     lapack::Uplo uplo, int64_t n,
     std::complex<double>* A, int64_t lda,
-    int64_t* ipiv );
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void hetrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size );
+
+void hetrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size );
 
 // -----------------------------------------------------------------------------
 int64_t hetrf_aa(
@@ -3234,6 +4075,22 @@ int64_t hetrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+
+int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+
+#endif  // LAPACK_ILP64
+
 // -----------------------------------------------------------------------------
 int64_t hetrs2(
     lapack::Uplo uplo, int64_t n, int64_t nrhs,
@@ -4415,6 +5272,30 @@ void laswp(
     std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
     int64_t const* ipiv, int64_t incx );
 
+#ifndef LAPACK_ILP64
+
+void laswp(
+    int64_t n,
+    float* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    int64_t n,
+    double* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+void laswp(
+    int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx );
+
+#endif  // LAPACK_ILP64
+
 // -----------------------------------------------------------------------------
 int64_t lauum(
     lapack::Uplo uplo, int64_t n,
@@ -4911,6 +5792,79 @@ inline int64_t unmqr(
     return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc );
 }
 
+int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* host_work, size_t host_work_size );
+
+// unmqr alias to ormqr
+inline int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* host_work, size_t host_work_size )
+{
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc, host_work, host_work_size );
+}
+
+int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* host_work, size_t host_work_size );
+
+// unmqr alias to ormqr
+inline int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* host_work, size_t host_work_size )
+{
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc, host_work, host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+void ormqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* host_work_size );
+
+// unmqr alias to ormqr
+inline void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* host_work_size )
+{
+    ormqr_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, host_work_size );
+}
+
+void ormqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* host_work_size );
+
+// unmqr alias to ormqr
+inline void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* host_work_size )
+{
+    ormqr_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, host_work_size );
+}
+
 // -----------------------------------------------------------------------------
 int64_t ormrq(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
@@ -5481,6 +6435,22 @@ int64_t posv(
     std::complex<double>* X, int64_t ldx,
     int64_t* iter );
 
+
+// -----------------------------------------------------------------------------
+int64_t posv_mixed(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter, int64_t itermax = 30 );
+
+int64_t posv_mixed(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter, int64_t itermax = 30 );
+
 // -----------------------------------------------------------------------------
 int64_t posvx(
     lapack::Factored fact, lapack::Uplo uplo, int64_t n, int64_t nrhs,
@@ -7448,6 +8418,16 @@ int64_t sturm(
     int64_t n, scalar_t const* diag,
     scalar_t const* offd, scalar_t u);
 
+template <typename scalar_t>
+void sturm(
+    int64_t n, scalar_t const* diag, scalar_t const* offd,
+    int64_t nshift, scalar_t const* u, int64_t* count );
+
+template <typename scalar_t>
+int64_t sturm_bisect(
+    int64_t n, scalar_t const* diag, scalar_t const* offd,
+    int64_t il, int64_t iu, scalar_t* W );
+
 // -----------------------------------------------------------------------------
 int64_t sycon(
     lapack::Uplo uplo, int64_t n,
@@ -7683,6 +8663,71 @@ inline int64_t heevd(
     return syevd( jobz, uplo, n, A, lda, W );
 }
 
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    void* host_work, size_t host_work_size );
+
+// heevd alias to syevd
+inline int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    void* host_work, size_t host_work_size )
+{
+    return syevd( jobz, uplo, n, A, lda, W, host_work, host_work_size );
+}
+
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    void* host_work, size_t host_work_size );
+
+// heevd alias to syevd
+inline int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    void* host_work, size_t host_work_size )
+{
+    return syevd( jobz, uplo, n, A, lda, W, host_work, host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+void syevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    size_t* host_work_size );
+
+// heevd alias to syevd
+inline void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    size_t* host_work_size )
+{
+    syevd_work_size_bytes( jobz, uplo, n, A, lda, W, host_work_size );
+}
+
+void syevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    size_t* host_work_size );
+
+// heevd alias to syevd
+inline void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    size_t* host_work_size )
+{
+    syevd_work_size_bytes( jobz, uplo, n, A, lda, W, host_work_size );
+}
+
 // -----------------------------------------------------------------------------
 int64_t syevd_2stage(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
@@ -7709,48 +8754,137 @@ inline int64_t heevd_2stage(
     double* A, int64_t lda,
     double* W )
 {
-    return syevd_2stage( jobz, uplo, n, A, lda, W );
+    return syevd_2stage( jobz, uplo, n, A, lda, W );
+}
+
+// -----------------------------------------------------------------------------
+int64_t syevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* m,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* isuppz );
+
+// heevr alias to syevr
+inline int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* m,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* isuppz )
+{
+    return syevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, m, W, Z, ldz, isuppz );
+}
+
+int64_t syevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* m,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* isuppz );
+
+// heevr alias to syevr
+inline int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* m,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* isuppz )
+{
+    return syevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, m, W, Z, ldz, isuppz );
+}
+
+int64_t syevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* nfound,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size );
+
+// heevr alias to syevr
+inline int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* nfound,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size )
+{
+    return syevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, host_work, host_work_size );
+}
+
+int64_t syevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size );
+
+// heevr alias to syevr
+inline int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size )
+{
+    return syevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, host_work, host_work_size );
 }
 
 // -----------------------------------------------------------------------------
-int64_t syevr(
+void syevr_work_size_bytes(
     lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
     float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
-    int64_t* m,
+    int64_t* nfound,
     float* W,
     float* Z, int64_t ldz,
-    int64_t* isuppz );
+    int64_t* isuppz,
+    size_t* host_work_size );
 
 // heevr alias to syevr
-inline int64_t heevr(
+inline void heevr_work_size_bytes(
     lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
     float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
-    int64_t* m,
+    int64_t* nfound,
     float* W,
     float* Z, int64_t ldz,
-    int64_t* isuppz )
+    int64_t* isuppz,
+    size_t* host_work_size )
 {
-    return syevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, m, W, Z, ldz, isuppz );
+    syevr_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, host_work_size );
 }
 
-int64_t syevr(
+void syevr_work_size_bytes(
     lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
     double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
-    int64_t* m,
+    int64_t* nfound,
     double* W,
     double* Z, int64_t ldz,
-    int64_t* isuppz );
+    int64_t* isuppz,
+    size_t* host_work_size );
 
 // heevr alias to syevr
-inline int64_t heevr(
+inline void heevr_work_size_bytes(
     lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
     double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
-    int64_t* m,
+    int64_t* nfound,
     double* W,
     double* Z, int64_t ldz,
-    int64_t* isuppz )
+    int64_t* isuppz,
+    size_t* host_work_size )
 {
-    return syevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, m, W, Z, ldz, isuppz );
+    syevr_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, host_work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -8581,6 +9715,87 @@ inline int64_t hetrd(
     return sytrd( uplo, n, A, lda, D, E, tau );
 }
 
+int64_t sytrd(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    void* host_work, size_t host_work_size );
+
+// hetrd alias to sytrd
+inline int64_t hetrd(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    void* host_work, size_t host_work_size )
+{
+    return sytrd( uplo, n, A, lda, D, E, tau, host_work, host_work_size );
+}
+
+int64_t sytrd(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    void* host_work, size_t host_work_size );
+
+// hetrd alias to sytrd
+inline int64_t hetrd(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    void* host_work, size_t host_work_size )
+{
+    return sytrd( uplo, n, A, lda, D, E, tau, host_work, host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+void sytrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    size_t* host_work_size );
+
+// hetrd alias to sytrd
+inline void hetrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    size_t* host_work_size )
+{
+    sytrd_work_size_bytes( uplo, n, A, lda, D, E, tau, host_work_size );
+}
+
+void sytrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    size_t* host_work_size );
+
+// hetrd alias to sytrd
+inline void hetrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    size_t* host_work_size )
+{
+    sytrd_work_size_bytes( uplo, n, A, lda, D, E, tau, host_work_size );
+}
+
 // -----------------------------------------------------------------------------
 int64_t sytrd_2stage(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
@@ -8661,6 +9876,137 @@ int64_t sytrf(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv );
+
+// hetrf alias to sytrf
+inline int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    return sytrf( uplo, n, A, lda, ipiv );
+}
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv );
+
+// hetrf alias to sytrf
+inline int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    return sytrf( uplo, n, A, lda, ipiv );
+}
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv );
+
+#endif  // LAPACK_ILP64
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size );
+
+// hetrf alias to sytrf
+inline int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size )
+{
+    return sytrf( uplo, n, A, lda, ipiv, host_work, host_work_size );
+}
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size );
+
+// hetrf alias to sytrf
+inline int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size )
+{
+    return sytrf( uplo, n, A, lda, ipiv, host_work, host_work_size );
+}
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size );
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void sytrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size );
+
+// hetrf alias to sytrf
+inline void hetrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size )
+{
+    sytrf_work_size_bytes( uplo, n, A, lda, ipiv, host_work_size );
+}
+
+void sytrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size );
+
+// hetrf alias to sytrf
+inline void hetrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size )
+{
+    sytrf_work_size_bytes( uplo, n, A, lda, ipiv, host_work_size );
+}
+
+void sytrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size );
+
+void sytrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t sytrf_aa(
     lapack::Uplo uplo, int64_t n,
@@ -8953,6 +10299,54 @@ int64_t sytrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+// hetrs alias to sytrs
+inline int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb )
+{
+    return sytrs( uplo, n, nrhs, A, lda, ipiv, B, ldb );
+}
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+// hetrs alias to sytrs
+inline int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb )
+{
+    return sytrs( uplo, n, nrhs, A, lda, ipiv, B, ldb );
+}
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+
+#endif  // LAPACK_ILP64
+
 // -----------------------------------------------------------------------------
 int64_t sytrs2(
     lapack::Uplo uplo, int64_t n, int64_t nrhs,
@@ -10229,6 +11623,35 @@ int64_t unmqr(
     std::complex<double> const* tau,
     std::complex<double>* C, int64_t ldc );
 
+int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* tau,
+    std::complex<float>* C, int64_t ldc,
+    void* host_work, size_t host_work_size );
+
+int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* tau,
+    std::complex<double>* C, int64_t ldc,
+    void* host_work, size_t host_work_size );
+
+// -----------------------------------------------------------------------------
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* tau,
+    std::complex<float>* C, int64_t ldc,
+    size_t* host_work_size );
+
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* tau,
+    std::complex<double>* C, int64_t ldc,
+    size_t* host_work_size );
+
 // -----------------------------------------------------------------------------
 int64_t unmrq(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
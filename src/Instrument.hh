@@ -0,0 +1,93 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_INSTRUMENT_INTERNAL_HH
+#define LAPACK_INSTRUMENT_INTERNAL_HH
+
+#include "lapack/util.hh"
+#include "lapack/instrument.hh"
+
+//------------------------------------------------------------------------------
+/// Instruments the enclosing wrapper, from this statement to the end of the
+/// scope. gflop is an expression evaluated only when instrumentation is
+/// enabled, typically using lapack::Gflop from flops.hh, or 0 if unknown.
+/// Unless LAPACK++ is compiled with LAPACK_INSTRUMENT defined, this expands
+/// to nothing, so there is no overhead.
+///
+/// Example:
+///
+///     LAPACK_INSTRUMENT_SCOPE( "getrf", 'd', m, n, 0,
+///                              Gflop< double >::getrf( m, n ) );
+///
+#ifdef LAPACK_INSTRUMENT
+    #include "lapack/flops.hh"
+
+    #include <atomic>
+    #include <chrono>
+
+    #define LAPACK_INSTRUMENT_SCOPE( routine, type, m, n, k, gflop ) \
+        lapack::internal::InstrumentScope instrument_scope_( \
+            routine, type, m, n, k, [&]() { return double( gflop ); } )
+#else
+    #define LAPACK_INSTRUMENT_SCOPE( routine, type, m, n, k, gflop ) \
+        ((void) 0)
+#endif
+
+#ifdef LAPACK_INSTRUMENT
+
+namespace lapack {
+namespace internal {
+
+/// Whether instrumentation is enabled; see instrument_enable.
+extern std::atomic< bool > instrument_on;
+
+void instrument_begin( InstrumentEvent const& event );
+void instrument_end( InstrumentEvent const& event );
+
+//------------------------------------------------------------------------------
+/// Records one call to a routine, from construction to destruction.
+/// When instrumentation is disabled, the cost is one atomic load.
+class InstrumentScope
+{
+public:
+    template <typename GflopFunc>
+    InstrumentScope(
+        char const* routine, char type,
+        int64_t m, int64_t n, int64_t k, GflopFunc&& gflop ):
+        active_( instrument_on.load( std::memory_order_relaxed ) )
+    {
+        if (active_) {
+            event_ = { routine, type, m, n, k, gflop(), 0.0 };
+            instrument_begin( event_ );
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~InstrumentScope()
+    {
+        if (active_) {
+            std::chrono::duration< double > elapsed
+                = std::chrono::steady_clock::now() - start_;
+            event_.time = elapsed.count();
+            instrument_end( event_ );
+        }
+    }
+
+    // not copyable
+    InstrumentScope( InstrumentScope const& ) = delete;
+    InstrumentScope& operator = ( InstrumentScope const& ) = delete;
+
+private:
+    bool active_;
+    InstrumentEvent event_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_INSTRUMENT
+
+#endif  // LAPACK_INSTRUMENT_INTERNAL_HH
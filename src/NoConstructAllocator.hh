@@ -10,15 +10,23 @@
 #include <limits>   // std::numeric_limits
 #include <new>      // std::bad_alloc, std::bad_array_new_length
 #include <vector>   // std::vector
-#if defined( _WIN32 ) || defined( _WIN64 )
-#   include <malloc.h>  // _aligned_malloc, _aligned_free
-#else
-#   include <stdlib.h>  // posix_memalign, free
-#endif
 
 namespace lapack {
+namespace internal {
+
+// Allocates 64-byte aligned memory from the calling thread's workspace
+// arena (see lapack/arena.hh), or from the heap if the thread has no arena
+// or it is full. Throws std::bad_alloc on failure.
+void* arena_allocate( std::size_t bytes );
+
+// Releases memory from arena_allocate, on any thread. The block records
+// the arena it came from, if any, so it is returned there.
+void arena_deallocate( void* ptr ) noexcept;
+
+}  // namespace internal
 
 // No-construct allocator type which allocates / deallocates.
+// Allocates from the thread's workspace arena, if set, else from the heap.
 template <typename T>
 struct NoConstructAllocator
 {
@@ -42,31 +50,12 @@ struct NoConstructAllocator
         if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
             throw std::bad_array_new_length();
 
-        void* memPtr = nullptr;
-        #if defined( _WIN32 ) || defined( _WIN64 )
-            memPtr = _aligned_malloc( n*sizeof(T), 64 );
-            if (memPtr != nullptr) {
-                auto p = static_cast<T*>(memPtr);
-                return p;
-            }
-        #else
-            int err = posix_memalign( &memPtr, 64, n*sizeof(T) );
-            if (err == 0) {
-                auto p = static_cast<T*>(memPtr);
-                return p;
-            }
-        #endif
-
-        throw std::bad_alloc();
+        return static_cast<T*>( internal::arena_allocate( n*sizeof(T) ) );
     }
 
     void deallocate(T* p, std::size_t n) noexcept
     {
-        #if defined( _WIN32 ) || defined( _WIN64 )
-            _aligned_free( p );
-        #else
-            free( p );
-        #endif
+        internal::arena_deallocate( p );
     }
 };
 
@@ -0,0 +1,85 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_QUERY_CACHE_INTERNAL_HH
+#define LAPACK_QUERY_CACHE_INTERNAL_HH
+
+#include "lapack/util.hh"
+#include "lapack/query_cache.hh"
+
+#include <cstddef>  // std::size_t
+#include <cstring>  // strcmp
+#include <initializer_list>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Key for the workspace query cache: the Fortran routine name, e.g.,
+/// "dgesvd", which includes the precision, and the integer and character
+/// arguments that the workspace size depends on.
+class QueryKey
+{
+public:
+    static constexpr int max_args = 12;
+
+    /// @param[in] routine
+    ///     Fortran routine name; must be a string literal, as only the
+    ///     pointer is kept.
+    ///
+    /// @param[in] args
+    ///     Dimensions and job flags, at most max_args.
+    ///
+    QueryKey( const char* routine, std::initializer_list<int64_t> args ):
+        routine_( routine ),
+        nargs_( 0 )
+    {
+        lapack_error_if( args.size() > max_args );
+        for (int64_t arg : args)
+            args_[ nargs_++ ] = arg;
+    }
+
+    bool operator == ( QueryKey const& other ) const
+    {
+        if (nargs_ != other.nargs_
+            || strcmp( routine_, other.routine_ ) != 0)
+            return false;
+        for (int i = 0; i < nargs_; ++i) {
+            if (args_[ i ] != other.args_[ i ])
+                return false;
+        }
+        return true;
+    }
+
+    /// FNV-1a hash of the routine name and arguments.
+    size_t hash() const
+    {
+        uint64_t h = 14695981039346656037ull;
+        for (const char* c = routine_; *c != '\0'; ++c)
+            h = (h ^ uint8_t( *c )) * 1099511628211ull;
+        for (int i = 0; i < nargs_; ++i)
+            h = (h ^ uint64_t( args_[ i ] )) * 1099511628211ull;
+        return size_t( h );
+    }
+
+private:
+    const char* routine_;
+    int nargs_;
+    int64_t args_[ max_args ];
+};
+
+//------------------------------------------------------------------------------
+/// If the cache is enabled and has key, sets value and returns true;
+/// otherwise returns false. Counts hits and misses while enabled.
+bool query_cache_lookup( QueryKey const& key, size_t* value );
+
+//------------------------------------------------------------------------------
+/// If the cache is enabled, stores value for key.
+void query_cache_insert( QueryKey const& key, size_t value );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_QUERY_CACHE_INTERNAL_HH
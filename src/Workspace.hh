@@ -0,0 +1,98 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_WORKSPACE_HH
+#define LAPACK_WORKSPACE_HH
+
+#include "lapack/util.hh"
+#include "lapack/config.h"
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // uintptr_t
+#include <limits>   // std::numeric_limits
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Each array in a host workspace starts on a multiple of this many bytes
+/// from the start of the workspace, same as NoConstructAllocator.
+constexpr size_t workspace_alignment = 64;
+
+//------------------------------------------------------------------------------
+/// @return bytes to reserve in a host workspace for an array of count
+/// elements of type T, rounded up so the next array remains aligned.
+/// At least one element is reserved, as LAPACK requires valid pointers.
+template <typename T>
+inline size_t workspace_bytes( int64_t count )
+{
+    size_t bytes = size_t( count < 1 ? 1 : count ) * sizeof(T);
+    return (bytes + workspace_alignment - 1)
+           / workspace_alignment * workspace_alignment;
+}
+
+//------------------------------------------------------------------------------
+/// Carves typed arrays out of a caller-supplied host workspace,
+/// in the same order that the matching *_work_size_bytes routine
+/// added them up. Throws Error if the workspace is too small.
+class Workspace
+{
+public:
+    Workspace( void* work, size_t size ):
+        ptr_( static_cast<char*>( work ) ),
+        end_( static_cast<char*>( work ) + size )
+    {
+        lapack_error_if( work == nullptr && size > 0 );
+    }
+
+    /// @return pointer to an array of count elements of type T,
+    /// reserving workspace_bytes<T>( count ) bytes.
+    template <typename T>
+    T* take( int64_t count )
+    {
+        size_t bytes = workspace_bytes<T>( count );
+        lapack_error_if_msg( ptr_ == nullptr || size_t( end_ - ptr_ ) < bytes,
+                             "host workspace too small" );
+        lapack_error_if_msg( uintptr_t( ptr_ ) % alignof(T) != 0,
+                             "host workspace misaligned" );
+        T* array = reinterpret_cast<T*>( ptr_ );
+        ptr_ += bytes;
+        return array;
+    }
+
+    /// @return number of elements of type T that fit in the rest of the
+    /// workspace, limited to what lapack_int can represent. Used as
+    /// lwork for the last (variable length) work array.
+    template <typename T>
+    lapack_int remaining() const
+    {
+        size_t count = (ptr_ == nullptr ? 0 : size_t( end_ - ptr_ ) / sizeof(T));
+        size_t max_count = size_t( std::numeric_limits<lapack_int>::max() );
+        return lapack_int( count < max_count ? count : max_count );
+    }
+
+    /// @return pointer to the rest of the workspace, as an array of
+    /// remaining<T>() elements of type T.
+    template <typename T>
+    T* take_remaining( lapack_int* count )
+    {
+        *count = remaining<T>();
+        lapack_error_if_msg( *count < 1, "host workspace too small" );
+        lapack_error_if_msg( uintptr_t( ptr_ ) % alignof(T) != 0,
+                             "host workspace misaligned" );
+        T* array = reinterpret_cast<T*>( ptr_ );
+        ptr_ = end_;
+        return array;
+    }
+
+private:
+    char* ptr_;
+    char* end_;
+};
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_WORKSPACE_HH
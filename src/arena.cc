@@ -0,0 +1,355 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/arena.hh"
+#include "NoConstructAllocator.hh"
+
+#include <limits>
+#include <mutex>
+#include <new>
+#include <vector>
+#if defined( _WIN32 ) || defined( _WIN64 )
+#   include <malloc.h>  // _aligned_malloc, _aligned_free
+#else
+#   include <stdlib.h>  // posix_memalign, free
+#endif
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace internal {
+
+class Arena;
+
+//------------------------------------------------------------------------------
+/// Header stored in the first bytes of every lapack::vector block, ahead of
+/// the data, recording where the block came from, so it is released
+/// correctly on any thread.
+struct BlockHeader {
+    Arena* owner;    ///< arena that allocated or counted it; nullptr if none
+    size_t bytes;    ///< size of the block, including header
+    bool in_arena;   ///< true if carved from owner's buffer, false if heap
+};
+
+//------------------------------------------------------------------------------
+/// Bump allocator for wrapper temporaries. Blocks are normally released in
+/// LIFO order, as lapack::vector temporaries go out of scope. A block
+/// released out of order is marked free and reclaimed when the blocks
+/// above it are released.
+///
+/// An arena is owned by one thread, but a block may be released on
+/// another thread, so its state is guarded by a mutex, which is normally
+/// uncontended. When its thread exits, the arena is detached and deleted
+/// once its last block is released, so blocks outlive the thread.
+class Arena
+{
+public:
+    static constexpr size_t alignment = 64;
+    static constexpr size_t header_size = alignment;
+    static_assert( sizeof( BlockHeader ) <= header_size,
+                   "BlockHeader too large" );
+
+    Arena():
+        buffer_( nullptr ),
+        size_( 0 ),
+        top_( 0 ),
+        overflow_bytes_( 0 ),
+        high_water_( 0 ),
+        overflows_( 0 ),
+        live_( 0 ),
+        detached_( false )
+    {}
+
+    ~Arena()
+    {
+        free_buffer();
+    }
+
+    void set_size( size_t size )
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        lapack_error_if_msg( live_ > 0, "arena is in use" );
+        free_buffer();
+        if (size > 0) {
+            size = round_up( size );
+            void* ptr = aligned_malloc( size );
+            if (ptr == nullptr)
+                throw std::bad_alloc();
+            buffer_ = static_cast<char*>( ptr );
+            size_ = size;
+            blocks_.reserve( 64 );
+        }
+        top_ = 0;
+        reset_locked();
+    }
+
+    /// @return block of bytes (a multiple of alignment) from the arena,
+    /// or nullptr if it does not fit; then the caller allocates it from
+    /// the heap, and it is counted as an overflow.
+    char* allocate( size_t bytes )
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        live_ += 1;
+        if (buffer_ != nullptr && bytes <= size_ - top_) {
+            blocks_.push_back( Block{ top_, false } );
+            char* ptr = buffer_ + top_;
+            top_ += bytes;
+            update_high_water();
+            return ptr;
+        }
+        overflow_bytes_ += bytes;
+        overflows_ += 1;
+        update_high_water();
+        return nullptr;
+    }
+
+    /// Releases block ptr of bytes, allocated by this arena, on any thread.
+    /// @return true if the arena is detached and now unused, so the
+    /// caller must delete it.
+    bool deallocate( char* ptr, size_t bytes, bool in_arena )
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if (in_arena) {
+            size_t offset = ptr - buffer_;
+            for (size_t i = blocks_.size(); i-- > 0; ) {
+                if (blocks_[ i ].offset == offset) {
+                    blocks_[ i ].freed = true;
+                    break;
+                }
+            }
+            while (! blocks_.empty() && blocks_.back().freed) {
+                top_ = blocks_.back().offset;
+                blocks_.pop_back();
+            }
+        }
+        else {
+            overflow_bytes_ -= min( overflow_bytes_, bytes );
+        }
+        live_ -= 1;
+        return detached_ && live_ == 0;
+    }
+
+    /// Called when the owning thread exits.
+    /// @return true if the arena is unused, so the caller must delete it.
+    bool detach()
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        detached_ = true;
+        return live_ == 0;
+    }
+
+    void reset()
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        reset_locked();
+    }
+
+    size_t size()
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        return size_;
+    }
+
+    size_t used()
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        return top_;
+    }
+
+    size_t high_water()
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        return high_water_;
+    }
+
+    size_t overflows()
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        return overflows_;
+    }
+
+    static size_t round_up( size_t bytes )
+    {
+        bytes = max( bytes, size_t( 1 ) );
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    static void* aligned_malloc( size_t bytes )
+    {
+        void* ptr = nullptr;
+        #if defined( _WIN32 ) || defined( _WIN64 )
+            ptr = _aligned_malloc( bytes, alignment );
+        #else
+            if (posix_memalign( &ptr, alignment, bytes ) != 0)
+                ptr = nullptr;
+        #endif
+        return ptr;
+    }
+
+    static void aligned_free( void* ptr )
+    {
+        #if defined( _WIN32 ) || defined( _WIN64 )
+            _aligned_free( ptr );
+        #else
+            free( ptr );
+        #endif
+    }
+
+private:
+    void free_buffer()
+    {
+        aligned_free( buffer_ );
+        buffer_ = nullptr;
+        size_ = 0;
+    }
+
+    void reset_locked()
+    {
+        high_water_ = top_ + overflow_bytes_;
+        overflows_ = 0;
+    }
+
+    void update_high_water()
+    {
+        high_water_ = max( high_water_, top_ + overflow_bytes_ );
+    }
+
+    struct Block {
+        size_t offset;
+        bool freed;
+    };
+
+    std::mutex mutex_;
+    char* buffer_;
+    size_t size_;
+    size_t top_;
+    size_t overflow_bytes_;
+    size_t high_water_;
+    size_t overflows_;
+    size_t live_;     ///< blocks allocated or counted, not yet released
+    bool detached_;   ///< owning thread has exited
+    std::vector< Block > blocks_;
+};
+
+//------------------------------------------------------------------------------
+/// Thread-local handle to the thread's arena, created by arena_set_size.
+/// On thread exit, the arena is deleted, or, if blocks from it are still
+/// live on other threads, detached, to be deleted by its last release.
+class ArenaHandle
+{
+public:
+    ArenaHandle():
+        arena_( nullptr )
+    {}
+
+    ~ArenaHandle()
+    {
+        if (arena_ != nullptr && arena_->detach())
+            delete arena_;
+    }
+
+    Arena* get() const { return arena_; }
+
+    Arena* get_or_create()
+    {
+        if (arena_ == nullptr)
+            arena_ = new Arena();
+        return arena_;
+    }
+
+private:
+    Arena* arena_;
+};
+
+static thread_local ArenaHandle s_arena;
+
+//------------------------------------------------------------------------------
+void* arena_allocate( size_t bytes )
+{
+    if (bytes > std::numeric_limits< size_t >::max() - 2*Arena::alignment)
+        throw std::bad_alloc();
+    bytes = Arena::header_size + Arena::round_up( bytes );
+    Arena* arena = s_arena.get();
+    char* ptr = nullptr;
+    if (arena != nullptr)
+        ptr = arena->allocate( bytes );
+    bool in_arena = (ptr != nullptr);
+    if (ptr == nullptr) {
+        ptr = static_cast<char*>( Arena::aligned_malloc( bytes ) );
+        if (ptr == nullptr) {
+            // Undo the overflow count. The arena is not detached, as its
+            // thread is running.
+            if (arena != nullptr)
+                arena->deallocate( nullptr, bytes, false );
+            throw std::bad_alloc();
+        }
+    }
+    new (ptr) BlockHeader{ arena, bytes, in_arena };
+    return ptr + Arena::header_size;
+}
+
+//------------------------------------------------------------------------------
+void arena_deallocate( void* data ) noexcept
+{
+    if (data == nullptr)
+        return;
+
+    char* ptr = static_cast<char*>( data ) - Arena::header_size;
+    BlockHeader header = *reinterpret_cast<BlockHeader*>( ptr );
+    if (! header.in_arena)
+        Arena::aligned_free( ptr );
+    if (header.owner != nullptr
+        && header.owner->deallocate( ptr, header.bytes, header.in_arena ))
+        delete header.owner;
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+void arena_set_size( size_t size )
+{
+    internal::s_arena.get_or_create()->set_size( size );
+}
+
+//------------------------------------------------------------------------------
+size_t arena_size()
+{
+    internal::Arena* arena = internal::s_arena.get();
+    return arena != nullptr ? arena->size() : 0;
+}
+
+//------------------------------------------------------------------------------
+size_t arena_used()
+{
+    internal::Arena* arena = internal::s_arena.get();
+    return arena != nullptr ? arena->used() : 0;
+}
+
+//------------------------------------------------------------------------------
+size_t arena_high_water()
+{
+    internal::Arena* arena = internal::s_arena.get();
+    return arena != nullptr ? arena->high_water() : 0;
+}
+
+//------------------------------------------------------------------------------
+size_t arena_overflows()
+{
+    internal::Arena* arena = internal::s_arena.get();
+    return arena != nullptr ? arena->overflows() : 0;
+}
+
+//------------------------------------------------------------------------------
+void arena_reset()
+{
+    internal::Arena* arena = internal::s_arena.get();
+    if (arena != nullptr)
+        arena->reset();
+}
+
+}  // namespace lapack
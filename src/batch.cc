@@ -0,0 +1,58 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "batch.hh"
+
+#include <mutex>
+
+#if defined(BLAS_HAVE_MKL)
+    extern "C" int MKL_Set_Num_Threads_Local( int nthreads );
+#elif defined(BLAS_HAVE_OPENBLAS)
+    extern "C" int  openblas_get_num_threads();
+    extern "C" void openblas_set_num_threads( int nthreads );
+#endif
+
+namespace lapack {
+namespace internal {
+
+#if ! defined(BLAS_HAVE_MKL) && defined(BLAS_HAVE_OPENBLAS)
+// OpenBLAS's setting is global: count active guards so only the first
+// saves it and only the last restores it.
+static std::mutex s_openblas_mutex;
+static int s_openblas_count = 0;
+static int s_openblas_saved = 0;
+#endif
+
+//------------------------------------------------------------------------------
+VendorSingleThread::VendorSingleThread():
+    saved_( 0 )
+{
+    #if defined(BLAS_HAVE_MKL)
+        saved_ = MKL_Set_Num_Threads_Local( 1 );
+    #elif defined(BLAS_HAVE_OPENBLAS)
+        std::lock_guard< std::mutex > guard( s_openblas_mutex );
+        if (s_openblas_count++ == 0) {
+            s_openblas_saved = openblas_get_num_threads();
+            openblas_set_num_threads( 1 );
+        }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+VendorSingleThread::~VendorSingleThread()
+{
+    #if defined(BLAS_HAVE_MKL)
+        // 0 restores the global setting.
+        MKL_Set_Num_Threads_Local( saved_ );
+    #elif defined(BLAS_HAVE_OPENBLAS)
+        std::lock_guard< std::mutex > guard( s_openblas_mutex );
+        if (--s_openblas_count == 0)
+            openblas_set_num_threads( s_openblas_saved );
+    #endif
+}
+
+}  // namespace internal
+}  // namespace lapack
@@ -0,0 +1,114 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_BATCH_INTERNAL_HH
+#define LAPACK_BATCH_INTERNAL_HH
+
+#include "lapack/util.hh"
+
+#include <exception>
+#include <optional>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// While in scope, limits the vendor BLAS/LAPACK library to one thread,
+/// so batched routines can factor one matrix per core without
+/// oversubscription. Restores the previous setting when destroyed.
+/// Supports MKL (thread-local setting) and OpenBLAS (global setting,
+/// which also affects other threads; nested and concurrent guards are
+/// counted, and the last one destroyed restores the setting);
+/// otherwise is a no-op.
+class VendorSingleThread
+{
+public:
+    VendorSingleThread();
+    ~VendorSingleThread();
+
+    // not copyable
+    VendorSingleThread( VendorSingleThread const& ) = delete;
+    VendorSingleThread& operator = ( VendorSingleThread const& ) = delete;
+
+private:
+    int saved_;
+};
+
+//------------------------------------------------------------------------------
+/// @return number of threads that batch_for uses for batch_count matrices.
+inline int batch_num_threads( int64_t batch_count )
+{
+    #ifdef _OPENMP
+        int nthreads = omp_get_max_threads();
+        if (batch_count < nthreads)
+            nthreads = (batch_count < 1 ? 1 : int( batch_count ));
+        return nthreads;
+    #else
+        return 1;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Calls body( i, thread ) for i = 0, ..., batch_count - 1, in parallel
+/// over OpenMP threads if OpenMP is enabled. When using more than one
+/// thread, the vendor library is in single-thread mode. thread is in [0, batch_num_threads( batch_count )),
+/// for indexing per-thread workspace.
+/// If body throws, the first exception is rethrown after the loop.
+template <typename Body>
+void batch_for( int64_t batch_count, Body&& body )
+{
+    if (batch_count <= 0)
+        return;
+
+    std::exception_ptr exception;
+    #ifdef _OPENMP
+        // With one thread, the vendor library may use all cores itself.
+        int nthreads = batch_num_threads( batch_count );
+        std::optional< VendorSingleThread > single_thread;
+        if (nthreads > 1)
+            single_thread.emplace();
+
+        #pragma omp parallel num_threads( nthreads )
+        {
+            int thread = omp_get_thread_num();
+
+            #pragma omp for schedule( static )
+            for (int64_t i = 0; i < batch_count; ++i) {
+                try {
+                    body( i, thread );
+                }
+                catch (...) {
+                    #pragma omp critical( lapack_batch_for )
+                    {
+                        if (! exception)
+                            exception = std::current_exception();
+                    }
+                }
+            }
+        }
+    #else
+        for (int64_t i = 0; i < batch_count; ++i) {
+            try {
+                body( i, 0 );
+            }
+            catch (...) {
+                if (! exception)
+                    exception = std::current_exception();
+            }
+        }
+    #endif
+
+    if (exception)
+        std::rethrow_exception( exception );
+}
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_BATCH_INTERNAL_HH
@@ -0,0 +1,702 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/factor.hh"
+#include "lapack/fortran.h"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+using blas::real;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Thin Fortran wrappers taking lapack_int pivots and caller's workspace,
+// which the int64_t pivot routines in wrappers.hh do not.
+
+//------------------------------------------------------------------------------
+/// Checks that the dimensions of a solve fit in lapack_int.
+void check_overflow( int64_t n, int64_t nrhs, int64_t lda, int64_t ldb )
+{
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Solves A X = B with the factors of hetrf, hetrf_rook, hetrf_rk, or
+/// hetrf_aa (sytrf, etc., if real). E is used by RK, work by Aasen.
+void hetrs_native(
+    LDLPivot pivot, Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda, float const* E,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb,
+    float* work, int64_t lwork )
+{
+    check_overflow( n, nrhs, lda, ldb );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+
+    switch (pivot) {
+        case LDLPivot::BunchKaufman:
+            LAPACK_ssytrs( &uplo_, &n_, &nrhs_, A, &lda_, ipiv,
+                           B, &ldb_, &info_ );
+            break;
+    #if LAPACK_VERSION >= 30500  // >= 3.5
+        case LDLPivot::Rook:
+            LAPACK_ssytrs_rook( &uplo_, &n_, &nrhs_, A, &lda_, ipiv,
+                                B, &ldb_, &info_ );
+            break;
+    #endif
+    #if LAPACK_VERSION >= 30700  // >= 3.7
+        case LDLPivot::RK:
+            LAPACK_ssytrs_3( &uplo_, &n_, &nrhs_, A, &lda_, E, ipiv,
+                             B, &ldb_, &info_ );
+            break;
+        case LDLPivot::Aasen:
+            LAPACK_ssytrs_aa( &uplo_, &n_, &nrhs_, A, &lda_, ipiv,
+                              B, &ldb_, work, &lwork_, &info_ );
+            break;
+    #endif
+        default:
+            throw Error( "pivoting not available in this LAPACK version" );
+    }
+    if (info_ < 0) {
+        throw Error();
+    }
+}
+
+void hetrs_native(
+    LDLPivot pivot, Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda, double const* E,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb,
+    double* work, int64_t lwork )
+{
+    check_overflow( n, nrhs, lda, ldb );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+
+    switch (pivot) {
+        case LDLPivot::BunchKaufman:
+            LAPACK_dsytrs( &uplo_, &n_, &nrhs_, A, &lda_, ipiv,
+                           B, &ldb_, &info_ );
+            break;
+    #if LAPACK_VERSION >= 30500  // >= 3.5
+        case LDLPivot::Rook:
+            LAPACK_dsytrs_rook( &uplo_, &n_, &nrhs_, A, &lda_, ipiv,
+                                B, &ldb_, &info_ );
+            break;
+    #endif
+    #if LAPACK_VERSION >= 30700  // >= 3.7
+        case LDLPivot::RK:
+            LAPACK_dsytrs_3( &uplo_, &n_, &nrhs_, A, &lda_, E, ipiv,
+                             B, &ldb_, &info_ );
+            break;
+        case LDLPivot::Aasen:
+            LAPACK_dsytrs_aa( &uplo_, &n_, &nrhs_, A, &lda_, ipiv,
+                              B, &ldb_, work, &lwork_, &info_ );
+            break;
+    #endif
+        default:
+            throw Error( "pivoting not available in this LAPACK version" );
+    }
+    if (info_ < 0) {
+        throw Error();
+    }
+}
+
+void hetrs_native(
+    LDLPivot pivot, Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* E,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb,
+    std::complex<float>* work, int64_t lwork )
+{
+    check_overflow( n, nrhs, lda, ldb );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+
+    switch (pivot) {
+        case LDLPivot::BunchKaufman:
+            LAPACK_chetrs( &uplo_, &n_, &nrhs_,
+                           (lapack_complex_float*) A, &lda_, ipiv,
+                           (lapack_complex_float*) B, &ldb_, &info_ );
+            break;
+    #if LAPACK_VERSION >= 30500  // >= 3.5
+        case LDLPivot::Rook:
+            LAPACK_chetrs_rook( &uplo_, &n_, &nrhs_,
+                                (lapack_complex_float*) A, &lda_, ipiv,
+                                (lapack_complex_float*) B, &ldb_, &info_ );
+            break;
+    #endif
+    #if LAPACK_VERSION >= 30700  // >= 3.7
+        case LDLPivot::RK:
+            LAPACK_chetrs_3( &uplo_, &n_, &nrhs_,
+                             (lapack_complex_float*) A, &lda_,
+                             (lapack_complex_float*) E, ipiv,
+                             (lapack_complex_float*) B, &ldb_, &info_ );
+            break;
+        case LDLPivot::Aasen:
+            LAPACK_chetrs_aa( &uplo_, &n_, &nrhs_,
+                              (lapack_complex_float*) A, &lda_, ipiv,
+                              (lapack_complex_float*) B, &ldb_,
+                              (lapack_complex_float*) work, &lwork_, &info_ );
+            break;
+    #endif
+        default:
+            throw Error( "pivoting not available in this LAPACK version" );
+    }
+    if (info_ < 0) {
+        throw Error();
+    }
+}
+
+void hetrs_native(
+    LDLPivot pivot, Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* E,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb,
+    std::complex<double>* work, int64_t lwork )
+{
+    check_overflow( n, nrhs, lda, ldb );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+
+    switch (pivot) {
+        case LDLPivot::BunchKaufman:
+            LAPACK_zhetrs( &uplo_, &n_, &nrhs_,
+                           (lapack_complex_double*) A, &lda_, ipiv,
+                           (lapack_complex_double*) B, &ldb_, &info_ );
+            break;
+    #if LAPACK_VERSION >= 30500  // >= 3.5
+        case LDLPivot::Rook:
+            LAPACK_zhetrs_rook( &uplo_, &n_, &nrhs_,
+                                (lapack_complex_double*) A, &lda_, ipiv,
+                                (lapack_complex_double*) B, &ldb_, &info_ );
+            break;
+    #endif
+    #if LAPACK_VERSION >= 30700  // >= 3.7
+        case LDLPivot::RK:
+            LAPACK_zhetrs_3( &uplo_, &n_, &nrhs_,
+                             (lapack_complex_double*) A, &lda_,
+                             (lapack_complex_double*) E, ipiv,
+                             (lapack_complex_double*) B, &ldb_, &info_ );
+            break;
+        case LDLPivot::Aasen:
+            LAPACK_zhetrs_aa( &uplo_, &n_, &nrhs_,
+                              (lapack_complex_double*) A, &lda_, ipiv,
+                              (lapack_complex_double*) B, &ldb_,
+                              (lapack_complex_double*) work, &lwork_, &info_ );
+            break;
+    #endif
+        default:
+            throw Error( "pivoting not available in this LAPACK version" );
+    }
+    if (info_ < 0) {
+        throw Error();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Multiplies C by Q or Q^H from geqrf, using the caller's workspace.
+/// If lwork = -1, returns the optimal lwork instead.
+int64_t unmqr_native(
+    Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda, float const* tau,
+    float* C, int64_t ldc,
+    float* work, int64_t lwork )
+{
+    check_overflow( m, n, lda, ldc );
+    char side_ = 'L';
+    char trans_ = (trans == Op::NoTrans ? 'N' : 'T');
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+    LAPACK_sormqr( &side_, &trans_, &m_, &n_, &k_, A, &lda_, tau,
+                   C, &ldc_, work, &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return (lwork == -1 ? int64_t( work[0] ) : 0);
+}
+
+int64_t unmqr_native(
+    Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda, double const* tau,
+    double* C, int64_t ldc,
+    double* work, int64_t lwork )
+{
+    check_overflow( m, n, lda, ldc );
+    char side_ = 'L';
+    char trans_ = (trans == Op::NoTrans ? 'N' : 'T');
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+    LAPACK_dormqr( &side_, &trans_, &m_, &n_, &k_, A, &lda_, tau,
+                   C, &ldc_, work, &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return (lwork == -1 ? int64_t( work[0] ) : 0);
+}
+
+int64_t unmqr_native(
+    Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* tau,
+    std::complex<float>* C, int64_t ldc,
+    std::complex<float>* work, int64_t lwork )
+{
+    check_overflow( m, n, lda, ldc );
+    char side_ = 'L';
+    char trans_ = (trans == Op::NoTrans ? 'N' : 'C');
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+    LAPACK_cunmqr( &side_, &trans_, &m_, &n_, &k_,
+                   (lapack_complex_float*) A, &lda_,
+                   (lapack_complex_float*) tau,
+                   (lapack_complex_float*) C, &ldc_,
+                   (lapack_complex_float*) work, &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return (lwork == -1 ? int64_t( real( work[0] ) ) : 0);
+}
+
+int64_t unmqr_native(
+    Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* tau,
+    std::complex<double>* C, int64_t ldc,
+    std::complex<double>* work, int64_t lwork )
+{
+    check_overflow( m, n, lda, ldc );
+    char side_ = 'L';
+    char trans_ = (trans == Op::NoTrans ? 'N' : 'C');
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+    LAPACK_zunmqr( &side_, &trans_, &m_, &n_, &k_,
+                   (lapack_complex_double*) A, &lda_,
+                   (lapack_complex_double*) tau,
+                   (lapack_complex_double*) C, &ldc_,
+                   (lapack_complex_double*) work, &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return (lwork == -1 ? int64_t( real( work[0] ) ) : 0);
+}
+
+//------------------------------------------------------------------------------
+/// One step of lacn2's reverse communication; isgn is used only if real.
+void lacn2(
+    int64_t n, float* v, float* x, lapack_int* isgn,
+    float* est, lapack_int* kase, lapack_int* isave )
+{
+    lapack_int n_ = (lapack_int) n;
+    LAPACK_slacn2( &n_, v, x, isgn, est, kase, isave );
+}
+
+void lacn2(
+    int64_t n, double* v, double* x, lapack_int* isgn,
+    double* est, lapack_int* kase, lapack_int* isave )
+{
+    lapack_int n_ = (lapack_int) n;
+    LAPACK_dlacn2( &n_, v, x, isgn, est, kase, isave );
+}
+
+void lacn2(
+    int64_t n, std::complex<float>* v, std::complex<float>* x,
+    lapack_int* isgn,
+    float* est, lapack_int* kase, lapack_int* isave )
+{
+    lapack_int n_ = (lapack_int) n;
+    LAPACK_clacn2( &n_, (lapack_complex_float*) v,
+                   (lapack_complex_float*) x, est, kase, isave );
+}
+
+void lacn2(
+    int64_t n, std::complex<double>* v, std::complex<double>* x,
+    lapack_int* isgn,
+    double* est, lapack_int* kase, lapack_int* isave )
+{
+    lapack_int n_ = (lapack_int) n;
+    LAPACK_zlacn2( &n_, (lapack_complex_double*) v,
+                   (lapack_complex_double*) x, est, kase, isave );
+}
+
+}  // namespace
+
+//==============================================================================
+// LUFactor
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+LUFactor< scalar_t >::LUFactor(
+    int64_t n, scalar_t const* A, int64_t lda )
+    : n_( n ),
+      info_( 0 ),
+      anorm_( 0 ),
+      rcond_( -1 )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+
+    int64_t ld = max( 1, n );
+    LU_.resize( ld * n );
+    ipiv_.resize( n );
+    lacpy( MatrixType::General, n, n, A, lda, LU_.data(), ld );
+    anorm_ = lange( Norm::One, n, n, A, lda );
+    // Calls the lapack_int pivot overload, except in ILP64 builds,
+    // where lapack_int is int64_t.
+    info_ = getrf( n, n, LU_.data(), ld, ipiv_.data() );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void LUFactor< scalar_t >::solve(
+    int64_t nrhs, scalar_t* B, int64_t ldb, Op trans ) const
+{
+    lapack_error_if( info_ != 0 );
+    getrs( trans, n_, nrhs, LU_.data(), max( 1, n_ ), ipiv_.data(), B, ldb );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+blas::real_type< scalar_t > LUFactor< scalar_t >::rcond()
+{
+    if (rcond_ < 0) {
+        real_t rcond = 0;
+        if (info_ == 0)
+            gecon( Norm::One, n_, LU_.data(), max( 1, n_ ), anorm_, &rcond );
+        rcond_ = rcond;
+    }
+    return rcond_;
+}
+
+//==============================================================================
+// CholeskyFactor
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+CholeskyFactor< scalar_t >::CholeskyFactor(
+    Uplo uplo, int64_t n, scalar_t const* A, int64_t lda )
+    : uplo_( uplo ),
+      n_( n ),
+      info_( 0 ),
+      anorm_( 0 ),
+      rcond_( -1 )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+
+    int64_t ld = max( 1, n );
+    LLt_.resize( ld * n );
+    lacpy( (uplo == Uplo::Lower ? MatrixType::Lower : MatrixType::Upper),
+           n, n, A, lda, LLt_.data(), ld );
+    anorm_ = lanhe( Norm::One, uplo, n, A, lda );
+    info_ = potrf( uplo, n, LLt_.data(), ld );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void CholeskyFactor< scalar_t >::solve(
+    int64_t nrhs, scalar_t* B, int64_t ldb ) const
+{
+    lapack_error_if( info_ != 0 );
+    potrs( uplo_, n_, nrhs, LLt_.data(), max( 1, n_ ), B, ldb );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+blas::real_type< scalar_t > CholeskyFactor< scalar_t >::rcond()
+{
+    if (rcond_ < 0) {
+        real_t rcond = 0;
+        if (info_ == 0)
+            pocon( uplo_, n_, LLt_.data(), max( 1, n_ ), anorm_, &rcond );
+        rcond_ = rcond;
+    }
+    return rcond_;
+}
+
+//==============================================================================
+// LDLFactor
+
+//------------------------------------------------------------------------------
+/// Rook, RK, and Aasen factor with the int64_t pivot routines, whose
+/// pivots are converted once here; solves then call LAPACK directly.
+template <typename scalar_t>
+LDLFactor< scalar_t >::LDLFactor(
+    Uplo uplo, int64_t n, scalar_t const* A, int64_t lda, LDLPivot pivot )
+    : uplo_( uplo ),
+      pivot_( pivot ),
+      n_( n ),
+      info_( 0 ),
+      anorm_( 0 ),
+      rcond_( -1 )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+
+    int64_t ld = max( 1, n );
+    LDL_.resize( ld * n );
+    ipiv_.resize( n );
+    lacpy( (uplo == Uplo::Lower ? MatrixType::Lower : MatrixType::Upper),
+           n, n, A, lda, LDL_.data(), ld );
+    anorm_ = lanhe( Norm::One, uplo, n, A, lda );
+
+    std::vector< int64_t > ipiv64( n );
+    switch (pivot) {
+        case LDLPivot::BunchKaufman:
+            // lapack_int pivot overloads; hetrf exists only for complex.
+            if constexpr (blas::is_complex< scalar_t >::value)
+                info_ = hetrf( uplo, n, LDL_.data(), ld, ipiv_.data() );
+            else
+                info_ = sytrf( uplo, n, LDL_.data(), ld, ipiv_.data() );
+            break;
+    #if LAPACK_VERSION >= 30500  // >= 3.5
+        case LDLPivot::Rook:
+            info_ = hetrf_rook( uplo, n, LDL_.data(), ld, ipiv64.data() );
+            break;
+    #endif
+    #if LAPACK_VERSION >= 30700  // >= 3.7
+        case LDLPivot::RK:
+            E_.resize( n );
+            info_ = hetrf_rk( uplo, n, LDL_.data(), ld, E_.data(),
+                              ipiv64.data() );
+            break;
+        case LDLPivot::Aasen:
+            // hetrs_aa needs lwork >= 3n - 2, for any nrhs.
+            work_.resize( max( 1, 3*n - 2 ) );
+            info_ = hetrf_aa( uplo, n, LDL_.data(), ld, ipiv64.data() );
+            break;
+    #endif
+        default:
+            throw Error( "pivoting not available in this LAPACK version" );
+    }
+    if (pivot != LDLPivot::BunchKaufman)
+        std::copy( ipiv64.begin(), ipiv64.end(), ipiv_.begin() );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void LDLFactor< scalar_t >::solve(
+    int64_t nrhs, scalar_t* B, int64_t ldb )
+{
+    lapack_error_if( info_ != 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( ldb < max( 1, n_ ) );
+    hetrs_native( pivot_, uplo_, n_, nrhs, LDL_.data(), max( 1, n_ ),
+                  E_.data(), ipiv_.data(), B, ldb,
+                  work_.data(), work_.size() );
+}
+
+//------------------------------------------------------------------------------
+/// As hecon: lacn2 estimates ||A^{-1}||_1 from solves with A. Since A is
+/// Hermitian, solves with A^H, which lacn2 also asks for, are the same.
+template <typename scalar_t>
+blas::real_type< scalar_t > LDLFactor< scalar_t >::rcond()
+{
+    if (rcond_ < 0) {
+        real_t rcond = 0;
+        if (n_ == 0) {
+            rcond = 1;
+        }
+        else if (info_ == 0 && anorm_ > 0) {
+            std::vector< scalar_t > v( n_ ), x( n_ );
+            std::vector< lapack_int > isgn( n_ );
+            lapack_int kase = 0, isave[ 3 ];
+            real_t ainvnm = 0;
+            do {
+                lacn2( n_, v.data(), x.data(), isgn.data(), &ainvnm,
+                       &kase, isave );
+                if (kase != 0)
+                    solve( x.data() );
+            } while (kase != 0);
+            if (ainvnm != 0)
+                rcond = (1 / ainvnm) / anorm_;
+        }
+        rcond_ = rcond;
+    }
+    return rcond_;
+}
+
+//==============================================================================
+// QRFactor
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+QRFactor< scalar_t >::QRFactor(
+    int64_t m, int64_t n, scalar_t const* A, int64_t lda )
+    : m_( m ),
+      n_( n ),
+      info_( 0 ),
+      rcond_( -1 ),
+      work_nrhs_( 0 )
+{
+    const scalar_t zero = 0.0;
+
+    lapack_error_if( n < 0 );
+    lapack_error_if( m < n );
+    lapack_error_if( lda < max( 1, m ) );
+
+    int64_t ld = max( 1, m );
+    QR_.resize( ld * n );
+    tau_.resize( n );
+    lacpy( MatrixType::General, m, n, A, lda, QR_.data(), ld );
+    geqrf( m, n, QR_.data(), ld, tau_.data() );
+    for (int64_t j = 0; j < n; ++j) {
+        if (QR_[ j + j*ld ] == zero) {
+            info_ = j + 1;
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// The unmqr workspace is queried and grown only when nrhs exceeds that of
+/// previous solves, so repeated solves allocate nothing.
+template <typename scalar_t>
+void QRFactor< scalar_t >::solve(
+    int64_t nrhs, scalar_t* B, int64_t ldb, Op trans )
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    if (trans == Op::Trans && ! blas::is_complex< scalar_t >::value)
+        trans = Op::ConjTrans;
+    lapack_error_if( trans != Op::NoTrans && trans != Op::ConjTrans );
+    lapack_error_if( info_ != 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( ldb < max( 1, m_ ) );
+
+    if (n_ == 0 || nrhs == 0) {
+        if (trans == Op::ConjTrans)
+            laset( MatrixType::General, m_, nrhs, zero, zero, B, ldb );
+        return;
+    }
+
+    // Grow the cached workspace if nrhs exceeds that of previous solves.
+    // With side = Left, the unmqr workspace depends only on nrhs.
+    int64_t lda = max( 1, m_ );
+    if (nrhs > work_nrhs_) {
+        scalar_t query;
+        int64_t lwork = unmqr_native( Op::NoTrans, m_, nrhs, n_,
+                                      QR_.data(), lda, tau_.data(),
+                                      B, ldb, &query, -1 );
+        if (int64_t( work_.size() ) < lwork)
+            work_.resize( lwork );
+        work_nrhs_ = nrhs;
+    }
+    int64_t lwork = work_.size();
+
+    if (trans == Op::NoTrans) {
+        // B = Q^H B; X = R^{-1} B( 0:n-1, : ).
+        unmqr_native( Op::ConjTrans, m_, nrhs, n_, QR_.data(), lda,
+                      tau_.data(), B, ldb, work_.data(), lwork );
+        blas::trsm( Layout::ColMajor, Side::Left, Uplo::Upper, Op::NoTrans,
+                    Diag::NonUnit, n_, nrhs, one, QR_.data(), lda, B, ldb );
+    }
+    else {
+        // X = Q [ R^{-H} B; 0 ].
+        blas::trsm( Layout::ColMajor, Side::Left, Uplo::Upper, Op::ConjTrans,
+                    Diag::NonUnit, n_, nrhs, one, QR_.data(), lda, B, ldb );
+        if (m_ > n_)
+            laset( MatrixType::General, m_ - n_, nrhs, zero, zero,
+                   &B[ n_ ], ldb );
+        unmqr_native( Op::NoTrans, m_, nrhs, n_, QR_.data(), lda,
+                      tau_.data(), B, ldb, work_.data(), lwork );
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+blas::real_type< scalar_t > QRFactor< scalar_t >::rcond()
+{
+    if (rcond_ < 0) {
+        real_t rcond = 0;
+        if (info_ == 0) {
+            trcon( Norm::One, Uplo::Upper, Diag::NonUnit, n_,
+                   QR_.data(), max( 1, m_ ), &rcond );
+        }
+        rcond_ = rcond;
+    }
+    return rcond_;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class LUFactor< float >;
+template class LUFactor< double >;
+template class LUFactor< std::complex<float> >;
+template class LUFactor< std::complex<double> >;
+
+template class CholeskyFactor< float >;
+template class CholeskyFactor< double >;
+template class CholeskyFactor< std::complex<float> >;
+template class CholeskyFactor< std::complex<double> >;
+
+template class LDLFactor< float >;
+template class LDLFactor< double >;
+template class LDLFactor< std::complex<float> >;
+template class LDLFactor< std::complex<double> >;
+
+template class QRFactor< float >;
+template class QRFactor< double >;
+template class QRFactor< std::complex<float> >;
+template class QRFactor< std::complex<double> >;
+
+}  // namespace lapack
@@ -0,0 +1,109 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_FIXED_DISPATCH_HH
+#define LAPACK_FIXED_DISPATCH_HH
+
+#include "lapack/fixed.hh"
+
+#include <type_traits>
+
+// Largest n for which the wrappers dispatch to lapack::fixed<n>.
+// Above about 12-16, OpenBLAS and MKL are faster than the fixed kernels.
+// Define as 0 when building LAPACK++ to always call LAPACK.
+#ifndef LAPACK_FIXED_SIZE_MAX
+    #define LAPACK_FIXED_SIZE_MAX 12
+#endif
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return true if wrappers should dispatch order n to fixed<n>.
+inline bool use_fixed( int64_t n )
+{
+    return 0 < n && n <= LAPACK_FIXED_SIZE_MAX;
+}
+
+//------------------------------------------------------------------------------
+/// Calls body( std::integral_constant< int, n >() ) for run-time n,
+/// so body can call fixed< n >. Requires use_fixed( n ).
+template <int N = 1, typename Body>
+inline void fixed_dispatch( int64_t n, Body&& body )
+{
+    if constexpr (N <= LAPACK_FIXED_SIZE_MAX) {
+        if (n == N)
+            body( std::integral_constant< int, N >() );
+        else
+            fixed_dispatch< N+1 >( n, body );
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+inline int64_t fixed_potrf(
+    lapack::Uplo uplo, int64_t n, scalar_t* A, int64_t lda )
+{
+    int64_t info = 0;
+    fixed_dispatch( n, [&]( auto N ) {
+        info = fixed< decltype( N )::value >::potrf( uplo, A, lda );
+    });
+    return info;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename pivot_t>
+inline int64_t fixed_getrf(
+    int64_t n, scalar_t* A, int64_t lda, pivot_t* ipiv )
+{
+    int64_t info = 0;
+    fixed_dispatch( n, [&]( auto N ) {
+        info = fixed< decltype( N )::value >::getrf( A, lda, ipiv );
+    });
+    return info;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+inline int64_t fixed_geqrf(
+    int64_t n, scalar_t* A, int64_t lda, scalar_t* tau )
+{
+    int64_t info = 0;
+    fixed_dispatch( n, [&]( auto N ) {
+        info = fixed< decltype( N )::value >::geqrf( A, lda, tau );
+    });
+    return info;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename pivot_t>
+inline int64_t fixed_getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, pivot_t const* ipiv,
+    scalar_t* B, int64_t ldb )
+{
+    fixed_dispatch( n, [&]( auto N ) {
+        fixed< decltype( N )::value >::getrs( trans, nrhs, A, lda, ipiv, B, ldb );
+    });
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+inline int64_t fixed_potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    fixed_dispatch( n, [&]( auto N ) {
+        fixed< decltype( N )::value >::potrs( uplo, nrhs, A, lda, B, ldb );
+    });
+    return 0;
+}
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_FIXED_DISPATCH_HH
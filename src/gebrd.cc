@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -25,6 +26,9 @@ int64_t gebrd(
     float* tauq,
     float* taup )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gebrd", 's', m, n, 0,
+                             Gflop< float >::gebrd( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -79,6 +83,9 @@ int64_t gebrd(
     double* tauq,
     double* taup )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gebrd", 'd', m, n, 0,
+                             Gflop< double >::gebrd( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -133,6 +140,9 @@ int64_t gebrd(
     std::complex<float>* tauq,
     std::complex<float>* taup )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gebrd", 'c', m, n, 0,
+                             Gflop< std::complex<float> >::gebrd( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -315,6 +325,9 @@ int64_t gebrd(
     std::complex<double>* tauq,
     std::complex<double>* taup )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gebrd", 'z', m, n, 0,
+                             Gflop< std::complex<double> >::gebrd( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -24,60 +27,13 @@ int64_t geev(
     float* VL, int64_t ldvl,
     float* VR, int64_t ldvr )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobvl_ = job2char( jobvl );
-    char jobvr_ = job2char( jobvr );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldvl_ = (lapack_int) ldvl;
-    lapack_int ldvr_ = (lapack_int) ldvr;
-    lapack_int info_ = 0;
-
-    // split-complex representation
-    lapack::vector< float > WR( max( 1, n ) );
-    lapack::vector< float > WI( max( 1, n ) );
-
-    // query for workspace size
-    float qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_sgeev(
-        &jobvl_, &jobvr_, &n_,
-        A, &lda_,
-        &WR[0], &WI[0],
-        VL, &ldvl_,
-        VR, &ldvr_,
-        qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    geev_work_size_bytes( jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr, &work_size );
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_sgeev(
-        &jobvl_, &jobvr_, &n_,
-        A, &lda_,
-        &WR[0], &WI[0],
-        VL, &ldvl_,
-        VR, &ldvr_,
-        &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    // merge split-complex representation
-    for (int64_t i = 0; i < n; ++i) {
-        W[i] = std::complex<float>( WR[i], WI[i] );
-    }
-    return info_;
+    return geev( jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -89,60 +45,13 @@ int64_t geev(
     double* VL, int64_t ldvl,
     double* VR, int64_t ldvr )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobvl_ = job2char( jobvl );
-    char jobvr_ = job2char( jobvr );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldvl_ = (lapack_int) ldvl;
-    lapack_int ldvr_ = (lapack_int) ldvr;
-    lapack_int info_ = 0;
-
-    // split-complex representation
-    lapack::vector< double > WR( max( 1, n ) );
-    lapack::vector< double > WI( max( 1, n ) );
-
-    // query for workspace size
-    double qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dgeev(
-        &jobvl_, &jobvr_, &n_,
-        A, &lda_,
-        &WR[0], &WI[0],
-        VL, &ldvl_,
-        VR, &ldvr_,
-        qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    geev_work_size_bytes( jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr, &work_size );
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_dgeev(
-        &jobvl_, &jobvr_, &n_,
-        A, &lda_,
-        &WR[0], &WI[0],
-        VL, &ldvl_,
-        VR, &ldvr_,
-        &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    // merge split-complex representation
-    for (int64_t i = 0; i < n; ++i) {
-        W[i] = std::complex<double>( WR[i], WI[i] );
-    }
-    return info_;
+    return geev( jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -154,56 +63,13 @@ int64_t geev(
     std::complex<float>* VL, int64_t ldvl,
     std::complex<float>* VR, int64_t ldvr )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobvl_ = job2char( jobvl );
-    char jobvr_ = job2char( jobvr );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldvl_ = (lapack_int) ldvl;
-    lapack_int ldvr_ = (lapack_int) ldvr;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    float qry_rwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cgeev(
-        &jobvl_, &jobvr_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        (lapack_complex_float*) W,
-        (lapack_complex_float*) VL, &ldvl_,
-        (lapack_complex_float*) VR, &ldvr_,
-        (lapack_complex_float*) qry_work, &ineg_one,
-        qry_rwork, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    geev_work_size_bytes( jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr, &work_size );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (2*n) );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_cgeev(
-        &jobvl_, &jobvr_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        (lapack_complex_float*) W,
-        (lapack_complex_float*) VL, &ldvl_,
-        (lapack_complex_float*) VR, &ldvr_,
-        (lapack_complex_float*) &work[0], &lwork_,
-        &rwork[0], &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return geev( jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -314,6 +180,133 @@ int64_t geev(
     std::complex<double>* W,
     std::complex<double>* VL, int64_t ldvl,
     std::complex<double>* VR, int64_t ldvr )
+{
+    size_t work_size;
+    geev_work_size_bytes( jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return geev( jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    float* A, int64_t lda,
+    std::complex<float>* W,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "sgeev", { jobvl_, jobvr_, n_, lda_, ldvl_, ldvr_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    float qry_work[1];
+    float qry_wr[1];
+    float qry_wi[1];
+    lapack_int ineg_one = -1;
+    LAPACK_sgeev(
+        &jobvl_, &jobvr_, &n_,
+        A, &lda_,
+        qry_wr, qry_wi,
+        VL, &ldvl_,
+        VR, &ldvr_,
+        qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // split-complex representation (WR, WI), then work
+    *host_work_size = 2*internal::workspace_bytes< float >( n )
+                    + internal::workspace_bytes< float >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    double* A, int64_t lda,
+    std::complex<double>* W,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "dgeev", { jobvl_, jobvr_, n_, lda_, ldvl_, ldvr_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    double qry_work[1];
+    double qry_wr[1];
+    double qry_wi[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dgeev(
+        &jobvl_, &jobvr_, &n_,
+        A, &lda_,
+        qry_wr, qry_wi,
+        VL, &ldvl_,
+        VR, &ldvr_,
+        qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // split-complex representation (WR, WI), then work
+    *host_work_size = 2*internal::workspace_bytes< double >( n )
+                    + internal::workspace_bytes< double >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* W,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -330,6 +323,79 @@ int64_t geev(
     lapack_int ldvr_ = (lapack_int) ldvr;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "cgeev", { jobvl_, jobvr_, n_, lda_, ldvl_, ldvr_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    float qry_rwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cgeev(
+        &jobvl_, &jobvr_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        (lapack_complex_float*) W,
+        (lapack_complex_float*) VL, &ldvl_,
+        (lapack_complex_float*) VR, &ldvr_,
+        (lapack_complex_float*) qry_work, &ineg_one,
+        qry_rwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // rwork, then work
+    *host_work_size = internal::workspace_bytes< float >( 2*n )
+                    + internal::workspace_bytes< std::complex<float> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::geev`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::geev`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::geev`.
+///
+/// @ingroup geev
+void geev_work_size_bytes(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* W,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "zgeev", { jobvl_, jobvr_, n_, lda_, ldvl_, ldvr_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     std::complex<double> qry_work[1];
     double qry_rwork[1];
@@ -348,9 +414,222 @@ int64_t geev(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (2*n) );
+    // rwork, then work
+    *host_work_size = internal::workspace_bytes< double >( 2*n )
+                    + internal::workspace_bytes< std::complex<double> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    float* A, int64_t lda,
+    std::complex<float>* W,
+    float* VL, int64_t ldvl,
+    float* VR, int64_t ldvr,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "geev", 's', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    // split-complex representation
+    float* WR = workspace.take< float >( n );
+    float* WI = workspace.take< float >( n );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_sgeev(
+        &jobvl_, &jobvr_, &n_,
+        A, &lda_,
+        WR, WI,
+        VL, &ldvl_,
+        VR, &ldvr_,
+        work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    // merge split-complex representation
+    for (int64_t i = 0; i < n; ++i) {
+        W[i] = std::complex<float>( WR[i], WI[i] );
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    double* A, int64_t lda,
+    std::complex<double>* W,
+    double* VL, int64_t ldvl,
+    double* VR, int64_t ldvr,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "geev", 'd', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    // split-complex representation
+    double* WR = workspace.take< double >( n );
+    double* WI = workspace.take< double >( n );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
+
+    LAPACK_dgeev(
+        &jobvl_, &jobvr_, &n_,
+        A, &lda_,
+        WR, WI,
+        VL, &ldvl_,
+        VR, &ldvr_,
+        work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    // merge split-complex representation
+    for (int64_t i = 0; i < n; ++i) {
+        W[i] = std::complex<double>( WR[i], WI[i] );
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* W,
+    std::complex<float>* VL, int64_t ldvl,
+    std::complex<float>* VR, int64_t ldvr,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "geev", 'c', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    float* rwork = workspace.take< float >( 2*n );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_cgeev(
+        &jobvl_, &jobvr_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        (lapack_complex_float*) W,
+        (lapack_complex_float*) VL, &ldvl_,
+        (lapack_complex_float*) VR, &ldvr_,
+        (lapack_complex_float*) work, &lwork_,
+        rwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Computes for an n-by-n nonsymmetric matrix A, the
+/// eigenvalues and, optionally, the left and/or right eigenvectors,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::geev` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in,out] jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr
+///     As for `lapack::geev` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::geev_work_size_bytes`.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, the QR algorithm failed to compute
+///     all the eigenvalues, and no eigenvectors have been computed;
+///     elements i+1:n of W contain eigenvalues which have converged.
+///
+/// @ingroup geev
+int64_t geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* W,
+    std::complex<double>* VL, int64_t ldvl,
+    std::complex<double>* VR, int64_t ldvr,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "geev", 'z', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvl) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvr) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobvl_ = job2char( jobvl );
+    char jobvr_ = job2char( jobvr );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldvl_ = (lapack_int) ldvl;
+    lapack_int ldvr_ = (lapack_int) ldvr;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    double* rwork = workspace.take< double >( 2*n );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zgeev(
         &jobvl_, &jobvr_, &n_,
@@ -358,8 +637,8 @@ int64_t geev(
         (lapack_complex_double*) W,
         (lapack_complex_double*) VL, &ldvl_,
         (lapack_complex_double*) VR, &ldvr_,
-        (lapack_complex_double*) &work[0], &lwork_,
-        &rwork[0], &info_
+        (lapack_complex_double*) work, &lwork_,
+        rwork, &info_
     );
     if (info_ < 0) {
         throw Error();
@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -22,44 +25,13 @@ int64_t gehrd(
     float* A, int64_t lda,
     float* tau )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ilo_ = (lapack_int) ilo;
-    lapack_int ihi_ = (lapack_int) ihi;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    float qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_sgehrd(
-        &n_, &ilo_, &ihi_,
-        A, &lda_,
-        tau,
-        qry_work, &ineg_one, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gehrd_work_size_bytes( n, ilo, ihi, A, lda, tau, &work_size );
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_sgehrd(
-        &n_, &ilo_, &ihi_,
-        A, &lda_,
-        tau,
-        &work[0], &lwork_, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gehrd( n, ilo, ihi, A, lda, tau, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -69,44 +41,13 @@ int64_t gehrd(
     double* A, int64_t lda,
     double* tau )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ilo_ = (lapack_int) ilo;
-    lapack_int ihi_ = (lapack_int) ihi;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    double qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dgehrd(
-        &n_, &ilo_, &ihi_,
-        A, &lda_,
-        tau,
-        qry_work, &ineg_one, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gehrd_work_size_bytes( n, ilo, ihi, A, lda, tau, &work_size );
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_dgehrd(
-        &n_, &ilo_, &ihi_,
-        A, &lda_,
-        tau,
-        &work[0], &lwork_, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gehrd( n, ilo, ihi, A, lda, tau, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -116,44 +57,13 @@ int64_t gehrd(
     std::complex<float>* A, int64_t lda,
     std::complex<float>* tau )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int n_ = (lapack_int) n;
-    lapack_int ilo_ = (lapack_int) ilo;
-    lapack_int ihi_ = (lapack_int) ihi;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cgehrd(
-        &n_, &ilo_, &ihi_,
-        (lapack_complex_float*) A, &lda_,
-        (lapack_complex_float*) tau,
-        (lapack_complex_float*) qry_work, &ineg_one, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gehrd_work_size_bytes( n, ilo, ihi, A, lda, tau, &work_size );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_cgehrd(
-        &n_, &ilo_, &ihi_,
-        (lapack_complex_float*) A, &lda_,
-        (lapack_complex_float*) tau,
-        (lapack_complex_float*) &work[0], &lwork_, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gehrd( n, ilo, ihi, A, lda, tau, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -239,6 +149,66 @@ int64_t gehrd(
     int64_t n, int64_t ilo, int64_t ihi,
     std::complex<double>* A, int64_t lda,
     std::complex<double>* tau )
+{
+    size_t work_size;
+    gehrd_work_size_bytes( n, ilo, ihi, A, lda, tau, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gehrd( n, ilo, ihi, A, lda, tau, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev_computational
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* A, int64_t lda,
+    float* tau,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "sgehrd", { n_, ilo_, ihi_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    float qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_sgehrd(
+        &n_, &ilo_, &ihi_,
+        A, &lda_,
+        tau,
+        qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< float >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev_computational
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* A, int64_t lda,
+    double* tau,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -253,6 +223,111 @@ int64_t gehrd(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "dgehrd", { n_, ilo_, ihi_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dgehrd(
+        &n_, &ilo_, &ihi_,
+        A, &lda_,
+        tau,
+        qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< double >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev_computational
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "cgehrd", { n_, ilo_, ihi_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cgehrd(
+        &n_, &ilo_, &ihi_,
+        (lapack_complex_float*) A, &lda_,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< std::complex<float> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::gehrd`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::gehrd`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::gehrd`.
+///
+/// @ingroup geev_computational
+void gehrd_work_size_bytes(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "zgehrd", { n_, ilo_, ihi_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     std::complex<double> qry_work[1];
     lapack_int ineg_one = -1;
@@ -266,14 +341,185 @@ int64_t gehrd(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    *host_work_size = internal::workspace_bytes< std::complex<double> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev_computational
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    float* A, int64_t lda,
+    float* tau,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gehrd", 's', n, n, 0,
+                             Gflop< float >::gehrd( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_sgehrd(
+        &n_, &ilo_, &ihi_,
+        A, &lda_,
+        tau,
+        work, &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev_computational
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    double* A, int64_t lda,
+    double* tau,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gehrd", 'd', n, n, 0,
+                             Gflop< double >::gehrd( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
+
+    LAPACK_dgehrd(
+        &n_, &ilo_, &ihi_,
+        A, &lda_,
+        tau,
+        work, &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geev_computational
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gehrd", 'c', n, n, 0,
+                             Gflop< std::complex<float> >::gehrd( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_cgehrd(
+        &n_, &ilo_, &ihi_,
+        (lapack_complex_float*) A, &lda_,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) work, &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Reduces a general matrix A to upper Hessenberg form H,
+/// $Q^H A Q = H$,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::gehrd` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in,out] n, ilo, ihi, A, lda, tau
+///     As for `lapack::gehrd` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::gehrd_work_size_bytes`.
+///
+/// @return = 0: successful exit
+///
+/// @ingroup geev_computational
+int64_t gehrd(
+    int64_t n, int64_t ilo, int64_t ihi,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gehrd", 'z', n, n, 0,
+                             Gflop< std::complex<double> >::gehrd( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ilo) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ihi) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ilo_ = (lapack_int) ilo;
+    lapack_int ihi_ = (lapack_int) ihi;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zgehrd(
         &n_, &ilo_, &ihi_,
         (lapack_complex_double*) A, &lda_,
         (lapack_complex_double*) tau,
-        (lapack_complex_double*) &work[0], &lwork_, &info_ );
+        (lapack_complex_double*) work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -21,6 +24,120 @@ int64_t gelqf(
     int64_t m, int64_t n,
     float* A, int64_t lda,
     float* tau )
+{
+    size_t work_size;
+    gelqf_work_size_bytes( m, n, A, lda, tau, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gelqf( m, n, A, lda, tau, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau )
+{
+    size_t work_size;
+    gelqf_work_size_bytes( m, n, A, lda, tau, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gelqf( m, n, A, lda, tau, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau )
+{
+    size_t work_size;
+    gelqf_work_size_bytes( m, n, A, lda, tau, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gelqf( m, n, A, lda, tau, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes an LQ factorization of an m-by-n matrix A:
+/// $A = L Q$.
+///
+/// This is the blocked Level 3 BLAS version of the algorithm.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On entry, the m-by-n matrix A.
+///     On exit, the elements on and below the diagonal of the array
+///     contain the m-by-min(m,n) lower trapezoidal matrix L (L is
+///     lower triangular if m <= n). The elements above the diagonal,
+///     with the array tau, represent the unitary matrix Q as a
+///     product of elementary reflectors (see Further Details).
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] tau
+///     The vector tau of length min(m,n).
+///     The scalar factors of the elementary reflectors (see Further
+///     Details).
+///
+/// @return = 0: successful exit
+///
+// -----------------------------------------------------------------------------
+/// @par Further Details
+///
+/// The matrix Q is represented as a product of elementary reflectors
+/// \[
+///     Q = H(k)^H \dots H(2)^H H(1)^H, \text{ where } k = \min(m,n).
+/// \]
+///
+/// Each H(i) has the form
+/// \[
+///     H(i) = I - \tau v v^H
+/// \]
+/// where $\tau$ is a scalar, and v is a vector with
+/// v(1:i-1) = 0 and v(i) = 1; conj(v(i+1:n)) is stored on exit in
+/// A(i,i+1:n), and $\tau$ in tau(i).
+///
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau )
+{
+    size_t work_size;
+    gelqf_work_size_bytes( m, n, A, lda, tau, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gelqf( m, n, A, lda, tau, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -33,6 +150,11 @@ int64_t gelqf(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "sgelqf", { m_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     float qry_work[1];
     lapack_int ineg_one = -1;
@@ -46,26 +168,58 @@ int64_t gelqf(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    *host_work_size = internal::workspace_bytes< float >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
 
-    LAPACK_sgelqf(
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "dgelqf", { m_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dgelqf(
         &m_, &n_,
         A, &lda_,
         tau,
-        &work[0], &lwork_, &info_ );
+        qry_work, &ineg_one, &info_ );
     if (info_ < 0) {
         throw Error();
     }
-    return info_;
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< double >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
 }
 
 // -----------------------------------------------------------------------------
 /// @ingroup gelqf
-int64_t gelqf(
+void gelqf_work_size_bytes(
     int64_t m, int64_t n,
-    double* A, int64_t lda,
-    double* tau )
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -78,27 +232,115 @@ int64_t gelqf(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "cgelqf", { m_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
-    double qry_work[1];
+    std::complex<float> qry_work[1];
     lapack_int ineg_one = -1;
-    LAPACK_dgelqf(
+    LAPACK_cgelqf(
         &m_, &n_,
-        A, &lda_,
-        tau,
-        qry_work, &ineg_one, &info_ );
+        (lapack_complex_float*) A, &lda_,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) qry_work, &ineg_one, &info_ );
     if (info_ < 0) {
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    *host_work_size = internal::workspace_bytes< std::complex<float> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
 
-    LAPACK_dgelqf(
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::gelqf`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::gelqf`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::gelqf`.
+///
+/// @ingroup gelqf
+void gelqf_work_size_bytes(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "zgelqf", { m_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<double> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_zgelqf(
+        &m_, &n_,
+        (lapack_complex_double*) A, &lda_,
+        (lapack_complex_double*) tau,
+        (lapack_complex_double*) qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< std::complex<double> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gelqf", 's', m, n, 0,
+                             Gflop< float >::gelqf( m, n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_sgelqf(
         &m_, &n_,
         A, &lda_,
         tau,
-        &work[0], &lwork_, &info_ );
+        work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
@@ -109,9 +351,13 @@ int64_t gelqf(
 /// @ingroup gelqf
 int64_t gelqf(
     int64_t m, int64_t n,
-    std::complex<float>* A, int64_t lda,
-    std::complex<float>* tau )
+    double* A, int64_t lda,
+    double* tau,
+    void* host_work, size_t host_work_size )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gelqf", 'd', m, n, 0,
+                             Gflop< double >::gelqf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -123,27 +369,54 @@ int64_t gelqf(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cgelqf(
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
+
+    LAPACK_dgelqf(
         &m_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        (lapack_complex_float*) tau,
-        (lapack_complex_float*) qry_work, &ineg_one, &info_ );
+        A, &lda_,
+        tau,
+        work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    return info_;
+}
 
-    // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gelqf", 'c', m, n, 0,
+                             Gflop< std::complex<float> >::gelqf( m, n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
 
     LAPACK_cgelqf(
         &m_, &n_,
         (lapack_complex_float*) A, &lda_,
         (lapack_complex_float*) tau,
-        (lapack_complex_float*) &work[0], &lwork_, &info_ );
+        (lapack_complex_float*) work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
@@ -151,61 +424,36 @@ int64_t gelqf(
 }
 
 // -----------------------------------------------------------------------------
-/// Computes an LQ factorization of an m-by-n matrix A:
-/// $A = L Q$.
-///
-/// This is the blocked Level 3 BLAS version of the algorithm.
+/// Computes an LQ factorization of an m-by-n matrix A, $A = L Q$,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::gelqf` without workspace.
 ///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
 ///
-/// @param[in] m
-///     The number of rows of the matrix A. m >= 0.
+/// @param[in,out] m, n, A, lda, tau
+///     As for `lapack::gelqf` without workspace.
 ///
-/// @param[in] n
-///     The number of columns of the matrix A. n >= 0.
-///
-/// @param[in,out] A
-///     The m-by-n matrix A, stored in an lda-by-n array.
-///     On entry, the m-by-n matrix A.
-///     On exit, the elements on and below the diagonal of the array
-///     contain the m-by-min(m,n) lower trapezoidal matrix L (L is
-///     lower triangular if m <= n). The elements above the diagonal,
-///     with the array tau, represent the unitary matrix Q as a
-///     product of elementary reflectors (see Further Details).
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
 ///
-/// @param[in] lda
-///     The leading dimension of the array A. lda >= max(1,m).
-///
-/// @param[out] tau
-///     The vector tau of length min(m,n).
-///     The scalar factors of the elementary reflectors (see Further
-///     Details).
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::gelqf_work_size_bytes`.
 ///
 /// @return = 0: successful exit
 ///
-// -----------------------------------------------------------------------------
-/// @par Further Details
-///
-/// The matrix Q is represented as a product of elementary reflectors
-/// \[
-///     Q = H(k)^H \dots H(2)^H H(1)^H, \text{ where } k = \min(m,n).
-/// \]
-///
-/// Each H(i) has the form
-/// \[
-///     H(i) = I - \tau v v^H
-/// \]
-/// where $\tau$ is a scalar, and v is a vector with
-/// v(1:i-1) = 0 and v(i) = 1; conj(v(i+1:n)) is stored on exit in
-/// A(i,i+1:n), and $\tau$ in tau(i).
-///
 /// @ingroup gelqf
 int64_t gelqf(
     int64_t m, int64_t n,
     std::complex<double>* A, int64_t lda,
-    std::complex<double>* tau )
+    std::complex<double>* tau,
+    void* host_work, size_t host_work_size )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gelqf", 'z', m, n, 0,
+                             Gflop< std::complex<double> >::gelqf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -217,27 +465,16 @@ int64_t gelqf(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    std::complex<double> qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_zgelqf(
-        &m_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        (lapack_complex_double*) tau,
-        (lapack_complex_double*) qry_work, &ineg_one, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
-
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zgelqf(
         &m_, &n_,
         (lapack_complex_double*) A, &lda_,
         (lapack_complex_double*) tau,
-        (lapack_complex_double*) &work[0], &lwork_, &info_ );
+        (lapack_complex_double*) work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
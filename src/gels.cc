@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -21,6 +24,161 @@ int64_t gels(
     lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
     float* A, int64_t lda,
     float* B, int64_t ldb )
+{
+    size_t work_size;
+    gels_work_size_bytes( trans, m, n, nrhs, A, lda, B, ldb, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gels( trans, m, n, nrhs, A, lda, B, ldb, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb )
+{
+    size_t work_size;
+    gels_work_size_bytes( trans, m, n, nrhs, A, lda, B, ldb, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gels( trans, m, n, nrhs, A, lda, B, ldb, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb )
+{
+    size_t work_size;
+    gels_work_size_bytes( trans, m, n, nrhs, A, lda, B, ldb, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gels( trans, m, n, nrhs, A, lda, B, ldb, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Solves overdetermined or underdetermined complex linear systems
+/// involving an m-by-n matrix A, or its conjugate-transpose, using a QR
+/// or LQ factorization of A. It is assumed that A has full rank.
+///
+/// The following options are provided:
+///
+/// 1. If trans = NoTrans and m >= n: find the least squares solution of
+///     an overdetermined system, i.e., solve the least squares problem
+///     minimize $|| B - A X ||_2$.
+///
+/// 2. If trans = NoTrans and m < n: find the minimum norm solution of
+///     an underdetermined system $A X = B$.
+///
+/// 3. If trans = ConjTrans and m >= n: find the minimum norm solution of
+///     an underdetermined system $A^H X = B$.
+///
+/// 4. If trans = ConjTrans and m < n: find the least squares solution of
+///     an overdetermined system, i.e., solve the least squares problem
+///     minimize $|| B - A^H X ||_2$.
+///
+/// Several right hand side vectors b and solution vectors x can be
+/// handled in a single call; they are stored as the columns of the
+/// m-by-nrhs right hand side matrix B and the n-by-nrhs solution
+/// matrix X.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] trans
+///     - lapack::Op::NoTrans:   the linear system involves $A$;
+///     - lapack::Op::ConjTrans: the linear system involves $A^H$.
+///     - lapack::Op::Trans:     the linear system involves $A^T$.
+///     \n
+///     For real matrices, Trans = ConjTrans.
+///     For complex matrices, Trans is illegal.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in] nrhs
+///     The number of right hand sides, i.e., the number of
+///     columns of the matrices B and X. nrhs >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On entry, the m-by-n matrix A.
+///     - If m >= n, A is overwritten by details of its QR
+///     factorization as returned by `lapack::geqrf`;
+///
+///     - If m < n, A is overwritten by details of its LQ
+///     factorization as returned by `lapack::gelqf`.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[in,out] B
+///     The max(m,n)-by-nrhs matrix B, stored in an ldb-by-nrhs array.
+///     On entry, the matrix B of right hand side vectors, stored
+///     columnwise; B is m-by-nrhs if trans = NoTrans, or n-by-nrhs
+///     if trans = ConjTrans.
+///     On successful exit, B is overwritten by the solution
+///     vectors, stored columnwise:
+///     - If trans = NoTrans and m >= n, rows 1 to n of B contain the least
+///     squares solution vectors; the residual sum of squares for the
+///     solution in each column is given by the sum of squares of the
+///     modulus of elements n+1 to m in that column;
+///
+///     - If trans = NoTrans and m < n, rows 1 to n of B contain the
+///     minimum norm solution vectors;
+///
+///     - If trans = ConjTrans and m >= n, rows 1 to m of B contain the
+///     minimum norm solution vectors;
+///
+///     - If trans = ConjTrans and m < n, rows 1 to m of B contain the
+///     least squares solution vectors; the residual sum of squares
+///     for the solution in each column is given by the sum of
+///     squares of the modulus of elements m+1 to n in that column.
+///
+/// @param[in] ldb
+///     The leading dimension of the array B. ldb >= max(1,m,n).
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, the i-th diagonal element of the
+///     triangular factor of A is zero, so that A does not have
+///     full rank; the least squares solution could not be
+///     computed.
+///
+/// @ingroup gels
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb )
+{
+    size_t work_size;
+    gels_work_size_bytes( trans, m, n, nrhs, A, lda, B, ldb, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gels( trans, m, n, nrhs, A, lda, B, ldb, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    size_t* host_work_size )
 {
     // for real, map ConjTrans to Trans
     if (trans == Op::ConjTrans)
@@ -42,6 +200,11 @@ int64_t gels(
     lapack_int ldb_ = (lapack_int) ldb;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "sgels", { trans_, m_, n_, nrhs_, lda_, ldb_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     float qry_work[1];
     lapack_int ineg_one = -1;
@@ -56,27 +219,17 @@ int64_t gels(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
-
-    LAPACK_sgels(
-        &trans_, &m_, &n_, &nrhs_,
-        A, &lda_,
-        B, &ldb_,
-        &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    *host_work_size = internal::workspace_bytes< float >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
 }
 
 // -----------------------------------------------------------------------------
 /// @ingroup gels
-int64_t gels(
+void gels_work_size_bytes(
     lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
     double* A, int64_t lda,
-    double* B, int64_t ldb )
+    double* B, int64_t ldb,
+    size_t* host_work_size )
 {
     // for real, map ConjTrans to Trans
     if (trans == Op::ConjTrans)
@@ -98,6 +251,11 @@ int64_t gels(
     lapack_int ldb_ = (lapack_int) ldb;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "dgels", { trans_, m_, n_, nrhs_, lda_, ldb_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     double qry_work[1];
     lapack_int ineg_one = -1;
@@ -112,14 +270,159 @@ int64_t gels(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    *host_work_size = internal::workspace_bytes< double >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
 
-    LAPACK_dgels(
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "cgels", { trans_, m_, n_, nrhs_, lda_, ldb_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cgels(
+        &trans_, &m_, &n_, &nrhs_,
+        (lapack_complex_float*) A, &lda_,
+        (lapack_complex_float*) B, &ldb_,
+        (lapack_complex_float*) qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< std::complex<float> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::gels`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::gels`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::gels`.
+///
+/// @ingroup gels
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "zgels", { trans_, m_, n_, nrhs_, lda_, ldb_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<double> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_zgels(
+        &trans_, &m_, &n_, &nrhs_,
+        (lapack_complex_double*) A, &lda_,
+        (lapack_complex_double*) B, &ldb_,
+        (lapack_complex_double*) qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< std::complex<double> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gels", 's', m, n, nrhs,
+                             Gflop< float >::gels( m, n, nrhs ) );
+
+    // for real, map ConjTrans to Trans
+    if (trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_sgels(
         &trans_, &m_, &n_, &nrhs_,
         A, &lda_,
         B, &ldb_,
-        &work[0], &lwork_, &info_
+        work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
@@ -131,9 +434,17 @@ int64_t gels(
 /// @ingroup gels
 int64_t gels(
     lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
-    std::complex<float>* A, int64_t lda,
-    std::complex<float>* B, int64_t ldb )
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    void* host_work, size_t host_work_size )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gels", 'd', m, n, nrhs,
+                             Gflop< double >::gels( m, n, nrhs ) );
+
+    // for real, map ConjTrans to Trans
+    if (trans == Op::ConjTrans)
+        trans = Op::Trans;
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -150,28 +461,60 @@ int64_t gels(
     lapack_int ldb_ = (lapack_int) ldb;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cgels(
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
+
+    LAPACK_dgels(
         &trans_, &m_, &n_, &nrhs_,
-        (lapack_complex_float*) A, &lda_,
-        (lapack_complex_float*) B, &ldb_,
-        (lapack_complex_float*) qry_work, &ineg_one, &info_
+        A, &lda_,
+        B, &ldb_,
+        work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    return info_;
+}
 
-    // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+int64_t gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gels", 'c', m, n, nrhs,
+                             Gflop< std::complex<float> >::gels( m, n, nrhs ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
 
     LAPACK_cgels(
         &trans_, &m_, &n_, &nrhs_,
         (lapack_complex_float*) A, &lda_,
         (lapack_complex_float*) B, &ldb_,
-        (lapack_complex_float*) &work[0], &lwork_, &info_
+        (lapack_complex_float*) work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
@@ -180,89 +523,24 @@ int64_t gels(
 }
 
 // -----------------------------------------------------------------------------
-/// Solves overdetermined or underdetermined complex linear systems
-/// involving an m-by-n matrix A, or its conjugate-transpose, using a QR
-/// or LQ factorization of A. It is assumed that A has full rank.
-///
-/// The following options are provided:
-///
-/// 1. If trans = NoTrans and m >= n: find the least squares solution of
-///     an overdetermined system, i.e., solve the least squares problem
-///     minimize $|| B - A X ||_2$.
-///
-/// 2. If trans = NoTrans and m < n: find the minimum norm solution of
-///     an underdetermined system $A X = B$.
-///
-/// 3. If trans = ConjTrans and m >= n: find the minimum norm solution of
-///     an underdetermined system $A^H X = B$.
-///
-/// 4. If trans = ConjTrans and m < n: find the least squares solution of
-///     an overdetermined system, i.e., solve the least squares problem
-///     minimize $|| B - A^H X ||_2$.
-///
-/// Several right hand side vectors b and solution vectors x can be
-/// handled in a single call; they are stored as the columns of the
-/// m-by-nrhs right hand side matrix B and the n-by-nrhs solution
-/// matrix X.
+/// Solves overdetermined or underdetermined systems $op(A) X = B$
+/// in the least squares sense,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::gels` without workspace.
 ///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
 ///
-/// @param[in] trans
-///     - lapack::Op::NoTrans:   the linear system involves $A$;
-///     - lapack::Op::ConjTrans: the linear system involves $A^H$.
-///     - lapack::Op::Trans:     the linear system involves $A^T$.
-///     \n
-///     For real matrices, Trans = ConjTrans.
-///     For complex matrices, Trans is illegal.
+/// @param[in,out] trans, m, n, nrhs, A, lda, B, ldb
+///     As for `lapack::gels` without workspace.
 ///
-/// @param[in] m
-///     The number of rows of the matrix A. m >= 0.
-///
-/// @param[in] n
-///     The number of columns of the matrix A. n >= 0.
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
 ///
-/// @param[in] nrhs
-///     The number of right hand sides, i.e., the number of
-///     columns of the matrices B and X. nrhs >= 0.
-///
-/// @param[in,out] A
-///     The m-by-n matrix A, stored in an lda-by-n array.
-///     On entry, the m-by-n matrix A.
-///     - If m >= n, A is overwritten by details of its QR
-///     factorization as returned by `lapack::geqrf`;
-///
-///     - If m < n, A is overwritten by details of its LQ
-///     factorization as returned by `lapack::gelqf`.
-///
-/// @param[in] lda
-///     The leading dimension of the array A. lda >= max(1,m).
-///
-/// @param[in,out] B
-///     The max(m,n)-by-nrhs matrix B, stored in an ldb-by-nrhs array.
-///     On entry, the matrix B of right hand side vectors, stored
-///     columnwise; B is m-by-nrhs if trans = NoTrans, or n-by-nrhs
-///     if trans = ConjTrans.
-///     On successful exit, B is overwritten by the solution
-///     vectors, stored columnwise:
-///     - If trans = NoTrans and m >= n, rows 1 to n of B contain the least
-///     squares solution vectors; the residual sum of squares for the
-///     solution in each column is given by the sum of squares of the
-///     modulus of elements n+1 to m in that column;
-///
-///     - If trans = NoTrans and m < n, rows 1 to n of B contain the
-///     minimum norm solution vectors;
-///
-///     - If trans = ConjTrans and m >= n, rows 1 to m of B contain the
-///     minimum norm solution vectors;
-///
-///     - If trans = ConjTrans and m < n, rows 1 to m of B contain the
-///     least squares solution vectors; the residual sum of squares
-///     for the solution in each column is given by the sum of
-///     squares of the modulus of elements m+1 to n in that column.
-///
-/// @param[in] ldb
-///     The leading dimension of the array B. ldb >= max(1,m,n).
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::gels_work_size_bytes`.
 ///
 /// @return = 0: successful exit
 /// @return > 0: if return value = i, the i-th diagonal element of the
@@ -274,8 +552,12 @@ int64_t gels(
 int64_t gels(
     lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
     std::complex<double>* A, int64_t lda,
-    std::complex<double>* B, int64_t ldb )
+    std::complex<double>* B, int64_t ldb,
+    void* host_work, size_t host_work_size )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gels", 'z', m, n, nrhs,
+                             Gflop< std::complex<double> >::gels( m, n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -292,28 +574,16 @@ int64_t gels(
     lapack_int ldb_ = (lapack_int) ldb;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    std::complex<double> qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_zgels(
-        &trans_, &m_, &n_, &nrhs_,
-        (lapack_complex_double*) A, &lda_,
-        (lapack_complex_double*) B, &ldb_,
-        (lapack_complex_double*) qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
-
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zgels(
         &trans_, &m_, &n_, &nrhs_,
         (lapack_complex_double*) A, &lda_,
         (lapack_complex_double*) B, &ldb_,
-        (lapack_complex_double*) &work[0], &lwork_, &info_
+        (lapack_complex_double*) work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
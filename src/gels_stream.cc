@@ -0,0 +1,226 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/ooc.hh"
+#include "NoConstructAllocator.hh"
+#include "ooc.hh"
+
+#include <cstring>
+#include <future>
+#include <memory>
+#include <vector>
+
+#if LAPACK_VERSION >= 30400  // >= 3.4
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Copies rows i, ..., i + mb - 1 of the m-by-n matrix in file to A,
+/// then releases the pages read.
+template <typename scalar_t>
+void copy_mapped_rows(
+    internal::MappedFile& file, blas::Layout layout,
+    int64_t m, int64_t n, int64_t i, int64_t mb,
+    scalar_t* A, int64_t lda )
+{
+    const size_t size = sizeof( scalar_t );
+    scalar_t const* data = reinterpret_cast< scalar_t const* >( file.data() );
+    if (layout == blas::Layout::ColMajor) {
+        for (int64_t j = 0; j < n; ++j) {
+            std::memcpy( &A[ j*lda ], &data[ i + j*m ], mb * size );
+            file.release( (i + j*m) * size, (i + mb + j*m) * size );
+        }
+    }
+    else {
+        for (int64_t ii = 0; ii < mb; ++ii) {
+            scalar_t const* row = &data[ (i + ii)*n ];
+            for (int64_t j = 0; j < n; ++j)
+                A[ ii + j*lda ] = row[ j ];
+        }
+        file.release( i*n * size, (i + mb)*n * size );
+    }
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+RowBlockReader< scalar_t > mmap_row_reader(
+    blas::Layout layout, int64_t m, int64_t n, int64_t nrhs,
+    std::string const& path_A, std::string const& path_B )
+{
+    lapack_error_if( layout != blas::Layout::ColMajor
+                     && layout != blas::Layout::RowMajor );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+
+    const size_t size = sizeof( scalar_t );
+    auto file_A = std::make_shared< internal::MappedFile >(
+        path_A, m*n * size, false );
+    file_A->advise_sequential( 0, file_A->size() );
+
+    std::shared_ptr< internal::MappedFile > file_B;
+    if (nrhs > 0) {
+        file_B = std::make_shared< internal::MappedFile >(
+            path_B, m*nrhs * size, false );
+        file_B->advise_sequential( 0, file_B->size() );
+    }
+
+    return [=]( int64_t i, int64_t mb,
+                scalar_t* A, int64_t lda,
+                scalar_t* B, int64_t ldb ) -> int64_t
+    {
+        int64_t rows = max( 0, min( mb, m - i ) );
+        if (rows > 0) {
+            copy_mapped_rows( *file_A, layout, m, n, i, rows, A, lda );
+            if (nrhs > 0)
+                copy_mapped_rows( *file_B, layout, m, nrhs, i, rows, B, ldb );
+        }
+        return rows;
+    };
+}
+
+//------------------------------------------------------------------------------
+/// Double buffered: while block k is folded into R on this thread, which
+/// keeps the BLAS threads, block k+1 is read on another thread.
+template <typename scalar_t>
+int64_t gels_stream(
+    int64_t n, int64_t nrhs,
+    RowBlockReader< scalar_t > const& read,
+    scalar_t* R, int64_t ldr,
+    scalar_t* X, int64_t ldx,
+    blas::real_type< scalar_t >* resid,
+    int64_t mb )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0.0;
+
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( ! read );
+    lapack_error_if( ldr < max( 1, n ) );
+    lapack_error_if( nrhs > 0 && ldx < max( 1, n ) );
+    lapack_error_if( mb < 0 );
+
+    if (mb == 0)
+        mb = (int64_t( 1 ) << 20) / max( 1, n + nrhs );
+    mb = max( mb, max( 1, n ) );
+    int64_t ib = max( 1, min( n, 32 ) );
+    int64_t ldd = max( 1, n );
+
+    // R = 0, D = Q^H B = 0, residual sums of squares = 0.
+    laset( MatrixType::General, n, n, zero, zero, R, ldr );
+    std::vector< scalar_t > D( ldd * nrhs, zero );
+    std::vector< real_t > scale( nrhs, 0 ), sumsq( nrhs, 1 );
+    lapack::vector< scalar_t > T( ib * n );
+
+    // Two row blocks, each [ A_k, B_k ] with leading dimension mb.
+    lapack::vector< scalar_t > buffer( 2 * mb * (n + nrhs) );
+    scalar_t* A_buf[ 2 ] = { &buffer[ 0 ], &buffer[ mb * (n + nrhs) ] };
+    scalar_t* B_buf[ 2 ] = { A_buf[ 0 ] + mb*n, A_buf[ 1 ] + mb*n };
+
+    auto fetch = [&]( int k, int64_t i ) -> int64_t {
+        int64_t rows = read( i, mb, A_buf[ k ], mb,
+                             (nrhs > 0 ? B_buf[ k ] : nullptr), mb );
+        lapack_error_if( rows < 0 || rows > mb );
+        return rows;
+    };
+
+    int64_t i = 0;
+    int k = 0;
+    int64_t rows = fetch( k, i );
+    while (rows > 0) {
+        std::future< int64_t > next
+            = std::async( std::launch::async, fetch, 1 - k, i + rows );
+
+        // [ R; A_k ] = Q_k [ R; 0 ], then [ D; B_k ] = Q_k^H [ D; B_k ].
+        // B_k is then the residual of these rows.
+        if (n > 0) {
+            tpqrt( rows, n, 0, ib, R, ldr, A_buf[ k ], mb, &T[ 0 ], ib );
+            if (nrhs > 0) {
+                tpmqrt( Side::Left, Op::ConjTrans, rows, nrhs, n, 0, ib,
+                        A_buf[ k ], mb, &T[ 0 ], ib,
+                        D.data(), ldd, B_buf[ k ], mb );
+            }
+        }
+        for (int64_t j = 0; j < nrhs; ++j)
+            lassq( rows, &B_buf[ k ][ j*mb ], 1, &scale[ j ], &sumsq[ j ] );
+
+        i += rows;
+        rows = next.get();
+        k = 1 - k;
+    }
+
+    if (resid) {
+        for (int64_t j = 0; j < nrhs; ++j)
+            resid[ j ] = scale[ j ] * sqrt( sumsq[ j ] );
+    }
+
+    // X = R^{-1} D, unless R is singular.
+    for (int64_t j = 0; j < n; ++j) {
+        if (R[ j + j*ldr ] == zero)
+            return j + 1;
+    }
+    if (nrhs > 0) {
+        lacpy( MatrixType::General, n, nrhs, D.data(), ldd, X, ldx );
+        trtrs( Uplo::Upper, Op::NoTrans, Diag::NonUnit, n, nrhs,
+               R, ldr, X, ldx );
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t geqr_stream(
+    int64_t n,
+    RowBlockReader< scalar_t > const& read,
+    scalar_t* R, int64_t ldr,
+    int64_t mb )
+{
+    gels_stream< scalar_t >( n, 0, read, R, ldr, nullptr, 1, nullptr, mb );
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_STREAM_INSTANTIATE( scalar_t ) \
+    template \
+    RowBlockReader< scalar_t > mmap_row_reader< scalar_t >( \
+        blas::Layout layout, int64_t m, int64_t n, int64_t nrhs, \
+        std::string const& path_A, std::string const& path_B ); \
+    \
+    template \
+    int64_t gels_stream< scalar_t >( \
+        int64_t n, int64_t nrhs, \
+        RowBlockReader< scalar_t > const& read, \
+        scalar_t* R, int64_t ldr, \
+        scalar_t* X, int64_t ldx, \
+        blas::real_type< scalar_t >* resid, \
+        int64_t mb ); \
+    \
+    template \
+    int64_t geqr_stream< scalar_t >( \
+        int64_t n, \
+        RowBlockReader< scalar_t > const& read, \
+        scalar_t* R, int64_t ldr, \
+        int64_t mb );
+
+LAPACK_STREAM_INSTANTIATE( float )
+LAPACK_STREAM_INSTANTIATE( double )
+LAPACK_STREAM_INSTANTIATE( std::complex<float> )
+LAPACK_STREAM_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_STREAM_INSTANTIATE
+
+}  // namespace lapack
+
+#endif  // LAPACK >= 3.4
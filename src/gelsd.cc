@@ -6,7 +6,11 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
+#include <cmath>
+#include <cstring>
 #include <vector>
 
 namespace lapack {
@@ -15,6 +19,39 @@ using blas::max;
 using blas::min;
 using blas::real;
 
+// -----------------------------------------------------------------------------
+/// Computes sizes of the iwork and, for complex, rwork arrays of ?gelsd,
+/// using the formulas in LAPACK's ?gelsd with SMLSIZ from ilaenv, so the
+/// workspace overloads can split the workspace without a workspace query.
+/// name is the upper-case routine name passed to ilaenv, e.g., "DGELSD".
+static void gelsd_iwork_sizes(
+    char const* name, int64_t m, int64_t n, int64_t nrhs,
+    int64_t* liwork, int64_t* lrwork )
+{
+    lapack_int ispec = 9;
+    lapack_int izero = 0;
+    int64_t smlsiz = LAPACK_ilaenv_base(
+        &ispec, name, " ", &izero, &izero, &izero, &izero
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , strlen( name ), 1
+        #endif
+        );
+
+    // One level more than LAPACK's nlvl, in case its log, in single
+    // precision for s and c, rounds differently at a power of 2.
+    int64_t minmn = min( m, n );
+    int64_t nlvl = 1;
+    if (minmn > 0) {
+        nlvl = max( 0, int64_t( std::log( double( minmn ) / double( smlsiz + 1 ) )
+                                / std::log( 2.0 ) ) + 1 ) + 1;
+    }
+    *liwork = max( 1, 3*minmn*nlvl + 11*minmn );
+    *lrwork = max( 1, 10*minmn + 2*minmn*smlsiz + 8*minmn*nlvl
+                      + 3*smlsiz*nrhs
+                      + max( (smlsiz + 1)*(smlsiz + 1),
+                             max( m, n )*(1 + nrhs) + 2*nrhs ) );
+}
+
 // -----------------------------------------------------------------------------
 /// @ingroup gels
 int64_t gelsd(
@@ -23,6 +60,160 @@ int64_t gelsd(
     float* B, int64_t ldb,
     float* S, float rcond,
     int64_t* rank )
+{
+    size_t work_size;
+    gelsd_work_size_bytes( m, n, nrhs, A, lda, B, ldb, S, rcond, rank, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gelsd( m, n, nrhs, A, lda, B, ldb, S, rcond, rank, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank )
+{
+    size_t work_size;
+    gelsd_work_size_bytes( m, n, nrhs, A, lda, B, ldb, S, rcond, rank, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gelsd( m, n, nrhs, A, lda, B, ldb, S, rcond, rank, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank )
+{
+    size_t work_size;
+    gelsd_work_size_bytes( m, n, nrhs, A, lda, B, ldb, S, rcond, rank, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gelsd( m, n, nrhs, A, lda, B, ldb, S, rcond, rank, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the minimum-norm solution to a real linear least
+/// squares problem:
+///     minimize $|| b - A x ||_2$
+/// using the singular value decomposition (SVD) of A. A is an m-by-n
+/// matrix which may be rank-deficient.
+///
+/// Several right hand side vectors b and solution vectors x can be
+/// handled in a single call; they are stored as the columns of the
+/// m-by-nrhs right hand side matrix B and the n-by-nrhs solution
+/// matrix X.
+///
+/// The problem is solved in three steps:
+/// (1) Reduce the coefficient matrix A to bidiagonal form with
+///     Householder transformations, reducing the original problem
+///     into a "bidiagonal least squares problem" (BLS)
+/// (2) Solve the BLS using a divide and conquer approach.
+/// (3) Apply back all the Householder transformations to solve
+///     the original least squares problem.
+///
+/// The effective rank of A is determined by treating as zero those
+/// singular values which are less than rcond times the largest singular
+/// value.
+///
+/// The divide and conquer algorithm makes very mild assumptions about
+/// floating point arithmetic. It will work on machines with a guard
+/// digit in add/subtract, or on those binary machines without guard
+/// digits which subtract like the Cray X-MP, Cray Y-MP, Cray C-90, or
+/// Cray-2. It could conceivably fail on hexadecimal or decimal machines
+/// without guard digits, but we know of none.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in] nrhs
+///     The number of right hand sides, i.e., the number of columns
+///     of the matrices B and X. nrhs >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On entry, the m-by-n matrix A.
+///     On exit, A has been destroyed.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[in,out] B
+///     The max(m,n)-by-nrhs matrix B or X, stored in an ldb-by-nrhs array.
+///     On entry, the m-by-nrhs right hand side matrix B.
+///     On exit, B is overwritten by the n-by-nrhs solution matrix X.
+///     If m >= n and rank = n, the residual sum-of-squares for
+///     the solution in the i-th column is given by the sum of
+///     squares of the modulus of elements n+1:m in that column.
+///
+/// @param[in] ldb
+///     The leading dimension of the array B. ldb >= max(1,m,n).
+///
+/// @param[out] S
+///     The vector S of length min(m,n).
+///     The singular values of A in decreasing order.
+///     The condition number of A in the 2-norm = S(1)/S(min(m,n)).
+///
+/// @param[in] rcond
+///     rcond is used to determine the effective rank of A.
+///     Singular values S(i) <= rcond*S(1) are treated as zero.
+///     If rcond < 0, machine precision is used instead.
+///
+/// @param[out] rank
+///     The effective rank of A, i.e., the number of singular values
+///     which are greater than rcond*S(1).
+///
+/// @return = 0: successful exit
+/// @return > 0: the algorithm for computing the SVD failed to converge;
+///     if return value = i, i off-diagonal elements of an intermediate
+///     bidiagonal form did not converge to zero.
+///
+/// @ingroup gels
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank )
+{
+    size_t work_size;
+    gelsd_work_size_bytes( m, n, nrhs, A, lda, B, ldb, S, rcond, rank, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gelsd( m, n, nrhs, A, lda, B, ldb, S, rcond, rank, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -37,9 +228,14 @@ int64_t gelsd(
     lapack_int nrhs_ = (lapack_int) nrhs;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int ldb_ = (lapack_int) ldb;
-    lapack_int rank_ = (lapack_int) *rank;
+    lapack_int rank_ = 0;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "sgelsd", { m_, n_, nrhs_, lda_, ldb_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     float qry_work[1];
     lapack_int qry_iwork[1];
@@ -55,34 +251,26 @@ int64_t gelsd(
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
-    lapack_int liwork_ = qry_iwork[0];
+    int64_t liwork_, lrwork_;
+    gelsd_iwork_sizes( "SGELSD", m, n, nrhs, &liwork_, &lrwork_ );
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
-
-    LAPACK_sgelsd(
-        &m_, &n_, &nrhs_,
-        A, &lda_,
-        B, &ldb_,
-        S, &rcond, &rank_,
-        &work[0], &lwork_,
-        &iwork[0], &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    *rank = rank_;
-    return info_;
+    // iwork, then work
+    size_t size = 0;
+    size += internal::workspace_bytes< lapack_int >( liwork_ );
+    size += internal::workspace_bytes< float >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
 }
 
 // -----------------------------------------------------------------------------
 /// @ingroup gels
-int64_t gelsd(
+void gelsd_work_size_bytes(
     int64_t m, int64_t n, int64_t nrhs,
     double* A, int64_t lda,
     double* B, int64_t ldb,
     double* S, double rcond,
-    int64_t* rank )
+    int64_t* rank,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -97,9 +285,14 @@ int64_t gelsd(
     lapack_int nrhs_ = (lapack_int) nrhs;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int ldb_ = (lapack_int) ldb;
-    lapack_int rank_ = (lapack_int) *rank;
+    lapack_int rank_ = 0;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "dgelsd", { m_, n_, nrhs_, lda_, ldb_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     double qry_work[1];
     lapack_int qry_iwork[1];
@@ -115,34 +308,26 @@ int64_t gelsd(
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
-    lapack_int liwork_ = qry_iwork[0];
+    int64_t liwork_, lrwork_;
+    gelsd_iwork_sizes( "DGELSD", m, n, nrhs, &liwork_, &lrwork_ );
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
-
-    LAPACK_dgelsd(
-        &m_, &n_, &nrhs_,
-        A, &lda_,
-        B, &ldb_,
-        S, &rcond, &rank_,
-        &work[0], &lwork_,
-        &iwork[0], &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    *rank = rank_;
-    return info_;
+    // iwork, then work
+    size_t size = 0;
+    size += internal::workspace_bytes< lapack_int >( liwork_ );
+    size += internal::workspace_bytes< double >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
 }
 
 // -----------------------------------------------------------------------------
 /// @ingroup gels
-int64_t gelsd(
+void gelsd_work_size_bytes(
     int64_t m, int64_t n, int64_t nrhs,
     std::complex<float>* A, int64_t lda,
     std::complex<float>* B, int64_t ldb,
     float* S, float rcond,
-    int64_t* rank )
+    int64_t* rank,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -157,9 +342,14 @@ int64_t gelsd(
     lapack_int nrhs_ = (lapack_int) nrhs;
     lapack_int lda_ = (lapack_int) lda;
     lapack_int ldb_ = (lapack_int) ldb;
-    lapack_int rank_ = (lapack_int) *rank;
+    lapack_int rank_ = 0;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "cgelsd", { m_, n_, nrhs_, lda_, ldb_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     std::complex<float> qry_work[1];
     float qry_rwork[1];
@@ -177,22 +367,237 @@ int64_t gelsd(
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = qry_rwork[0];
-    lapack_int liwork_ = qry_iwork[0];
+    int64_t liwork_, lrwork_;
+    gelsd_iwork_sizes( "CGELSD", m, n, nrhs, &liwork_, &lrwork_ );
 
-    // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    // iwork, rwork, then work
+    size_t size = 0;
+    size += internal::workspace_bytes< lapack_int >( liwork_ );
+    size += internal::workspace_bytes< float >( lrwork_ );
+    size += internal::workspace_bytes< std::complex<float> >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::gelsd`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::gelsd`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::gelsd`.
+///
+/// @ingroup gels
+void gelsd_work_size_bytes(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int rank_ = 0;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "zgelsd", { m_, n_, nrhs_, lda_, ldb_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<double> qry_work[1];
+    double qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_zgelsd(
+        &m_, &n_, &nrhs_,
+        (lapack_complex_double*) A, &lda_,
+        (lapack_complex_double*) B, &ldb_,
+        S, &rcond, &rank_,
+        (lapack_complex_double*) qry_work, &ineg_one,
+        qry_rwork,
+        qry_iwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+    int64_t liwork_, lrwork_;
+    gelsd_iwork_sizes( "ZGELSD", m, n, nrhs, &liwork_, &lrwork_ );
+
+    // iwork, rwork, then work
+    size_t size = 0;
+    size += internal::workspace_bytes< lapack_int >( liwork_ );
+    size += internal::workspace_bytes< double >( lrwork_ );
+    size += internal::workspace_bytes< std::complex<double> >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    float* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    void* host_work, size_t host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int rank_ = (lapack_int) *rank;
+    lapack_int info_ = 0;
+
+    // size of iwork, as in gelsd_work_size_bytes
+    int64_t liwork_, lrwork_;
+    gelsd_iwork_sizes( "SGELSD", m, n, nrhs, &liwork_, &lrwork_ );
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_sgelsd(
+        &m_, &n_, &nrhs_,
+        A, &lda_,
+        B, &ldb_,
+        S, &rcond, &rank_,
+        work, &lwork_,
+        iwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *rank = rank_;
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    double* B, int64_t ldb,
+    double* S, double rcond,
+    int64_t* rank,
+    void* host_work, size_t host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int rank_ = (lapack_int) *rank;
+    lapack_int info_ = 0;
+
+    // size of iwork, as in gelsd_work_size_bytes
+    int64_t liwork_, lrwork_;
+    gelsd_iwork_sizes( "DGELSD", m, n, nrhs, &liwork_, &lrwork_ );
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
+
+    LAPACK_dgelsd(
+        &m_, &n_, &nrhs_,
+        A, &lda_,
+        B, &ldb_,
+        S, &rcond, &rank_,
+        work, &lwork_,
+        iwork, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *rank = rank_;
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gels
+int64_t gelsd(
+    int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* B, int64_t ldb,
+    float* S, float rcond,
+    int64_t* rank,
+    void* host_work, size_t host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int rank_ = (lapack_int) *rank;
+    lapack_int info_ = 0;
+
+    // sizes of iwork and rwork, as in gelsd_work_size_bytes
+    int64_t liwork_, lrwork_;
+    gelsd_iwork_sizes( "CGELSD", m, n, nrhs, &liwork_, &lrwork_ );
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    float* rwork = workspace.take< float >( lrwork_ );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
 
     LAPACK_cgelsd(
         &m_, &n_, &nrhs_,
         (lapack_complex_float*) A, &lda_,
         (lapack_complex_float*) B, &ldb_,
         S, &rcond, &rank_,
-        (lapack_complex_float*) &work[0], &lwork_,
-        &rwork[0],
-        &iwork[0], &info_ );
+        (lapack_complex_float*) work, &lwork_,
+        rwork,
+        iwork, &info_ );
     if (info_ < 0) {
         throw Error();
     }
@@ -201,81 +606,24 @@ int64_t gelsd(
 }
 
 // -----------------------------------------------------------------------------
-/// Computes the minimum-norm solution to a real linear least
-/// squares problem:
-///     minimize $|| b - A x ||_2$
-/// using the singular value decomposition (SVD) of A. A is an m-by-n
-/// matrix which may be rank-deficient.
-///
-/// Several right hand side vectors b and solution vectors x can be
-/// handled in a single call; they are stored as the columns of the
-/// m-by-nrhs right hand side matrix B and the n-by-nrhs solution
-/// matrix X.
-///
-/// The problem is solved in three steps:
-/// (1) Reduce the coefficient matrix A to bidiagonal form with
-///     Householder transformations, reducing the original problem
-///     into a "bidiagonal least squares problem" (BLS)
-/// (2) Solve the BLS using a divide and conquer approach.
-/// (3) Apply back all the Householder transformations to solve
-///     the original least squares problem.
-///
-/// The effective rank of A is determined by treating as zero those
-/// singular values which are less than rcond times the largest singular
-/// value.
-///
-/// The divide and conquer algorithm makes very mild assumptions about
-/// floating point arithmetic. It will work on machines with a guard
-/// digit in add/subtract, or on those binary machines without guard
-/// digits which subtract like the Cray X-MP, Cray Y-MP, Cray C-90, or
-/// Cray-2. It could conceivably fail on hexadecimal or decimal machines
-/// without guard digits, but we know of none.
+/// Computes the minimum-norm solution to a linear least squares problem
+/// using the SVD of A,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::gelsd` without workspace.
 ///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
 ///
-/// @param[in] m
-///     The number of rows of the matrix A. m >= 0.
-///
-/// @param[in] n
-///     The number of columns of the matrix A. n >= 0.
-///
-/// @param[in] nrhs
-///     The number of right hand sides, i.e., the number of columns
-///     of the matrices B and X. nrhs >= 0.
-///
-/// @param[in,out] A
-///     The m-by-n matrix A, stored in an lda-by-n array.
-///     On entry, the m-by-n matrix A.
-///     On exit, A has been destroyed.
-///
-/// @param[in] lda
-///     The leading dimension of the array A. lda >= max(1,m).
-///
-/// @param[in,out] B
-///     The max(m,n)-by-nrhs matrix B or X, stored in an ldb-by-nrhs array.
-///     On entry, the m-by-nrhs right hand side matrix B.
-///     On exit, B is overwritten by the n-by-nrhs solution matrix X.
-///     If m >= n and rank = n, the residual sum-of-squares for
-///     the solution in the i-th column is given by the sum of
-///     squares of the modulus of elements n+1:m in that column.
-///
-/// @param[in] ldb
-///     The leading dimension of the array B. ldb >= max(1,m,n).
-///
-/// @param[out] S
-///     The vector S of length min(m,n).
-///     The singular values of A in decreasing order.
-///     The condition number of A in the 2-norm = S(1)/S(min(m,n)).
+/// @param[in,out] m, n, nrhs, A, lda, B, ldb, S, rcond, rank
+///     As for `lapack::gelsd` without workspace.
 ///
-/// @param[in] rcond
-///     rcond is used to determine the effective rank of A.
-///     Singular values S(i) <= rcond*S(1) are treated as zero.
-///     If rcond < 0, machine precision is used instead.
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
 ///
-/// @param[out] rank
-///     The effective rank of A, i.e., the number of singular values
-///     which are greater than rcond*S(1).
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::gelsd_work_size_bytes`.
 ///
 /// @return = 0: successful exit
 /// @return > 0: the algorithm for computing the SVD failed to converge;
@@ -288,7 +636,8 @@ int64_t gelsd(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* B, int64_t ldb,
     double* S, double rcond,
-    int64_t* rank )
+    int64_t* rank,
+    void* host_work, size_t host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -306,39 +655,25 @@ int64_t gelsd(
     lapack_int rank_ = (lapack_int) *rank;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    std::complex<double> qry_work[1];
-    double qry_rwork[1];
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_zgelsd(
-        &m_, &n_, &nrhs_,
-        (lapack_complex_double*) A, &lda_,
-        (lapack_complex_double*) B, &ldb_,
-        S, &rcond, &rank_,
-        (lapack_complex_double*) qry_work, &ineg_one,
-        qry_rwork,
-        qry_iwork, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = qry_rwork[0];
-    lapack_int liwork_ = qry_iwork[0];
+    // sizes of iwork and rwork, as in gelsd_work_size_bytes
+    int64_t liwork_, lrwork_;
+    gelsd_iwork_sizes( "ZGELSD", m, n, nrhs, &liwork_, &lrwork_ );
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    double* rwork = workspace.take< double >( lrwork_ );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zgelsd(
         &m_, &n_, &nrhs_,
         (lapack_complex_double*) A, &lda_,
         (lapack_complex_double*) B, &ldb_,
         S, &rcond, &rank_,
-        (lapack_complex_double*) &work[0], &lwork_,
-        &rwork[0],
-        &iwork[0], &info_ );
+        (lapack_complex_double*) work, &lwork_,
+        rwork,
+        iwork, &info_ );
     if (info_ < 0) {
         throw Error();
     }
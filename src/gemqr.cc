@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "native.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7
 
@@ -24,6 +25,11 @@ int64_t gemqr(
     float const* T, int64_t tsize,
     float* C, int64_t ldc )
 {
+    if (internal::is_tsqr( T, tsize )) {
+        return internal::gemqr_tsqr( side, trans, m, n, k, A, lda,
+                                     T, tsize, C, ldc );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -81,6 +87,11 @@ int64_t gemqr(
     double const* T, int64_t tsize,
     double* C, int64_t ldc )
 {
+    if (internal::is_tsqr( T, tsize )) {
+        return internal::gemqr_tsqr( side, trans, m, n, k, A, lda,
+                                     T, tsize, C, ldc );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -138,6 +149,11 @@ int64_t gemqr(
     std::complex<float> const* T, int64_t tsize,
     std::complex<float>* C, int64_t ldc )
 {
+    if (internal::is_tsqr( T, tsize )) {
+        return internal::gemqr_tsqr( side, trans, m, n, k, A, lda,
+                                     T, tsize, C, ldc );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -195,6 +211,11 @@ int64_t gemqr(
     std::complex<double> const* T, int64_t tsize,
     std::complex<double>* C, int64_t ldc )
 {
+    if (internal::is_tsqr( T, tsize )) {
+        return internal::gemqr_tsqr( side, trans, m, n, k, A, lda,
+                                     T, tsize, C, ldc );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +23,9 @@ int64_t geqlf(
     float* A, int64_t lda,
     float* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "geqlf", 's', m, n, 0,
+                             Gflop< float >::geqlf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -67,6 +71,9 @@ int64_t geqlf(
     double* A, int64_t lda,
     double* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "geqlf", 'd', m, n, 0,
+                             Gflop< double >::geqlf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -112,6 +119,9 @@ int64_t geqlf(
     std::complex<float>* A, int64_t lda,
     std::complex<float>* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "geqlf", 'c', m, n, 0,
+                             Gflop< std::complex<float> >::geqlf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -211,6 +221,9 @@ int64_t geqlf(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "geqlf", 'z', m, n, 0,
+                             Gflop< std::complex<double> >::geqlf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -0,0 +1,183 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/randomized.hh"
+#include "sketch.hh"
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Randomized QRCP, after Duersch and Gu, "Randomized QR with column
+/// pivoting", SIAM J. Sci. Comput., 2017. With Omega A22 P = Omega Q R,
+/// and Omega Q = [ S1 S2 ], the sketch columns are B1 = S1 R11 and
+/// B2 = S1 R12 + S2 R22, so B2 - B1 R11^{-1} R12 = S2 R22 is a sketch
+/// of the next trailing matrix R22, without another pass over A.
+template <typename scalar_t>
+int64_t geqp3_rand(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* jpvt,
+    scalar_t* tau,
+    int64_t* iseed,
+    int64_t nb,
+    int64_t oversample,
+    lapack::Sketch sketch )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t one = 1;
+    const real_t eps = std::numeric_limits< real_t >::epsilon();
+
+    // check arguments
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( nb < 1 );
+    lapack_error_if( oversample < 0 );
+    lapack_error_if( sketch != Sketch::Gaussian && sketch != Sketch::SRHT );
+
+    // Move leading columns to the front, as geqp3 does.
+    int64_t nfixed = 0;
+    for (int64_t j = 0; j < n; ++j) {
+        if (jpvt[ j ] != 0) {
+            if (j != nfixed) {
+                blas::swap( m, &A[ j*lda ], 1, &A[ nfixed*lda ], 1 );
+                jpvt[ j ] = jpvt[ nfixed ];
+            }
+            jpvt[ nfixed ] = j + 1;
+            ++nfixed;
+        }
+        else {
+            jpvt[ j ] = j + 1;
+        }
+    }
+
+    // Factor leading columns and update the rest of A.
+    int64_t minmn = min( m, n );
+    int64_t j = min( nfixed, minmn );
+    if (j > 0) {
+        lapack::geqrf( m, j, A, lda, tau );
+        if (j < n) {
+            lapack::unmqr( Side::Left, Op::ConjTrans, m, n - j, j,
+                           A, lda, tau, &A[ j*lda ], lda );
+        }
+    }
+    if (j >= minmn)
+        return 0;
+
+    // Sketch B = Omega A22, lb-by-(n - j), stored in columns j:n-1 of an
+    // ldb-by-n array so columns of B match columns of A.
+    int64_t ldb = nb + oversample;
+    int64_t lb = min( ldb, m - j );
+    std::vector< scalar_t > B( ldb * n );
+    internal::sketch( Side::Left, sketch, m - j, n - j, lb,
+                      &A[ j + j*lda ], lda, &B[ j*ldb ], ldb, iseed );
+
+    std::vector< scalar_t > Bc, tauB, T, W;
+    std::vector< int64_t > jp, who, where;
+    while (j < minmn) {
+        int64_t jb = min( nb, minmn - j );
+        int64_t nt = n - j;
+
+        // ---------- choose jb pivots by QRCP of the sketch
+        Bc.resize( lb * nt );
+        lapack::lacpy( MatrixType::General, lb, nt,
+                       &B[ j*ldb ], ldb, &Bc[ 0 ], lb );
+        jp.assign( nt, 0 );
+        tauB.resize( min( lb, nt ) );
+        lapack::geqp3( lb, nt, &Bc[ 0 ], lb, &jp[ 0 ], &tauB[ 0 ] );
+
+        // Swap the pivot columns to the front of A22, B, and jpvt,
+        // tracking where each column of A22 is (where) and which column
+        // is in each position (who).
+        who.resize( nt );
+        where.resize( nt );
+        std::iota( who.begin(), who.end(), 0 );
+        std::iota( where.begin(), where.end(), 0 );
+        for (int64_t c = 0; c < jb; ++c) {
+            int64_t p = where[ jp[ c ] - 1 ];
+            if (p != c) {
+                blas::swap( m,  &A[ (j + c)*lda ], 1, &A[ (j + p)*lda ], 1 );
+                blas::swap( lb, &B[ (j + c)*ldb ], 1, &B[ (j + p)*ldb ], 1 );
+                std::swap( jpvt[ j + c ], jpvt[ j + p ] );
+                std::swap( who[ c ], who[ p ] );
+                where[ who[ c ] ] = c;
+                where[ who[ p ] ] = p;
+            }
+        }
+
+        // ---------- factor the panel and update the trailing matrix
+        scalar_t* Ajj = &A[ j + j*lda ];
+        lapack::geqrf( m - j, jb, Ajj, lda, &tau[ j ] );
+        if (jb < nt) {
+            // larfb directly; unmqr does not block when k <= its block size
+            T.resize( jb * jb );
+            lapack::larft( Direction::Forward, StoreV::Columnwise, m - j, jb,
+                           Ajj, lda, &tau[ j ], &T[ 0 ], jb );
+            lapack::larfb( Side::Left, Op::ConjTrans,
+                           Direction::Forward, StoreV::Columnwise,
+                           m - j, nt - jb, jb, Ajj, lda, &T[ 0 ], jb,
+                           &Ajj[ jb*lda ], lda );
+        }
+        j += jb;
+        if (j >= minmn)
+            break;
+
+        // ---------- update the sketch, B2 -= B1 R11^{-1} R12, if R11 is
+        // well enough conditioned; otherwise sketch A22 again.
+        real_t rcond;
+        lapack::trcon( Norm::One, Uplo::Upper, Diag::NonUnit, jb,
+                       Ajj, lda, &rcond );
+        if (rcond > std::sqrt( eps )) {
+            W.resize( jb * (n - j) );
+            lapack::lacpy( MatrixType::General, jb, n - j,
+                           &Ajj[ jb*lda ], lda, &W[ 0 ], jb );
+            blas::trsm( blas::Layout::ColMajor, Side::Left, Uplo::Upper,
+                        Op::NoTrans, Diag::NonUnit, jb, n - j,
+                        one, Ajj, lda, &W[ 0 ], jb );
+            blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                        lb, n - j, jb,
+                        -one, &B[ (j - jb)*ldb ], ldb, &W[ 0 ], jb,
+                        one,  &B[ j*ldb ], ldb );
+        }
+        else {
+            lb = min( ldb, m - j );
+            internal::sketch( Side::Left, sketch, m - j, n - j, lb,
+                              &A[ j + j*lda ], lda, &B[ j*ldb ], ldb, iseed );
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_GEQP3_RAND_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t geqp3_rand< scalar_t >( \
+        int64_t m, int64_t n, \
+        scalar_t* A, int64_t lda, \
+        int64_t* jpvt, \
+        scalar_t* tau, \
+        int64_t* iseed, \
+        int64_t nb, \
+        int64_t oversample, \
+        lapack::Sketch sketch );
+
+LAPACK_GEQP3_RAND_INSTANTIATE( float )
+LAPACK_GEQP3_RAND_INSTANTIATE( double )
+LAPACK_GEQP3_RAND_INSTANTIATE( std::complex<float> )
+LAPACK_GEQP3_RAND_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_GEQP3_RAND_INSTANTIATE
+
+}  // namespace lapack
@@ -6,6 +6,7 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "native.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7.0
 
@@ -24,6 +25,10 @@ int64_t geqr(
     float* A, int64_t lda,
     float* T, int64_t tsize )
 {
+    if (geqr_method() == Method::Native && m >= n) {
+        return internal::geqr_tsqr( m, n, A, lda, T, tsize );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -75,6 +80,10 @@ int64_t geqr(
     double* A, int64_t lda,
     double* T, int64_t tsize )
 {
+    if (geqr_method() == Method::Native && m >= n) {
+        return internal::geqr_tsqr( m, n, A, lda, T, tsize );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -126,6 +135,10 @@ int64_t geqr(
     std::complex<float>* A, int64_t lda,
     std::complex<float>* T, int64_t tsize )
 {
+    if (geqr_method() == Method::Native && m >= n) {
+        return internal::geqr_tsqr( m, n, A, lda, T, tsize );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -260,12 +273,33 @@ int64_t geqr(
 /// latsqr (if the matrix is tall-and-skinny) or geqrt to compute
 /// the QR factorization.
 ///
+/// @par Native TSQR
+///
+/// If geqr_method() is Method::Native and m >= n, geqr instead uses
+/// LAPACK++'s parallel TSQR: A is split into row blocks of mb rows
+/// (see geqr_set_block_size), each block is factored independently
+/// with geqrt, then the R factors are merged pairwise in a binary tree
+/// with tpqrt. Blocks and merges at each tree level run in parallel
+/// (OpenMP). T then holds
+///
+///     T[0]: tsize
+///     T[1]: row block size (mb)
+///     T[2]: -(column block size), negative to distinguish it from LAPACK's
+///     T[5:TSIZE-1]: for each row block, its geqrt T and the tpqrt T
+///         of the merge that absorbed it
+///
+/// gemqr detects this format and applies Q with the same tree.
+///
 /// @ingroup geqrf
 int64_t geqr(
     int64_t m, int64_t n,
     std::complex<double>* A, int64_t lda,
     std::complex<double>* T, int64_t tsize )
 {
+    if (geqr_method() == Method::Native && m >= n) {
+        return internal::geqr_tsqr( m, n, A, lda, T, tsize );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -0,0 +1,469 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/fortran.h"
+#include "NoConstructAllocator.hh"
+#include "batch.hh"
+#include "native.hh"
+
+#include <atomic>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+using blas::real;
+
+namespace {
+
+std::atomic< char >    g_geqr_method( char( Method::Vendor ) );
+std::atomic< int64_t > g_geqr_mb( 0 );
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+void geqr_set_method( Method method )
+{
+    g_geqr_method.store( char( method ), std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+Method geqr_method()
+{
+    return Method( g_geqr_method.load( std::memory_order_relaxed ) );
+}
+
+//------------------------------------------------------------------------------
+void geqr_set_block_size( int64_t mb )
+{
+    lapack_error_if( mb < 0 );
+    g_geqr_mb.store( mb, std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+int64_t geqr_block_size()
+{
+    return g_geqr_mb.load( std::memory_order_relaxed );
+}
+
+#if LAPACK_VERSION >= 30700  // >= 3.7.0
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Layout of the native TSQR factorization of an m-by-n matrix A, m >= n.
+///
+/// A is split into row blocks of mb >= n rows; the last block also gets
+/// the remaining rows. Each block b is factored with geqrt, leaving
+/// V_b below the diagonal of block b and R_b in its top n rows.
+/// Then a binary tree merges R factors: at level s = 1, 2, 4, ...,
+/// block b absorbs block b + s with tpqrt (l = n), leaving the
+/// upper triangular V in the top n rows of block b + s, where R_{b+s} was.
+/// R ends in the top n rows of block 0.
+///
+/// T holds a 5 element header, as LAPACK's geqr does, then per block the
+/// leaf T_b and merge T_b (for the tpqrt that absorbed block b), each
+/// ib-by-n with ldt = ib:
+///     T[ 0 ] = tsize, T[ 1 ] = mb, T[ 2 ] = -ib.
+/// LAPACK's geqr stores T[ 2 ] = nb > 0, so the sign identifies the format.
+struct TsqrLayout
+{
+    TsqrLayout( int64_t m_, int64_t n_, int64_t mb_, int64_t ib_ ):
+        m( m_ ), n( n_ ), mb( mb_ ), ib( ib_ ),
+        nblocks( max( 1, m_ / mb_ ) )
+    {}
+
+    /// @return first row of block b.
+    int64_t row( int64_t b ) const { return b*mb; }
+
+    /// @return number of rows in block b.
+    int64_t rows( int64_t b ) const
+        { return (b == nblocks - 1 ? m - b*mb : mb); }
+
+    /// @return size of T, including the header.
+    int64_t tsize() const { return header + nblocks * 2 * ib * n; }
+
+    template <typename scalar_t>
+    scalar_t* leaf_T( scalar_t* T, int64_t b ) const
+        { return &T[ header + (2*b) * ib * n ]; }
+
+    template <typename scalar_t>
+    scalar_t* merge_T( scalar_t* T, int64_t b ) const
+        { return &T[ header + (2*b + 1) * ib * n ]; }
+
+    static constexpr int64_t header = 5;
+
+    int64_t m, n, mb, ib, nblocks;
+};
+
+//------------------------------------------------------------------------------
+/// @return row block size mb >= n for the native TSQR: geqr_block_size()
+/// if set, otherwise blocks of about 2^17 elements, so a block fits in
+/// L2 cache, but at least 2n rows so local QRs dominate the merges, and
+/// at most m / tsqr_min_blocks rows so many threads have a block.
+/// It does not depend on the number of threads, which may change between
+/// the tsize query and the factorization.
+int64_t tsqr_row_block( int64_t m, int64_t n )
+{
+    const int64_t tsqr_min_blocks = 64;
+
+    int64_t mb = geqr_block_size();
+    if (mb == 0) {
+        mb = min( (int64_t( 1 ) << 17) / max( 1, n ),
+                  (m + tsqr_min_blocks - 1) / tsqr_min_blocks );
+        mb = max( mb, 2*n );
+    }
+    return max( mb, max( 1, n ) );
+}
+
+//------------------------------------------------------------------------------
+/// @return inner block size for geqrt, tpqrt, etc.
+inline int64_t tsqr_inner_block( int64_t n )
+{
+    return max( 1, min( n, 32 ) );
+}
+
+//------------------------------------------------------------------------------
+/// @return true if T was produced by the native TSQR, i.e., geqr_tsqr.
+template <typename scalar_t>
+bool is_tsqr( scalar_t const* T, int64_t tsize )
+{
+    return tsize >= TsqrLayout::header && real( T[ 2 ] ) < 0;
+}
+
+//------------------------------------------------------------------------------
+/// Native TSQR with the geqr interface; see TsqrLayout.
+/// Requires m >= n. Leaves run in parallel, then merges at each tree level.
+template <typename scalar_t>
+int64_t geqr_tsqr(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t tsize )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 || n > m );
+    lapack_error_if( lda < max( 1, m ) );
+
+    TsqrLayout L( m, n, tsqr_row_block( m, n ), tsqr_inner_block( n ) );
+
+    // tsize == -1 or -2 is query
+    if (tsize < 0) {
+        T[ 0 ] = scalar_t( L.tsize() );
+        return 0;
+    }
+    lapack_error_if( tsize < L.tsize() );
+
+    T[ 0 ] = scalar_t( L.tsize() );
+    T[ 1 ] = scalar_t( L.mb );
+    T[ 2 ] = scalar_t( -L.ib );
+    T[ 3 ] = 0;
+    T[ 4 ] = 0;
+    if (n == 0)
+        return 0;
+
+    // Local QR of each block.
+    batch_for( L.nblocks, [&]( int64_t b, int ) {
+        geqrt( L.rows( b ), n, L.ib, &A[ L.row( b ) ], lda,
+               L.leaf_T( T, b ), L.ib );
+    });
+
+    // Merge R factors up the tree.
+    for (int64_t s = 1; s < L.nblocks; s *= 2) {
+        int64_t npairs = (L.nblocks - s + 2*s - 1) / (2*s);
+        batch_for( npairs, [&]( int64_t p, int ) {
+            int64_t b = 2*s*p;
+            tpqrt( n, n, n, L.ib,
+                   &A[ L.row( b )     ], lda,
+                   &A[ L.row( b + s ) ], lda,
+                   L.merge_T( T, b + s ), L.ib );
+        });
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Native application of Q from geqr_tsqr, with the gemqr interface.
+/// Q = diag( Q_b ) Q_1 Q_2 ... Q_levels, where Q_b are the local QRs
+/// and Q_j are the merges at tree level j.
+template <typename scalar_t>
+int64_t gemqr_tsqr(
+    Side side, Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T, int64_t tsize,
+    scalar_t* C, int64_t ldc )
+{
+    int64_t mq = (side == Side::Left ? m : n);  // rows of A, order of Q
+    lapack_error_if( side != Side::Left && side != Side::Right );
+    lapack_error_if( trans != Op::NoTrans && trans != Op::ConjTrans
+                     && ! (trans == Op::Trans && ! blas::is_complex< scalar_t >::value) );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( k < 0 || k > mq );
+    lapack_error_if( lda < max( 1, mq ) );
+    lapack_error_if( ldc < max( 1, m ) );
+
+    TsqrLayout L( mq, k, int64_t( real( T[ 1 ] ) ), int64_t( -real( T[ 2 ] ) ) );
+    lapack_error_if( tsize < L.tsize() );
+
+    if (m == 0 || n == 0 || k == 0)
+        return 0;
+
+    // Columns of C (for Right) or rows (for Left) that block b touches.
+    auto Cb = [&]( int64_t b ) {
+        return (side == Side::Left ? &C[ L.row( b ) ] : &C[ L.row( b )*ldc ]);
+    };
+
+    auto leaves = [&]() {
+        batch_for( L.nblocks, [&]( int64_t b, int ) {
+            int64_t mb = L.rows( b );
+            gemqrt( side, trans,
+                    (side == Side::Left ? mb : m),
+                    (side == Side::Left ? n  : mb), k, L.ib,
+                    &A[ L.row( b ) ], lda, L.leaf_T( T, b ), L.ib,
+                    Cb( b ), ldc );
+        });
+    };
+
+    auto level = [&]( int64_t s ) {
+        int64_t npairs = (L.nblocks - s + 2*s - 1) / (2*s);
+        batch_for( npairs, [&]( int64_t p, int ) {
+            int64_t b = 2*s*p;
+            tpmqrt( side, trans,
+                    (side == Side::Left ? k : m),
+                    (side == Side::Left ? n : k), k, k, L.ib,
+                    &A[ L.row( b + s ) ], lda, L.merge_T( T, b + s ), L.ib,
+                    Cb( b ), ldc, Cb( b + s ), ldc );
+        });
+    };
+
+    int64_t top = 1;
+    while (top*2 < L.nblocks)
+        top *= 2;
+
+    // Q^H C and C Q apply leaves first; Q C and C Q^H apply the root first.
+    bool leaves_first = ((side == Side::Left) == (trans != Op::NoTrans));
+    if (leaves_first) {
+        leaves();
+        for (int64_t s = 1; s < L.nblocks; s *= 2)
+            level( s );
+    }
+    else {
+        for (int64_t s = top; s >= 1 && s < L.nblocks; s /= 2)
+            level( s );
+        leaves();
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TSQR_INSTANTIATE( scalar_t ) \
+    template \
+    bool is_tsqr< scalar_t >( scalar_t const* T, int64_t tsize ); \
+    \
+    template \
+    int64_t geqr_tsqr< scalar_t >( \
+        int64_t m, int64_t n, scalar_t* A, int64_t lda, \
+        scalar_t* T, int64_t tsize ); \
+    \
+    template \
+    int64_t gemqr_tsqr< scalar_t >( \
+        Side side, Op trans, int64_t m, int64_t n, int64_t k, \
+        scalar_t const* A, int64_t lda, \
+        scalar_t const* T, int64_t tsize, \
+        scalar_t* C, int64_t ldc );
+
+LAPACK_TSQR_INSTANTIATE( float )
+LAPACK_TSQR_INSTANTIATE( double )
+LAPACK_TSQR_INSTANTIATE( std::complex<float> )
+LAPACK_TSQR_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_TSQR_INSTANTIATE
+
+}  // namespace internal
+
+#if LAPACK_VERSION >= 30900  // >= 3.9.0
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Generic implementation of getsqrhrt.
+template <typename scalar_t>
+int64_t getsqrhrt(
+    int64_t m, int64_t n, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t ldt )
+{
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 || n > m );
+    lapack_error_if( nb < 1 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldt < max( 1, min( nb, n ) ) );
+
+    if (n == 0)
+        return 0;
+
+    // TSQR factorization.
+    TsqrLayout L( m, n, tsqr_row_block( m, n ), tsqr_inner_block( n ) );
+    lapack::vector< scalar_t > Tq( L.tsize() );
+    geqr_tsqr( m, n, A, lda, &Tq[ 0 ], L.tsize() );
+
+    // Save R.
+    lapack::vector< scalar_t > R( n*n );
+    lacpy( MatrixType::Upper, n, n, A, lda, &R[ 0 ], n );
+
+    // Form Q1 = Q [ I; 0 ] in place. First apply the tree to the top
+    // n rows of each block, X_b, starting from X_0 = I, X_b = 0.
+    lapack::vector< scalar_t > X( L.nblocks * n * n );
+    laset( MatrixType::General, n, L.nblocks * n, zero, zero, &X[ 0 ], n );
+    laset( MatrixType::General, n, n, zero, one, &X[ 0 ], n );
+    int64_t top = 1;
+    while (top*2 < L.nblocks)
+        top *= 2;
+    for (int64_t s = top; s >= 1 && s < L.nblocks; s /= 2) {
+        int64_t npairs = (L.nblocks - s + 2*s - 1) / (2*s);
+        batch_for( npairs, [&]( int64_t p, int ) {
+            int64_t b = 2*s*p;
+            tpmqrt( Side::Left, Op::NoTrans, n, n, n, n, L.ib,
+                    &A[ L.row( b + s ) ], lda, L.merge_T( &Tq[ 0 ], b + s ), L.ib,
+                    &X[ b*n*n ], n, &X[ (b + s)*n*n ], n );
+        });
+    }
+
+    // Then apply each leaf Q_b to [ X_b; 0 ], overwriting block b of A.
+    // Each thread copies its block's V to workspace first.
+    int nthreads = batch_num_threads( L.nblocks );
+    int64_t mb_max = L.rows( L.nblocks - 1 );
+    lapack::vector< scalar_t > W( nthreads * mb_max * n );
+    batch_for( L.nblocks, [&]( int64_t b, int thread ) {
+        int64_t mb = L.rows( b );
+        scalar_t* Ab = &A[ L.row( b ) ];
+        scalar_t* Wb = &W[ thread * mb_max * n ];
+        lacpy( MatrixType::General, mb, n, Ab, lda, Wb, mb );
+        laset( MatrixType::General, mb - n, n, zero, zero, &Ab[ n ], lda );
+        lacpy( MatrixType::General, n, n, &X[ b*n*n ], n, Ab, lda );
+        gemqrt( Side::Left, Op::NoTrans, mb, n, n, L.ib,
+                Wb, mb, L.leaf_T( &Tq[ 0 ], b ), L.ib, Ab, lda );
+    });
+
+    // Householder reconstruction: Q1 - [ S; 0 ] = V U, with S = diag( D ).
+    lapack::vector< scalar_t > D( n );
+    unhr_col( m, n, nb, A, lda, T, ldt, &D[ 0 ] );
+
+    // R_hr = S R, stored above the diagonal of V.
+    for (int64_t i = 0; i < n; ++i) {
+        if (D[ i ] == -one) {
+            for (int64_t j = i; j < n; ++j)
+                A[ i + j*lda ] = -R[ i + j*n ];
+        }
+        else {
+            for (int64_t j = i; j < n; ++j)
+                A[ i + j*lda ] = R[ i + j*n ];
+        }
+    }
+    return 0;
+}
+
+}  // namespace internal
+
+// -----------------------------------------------------------------------------
+/// @ingroup geqrf
+int64_t getsqrhrt(
+    int64_t m, int64_t n, int64_t nb,
+    float* A, int64_t lda,
+    float* T, int64_t ldt )
+{
+    return internal::getsqrhrt( m, n, nb, A, lda, T, ldt );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geqrf
+int64_t getsqrhrt(
+    int64_t m, int64_t n, int64_t nb,
+    double* A, int64_t lda,
+    double* T, int64_t ldt )
+{
+    return internal::getsqrhrt( m, n, nb, A, lda, T, ldt );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geqrf
+int64_t getsqrhrt(
+    int64_t m, int64_t n, int64_t nb,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* T, int64_t ldt )
+{
+    return internal::getsqrhrt( m, n, nb, A, lda, T, ldt );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes a QR factorization of a tall-skinny m-by-n matrix A, m >= n,
+///     $A = Q R,$
+/// with Q in Householder form, as returned by geqrt:
+/// Q = I - V T V^H, with V unit lower trapezoidal and T block upper
+/// triangular with nb-by-nb blocks.
+///
+/// This is LAPACK's getsqrhrt, implemented natively: it factors A
+/// with the parallel TSQR of geqr (with Method::Native, regardless of
+/// geqr_method), forms the first n columns of Q in place,
+/// then reconstructs the Householder vectors with unhr_col (orhr_col).
+/// Extra memory is about n^2 (number of row blocks + 2) plus
+/// one row block per thread, independent of m otherwise.
+///
+/// Q can be applied with gemqrt. Also, the diagonal of T holds the
+/// scalar factors tau of the elementary reflectors, so
+/// A and tau( i ) = T( i % nb, i ) form the same representation
+/// as geqrf's output, usable by unmqr and ungqr.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. m >= n >= 0.
+///
+/// @param[in] nb
+///     The column block size of the output T. nb >= 1.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On entry, the m-by-n matrix A.
+///     On exit, the elements on and above the diagonal contain the
+///     n-by-n upper triangular matrix R; the elements below the
+///     diagonal are the columns of V.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] T
+///     The min(nb,n)-by-n matrix T, stored in an ldt-by-n array.
+///     The upper triangular block reflectors stored in compact form
+///     as a sequence of upper triangular blocks, as in geqrt.
+///
+/// @param[in] ldt
+///     The leading dimension of the array T. ldt >= max(1,min(nb,n)).
+///
+/// @return = 0: successful exit
+///
+/// @ingroup geqrf
+int64_t getsqrhrt(
+    int64_t m, int64_t n, int64_t nb,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* T, int64_t ldt )
+{
+    return internal::getsqrhrt( m, n, nb, A, lda, T, ldt );
+}
+
+#endif  // LAPACK >= 3.9.0
+
+#endif  // LAPACK >= 3.7.0
+
+}  // namespace lapack
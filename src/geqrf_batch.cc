@@ -0,0 +1,179 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "NoConstructAllocator.hh"
+#include "batch.hh"
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Computes QR factorizations of a batch of m-by-n matrices, $A_i = Q_i R_i$.
+/// See `lapack::geqrf`.
+/// Matrices are factored in parallel; see lapack/batch.hh.
+/// The workspace is queried once and allocated once per thread.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of each matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of each matrix A. n >= 0.
+///
+/// @param[in,out] Aarray
+///     Array of batch_count pointers to m-by-n matrices A, each stored in
+///     an lda-by-n array. On exit, R and the Householder vectors,
+///     as for `lapack::geqrf`.
+///
+/// @param[in] lda
+///     The leading dimension of each A. lda >= max(1,m).
+///
+/// @param[out] tau_array
+///     Array of batch_count pointers to vectors tau, each of length
+///     min(m,n), holding the scalar factors of the elementary reflectors.
+///
+/// @param[out] info
+///     Array of length batch_count. info[ i ] is the `lapack::geqrf` return
+///     value for the i-th matrix.
+///
+/// @param[in] batch_count
+///     The number of matrices. batch_count >= 0.
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf_batch(
+    int64_t m, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    scalar_t* const* tau_array,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( batch_count < 0 );
+    if (batch_count == 0)
+        return;
+
+    // one workspace per thread
+    size_t work_size;
+    geqrf_work_size_bytes( m, n, Aarray[ 0 ], lda, tau_array[ 0 ], &work_size );
+    int nthreads = internal::batch_num_threads( batch_count );
+    lapack::vector< char > work( work_size * nthreads );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int thread ) {
+        info[ i ] = geqrf( m, n, Aarray[ i ], lda, tau_array[ i ],
+                           &work[ thread*work_size ], work_size );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes QR factorizations of a batch of m-by-n matrices stored with a
+/// fixed stride. Otherwise the same as `lapack::geqrf_batch`.
+///
+/// @param[in,out] A
+///     The i-th matrix A is stored at A + i*strideA.
+///
+/// @param[in] strideA
+///     Stride between matrices in A. strideA >= lda*n.
+///
+/// @param[out] tau
+///     The i-th vector tau is stored at tau + i*stride_tau.
+///
+/// @param[in] stride_tau
+///     Stride between vectors tau. stride_tau >= min(m,n).
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf_strided_batch(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    scalar_t* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( stride_tau < blas::min( m, n ) );
+    lapack_error_if( batch_count < 0 );
+    if (batch_count == 0)
+        return;
+
+    // one workspace per thread
+    size_t work_size;
+    geqrf_work_size_bytes( m, n, A, lda, tau, &work_size );
+    int nthreads = internal::batch_num_threads( batch_count );
+    lapack::vector< char > work( work_size * nthreads );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int thread ) {
+        info[ i ] = geqrf( m, n, &A[ i*strideA ], lda, &tau[ i*stride_tau ],
+                           &work[ thread*work_size ], work_size );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geqrf_batch<float>(
+    int64_t m, int64_t n,
+    float* const* Aarray, int64_t lda,
+    float* const* tau_array,
+    int64_t* info, int64_t batch_count );
+
+template
+void geqrf_batch<double>(
+    int64_t m, int64_t n,
+    double* const* Aarray, int64_t lda,
+    double* const* tau_array,
+    int64_t* info, int64_t batch_count );
+
+template
+void geqrf_batch< std::complex<float> >(
+    int64_t m, int64_t n,
+    std::complex<float>* const* Aarray, int64_t lda,
+    std::complex<float>* const* tau_array,
+    int64_t* info, int64_t batch_count );
+
+template
+void geqrf_batch< std::complex<double> >(
+    int64_t m, int64_t n,
+    std::complex<double>* const* Aarray, int64_t lda,
+    std::complex<double>* const* tau_array,
+    int64_t* info, int64_t batch_count );
+
+template
+void geqrf_strided_batch<float>(
+    int64_t m, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    float* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count );
+
+template
+void geqrf_strided_batch<double>(
+    int64_t m, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    double* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count );
+
+template
+void geqrf_strided_batch< std::complex<float> >(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    std::complex<float>* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count );
+
+template
+void geqrf_strided_batch< std::complex<double> >(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    std::complex<double>* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count );
+
+}  // namespace lapack
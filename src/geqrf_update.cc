@@ -0,0 +1,239 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/update.hh"
+
+#include <algorithm>
+
+// A rotation G = [ c, s; -conj(s), c ] applied to rows p, q of R, R = G R,
+// is applied to columns p, q of Q as Q = Q G^H, which blas::rot does
+// with c and conj( s ). Then A = Q R is unchanged.
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+using blas::conj;
+
+//------------------------------------------------------------------------------
+/// w is stored as row m of R, and Q extended to [ Q, 0; 0, 1 ] with its
+/// last row moved to row i, so A with w inserted = Q [ R; w^T ]. Row m
+/// is then rotated into rows 0, ..., min(m,n)-1 of R.
+template <typename scalar_t>
+void geqrf_insert_row(
+    int64_t m, int64_t n, int64_t i,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* R, int64_t ldr,
+    scalar_t const* w, int64_t incw )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( Q != nullptr && (i < 0 || i > m) );
+    lapack_error_if( Q != nullptr && ldq < m+1 );
+    lapack_error_if( ldr < m+1 );
+    lapack_error_if( incw <= 0 );
+
+    blas::copy( n, w, incw, &R[ m ], ldr );
+
+    if (Q != nullptr) {
+        for (int64_t jj = 0; jj < m; ++jj) {
+            scalar_t* q = &Q[ jj*ldq ];
+            std::copy_backward( &q[ i ], &q[ m ], &q[ m+1 ] );
+            q[ i ] = zero;
+        }
+        std::fill( &Q[ m*ldq ], &Q[ m*ldq + m+1 ], zero );
+        Q[ i + m*ldq ] = one;
+    }
+
+    real_t c;
+    scalar_t s, r;
+    for (int64_t k = 0; k < min( m, n ); ++k) {
+        lapack::lartg( R[ k + k*ldr ], R[ m + k*ldr ], &c, &s, &r );
+        R[ k + k*ldr ] = r;
+        R[ m + k*ldr ] = zero;
+        blas::rot( n-k-1, &R[ k + (k+1)*ldr ], ldr,
+                          &R[ m + (k+1)*ldr ], ldr, c, s );
+        if (Q != nullptr)
+            blas::rot( m+1, &Q[ k*ldq ], 1, &Q[ m*ldq ], 1, c, conj( s ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Rotations in planes (k-1, k), k = m-1, ..., 1, zero row i of Q right to
+/// left, making R upper Hessenberg. Then row i of Q is a multiple of e_1^T,
+/// so column 0 of Q is zero outside row i, and
+/// A without row i = Q( rows != i, 1:m-1 ) R( 1:m-1, : ).
+template <typename scalar_t>
+void geqrf_delete_row(
+    int64_t m, int64_t n, int64_t i,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* R, int64_t ldr )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+
+    lapack_error_if( m < 1 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( i < 0 || i >= m );
+    lapack_error_if( Q == nullptr );
+    lapack_error_if( ldq < max( 1, m ) );
+    lapack_error_if( ldr < max( 1, m ) );
+
+    real_t c;
+    scalar_t s, r;
+    for (int64_t k = m-1; k >= 1; --k) {
+        // Zeros Q(i,k) = conj( -s conj( Q(i,k-1) ) + c conj( Q(i,k) ) ).
+        lapack::lartg( conj( Q[ i + (k-1)*ldq ] ), conj( Q[ i + k*ldq ] ),
+                       &c, &s, &r );
+        blas::rot( m, &Q[ (k-1)*ldq ], 1, &Q[ k*ldq ], 1, c, conj( s ) );
+        Q[ i + k*ldq ] = zero;
+        if (k-1 < n) {
+            blas::rot( n-k+1, &R[ (k-1) + (k-1)*ldr ], ldr,
+                              &R[  k    + (k-1)*ldr ], ldr, c, s );
+        }
+    }
+
+    // Drop row 0 of R; the subdiagonal moves onto the diagonal.
+    for (int64_t jj = 0; jj < n; ++jj) {
+        scalar_t* rj = &R[ jj*ldr ];
+        std::copy( &rj[ 1 ], &rj[ m ], &rj[ 0 ] );
+    }
+
+    // Drop row i and column 0 of Q.
+    for (int64_t jj = 0; jj < m-1; ++jj) {
+        scalar_t* qj  = &Q[ jj*ldq ];
+        scalar_t* qj1 = &Q[ (jj+1)*ldq ];
+        std::copy( &qj1[ 0 ],   &qj1[ i ], &qj[ 0 ] );
+        std::copy( &qj1[ i+1 ], &qj1[ m ], &qj[ i ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Column j of R is set to u = Q^H a. Below row n, the other columns of R
+/// are zero, so one reflector zeros u(n+1 : m-1) and touches only
+/// Q( :, n : m-1 ). Rotations in planes (k-1, k), k = min(n, m-1), ..., j+1,
+/// zero the rest; each fills in only R(k,k), on the new diagonal.
+template <typename scalar_t>
+void geqrf_insert_col(
+    int64_t m, int64_t n, int64_t j,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* R, int64_t ldr,
+    scalar_t const* a )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( j < 0 || j > n );
+    lapack_error_if( Q == nullptr );
+    lapack_error_if( ldq < max( 1, m ) );
+    lapack_error_if( ldr < max( 1, m ) );
+
+    for (int64_t jj = n-1; jj >= j; --jj)
+        blas::copy( m, &R[ jj*ldr ], 1, &R[ (jj+1)*ldr ], 1 );
+
+    scalar_t* u = &R[ j*ldr ];
+    blas::gemv( blas::Layout::ColMajor, Op::ConjTrans, m, m,
+                one, Q, ldq, a, 1, zero, u, 1 );
+
+    if (m - n > 1) {
+        scalar_t alpha = u[ n ], tau;
+        lapack::larfg( m-n, &alpha, &u[ n+1 ], 1, &tau );
+        u[ n ] = one;
+        lapack::larf( Side::Right, m, m-n, &u[ n ], 1, tau, &Q[ n*ldq ], ldq );
+        u[ n ] = alpha;
+        std::fill( &u[ n+1 ], &u[ m ], zero );
+    }
+
+    real_t c;
+    scalar_t s, r;
+    for (int64_t k = min( n, m-1 ); k > j; --k) {
+        lapack::lartg( u[ k-1 ], u[ k ], &c, &s, &r );
+        u[ k-1 ] = r;
+        u[ k ] = zero;
+        blas::rot( n-k+1, &R[ (k-1) + k*ldr ], ldr,
+                          &R[  k    + k*ldr ], ldr, c, s );
+        blas::rot( m, &Q[ (k-1)*ldq ], 1, &Q[ k*ldq ], 1, c, conj( s ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Shifting columns j+1 : n-1 of R left leaves subdiagonal entries
+/// R(k+1, k), k = j, ..., which rotations in planes (k, k+1) zero.
+template <typename scalar_t>
+void geqrf_delete_col(
+    int64_t m, int64_t n, int64_t j,
+    scalar_t* Q, int64_t ldq,
+    scalar_t* R, int64_t ldr )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 1 );
+    lapack_error_if( j < 0 || j >= n );
+    lapack_error_if( Q != nullptr && ldq < max( 1, m ) );
+    lapack_error_if( ldr < max( 1, m ) );
+
+    for (int64_t jj = j; jj < n-1; ++jj)
+        blas::copy( m, &R[ (jj+1)*ldr ], 1, &R[ jj*ldr ], 1 );
+
+    real_t c;
+    scalar_t s, r;
+    for (int64_t k = j; k < min( n-1, m-1 ); ++k) {
+        lapack::lartg( R[ k + k*ldr ], R[ (k+1) + k*ldr ], &c, &s, &r );
+        R[ k + k*ldr ] = r;
+        R[ (k+1) + k*ldr ] = zero;
+        blas::rot( n-k-2, &R[  k    + (k+1)*ldr ], ldr,
+                          &R[ (k+1) + (k+1)*ldr ], ldr, c, s );
+        if (Q != nullptr)
+            blas::rot( m, &Q[ k*ldq ], 1, &Q[ (k+1)*ldq ], 1, c, conj( s ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_UPDATE_INSTANTIATE( scalar_t ) \
+    template \
+    void geqrf_insert_row< scalar_t >( \
+        int64_t m, int64_t n, int64_t i, \
+        scalar_t* Q, int64_t ldq, \
+        scalar_t* R, int64_t ldr, \
+        scalar_t const* w, int64_t incw ); \
+    \
+    template \
+    void geqrf_delete_row< scalar_t >( \
+        int64_t m, int64_t n, int64_t i, \
+        scalar_t* Q, int64_t ldq, \
+        scalar_t* R, int64_t ldr ); \
+    \
+    template \
+    void geqrf_insert_col< scalar_t >( \
+        int64_t m, int64_t n, int64_t j, \
+        scalar_t* Q, int64_t ldq, \
+        scalar_t* R, int64_t ldr, \
+        scalar_t const* a ); \
+    \
+    template \
+    void geqrf_delete_col< scalar_t >( \
+        int64_t m, int64_t n, int64_t j, \
+        scalar_t* Q, int64_t ldq, \
+        scalar_t* R, int64_t ldr );
+
+LAPACK_UPDATE_INSTANTIATE( float )
+LAPACK_UPDATE_INSTANTIATE( double )
+LAPACK_UPDATE_INSTANTIATE( std::complex<float> )
+LAPACK_UPDATE_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_UPDATE_INSTANTIATE
+
+}  // namespace lapack
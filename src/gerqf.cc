@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +23,9 @@ int64_t gerqf(
     float* A, int64_t lda,
     float* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gerqf", 's', m, n, 0,
+                             Gflop< float >::gerqf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -67,6 +71,9 @@ int64_t gerqf(
     double* A, int64_t lda,
     double* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gerqf", 'd', m, n, 0,
+                             Gflop< double >::gerqf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -112,6 +119,9 @@ int64_t gerqf(
     std::complex<float>* A, int64_t lda,
     std::complex<float>* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gerqf", 'c', m, n, 0,
+                             Gflop< std::complex<float> >::gerqf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -212,6 +222,9 @@ int64_t gerqf(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gerqf", 'z', m, n, 0,
+                             Gflop< std::complex<double> >::gerqf( m, n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
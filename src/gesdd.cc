@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -15,6 +18,22 @@ using blas::max;
 using blas::min;
 using blas::real;
 
+// -----------------------------------------------------------------------------
+// Size of rwork for complex gesdd, from documentation. Some LAPACK
+// versions don't return it in the workspace query, and the workspace
+// routine needs it without a query.
+static int64_t gesdd_lrwork( lapack::Job jobz, int64_t m, int64_t n )
+{
+    int64_t mx = max( m, n );
+    int64_t mn = min( m, n );
+    if (jobz == lapack::Job::NoVec) {
+        return max( 1, 7*mn );  // LAPACK > 3.6 needs only 5*mn
+    }
+    else {
+        return max( 1, 5*mn*mn + 5*mn, 2*mx*mn + 2*mn*mn + mn );
+    }
+}
+
 // -----------------------------------------------------------------------------
 /// @ingroup gesvd
 int64_t gesdd(
@@ -24,57 +43,13 @@ int64_t gesdd(
     float* U, int64_t ldu,
     float* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobz_ = job2char( jobz );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    float qry_work[1];
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_sgesdd(
-        &jobz_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        qry_work, &ineg_one,
-        qry_iwork, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gesdd_work_size_bytes( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &work_size );
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_sgesdd(
-        &jobz_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        &work[0], &lwork_,
-        &iwork[0], &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gesdd( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -86,57 +61,13 @@ int64_t gesdd(
     double* U, int64_t ldu,
     double* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobz_ = job2char( jobz );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    double qry_work[1];
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dgesdd(
-        &jobz_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        qry_work, &ineg_one,
-        qry_iwork, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gesdd_work_size_bytes( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &work_size );
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_dgesdd(
-        &jobz_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        &work[0], &lwork_,
-        &iwork[0], &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gesdd( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -148,74 +79,13 @@ int64_t gesdd(
     std::complex<float>* U, int64_t ldu,
     std::complex<float>* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobz_ = job2char( jobz );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    float qry_rwork[1] = { 0 };
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cgesdd(
-        &jobz_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        S,
-        (lapack_complex_float*) U, &ldu_,
-        (lapack_complex_float*) VT, &ldvt_,
-        (lapack_complex_float*) qry_work, &ineg_one,
-        qry_rwork,
-        qry_iwork, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = qry_rwork[0];
-    if (lrwork_ == 0) {
-        // if query doesn't work, this is from documentation
-        lapack_int mx = max( m, n );
-        lapack_int mn = min( m, n );
-        if (jobz == lapack::Job::NoVec) {
-            lrwork_ = 7*mn;  // LAPACK > 3.6 needs only 5*mn
-        }
-        else {
-            lrwork_ = max( 5*mn*mn + 5*mn, 2*mx*mn + 2*mn*mn + mn );
-        }
-        lrwork_ = max( 1, lrwork_ );
-    }
+    size_t work_size;
+    gesdd_work_size_bytes( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &work_size );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_cgesdd(
-        &jobz_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        S,
-        (lapack_complex_float*) U, &ldu_,
-        (lapack_complex_float*) VT, &ldvt_,
-        (lapack_complex_float*) &work[0], &lwork_,
-        &rwork[0],
-        &iwork[0], &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gesdd( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -332,6 +202,135 @@ int64_t gesdd(
     double* S,
     std::complex<double>* U, int64_t ldu,
     std::complex<double>* VT, int64_t ldvt )
+{
+    size_t work_size;
+    gesdd_work_size_bytes( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gesdd( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "sgesdd", { jobz_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    float qry_work[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_sgesdd(
+        &jobz_, &m_, &n_,
+        A, &lda_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        qry_work, &ineg_one,
+        qry_iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // iwork, then work
+    *host_work_size = internal::workspace_bytes< lapack_int >( 8*min( m, n ) )
+                    + internal::workspace_bytes< float >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "dgesdd", { jobz_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dgesdd(
+        &jobz_, &m_, &n_,
+        A, &lda_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        qry_work, &ineg_one,
+        qry_iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // iwork, then work
+    *host_work_size = internal::workspace_bytes< lapack_int >( 8*min( m, n ) )
+                    + internal::workspace_bytes< double >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -349,6 +348,83 @@ int64_t gesdd(
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "cgesdd", { jobz_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    float qry_rwork[1] = { 0 };
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cgesdd(
+        &jobz_, &m_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        S,
+        (lapack_complex_float*) U, &ldu_,
+        (lapack_complex_float*) VT, &ldvt_,
+        (lapack_complex_float*) qry_work, &ineg_one,
+        qry_rwork,
+        qry_iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // iwork, rwork, then work
+    *host_work_size = internal::workspace_bytes< lapack_int >( 8*min( m, n ) )
+                    + internal::workspace_bytes< float >( gesdd_lrwork( jobz, m, n ) )
+                    + internal::workspace_bytes< std::complex<float> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::gesdd`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::gesdd`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::gesdd`.
+///
+/// @ingroup gesvd
+void gesdd_work_size_bytes(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "zgesdd", { jobz_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     std::complex<double> qry_work[1];
     double qry_rwork[1] = { 0 };
@@ -368,24 +444,220 @@ int64_t gesdd(
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = qry_rwork[0];
-    if (lrwork_ == 0) {
-        // if query doesn't work, this is from documentation
-        lapack_int mx = max( m, n );
-        lapack_int mn = min( m, n );
-        if (jobz == lapack::Job::NoVec) {
-            lrwork_ = 7*mn;  // LAPACK > 3.6 needs only 5*mn
-        }
-        else {
-            lrwork_ = max( 5*mn*mn + 5*mn, 2*mx*mn + 2*mn*mn + mn );
-        }
-        lrwork_ = max( 1, lrwork_ );
+
+    // iwork, rwork, then work
+    *host_work_size = internal::workspace_bytes< lapack_int >( 8*min( m, n ) )
+                    + internal::workspace_bytes< double >( gesdd_lrwork( jobz, m, n ) )
+                    + internal::workspace_bytes< std::complex<double> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesdd", 's', m, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
     }
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( 8*min( m, n ) );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_sgesdd(
+        &jobz_, &m_, &n_,
+        A, &lda_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        work, &lwork_,
+        iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesdd", 'd', m, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( 8*min( m, n ) );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
+
+    LAPACK_dgesdd(
+        &jobz_, &m_, &n_,
+        A, &lda_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        work, &lwork_,
+        iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesdd", 'c', m, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( 8*min( m, n ) );
+    float* rwork = workspace.take< float >( gesdd_lrwork( jobz, m, n ) );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_cgesdd(
+        &jobz_, &m_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        S,
+        (lapack_complex_float*) U, &ldu_,
+        (lapack_complex_float*) VT, &ldvt_,
+        (lapack_complex_float*) work, &lwork_,
+        rwork,
+        iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the singular value decomposition (SVD) of a
+/// m-by-n matrix A, optionally computing the left and/or right singular
+/// vectors, by using divide-and-conquer method,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::gesdd` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in,out] jobz, m, n, A, lda, S, U, ldu, VT, ldvt
+///     As for `lapack::gesdd` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::gesdd_work_size_bytes`.
+///
+/// @return = 0: successful exit.
+/// @return > 0: The updating process of `lapack::bdsdc` did not converge.
+///
+/// @ingroup gesvd
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesdd", 'z', m, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( 8*min( m, n ) );
+    double* rwork = workspace.take< double >( gesdd_lrwork( jobz, m, n ) );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zgesdd(
         &jobz_, &m_, &n_,
@@ -393,9 +665,9 @@ int64_t gesdd(
         S,
         (lapack_complex_double*) U, &ldu_,
         (lapack_complex_double*) VT, &ldvt_,
-        (lapack_complex_double*) &work[0], &lwork_,
-        &rwork[0],
-        &iwork[0], &info_
+        (lapack_complex_double*) work, &lwork_,
+        rwork,
+        iwork, &info_
     );
     if (info_ < 0) {
         throw Error();
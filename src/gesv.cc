@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -23,6 +24,9 @@ int64_t gesv(
     int64_t* ipiv,
     float* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 's', n, n, nrhs,
+                             Gflop< float >::gesv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -65,6 +69,9 @@ int64_t gesv(
     int64_t* ipiv,
     double* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'd', n, n, nrhs,
+                             Gflop< double >::gesv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -107,6 +114,9 @@ int64_t gesv(
     int64_t* ipiv,
     std::complex<float>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::gesv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -198,6 +208,9 @@ int64_t gesv(
     int64_t* ipiv,
     std::complex<double>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::gesv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -241,6 +254,9 @@ int64_t gesv(
     double* X, int64_t ldx,
     int64_t* iter )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'd', n, n, nrhs,
+                             Gflop< double >::gesv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -295,6 +311,9 @@ int64_t gesv(
     std::complex<double>* X, int64_t ldx,
     int64_t* iter )
 {
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::gesv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -342,4 +361,251 @@ int64_t gesv(
     return info_;
 }
 
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    lapack_int* ipiv,
+    float* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 's', n, n, nrhs,
+                             Gflop< float >::gesv( n, nrhs ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_sgesv(
+        &n_, &nrhs_,
+        A, &lda_,
+        ipiv,
+        B, &ldb_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'd', n, n, nrhs,
+                             Gflop< double >::gesv( n, nrhs ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_dgesv(
+        &n_, &nrhs_,
+        A, &lda_,
+        ipiv,
+        B, &ldb_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<float>* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::gesv( n, nrhs ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_cgesv(
+        &n_, &nrhs_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) B, &ldb_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double>* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::gesv( n, nrhs ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_zgesv(
+        &n_, &nrhs_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) B, &ldb_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'd', n, n, nrhs,
+                             Gflop< double >::gesv( n, nrhs ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int iter_ = (lapack_int) *iter;
+    lapack_int info_ = 0;
+
+    // allocate workspace
+    lapack::vector< double > work( (n)*(nrhs) );
+    lapack::vector< float > swork( (n*(n+nrhs)) );
+
+    LAPACK_dsgesv(
+        &n_, &nrhs_,
+        A, &lda_,
+        ipiv,
+        B, &ldb_,
+        X, &ldx_,
+        &work[0],
+        &swork[0], &iter_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *iter = iter_;
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Overloaded versions taking `lapack_int` pivots, for LP64 builds
+/// (32-bit lapack_int), pass ipiv directly to LAPACK, instead of
+/// copying to and from a temporary `int64_t` array.
+/// Otherwise the same as the `int64_t` pivot version.
+/// @see lapack::gesv
+/// @ingroup gesv
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::gesv( n, nrhs ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldx) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int ldx_ = (lapack_int) ldx;
+    lapack_int iter_ = (lapack_int) *iter;
+    lapack_int info_ = 0;
+
+    // allocate workspace
+    lapack::vector< std::complex<double> > work( (n)*(nrhs) );
+    lapack::vector< std::complex<float> > swork( (n*(n+nrhs)) );
+    lapack::vector< double > rwork( (n) );
+
+    LAPACK_zcgesv(
+        &n_, &nrhs_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) B, &ldb_,
+        (lapack_complex_double*) X, &ldx_,
+        (lapack_complex_double*) &work[0],
+        (lapack_complex_float*) &swork[0],
+        &rwork[0], &iter_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *iter = iter_;
+    return info_;
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
@@ -0,0 +1,264 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "Instrument.hh"
+#include "NoConstructAllocator.hh"
+#include "mixed.hh"
+
+namespace lapack {
+
+using blas::max;
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Mixed-precision iterative refinement for gesv_mixed.
+/// Uses A, B, X as in gesv_mixed, and ipiv for the low precision factor.
+/// Does not modify A.
+///
+/// @return number of refinement iterations >= 0 if it converged;
+/// otherwise -2 if a conversion overflowed, -3 if the low precision
+/// factorization failed, or -(itermax + 1) if it did not converge.
+template <typename scalar_t, typename pivot_t>
+int64_t gesv_refine(
+    int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    pivot_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    int64_t itermax )
+{
+    using real_t = blas::real_type< scalar_t >;
+    using low_t = low_precision< scalar_t >;
+    const scalar_t one = 1.0;
+
+    // dlamch( 'Epsilon' ) is half of std::numeric_limits epsilon.
+    real_t eps = std::numeric_limits< real_t >::epsilon() / 2;
+    real_t Anorm = lange( Norm::Inf, n, n, A, lda );
+    real_t cte = Anorm * eps * std::sqrt( real_t( n ) );
+
+    lapack::vector< low_t > SA( n*n );
+    lapack::vector< low_t > SX( n*nrhs );
+    lapack::vector< scalar_t > R( n*nrhs );
+
+    if (to_low( n, n, A, lda, &SA[0], n ) != 0
+        || to_low( n, nrhs, B, ldb, &SX[0], n ) != 0) {
+        return -2;
+    }
+    if (getrf( n, n, &SA[0], n, ipiv ) != 0)
+        return -3;
+    getrs( Op::NoTrans, n, nrhs, &SA[0], n, ipiv, &SX[0], n );
+    to_high( n, nrhs, &SX[0], n, X, ldx );
+
+    for (int64_t iter = 0; iter <= itermax; ++iter) {
+        if (iter > 0) {
+            // Solve A D = R in low precision; update X += D.
+            if (to_low( n, nrhs, &R[0], n, &SX[0], n ) != 0)
+                return -2;
+            getrs( Op::NoTrans, n, nrhs, &SA[0], n, ipiv, &SX[0], n );
+            to_high( n, nrhs, &SX[0], n, &R[0], n );
+            for (int64_t j = 0; j < nrhs; ++j)
+                blas::axpy( n, one, &R[ j*n ], 1, &X[ j*ldx ], 1 );
+        }
+
+        // R = B - A X
+        lacpy( MatrixType::General, n, nrhs, B, ldb, &R[0], n );
+        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, n, nrhs, n,
+                    -one, A, lda, X, ldx, one, &R[0], n );
+        if (mixed_converged( n, nrhs, X, ldx, &R[0], n, cte ))
+            return iter;
+    }
+    return -(itermax + 1);
+}
+
+//------------------------------------------------------------------------------
+/// Generic implementation of gesv_mixed for double and complex<double>,
+/// and int64_t or lapack_int pivots.
+template <typename scalar_t, typename pivot_t>
+int64_t gesv_mixed(
+    int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    pivot_t* ipiv,
+    scalar_t const* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    int64_t* iter, int64_t itermax )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldb < max( 1, n ) );
+    lapack_error_if( ldx < max( 1, n ) );
+    lapack_error_if( itermax < 0 );
+
+    *iter = 0;
+    if (n == 0 || nrhs == 0)
+        return 0;
+
+    *iter = gesv_refine( n, nrhs, A, lda, ipiv, B, ldb, X, ldx, itermax );
+    if (*iter >= 0)
+        return 0;
+
+    // Fall back to factoring and solving in working precision.
+    lacpy( MatrixType::General, n, nrhs, B, ldb, X, ldx );
+    int64_t info = getrf( n, n, A, lda, ipiv );
+    if (info == 0)
+        getrs( Op::NoTrans, n, nrhs, A, lda, ipiv, X, ldx );
+    return info;
+}
+
+}  // namespace internal
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv
+int64_t gesv_mixed(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter, int64_t itermax )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv_mixed", 'd', n, n, nrhs, 0 );
+
+    return internal::gesv_mixed(
+        n, nrhs, A, lda, ipiv, B, ldb, X, ldx, iter, itermax );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the solution to a system of linear equations
+///     $A X = B$,
+/// where A is an n-by-n matrix and X and B are n-by-nrhs matrices,
+/// using mixed-precision iterative refinement.
+///
+/// A is converted to single precision (float or std::complex<float>)
+/// and factored there with getrf, which is typically about twice as fast
+/// as in double precision. The solution is then refined in double
+/// precision: the residual $R = B - A X$ is computed in double, the
+/// correction is solved with the single precision factors, and X is
+/// updated, until for each column
+///     $\max_i |R(i,j)| \le \max_i |X(i,j)| \, ||A||_\infty \, \epsilon \sqrt{n},$
+/// with $\epsilon$ the double precision unit roundoff.
+///
+/// If a conversion overflows, the single precision factorization fails,
+/// or refinement does not converge within itermax iterations, it
+/// automatically falls back to factoring A and solving in double precision
+/// with getrf and getrs. Refinement converges when A is not too
+/// ill-conditioned, roughly $\kappa(A) \lesssim 10^{6}$.
+///
+/// This is equivalent to LAPACK's dsgesv and zcgesv, also available as
+/// gesv overloads with an iter argument, but with a given itermax.
+///
+/// Overloaded versions are available for
+/// `double` and `std::complex<double>`.
+///
+/// @param[in] n
+///     The number of linear equations, i.e., the order of the
+///     matrix A. n >= 0.
+///
+/// @param[in] nrhs
+///     The number of right hand sides, i.e., the number of columns
+///     of the matrices B and X. nrhs >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n matrix A, stored in an lda-by-n array.
+///     On entry, the n-by-n coefficient matrix A.
+///     On exit, if iter >= 0, unchanged.
+///     If iter < 0, the factors L and U from the factorization
+///     $A = P L U$ in double precision;
+///     the unit diagonal elements of L are not stored.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,n).
+///
+/// @param[out] ipiv
+///     The vector ipiv of length n.
+///     The pivot indices that define the permutation matrix P;
+///     row i of the matrix was interchanged with row ipiv(i).
+///     Corresponds either to the single precision factorization
+///     (if iter >= 0) or the double precision factorization (if iter < 0).
+///
+/// @param[in] B
+///     The n-by-nrhs right hand side matrix B, stored in an ldb-by-nrhs array.
+///
+/// @param[in] ldb
+///     The leading dimension of the array B. ldb >= max(1,n).
+///
+/// @param[out] X
+///     The n-by-nrhs solution matrix X, stored in an ldx-by-nrhs array.
+///
+/// @param[in] ldx
+///     The leading dimension of the array X. ldx >= max(1,n).
+///
+/// @param[out] iter
+///     - >= 0: number of refinement iterations needed; 0 if the single
+///             precision solve was accurate enough.
+///     - < 0:  fell back to double precision:
+///       - -2: overflow converting A, B, or a residual to single precision;
+///       - -3: single precision factorization failed;
+///       - -(itermax + 1): refinement did not converge.
+///
+/// @param[in] itermax
+///     Maximum number of refinement iterations, itermax >= 0.
+///     Default 30, as in LAPACK.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, U(i,i) computed in double precision is
+///              exactly zero. The factorization has been completed, but the
+///              factor U is exactly singular, so the solution could not be
+///              computed.
+///
+/// @ingroup gesv
+int64_t gesv_mixed(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter, int64_t itermax )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv_mixed", 'z', n, n, nrhs, 0 );
+
+    return internal::gesv_mixed(
+        n, nrhs, A, lda, ipiv, B, ldb, X, ldx, iter, itermax );
+}
+
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv
+int64_t gesv_mixed(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter, int64_t itermax )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv_mixed", 'd', n, n, nrhs, 0 );
+
+    return internal::gesv_mixed(
+        n, nrhs, A, lda, ipiv, B, ldb, X, ldx, iter, itermax );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv
+int64_t gesv_mixed(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter, int64_t itermax )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesv_mixed", 'z', n, n, nrhs, 0 );
+
+    return internal::gesv_mixed(
+        n, nrhs, A, lda, ipiv, B, ldb, X, ldx, iter, itermax );
+}
+
+#endif  // LAPACK_ILP64
+
+}  // namespace lapack
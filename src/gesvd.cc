@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -24,54 +27,13 @@ int64_t gesvd(
     float* U, int64_t ldu,
     float* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobu_ = job2char( jobu );
-    char jobvt_ = job2char( jobvt );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    float qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_sgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gesvd_work_size_bytes( jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt, &work_size );
 
     // allocate workspace
-    std::vector< float > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_sgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gesvd( jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -83,54 +45,13 @@ int64_t gesvd(
     double* U, int64_t ldu,
     double* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobu_ = job2char( jobu );
-    char jobvt_ = job2char( jobvt );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    double qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gesvd_work_size_bytes( jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt, &work_size );
 
     // allocate workspace
-    std::vector< double > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_dgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gesvd( jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -142,58 +63,13 @@ int64_t gesvd(
     std::complex<float>* U, int64_t ldu,
     std::complex<float>* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobu_ = job2char( jobu );
-    char jobvt_ = job2char( jobvt );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    float qry_rwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        S,
-        (lapack_complex_float*) U, &ldu_,
-        (lapack_complex_float*) VT, &ldvt_,
-        (lapack_complex_float*) qry_work, &ineg_one,
-        qry_rwork, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gesvd_work_size_bytes( jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt, &work_size );
 
     // allocate workspace
-    std::vector< std::complex<float> > work( lwork_ );
-    std::vector< float > rwork( (5*min(m,n)) );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_cgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        S,
-        (lapack_complex_float*) U, &ldu_,
-        (lapack_complex_float*) VT, &ldvt_,
-        (lapack_complex_float*) &work[0], &lwork_,
-        &rwork[0], &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gesvd( jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -313,6 +189,77 @@ int64_t gesvd(
     double* S,
     std::complex<double>* U, int64_t ldu,
     std::complex<double>* VT, int64_t ldvt )
+{
+    size_t work_size;
+    gesvd_work_size_bytes( jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gesvd( jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "sgesvd", { jobu_, jobvt_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    float qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_sgesvd(
+        &jobu_, &jobvt_, &m_, &n_,
+        A, &lda_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< float >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -331,6 +278,133 @@ int64_t gesvd(
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "dgesvd", { jobu_, jobvt_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dgesvd(
+        &jobu_, &jobvt_, &m_, &n_,
+        A, &lda_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< double >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "cgesvd", { jobu_, jobvt_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    float qry_rwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cgesvd(
+        &jobu_, &jobvt_, &m_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        S,
+        (lapack_complex_float*) U, &ldu_,
+        (lapack_complex_float*) VT, &ldvt_,
+        (lapack_complex_float*) qry_work, &ineg_one,
+        qry_rwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // rwork, then work
+    *host_work_size = internal::workspace_bytes< float >( 5*min( m, n ) )
+                    + internal::workspace_bytes< std::complex<float> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::gesvd`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::gesvd`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::gesvd`.
+///
+/// @ingroup gesvd
+void gesvd_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "zgesvd", { jobu_, jobvt_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     std::complex<double> qry_work[1];
     double qry_rwork[1];
@@ -349,9 +423,217 @@ int64_t gesvd(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    std::vector< std::complex<double> > work( lwork_ );
-    std::vector< double > rwork( (5*min(m,n)) );
+    // rwork, then work
+    *host_work_size = internal::workspace_bytes< double >( 5*min( m, n ) )
+                    + internal::workspace_bytes< std::complex<double> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesvd", 's', m, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_sgesvd(
+        &jobu_, &jobvt_, &m_, &n_,
+        A, &lda_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesvd", 'd', m, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
+
+    LAPACK_dgesvd(
+        &jobu_, &jobvt_, &m_, &n_,
+        A, &lda_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesvd", 'c', m, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    float* rwork = workspace.take< float >( 5*min( m, n ) );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_cgesvd(
+        &jobu_, &jobvt_, &m_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        S,
+        (lapack_complex_float*) U, &ldu_,
+        (lapack_complex_float*) VT, &ldvt_,
+        (lapack_complex_float*) work, &lwork_,
+        rwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the singular value decomposition (SVD) of a
+/// m-by-n matrix A, optionally computing the left and/or right singular
+/// vectors,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::gesvd` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in,out] jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt
+///     As for `lapack::gesvd` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::gesvd_work_size_bytes`.
+///
+/// @return = 0: successful exit.
+/// @return > 0: if bdsqr did not converge, return value
+///     specifies how many superdiagonals of an intermediate
+///     bidiagonal form B did not converge to zero.
+///
+/// @ingroup gesvd
+int64_t gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "gesvd", 'z', m, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    double* rwork = workspace.take< double >( 5*min( m, n ) );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zgesvd(
         &jobu_, &jobvt_, &m_, &n_,
@@ -359,8 +641,8 @@ int64_t gesvd(
         S,
         (lapack_complex_double*) U, &ldu_,
         (lapack_complex_double*) VT, &ldvt_,
-        (lapack_complex_double*) &work[0], &lwork_,
-        &rwork[0], &info_
+        (lapack_complex_double*) work, &lwork_,
+        rwork, &info_
     );
     if (info_ < 0) {
         throw Error();
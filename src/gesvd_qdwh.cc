@@ -0,0 +1,117 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/polar.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t gesvd_qdwh(
+    lapack::Job jobz, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt )
+{
+    using blas::conj;
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // check arguments
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::SomeVec );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldu < 1 || (jobz == Job::SomeVec && ldu < m) );
+    lapack_error_if( ldvt < 1 || (jobz == Job::SomeVec && ldvt < min( m, n )) );
+
+    int64_t minmn = min( m, n );
+    if (minmn == 0)
+        return 0;
+
+    // Work on the tall matrix B = A, or A^H if m < n; mb >= nb.
+    bool wide = m < n;
+    int64_t mb = max( m, n );
+    std::vector< scalar_t > B;
+    scalar_t* Bp = A;
+    int64_t ldb = lda;
+    if (wide) {
+        B.resize( mb * minmn );
+        for (int64_t j = 0; j < m; ++j) {
+            for (int64_t i = 0; i < n; ++i)
+                B[ i + j*mb ] = conj( A[ j + i*lda ] );
+        }
+        Bp = &B[ 0 ];
+        ldb = mb;
+    }
+
+    // B = Up H, H = V Lambda V^H, so B = (Up V) Lambda V^H
+    std::vector< scalar_t > H( minmn * minmn );
+    std::vector< real_t > Lambda( minmn );
+    int64_t info = lapack::qdwh( mb, minmn, Bp, ldb, &H[ 0 ], minmn );
+    if (info != 0)
+        return info;
+    Job jobv = (jobz == Job::NoVec ? Job::NoVec : Job::Vec);
+    info = lapack::heevd_qdwh( jobv, Uplo::Lower, minmn, &H[ 0 ], minmn,
+                               &Lambda[ 0 ] );
+    if (info != 0)
+        return info;
+
+    // singular values in descending order; H is positive semidefinite,
+    // up to rounding
+    for (int64_t i = 0; i < minmn; ++i)
+        S[ i ] = max( Lambda[ minmn-1 - i ], real_t( 0 ) );
+    if (jobz == Job::NoVec)
+        return 0;
+
+    // V = H with columns reversed, W = Up V
+    std::vector< scalar_t > V( minmn * minmn ), W( mb * minmn );
+    for (int64_t j = 0; j < minmn; ++j)
+        blas::copy( minmn, &H[ (minmn-1 - j)*minmn ], 1, &V[ j*minmn ], 1 );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                mb, minmn, minmn,
+                one,  Bp, ldb, &V[ 0 ], minmn,
+                zero, &W[ 0 ], mb );
+
+    // A = W Sigma V^H, or if wide, A = V Sigma W^H
+    scalar_t* Up = (wide ? &V[ 0 ] : &W[ 0 ]);
+    int64_t   ldup = (wide ? minmn : mb);
+    scalar_t* Vp = (wide ? &W[ 0 ] : &V[ 0 ]);
+    int64_t   ldvp = (wide ? mb : minmn);
+    lapack::lacpy( MatrixType::General, m, minmn, Up, ldup, U, ldu );
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < minmn; ++i)
+            VT[ i + j*ldvt ] = conj( Vp[ j + i*ldvp ] );
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_GESVD_QDWH_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t gesvd_qdwh< scalar_t >( \
+        lapack::Job jobz, int64_t m, int64_t n, \
+        scalar_t* A, int64_t lda, \
+        blas::real_type< scalar_t >* S, \
+        scalar_t* U, int64_t ldu, \
+        scalar_t* VT, int64_t ldvt );
+
+LAPACK_GESVD_QDWH_INSTANTIATE( float )
+LAPACK_GESVD_QDWH_INSTANTIATE( double )
+LAPACK_GESVD_QDWH_INSTANTIATE( std::complex<float> )
+LAPACK_GESVD_QDWH_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_GESVD_QDWH_INSTANTIATE
+
+}  // namespace lapack
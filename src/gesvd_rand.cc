@@ -0,0 +1,173 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/randomized.hh"
+#include "sketch.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Overwrites the m-by-l matrix Y with an orthonormal basis of its range.
+template <typename scalar_t>
+static void orth( int64_t m, int64_t l, scalar_t* Y, int64_t ldy,
+                  scalar_t* tau )
+{
+    lapack::geqrf( m, l, Y, ldy, tau );
+    lapack::ungqr( m, l, l, Y, ldy, tau );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t gesvd_rand(
+    lapack::Job jobz, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    int64_t* rank,
+    blas::real_type< scalar_t >* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    int64_t* iseed,
+    blas::real_type< scalar_t > tol,
+    int64_t oversample,
+    int64_t power,
+    lapack::Sketch sketch )
+{
+    using blas::conj;
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // check arguments
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( k < 0 || k > min( m, n ) );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldu < 1 || (jobz == Job::Vec && ldu < m) );
+    lapack_error_if( ldvt < 1 || (jobz == Job::Vec && ldvt < k) );
+    lapack_error_if( oversample < 0 );
+    lapack_error_if( power < 0 );
+    lapack_error_if( sketch != Sketch::Gaussian && sketch != Sketch::SRHT );
+
+    *rank = 0;
+    if (k == 0)
+        return 0;
+
+    int64_t l = min( k + oversample, min( m, n ) );
+
+    // Q = orth( A Omega ), m-by-l
+    std::vector< scalar_t > Q( m * l ), Z( n * l ), tau( l );
+    internal::sketch( Side::Right, sketch, m, n, l, A, lda, &Q[ 0 ], m, iseed );
+    orth( m, l, &Q[ 0 ], m, &tau[ 0 ] );
+
+    // power iterations, Q = orth( A orth( A^H Q ) )
+    for (int64_t iter = 0; iter < power; ++iter) {
+        blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                    n, l, m,
+                    one,  A, lda, &Q[ 0 ], m,
+                    zero, &Z[ 0 ], n );
+        orth( n, l, &Z[ 0 ], n, &tau[ 0 ] );
+        blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                    m, l, n,
+                    one,  A, lda, &Z[ 0 ], n,
+                    zero, &Q[ 0 ], m );
+        orth( m, l, &Q[ 0 ], m, &tau[ 0 ] );
+    }
+
+    // A^H Q = Qb R, so A = Q Q^H A = Q R^H Qb^H, with Qb kept as
+    // Householder reflectors in Z.
+    blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                n, l, m,
+                one,  A, lda, &Q[ 0 ], m,
+                zero, &Z[ 0 ], n );
+    lapack::geqrf( n, l, &Z[ 0 ], n, &tau[ 0 ] );
+
+    // B = R^H, lower triangular l-by-l; B = Ur Sigma Vr^H
+    std::vector< scalar_t > B( l * l, zero );
+    for (int64_t j = 0; j < l; ++j) {
+        for (int64_t i = j; i < l; ++i)
+            B[ i + j*l ] = conj( Z[ j + i*n ] );
+    }
+    std::vector< real_t > Sb( l );
+    std::vector< scalar_t > Ur, VrT;
+    int64_t ldur = 1;
+    if (jobz == Job::Vec) {
+        ldur = l;
+        Ur.resize( l * l );
+        VrT.resize( l * l );
+    }
+    else {
+        Ur.resize( 1 );
+        VrT.resize( 1 );
+    }
+    int64_t info = lapack::gesdd( jobz == Job::Vec ? Job::AllVec : Job::NoVec,
+                                  l, l, &B[ 0 ], l, &Sb[ 0 ],
+                                  &Ur[ 0 ], ldur, &VrT[ 0 ], ldur );
+
+    // truncate to rank
+    int64_t r = k;
+    if (tol > 0) {
+        r = 0;
+        while (r < k && Sb[ r ] > tol * Sb[ 0 ])
+            ++r;
+    }
+    *rank = r;
+    std::copy( Sb.begin(), Sb.begin() + r, S );
+    std::fill( S + r, S + k, real_t( 0 ) );
+
+    if (jobz == Job::Vec) {
+        // U = Q Ur( :, 0:k-1 )
+        blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                    m, k, l,
+                    one,  &Q[ 0 ], m, &Ur[ 0 ], l,
+                    zero, U, ldu );
+
+        // V = Qb [ Vr( :, 0:k-1 ); 0 ], n-by-k, then VT = V^H
+        std::vector< scalar_t > V( n * k, zero );
+        for (int64_t j = 0; j < k; ++j) {
+            for (int64_t i = 0; i < l; ++i)
+                V[ i + j*n ] = conj( VrT[ j + i*l ] );
+        }
+        lapack::unmqr( Side::Left, Op::NoTrans, n, k, l,
+                       &Z[ 0 ], n, &tau[ 0 ], &V[ 0 ], n );
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < k; ++i)
+                VT[ i + j*ldvt ] = conj( V[ j + i*n ] );
+        }
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_GESVD_RAND_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t gesvd_rand< scalar_t >( \
+        lapack::Job jobz, int64_t m, int64_t n, int64_t k, \
+        scalar_t const* A, int64_t lda, \
+        int64_t* rank, \
+        blas::real_type< scalar_t >* S, \
+        scalar_t* U, int64_t ldu, \
+        scalar_t* VT, int64_t ldvt, \
+        int64_t* iseed, \
+        blas::real_type< scalar_t > tol, \
+        int64_t oversample, \
+        int64_t power, \
+        lapack::Sketch sketch );
+
+LAPACK_GESVD_RAND_INSTANTIATE( float )
+LAPACK_GESVD_RAND_INSTANTIATE( double )
+LAPACK_GESVD_RAND_INSTANTIATE( std::complex<float> )
+LAPACK_GESVD_RAND_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_GESVD_RAND_INSTANTIATE
+
+}  // namespace lapack
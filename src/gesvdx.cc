@@ -6,6 +6,8 @@
 #include "lapack.hh"
 #include "lapack/fortran.h"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #if LAPACK_VERSION >= 30600  // >= v3.6
 
@@ -27,65 +29,13 @@ int64_t gesvdx(
     float* U, int64_t ldu,
     float* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobu_ = job2char( jobu );
-    char jobvt_ = job2char( jobvt );
-    char range_ = range2char( range );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int il_ = (lapack_int) il;
-    lapack_int iu_ = (lapack_int) iu;
-    lapack_int nfound_ = (lapack_int) *nfound;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    float qry_work[1];
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_sgesvdx(
-        &jobu_, &jobvt_, &range_, &m_, &n_,
-        A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        qry_work, &ineg_one,
-        qry_iwork, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gesvdx_work_size_bytes( jobu, jobvt, range, m, n, A, lda, vl, vu, il, iu, nfound, S, U, ldu, VT, ldvt, &work_size );
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (12*min(m,n)) );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_sgesvdx(
-        &jobu_, &jobvt_, &range_, &m_, &n_,
-        A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        &work[0], &lwork_,
-        &iwork[0], &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    *nfound = nfound_;
-    return info_;
+    return gesvdx( jobu, jobvt, range, m, n, A, lda, vl, vu, il, iu, nfound, S, U, ldu, VT, ldvt, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -98,65 +48,13 @@ int64_t gesvdx(
     double* U, int64_t ldu,
     double* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobu_ = job2char( jobu );
-    char jobvt_ = job2char( jobvt );
-    char range_ = range2char( range );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int il_ = (lapack_int) il;
-    lapack_int iu_ = (lapack_int) iu;
-    lapack_int nfound_ = (lapack_int) *nfound;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    double qry_work[1];
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dgesvdx(
-        &jobu_, &jobvt_, &range_, &m_, &n_,
-        A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        qry_work, &ineg_one,
-        qry_iwork, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    gesvdx_work_size_bytes( jobu, jobvt, range, m, n, A, lda, vl, vu, il, iu, nfound, S, U, ldu, VT, ldvt, &work_size );
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (12*min(m,n)) );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_dgesvdx(
-        &jobu_, &jobvt_, &range_, &m_, &n_,
-        A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        &work[0], &lwork_,
-        &iwork[0], &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    *nfound = nfound_;
-    return info_;
+    return gesvdx( jobu, jobvt, range, m, n, A, lda, vl, vu, il, iu, nfound, S, U, ldu, VT, ldvt, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -169,72 +67,13 @@ int64_t gesvdx(
     std::complex<float>* U, int64_t ldu,
     std::complex<float>* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobu_ = job2char( jobu );
-    char jobvt_ = job2char( jobvt );
-    char range_ = range2char( range );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int il_ = (lapack_int) il;
-    lapack_int iu_ = (lapack_int) iu;
-    lapack_int nfound_ = (lapack_int) *nfound;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    float qry_rwork[1];
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cgesvdx(
-        &jobu_, &jobvt_, &range_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
-        S,
-        (lapack_complex_float*) U, &ldu_,
-        (lapack_complex_float*) VT, &ldvt_,
-        (lapack_complex_float*) qry_work, &ineg_one,
-        qry_rwork,
-        qry_iwork, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
-
-    // from docs
-    int64_t lrwork = min(m,n)*(min(m,n)*2 + 15*min(m,n));
+    size_t work_size;
+    gesvdx_work_size_bytes( jobu, jobvt, range, m, n, A, lda, vl, vu, il, iu, nfound, S, U, ldu, VT, ldvt, &work_size );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( (max( 1, lrwork )) );
-    lapack::vector< lapack_int > iwork( (12*min(m,n)) );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_cgesvdx(
-        &jobu_, &jobvt_, &range_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
-        S,
-        (lapack_complex_float*) U, &ldu_,
-        (lapack_complex_float*) VT, &ldvt_,
-        (lapack_complex_float*) &work[0], &lwork_,
-        &rwork[0],
-        &iwork[0], &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    *nfound = nfound_;
-    return info_;
+    return gesvdx( jobu, jobvt, range, m, n, A, lda, vl, vu, il, iu, nfound, S, U, ldu, VT, ldvt, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -373,6 +212,26 @@ int64_t gesvdx(
     double* S,
     std::complex<double>* U, int64_t ldu,
     std::complex<double>* VT, int64_t ldvt )
+{
+    size_t work_size;
+    gesvdx_work_size_bytes( jobu, jobvt, range, m, n, A, lda, vl, vu, il, iu, nfound, S, U, ldu, VT, ldvt, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return gesvdx( jobu, jobvt, range, m, n, A, lda, vl, vu, il, iu, nfound, S, U, ldu, VT, ldvt, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -392,24 +251,27 @@ int64_t gesvdx(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int il_ = (lapack_int) il;
     lapack_int iu_ = (lapack_int) iu;
-    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int nfound_ = 0;
     lapack_int ldu_ = (lapack_int) ldu;
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "sgesvdx", { jobu_, jobvt_, range_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
-    std::complex<double> qry_work[1];
-    double qry_rwork[1];
+    float qry_work[1];
     lapack_int qry_iwork[1];
     lapack_int ineg_one = -1;
-    LAPACK_zgesvdx(
+    LAPACK_sgesvdx(
         &jobu_, &jobvt_, &range_, &m_, &n_,
-        (lapack_complex_double*) A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
+        A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
         S,
-        (lapack_complex_double*) U, &ldu_,
-        (lapack_complex_double*) VT, &ldvt_,
-        (lapack_complex_double*) qry_work, &ineg_one,
-        qry_rwork,
+        U, &ldu_,
+        VT, &ldvt_,
+        qry_work, &ineg_one,
         qry_iwork, &info_
     );
     if (info_ < 0) {
@@ -417,13 +279,476 @@ int64_t gesvdx(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // from docs
-    int64_t lrwork = min(m,n)*(min(m,n)*2 + 15*min(m,n));
+    // iwork, then work
+    size_t size = 0;
+    size += internal::workspace_bytes< lapack_int >( 12*min(m,n) );
+    size += internal::workspace_bytes< float >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( (max( 1, lrwork )) );
-    lapack::vector< lapack_int > iwork( (12*min(m,n)) );
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    char range_ = range2char( range );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = 0;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "dgesvdx", { jobu_, jobvt_, range_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dgesvdx(
+        &jobu_, &jobvt_, &range_, &m_, &n_,
+        A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        qry_work, &ineg_one,
+        qry_iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // iwork, then work
+    size_t size = 0;
+    size += internal::workspace_bytes< lapack_int >( 12*min(m,n) );
+    size += internal::workspace_bytes< double >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    char range_ = range2char( range );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = 0;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "cgesvdx", { jobu_, jobvt_, range_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    float qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cgesvdx(
+        &jobu_, &jobvt_, &range_, &m_, &n_,
+        (lapack_complex_float*) A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
+        S,
+        (lapack_complex_float*) U, &ldu_,
+        (lapack_complex_float*) VT, &ldvt_,
+        (lapack_complex_float*) qry_work, &ineg_one,
+        qry_rwork,
+        qry_iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // from docs
+    int64_t lrwork = min(m,n)*(min(m,n)*2 + 15*min(m,n));
+
+    // iwork, rwork, then work
+    size_t size = 0;
+    size += internal::workspace_bytes< lapack_int >( 12*min(m,n) );
+    size += internal::workspace_bytes< float >( max( 1, lrwork ) );
+    size += internal::workspace_bytes< std::complex<float> >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::gesvdx`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::gesvdx`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::gesvdx`.
+///
+/// @ingroup gesvd
+void gesvdx_work_size_bytes(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    char range_ = range2char( range );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = 0;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "zgesvdx", { jobu_, jobvt_, range_, m_, n_, lda_, ldu_, ldvt_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<double> qry_work[1];
+    double qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_zgesvdx(
+        &jobu_, &jobvt_, &range_, &m_, &n_,
+        (lapack_complex_double*) A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
+        S,
+        (lapack_complex_double*) U, &ldu_,
+        (lapack_complex_double*) VT, &ldvt_,
+        (lapack_complex_double*) qry_work, &ineg_one,
+        qry_rwork,
+        qry_iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // from docs
+    int64_t lrwork = min(m,n)*(min(m,n)*2 + 15*min(m,n));
+
+    // iwork, rwork, then work
+    size_t size = 0;
+    size += internal::workspace_bytes< lapack_int >( 12*min(m,n) );
+    size += internal::workspace_bytes< double >( max( 1, lrwork ) );
+    size += internal::workspace_bytes< std::complex<double> >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    char range_ = range2char( range );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( 12*min(m,n) );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_sgesvdx(
+        &jobu_, &jobvt_, &range_, &m_, &n_,
+        A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        work, &lwork_,
+        iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *nfound = nfound_;
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    char range_ = range2char( range );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( 12*min(m,n) );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
+
+    LAPACK_dgesvdx(
+        &jobu_, &jobvt_, &range_, &m_, &n_,
+        A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
+        S,
+        U, &ldu_,
+        VT, &ldvt_,
+        work, &lwork_,
+        iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *nfound = nfound_;
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    char range_ = range2char( range );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // from docs
+    int64_t lrwork = min(m,n)*(min(m,n)*2 + 15*min(m,n));
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( 12*min(m,n) );
+    float* rwork = workspace.take< float >( max( 1, lrwork ) );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_cgesvdx(
+        &jobu_, &jobvt_, &range_, &m_, &n_,
+        (lapack_complex_float*) A, &lda_, &vl, &vu, &il_, &iu_, &nfound_,
+        S,
+        (lapack_complex_float*) U, &ldu_,
+        (lapack_complex_float*) VT, &ldvt_,
+        (lapack_complex_float*) work, &lwork_,
+        rwork,
+        iwork, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *nfound = nfound_;
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Computes selected singular values and, optionally, singular vectors
+/// of an m-by-n matrix A,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::gesvdx` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in,out] jobu, jobvt, range, m, n, A, lda, vl, vu, il, iu, nfound, S, U, ldu, VT, ldvt
+///     As for `lapack::gesvdx` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::gesvdx_work_size_bytes`.
+///
+/// @return = 0: successful exit
+/// @return > 0 and <= n: if return value = i, then i eigenvectors failed to
+///              converge in `lapack::bdsvdx`/`lapack::stevx`.
+/// @return > n: if return value = 2*n + 1, an internal error occurred in
+///              `lapack::bdsvdx`
+///
+/// @ingroup gesvd
+int64_t gesvdx(
+    lapack::Job jobu, lapack::Job jobvt, lapack::Range range, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    void* host_work, size_t host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobu_ = job2char( jobu );
+    char jobvt_ = job2char( jobvt );
+    char range_ = range2char( range );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // from docs
+    int64_t lrwork = min(m,n)*(min(m,n)*2 + 15*min(m,n));
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int* iwork = workspace.take< lapack_int >( 12*min(m,n) );
+    double* rwork = workspace.take< double >( max( 1, lrwork ) );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zgesvdx(
         &jobu_, &jobvt_, &range_, &m_, &n_,
@@ -431,9 +756,9 @@ int64_t gesvdx(
         S,
         (lapack_complex_double*) U, &ldu_,
         (lapack_complex_double*) VT, &ldvt_,
-        (lapack_complex_double*) &work[0], &lwork_,
-        &rwork[0],
-        &iwork[0], &info_
+        (lapack_complex_double*) work, &lwork_,
+        rwork,
+        iwork, &info_
     );
     if (info_ < 0) {
         throw Error();
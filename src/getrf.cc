@@ -5,6 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
+#include "fixed.hh"
+#include "native.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +25,18 @@ int64_t getrf(
     float* A, int64_t lda,
     int64_t* ipiv )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getrf", 's', m, n, 0,
+                             Gflop< float >::getrf( m, n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (m == n && internal::use_fixed( n ) && lda >= n) {
+        return internal::fixed_getrf( n, A, lda, ipiv );
+    }
+
+    if (getrf_method() == Method::Native) {
+        return internal::getrf_native( m, n, A, lda, ipiv, getrf_block_size() );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -60,6 +75,18 @@ int64_t getrf(
     double* A, int64_t lda,
     int64_t* ipiv )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getrf", 'd', m, n, 0,
+                             Gflop< double >::getrf( m, n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (m == n && internal::use_fixed( n ) && lda >= n) {
+        return internal::fixed_getrf( n, A, lda, ipiv );
+    }
+
+    if (getrf_method() == Method::Native) {
+        return internal::getrf_native( m, n, A, lda, ipiv, getrf_block_size() );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -98,6 +125,18 @@ int64_t getrf(
     std::complex<float>* A, int64_t lda,
     int64_t* ipiv )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getrf", 'c', m, n, 0,
+                             Gflop< std::complex<float> >::getrf( m, n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (m == n && internal::use_fixed( n ) && lda >= n) {
+        return internal::fixed_getrf( n, A, lda, ipiv );
+    }
+
+    if (getrf_method() == Method::Native) {
+        return internal::getrf_native( m, n, A, lda, ipiv, getrf_block_size() );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -142,6 +181,8 @@ int64_t getrf(
 /// triangular (upper trapezoidal if m < n).
 ///
 /// This is the right-looking Level 3 BLAS version of the algorithm.
+/// getrf_set_method selects whether it calls the vendor LAPACK (default)
+/// or LAPACK++'s native, multithreaded recursive LU.
 ///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
@@ -178,6 +219,18 @@ int64_t getrf(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getrf", 'z', m, n, 0,
+                             Gflop< std::complex<double> >::getrf( m, n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (m == n && internal::use_fixed( n ) && lda >= n) {
+        return internal::fixed_getrf( n, A, lda, ipiv );
+    }
+
+    if (getrf_method() == Method::Native) {
+        return internal::getrf_native( m, n, A, lda, ipiv, getrf_block_size() );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -209,4 +262,173 @@ int64_t getrf(
     return info_;
 }
 
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+int64_t getrf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getrf", 's', m, n, 0,
+                             Gflop< float >::getrf( m, n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (m == n && internal::use_fixed( n ) && lda >= n) {
+        return internal::fixed_getrf( n, A, lda, ipiv );
+    }
+
+    if (getrf_method() == Method::Native) {
+        return internal::getrf_native( m, n, A, lda, ipiv, getrf_block_size() );
+    }
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    LAPACK_sgetrf(
+        &m_, &n_,
+        A, &lda_,
+        ipiv, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+int64_t getrf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getrf", 'd', m, n, 0,
+                             Gflop< double >::getrf( m, n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (m == n && internal::use_fixed( n ) && lda >= n) {
+        return internal::fixed_getrf( n, A, lda, ipiv );
+    }
+
+    if (getrf_method() == Method::Native) {
+        return internal::getrf_native( m, n, A, lda, ipiv, getrf_block_size() );
+    }
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    LAPACK_dgetrf(
+        &m_, &n_,
+        A, &lda_,
+        ipiv, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+int64_t getrf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getrf", 'c', m, n, 0,
+                             Gflop< std::complex<float> >::getrf( m, n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (m == n && internal::use_fixed( n ) && lda >= n) {
+        return internal::fixed_getrf( n, A, lda, ipiv );
+    }
+
+    if (getrf_method() == Method::Native) {
+        return internal::getrf_native( m, n, A, lda, ipiv, getrf_block_size() );
+    }
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    LAPACK_cgetrf(
+        &m_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Overloaded versions taking `lapack_int` pivots, for LP64 builds
+/// (32-bit lapack_int), pass ipiv directly to LAPACK, instead of
+/// copying to and from a temporary `int64_t` array.
+/// Otherwise the same as the `int64_t` pivot version.
+/// @see lapack::getrf
+/// @ingroup gesv_computational
+int64_t getrf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getrf", 'z', m, n, 0,
+                             Gflop< std::complex<double> >::getrf( m, n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (m == n && internal::use_fixed( n ) && lda >= n) {
+        return internal::fixed_getrf( n, A, lda, ipiv );
+    }
+
+    if (getrf_method() == Method::Native) {
+        return internal::getrf_native( m, n, A, lda, ipiv, getrf_block_size() );
+    }
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    LAPACK_zgetrf(
+        &m_, &n_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
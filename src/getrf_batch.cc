@@ -0,0 +1,158 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "batch.hh"
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Computes LU factorizations, with partial pivoting, of a batch of
+/// general m-by-n matrices, $A_i = P_i L_i U_i$. See `lapack::getrf`.
+/// Matrices are factored in parallel; see lapack/batch.hh.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of each matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of each matrix A. n >= 0.
+///
+/// @param[in,out] Aarray
+///     Array of batch_count pointers to m-by-n matrices A, each stored in
+///     an lda-by-n array. On exit, the factors L and U.
+///
+/// @param[in] lda
+///     The leading dimension of each A. lda >= max(1,m).
+///
+/// @param[out] ipiv_array
+///     Array of batch_count pointers to pivot vectors, each of length
+///     min(m,n).
+///
+/// @param[out] info
+///     Array of length batch_count. info[ i ] is the `lapack::getrf` return
+///     value for the i-th matrix: 0 on success; > 0 if U(i,i) is exactly zero.
+///
+/// @param[in] batch_count
+///     The number of matrices. batch_count >= 0.
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrf_batch(
+    int64_t m, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    int64_t* const* ipiv_array,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( batch_count < 0 );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int ) {
+        info[ i ] = getrf( m, n, Aarray[ i ], lda, ipiv_array[ i ] );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes LU factorizations of a batch of general m-by-n matrices
+/// stored with a fixed stride. Otherwise the same as `lapack::getrf_batch`.
+///
+/// @param[in,out] A
+///     The i-th matrix A is stored at A + i*strideA.
+///
+/// @param[in] strideA
+///     Stride between matrices in A. strideA >= lda*n.
+///
+/// @param[out] ipiv
+///     The i-th pivot vector is stored at ipiv + i*stride_ipiv.
+///
+/// @param[in] stride_ipiv
+///     Stride between pivot vectors. stride_ipiv >= min(m,n).
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrf_strided_batch(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( stride_ipiv < blas::min( m, n ) );
+    lapack_error_if( batch_count < 0 );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int ) {
+        info[ i ] = getrf( m, n, &A[ i*strideA ], lda, &ipiv[ i*stride_ipiv ] );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrf_batch<float>(
+    int64_t m, int64_t n,
+    float* const* Aarray, int64_t lda,
+    int64_t* const* ipiv_array,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrf_batch<double>(
+    int64_t m, int64_t n,
+    double* const* Aarray, int64_t lda,
+    int64_t* const* ipiv_array,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrf_batch< std::complex<float> >(
+    int64_t m, int64_t n,
+    std::complex<float>* const* Aarray, int64_t lda,
+    int64_t* const* ipiv_array,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrf_batch< std::complex<double> >(
+    int64_t m, int64_t n,
+    std::complex<double>* const* Aarray, int64_t lda,
+    int64_t* const* ipiv_array,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrf_strided_batch<float>(
+    int64_t m, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrf_strided_batch<double>(
+    int64_t m, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrf_strided_batch< std::complex<float> >(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrf_strided_batch< std::complex<double> >(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count );
+
+}  // namespace lapack
@@ -0,0 +1,301 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "batch.hh"
+#include "native.hh"
+
+#include <atomic>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace {
+
+std::atomic< char >    g_getrf_method( char( Method::Vendor ) );
+std::atomic< int64_t > g_getrf_nb( 128 );
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+void getrf_set_method( Method method )
+{
+    g_getrf_method.store( char( method ), std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+Method getrf_method()
+{
+    return Method( g_getrf_method.load( std::memory_order_relaxed ) );
+}
+
+//------------------------------------------------------------------------------
+void getrf_set_block_size( int64_t nb )
+{
+    lapack_error_if( nb < 1 );
+    g_getrf_nb.store( nb, std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+int64_t getrf_block_size()
+{
+    return g_getrf_nb.load( std::memory_order_relaxed );
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Applies row interchanges k1, ..., k2-1 in ipiv to the n columns of A,
+/// as laswp does: row i is swapped with row ipiv[ i ] - 1 (1-based ipiv).
+template <typename scalar_t, typename pivot_t>
+void swap_rows(
+    int64_t n, scalar_t* A, int64_t lda,
+    int64_t k1, int64_t k2, pivot_t const* ipiv )
+{
+    for (int64_t j = 0; j < n; ++j) {
+        scalar_t* Aj = &A[ j*lda ];
+        for (int64_t i = k1; i < k2; ++i) {
+            int64_t ip = ipiv[ i ] - 1;
+            if (ip != i)
+                std::swap( Aj[ i ], Aj[ ip ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Recursive LU factorization of an m-by-n panel, as in LAPACK's getrf2:
+/// factors the left half, updates the right half, then factors the
+/// lower right part. Pivots are 1-based, relative to the panel's first row.
+/// @return 0, or i > 0 if U(i,i) is exactly zero.
+template <typename scalar_t, typename pivot_t>
+int64_t getrf_recursive(
+    int64_t m, int64_t n, scalar_t* A, int64_t lda, pivot_t* ipiv )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    if (m == 0 || n == 0)
+        return 0;
+
+    if (m == 1) {
+        ipiv[ 0 ] = 1;
+        return (A[ 0 ] == zero ? 1 : 0);
+    }
+
+    if (n == 1) {
+        int64_t i = blas::iamax( m, A, 1 );
+        ipiv[ 0 ] = pivot_t( i + 1 );
+        if (A[ i ] == zero)
+            return 1;
+        if (i != 0)
+            std::swap( A[ 0 ], A[ i ] );
+        if (std::abs( A[ 0 ] ) >= std::numeric_limits< real_t >::min()) {
+            blas::scal( m - 1, one / A[ 0 ], &A[ 1 ], 1 );
+        }
+        else {
+            for (int64_t k = 1; k < m; ++k)
+                A[ k ] /= A[ 0 ];
+        }
+        return 0;
+    }
+
+    int64_t mn = min( m, n );
+    int64_t n1 = mn / 2;
+    int64_t n2 = n - n1;
+    scalar_t* A12 = &A[ n1*lda ];
+    scalar_t* A21 = &A[ n1 ];
+    scalar_t* A22 = &A[ n1 + n1*lda ];
+
+    // Factor [ A11; A21 ].
+    int64_t info = getrf_recursive( m, n1, A, lda, ipiv );
+
+    // Update [ A12; A22 ].
+    swap_rows( n2, A12, lda, 0, n1, ipiv );
+    blas::trsm( Layout::ColMajor, Side::Left, Uplo::Lower,
+                Op::NoTrans, Diag::Unit, n1, n2,
+                one, A, lda, A12, lda );
+    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m - n1, n2, n1,
+                -one, A21, lda, A12, lda, one, A22, lda );
+
+    // Factor A22 and apply its pivots to A21.
+    int64_t info2 = getrf_recursive( m - n1, n2, A22, lda, &ipiv[ n1 ] );
+    if (info == 0 && info2 > 0)
+        info = info2 + n1;
+    for (int64_t i = n1; i < mn; ++i)
+        ipiv[ i ] += pivot_t( n1 );
+    swap_rows( n1, A, lda, n1, mn, ipiv );
+
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Applies panel k, i.e., rows and columns k0 : k0 + kb - 1 factored with
+/// pivots ipiv (1-based, relative to row 0), to the jb columns of A
+/// starting at column j0: row swaps, triangular solve, and trailing update.
+template <typename scalar_t, typename pivot_t>
+void getrf_update(
+    int64_t m, int64_t k0, int64_t kb, int64_t j0, int64_t jb,
+    scalar_t* A, int64_t lda, pivot_t const* ipiv )
+{
+    const scalar_t one = 1.0;
+
+    swap_rows( jb, &A[ j0*lda ], lda, k0, k0 + kb, ipiv );
+    blas::trsm( Layout::ColMajor, Side::Left, Uplo::Lower,
+                Op::NoTrans, Diag::Unit, kb, jb,
+                one, &A[ k0 + k0*lda ], lda, &A[ k0 + j0*lda ], lda );
+    if (m > k0 + kb) {
+        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                    m - k0 - kb, jb, kb,
+                    -one, &A[ k0 + kb + k0*lda ], lda,
+                          &A[ k0      + j0*lda ], lda,
+                    one,  &A[ k0 + kb + j0*lda ], lda );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Right-looking blocked LU with look-ahead, one OpenMP task per panel
+/// factorization and per block column update. Tasks on block column j
+/// are ordered by a dependency on column[ j ]. Panel k + 1 depends only on
+/// its update by panel k, so it starts while the remaining columns are
+/// still being updated; it and its update have higher priority.
+/// Afterwards, the pivots of later panels are applied to the columns
+/// left of them, in parallel over block columns.
+template <typename scalar_t, typename pivot_t>
+int64_t getrf_native(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    pivot_t* ipiv, int64_t nb )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( nb < 1 );
+
+    if (m == 0 || n == 0)
+        return 0;
+
+    int64_t mn = min( m, n );
+    if (n <= nb)
+        return getrf_recursive( m, n, A, lda, ipiv );
+
+    int64_t nt = (n  + nb - 1) / nb;  // block columns
+    int64_t kt = (mn + nb - 1) / nb;  // panels
+    std::vector< int64_t > panel_info( kt, 0 );
+    std::vector< char > column( nt );
+    char* col = column.data();
+
+    // Each task calls the vendor BLAS with one thread.
+    std::optional< VendorSingleThread > single_thread;
+    #ifdef _OPENMP
+        if (omp_get_max_threads() > 1)
+            single_thread.emplace();
+    #endif
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t k = 0; k < kt; ++k) {
+            int64_t k0 = k*nb;
+            int64_t kb = min( nb, mn - k0 );
+
+            // Factor panel k. If m < n, the last block column is wider than
+            // the last panel; update the rest of it here.
+            #pragma omp task depend( inout: col[ k ] ) priority( 1 ) \
+                firstprivate( k, k0, kb ) shared( panel_info )
+            {
+                int64_t iinfo = getrf_recursive(
+                    m - k0, kb, &A[ k0 + k0*lda ], lda, &ipiv[ k0 ] );
+                if (iinfo > 0)
+                    panel_info[ k ] = iinfo + k0;
+                for (int64_t i = k0; i < k0 + kb; ++i)
+                    ipiv[ i ] += pivot_t( k0 );
+
+                int64_t jb = min( nb, n - k0 );
+                if (jb > kb)
+                    getrf_update( m, k0, kb, k0 + kb, jb - kb, A, lda, ipiv );
+            }
+
+            // Update block columns right of panel k;
+            // block column k + 1 is the look-ahead.
+            for (int64_t j = k + 1; j < nt; ++j) {
+                int64_t j0 = j*nb;
+                int64_t jb = min( nb, n - j0 );
+                #pragma omp task depend( in: col[ k ] ) depend( inout: col[ j ] ) \
+                    priority( j == k + 1 ? 1 : 0 ) firstprivate( k0, kb, j0, jb )
+                {
+                    getrf_update( m, k0, kb, j0, jb, A, lda, ipiv );
+                }
+            }
+        }
+    }
+
+    // Apply pivots of panels k > j to block column j.
+    #pragma omp parallel for schedule( dynamic )
+    for (int64_t j = 0; j < kt - 1; ++j) {
+        int64_t j0 = j*nb;
+        swap_rows( nb, &A[ j0*lda ], lda, j0 + nb, mn, ipiv );
+    }
+
+    for (int64_t k = 0; k < kt; ++k) {
+        if (panel_info[ k ] > 0)
+            return panel_info[ k ];
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t getrf_native< float, int64_t >(
+    int64_t m, int64_t n, float* A, int64_t lda,
+    int64_t* ipiv, int64_t nb );
+
+template
+int64_t getrf_native< double, int64_t >(
+    int64_t m, int64_t n, double* A, int64_t lda,
+    int64_t* ipiv, int64_t nb );
+
+template
+int64_t getrf_native< std::complex<float>, int64_t >(
+    int64_t m, int64_t n, std::complex<float>* A, int64_t lda,
+    int64_t* ipiv, int64_t nb );
+
+template
+int64_t getrf_native< std::complex<double>, int64_t >(
+    int64_t m, int64_t n, std::complex<double>* A, int64_t lda,
+    int64_t* ipiv, int64_t nb );
+
+#ifndef LAPACK_ILP64
+
+template
+int64_t getrf_native< float, lapack_int >(
+    int64_t m, int64_t n, float* A, int64_t lda,
+    lapack_int* ipiv, int64_t nb );
+
+template
+int64_t getrf_native< double, lapack_int >(
+    int64_t m, int64_t n, double* A, int64_t lda,
+    lapack_int* ipiv, int64_t nb );
+
+template
+int64_t getrf_native< std::complex<float>, lapack_int >(
+    int64_t m, int64_t n, std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv, int64_t nb );
+
+template
+int64_t getrf_native< std::complex<double>, lapack_int >(
+    int64_t m, int64_t n, std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv, int64_t nb );
+
+#endif  // LAPACK_ILP64
+
+}  // namespace internal
+}  // namespace lapack
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +23,9 @@ int64_t getri(
     float* A, int64_t lda,
     int64_t const* ipiv )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getri", 's', n, n, 0,
+                             Gflop< float >::getri( n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -73,6 +77,9 @@ int64_t getri(
     double* A, int64_t lda,
     int64_t const* ipiv )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getri", 'd', n, n, 0,
+                             Gflop< double >::getri( n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -124,6 +131,9 @@ int64_t getri(
     std::complex<float>* A, int64_t lda,
     int64_t const* ipiv )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getri", 'c', n, n, 0,
+                             Gflop< std::complex<float> >::getri( n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -207,6 +217,9 @@ int64_t getri(
     std::complex<double>* A, int64_t lda,
     int64_t const* ipiv )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getri", 'z', n, n, 0,
+                             Gflop< std::complex<double> >::getri( n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -251,4 +264,197 @@ int64_t getri(
     return info_;
 }
 
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+int64_t getri(
+    int64_t n,
+    float* A, int64_t lda,
+    lapack_int const* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getri", 's', n, n, 0,
+                             Gflop< float >::getri( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    float qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_sgetri(
+        &n_,
+        A, &lda_,
+        ipiv,
+        qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::vector< float > work( lwork_ );
+
+    LAPACK_sgetri(
+        &n_,
+        A, &lda_,
+        ipiv,
+        &work[0], &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+int64_t getri(
+    int64_t n,
+    double* A, int64_t lda,
+    lapack_int const* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getri", 'd', n, n, 0,
+                             Gflop< double >::getri( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dgetri(
+        &n_,
+        A, &lda_,
+        ipiv,
+        qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::vector< double > work( lwork_ );
+
+    LAPACK_dgetri(
+        &n_,
+        A, &lda_,
+        ipiv,
+        &work[0], &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+int64_t getri(
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int const* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getri", 'c', n, n, 0,
+                             Gflop< std::complex<float> >::getri( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cgetri(
+        &n_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::vector< std::complex<float> > work( lwork_ );
+
+    LAPACK_cgetri(
+        &n_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) &work[0], &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Overloaded versions taking `lapack_int` pivots, for LP64 builds
+/// (32-bit lapack_int), pass ipiv directly to LAPACK, instead of
+/// copying to and from a temporary `int64_t` array.
+/// Otherwise the same as the `int64_t` pivot version.
+/// @see lapack::getri
+/// @ingroup gesv_computational
+int64_t getri(
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int const* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getri", 'z', n, n, 0,
+                             Gflop< std::complex<double> >::getri( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    std::complex<double> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_zgetri(
+        &n_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::vector< std::complex<double> > work( lwork_ );
+
+    LAPACK_zgetri(
+        &n_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) &work[0], &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
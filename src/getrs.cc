@@ -5,6 +5,8 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
+#include "fixed.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -23,6 +25,16 @@ int64_t getrs(
     int64_t const* ipiv,
     float* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getrs", 's', n, n, nrhs,
+                             Gflop< float >::getrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (trans == Op::NoTrans || trans == Op::Trans
+            || trans == Op::ConjTrans)) {
+        return internal::fixed_getrs( trans, n, nrhs, A, lda, ipiv, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -65,6 +77,16 @@ int64_t getrs(
     int64_t const* ipiv,
     double* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getrs", 'd', n, n, nrhs,
+                             Gflop< double >::getrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (trans == Op::NoTrans || trans == Op::Trans
+            || trans == Op::ConjTrans)) {
+        return internal::fixed_getrs( trans, n, nrhs, A, lda, ipiv, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -107,6 +129,16 @@ int64_t getrs(
     int64_t const* ipiv,
     std::complex<float>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getrs", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::getrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (trans == Op::NoTrans || trans == Op::Trans
+            || trans == Op::ConjTrans)) {
+        return internal::fixed_getrs( trans, n, nrhs, A, lda, ipiv, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -202,6 +234,16 @@ int64_t getrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "getrs", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::getrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (trans == Op::NoTrans || trans == Op::Trans
+            || trans == Op::ConjTrans)) {
+        return internal::fixed_getrs( trans, n, nrhs, A, lda, ipiv, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -236,4 +278,189 @@ int64_t getrs(
     return info_;
 }
 
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getrs", 's', n, n, nrhs,
+                             Gflop< float >::getrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (trans == Op::NoTrans || trans == Op::Trans
+            || trans == Op::ConjTrans)) {
+        return internal::fixed_getrs( trans, n, nrhs, A, lda, ipiv, B, ldb );
+    }
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_sgetrs(
+        &trans_, &n_, &nrhs_,
+        A, &lda_,
+        ipiv,
+        B, &ldb_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getrs", 'd', n, n, nrhs,
+                             Gflop< double >::getrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (trans == Op::NoTrans || trans == Op::Trans
+            || trans == Op::ConjTrans)) {
+        return internal::fixed_getrs( trans, n, nrhs, A, lda, ipiv, B, ldb );
+    }
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_dgetrs(
+        &trans_, &n_, &nrhs_,
+        A, &lda_,
+        ipiv,
+        B, &ldb_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getrs", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::getrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (trans == Op::NoTrans || trans == Op::Trans
+            || trans == Op::ConjTrans)) {
+        return internal::fixed_getrs( trans, n, nrhs, A, lda, ipiv, B, ldb );
+    }
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_cgetrs(
+        &trans_, &n_, &nrhs_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) B, &ldb_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Overloaded versions taking `lapack_int` pivots, for LP64 builds
+/// (32-bit lapack_int), pass ipiv directly to LAPACK, instead of
+/// copying to and from a temporary `int64_t` array.
+/// Otherwise the same as the `int64_t` pivot version.
+/// @see lapack::getrs
+/// @ingroup gesv_computational
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "getrs", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::getrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (trans == Op::NoTrans || trans == Op::Trans
+            || trans == Op::ConjTrans)) {
+        return internal::fixed_getrs( trans, n, nrhs, A, lda, ipiv, B, ldb );
+    }
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_zgetrs(
+        &trans_, &n_, &nrhs_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) B, &ldb_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
@@ -0,0 +1,196 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "batch.hh"
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Solves a batch of systems of linear equations $A_i X_i = B_i$,
+/// $A_i^T X_i = B_i$, or $A_i^H X_i = B_i$, using the LU factorizations
+/// computed by `lapack::getrf_batch`. See `lapack::getrs`.
+/// Systems are solved in parallel; see lapack/batch.hh.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] trans
+///     The form of the systems of equations, as for `lapack::getrs`.
+///
+/// @param[in] n
+///     The order of each matrix A. n >= 0.
+///
+/// @param[in] nrhs
+///     The number of right hand sides in each B. nrhs >= 0.
+///
+/// @param[in] Aarray
+///     Array of batch_count pointers to the factors L and U from
+///     `lapack::getrf_batch`, each stored in an lda-by-n array.
+///
+/// @param[in] lda
+///     The leading dimension of each A. lda >= max(1,n).
+///
+/// @param[in] ipiv_array
+///     Array of batch_count pointers to pivot vectors from
+///     `lapack::getrf_batch`, each of length n.
+///
+/// @param[in,out] Barray
+///     Array of batch_count pointers to n-by-nrhs matrices B, each stored in
+///     an ldb-by-nrhs array. On exit, the solutions X.
+///
+/// @param[in] ldb
+///     The leading dimension of each B. ldb >= max(1,n).
+///
+/// @param[out] info
+///     Array of length batch_count. info[ i ] is the `lapack::getrs` return
+///     value for the i-th system.
+///
+/// @param[in] batch_count
+///     The number of systems. batch_count >= 0.
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrs_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* const* Aarray, int64_t lda,
+    int64_t const* const* ipiv_array,
+    scalar_t* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( trans != Op::NoTrans &&
+                     trans != Op::Trans &&
+                     trans != Op::ConjTrans );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldb < max( 1, n ) );
+    lapack_error_if( batch_count < 0 );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int ) {
+        info[ i ] = getrs( trans, n, nrhs, Aarray[ i ], lda, ipiv_array[ i ],
+                           Barray[ i ], ldb );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Solves a batch of systems of linear equations stored with a fixed
+/// stride. Otherwise the same as `lapack::getrs_batch`.
+///
+/// @param[in] A
+///     The i-th factored matrix A is stored at A + i*strideA.
+///
+/// @param[in] strideA
+///     Stride between matrices in A. strideA >= lda*n.
+///
+/// @param[in] ipiv
+///     The i-th pivot vector is stored at ipiv + i*stride_ipiv.
+///
+/// @param[in] stride_ipiv
+///     Stride between pivot vectors. stride_ipiv >= n.
+///
+/// @param[in,out] B
+///     The i-th right-hand side matrix B is stored at B + i*strideB.
+///
+/// @param[in] strideB
+///     Stride between matrices in B. strideB >= ldb*nrhs.
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrs_strided_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* B, int64_t ldb, int64_t strideB,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( trans != Op::NoTrans &&
+                     trans != Op::Trans &&
+                     trans != Op::ConjTrans );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldb < max( 1, n ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( stride_ipiv < n );
+    lapack_error_if( strideB < ldb*nrhs );
+    lapack_error_if( batch_count < 0 );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int ) {
+        info[ i ] = getrs( trans, n, nrhs, &A[ i*strideA ], lda,
+                           &ipiv[ i*stride_ipiv ], &B[ i*strideB ], ldb );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrs_batch<float>(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* const* Aarray, int64_t lda,
+    int64_t const* const* ipiv_array,
+    float* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrs_batch<double>(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* const* Aarray, int64_t lda,
+    int64_t const* const* ipiv_array,
+    double* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrs_batch< std::complex<float> >(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    int64_t const* const* ipiv_array,
+    std::complex<float>* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrs_batch< std::complex<double> >(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* const* Aarray, int64_t lda,
+    int64_t const* const* ipiv_array,
+    std::complex<double>* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrs_strided_batch<float>(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    float* B, int64_t ldb, int64_t strideB,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrs_strided_batch<double>(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    double* B, int64_t ldb, int64_t strideB,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrs_strided_batch< std::complex<float> >(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    std::complex<float>* B, int64_t ldb, int64_t strideB,
+    int64_t* info, int64_t batch_count );
+
+template
+void getrs_strided_batch< std::complex<double> >(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda, int64_t strideA,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    std::complex<double>* B, int64_t ldb, int64_t strideB,
+    int64_t* info, int64_t batch_count );
+
+}  // namespace lapack
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +23,8 @@ int64_t heev(
     std::complex<float>* A, int64_t lda,
     float* W )
 {
+    LAPACK_INSTRUMENT_SCOPE( "heev", 'c', n, n, 0, 0 );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -120,6 +123,8 @@ int64_t heev(
     std::complex<double>* A, int64_t lda,
     double* W )
 {
+    LAPACK_INSTRUMENT_SCOPE( "heev", 'z', n, n, 0, 0 );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "native.hh"
 #include "NoConstructAllocator.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7
@@ -24,6 +25,10 @@ int64_t heev_2stage(
     std::complex<float>* A, int64_t lda,
     float* W )
 {
+    if (heev_2stage_method() == Method::Native) {
+        return internal::heev_2stage_native( jobz, uplo, n, A, lda, W, false );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -80,7 +85,9 @@ int64_t heev_2stage(
 /// @param[in] jobz
 ///     - lapack::Job::NoVec: Compute eigenvalues only;
 ///     - lapack::Job::Vec:   Compute eigenvalues and eigenvectors.
-///                           Not yet available (as of LAPACK 3.8.0).
+///                           Not yet available (as of LAPACK 3.8.0)
+///                           with the vendor method; see
+///                           heev_2stage_set_method.
 ///
 /// @param[in] uplo
 ///     - lapack::Uplo::Upper: Upper triangle of A is stored;
@@ -152,6 +159,10 @@ int64_t heev_2stage(
     std::complex<double>* A, int64_t lda,
     double* W )
 {
+    if (heev_2stage_method() == Method::Native) {
+        return internal::heev_2stage_native( jobz, uplo, n, A, lda, W, false );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
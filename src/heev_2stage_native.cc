@@ -0,0 +1,468 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "batch.hh"
+#include "native.hh"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace {
+
+std::atomic< char >    g_heev_2stage_method( char( Method::Vendor ) );
+std::atomic< int64_t > g_heev_2stage_kd( 0 );
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+void heev_2stage_set_method( Method method )
+{
+    g_heev_2stage_method.store( char( method ), std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+Method heev_2stage_method()
+{
+    return Method( g_heev_2stage_method.load( std::memory_order_relaxed ) );
+}
+
+//------------------------------------------------------------------------------
+void heev_2stage_set_block_size( int64_t kd )
+{
+    lapack_error_if( kd < 0 );
+    g_heev_2stage_kd.store( kd, std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+int64_t heev_2stage_block_size()
+{
+    return g_heev_2stage_kd.load( std::memory_order_relaxed );
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Stage 1: reduces the Hermitian matrix A, lower triangle stored, to a
+/// lower band of width kd, Q1^H A Q1 = B, as hetrd_he2hb does.
+/// For each panel of kd columns j, ..., the QR factorization of the block
+/// below the band gives Q = I - V T V^H, and the trailing matrix is
+/// updated by the two-sided her2k update
+///     A22 = Q^H A22 Q = A22 - V X^H - X V^H,
+///     X = W - 1/2 V (T^H V^H W),  W = A22 V T.
+/// On exit, B is in the band of A, and the reflectors of Q1 are below it,
+/// as the QR factorization of A( kd:n-1, 0:n-kd-1 ), with scalars tau.
+template <typename scalar_t>
+void he2hb(
+    int64_t n, int64_t kd,
+    scalar_t* A, int64_t lda,
+    scalar_t* tau )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const scalar_t half = 0.5;
+
+    std::vector< scalar_t > V( n * kd ), W( n * kd ), T( kd * kd ), M( kd * kd );
+    for (int64_t j = 0; j < n - kd; j += kd) {
+        int64_t m1 = n - kd - j;
+        int64_t pk = min( m1, kd );
+        scalar_t* Ap = &A[ (j + kd) + j*lda ];
+        // For the last panel, m1 < kd: factor the full kd columns,
+        // so Q^H is also applied to the band columns j+m1, ..., j+kd-1.
+        lapack::geqrf( m1, kd, Ap, lda, &tau[ j ] );
+
+        // V with explicit unit diagonal and zeros above
+        lapack::laset( MatrixType::Upper, m1, pk, zero, one, &V[ 0 ], m1 );
+        lapack::lacpy( MatrixType::Lower, m1 - 1, pk, &Ap[ 1 ], lda,
+                       &V[ 1 ], m1 );
+        lapack::larft( Direction::Forward, StoreV::Columnwise, m1, pk,
+                       &V[ 0 ], m1, &tau[ j ], &T[ 0 ], kd );
+
+        // W = A22 V T, M = T^H V^H W, W = W - 1/2 V M
+        scalar_t* A22 = &A[ (j + kd) + (j + kd)*lda ];
+        blas::hemm( blas::Layout::ColMajor, Side::Left, Uplo::Lower, m1, pk,
+                    one,  A22, lda, &V[ 0 ], m1,
+                    zero, &W[ 0 ], m1 );
+        blas::trmm( blas::Layout::ColMajor, Side::Right, Uplo::Upper,
+                    Op::NoTrans, Diag::NonUnit, m1, pk,
+                    one, &T[ 0 ], kd, &W[ 0 ], m1 );
+        blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                    pk, pk, m1,
+                    one,  &V[ 0 ], m1, &W[ 0 ], m1,
+                    zero, &M[ 0 ], kd );
+        blas::trmm( blas::Layout::ColMajor, Side::Left, Uplo::Upper,
+                    Op::ConjTrans, Diag::NonUnit, pk, pk,
+                    one, &T[ 0 ], kd, &M[ 0 ], kd );
+        blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                    m1, pk, pk,
+                    -half, &V[ 0 ], m1, &M[ 0 ], kd,
+                    one,   &W[ 0 ], m1 );
+        blas::her2k( blas::Layout::ColMajor, Uplo::Lower, Op::NoTrans, m1, pk,
+                     -one, &V[ 0 ], m1, &W[ 0 ], m1,
+                     real_t( 1 ), A22, lda );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Stage 2: bulge chasing from a Hermitian band of width kd to tridiagonal
+/// form, Q2^H B Q2 = T, after Haidar, Ltaief, and Dongarra, SC '11, as in
+/// LAPACK's hetrd_hb2st.
+///
+/// B is in compact lower band storage with ldab = 2 kd + 1, the rows below
+/// the band holding the bulges: B(i, j) is AB[ i + j*(ldab - 1) ] for
+/// 0 <= i - j <= 2 kd, so blocks of B are addressed as general matrices
+/// with leading dimension ldab - 1.
+///
+/// Sweep s annihilates column s below its subdiagonal. Its block t covers
+/// rows s+1+t*kd, ..., s+(t+1)*kd, and it has 2 nblk - 1 steps:
+/// - step 0 generates H(s, 0) from column s and applies it to the
+///   diagonal block 0 from both sides;
+/// - step 2t+1 applies H(s, t) from the right to the block below, which
+///   creates a bulge, then generates H(s, t+1) from the bulge's first
+///   column and applies it from the left to the rest of the block;
+/// - step 2t applies H(s, t) from both sides to diagonal block t.
+///
+/// Sweeps are assigned round-robin to threads. Step k of sweep s waits
+/// until sweep s - 1 has finished step k + 2, the last of its steps that
+/// touch the same entries, so successive sweeps follow each other down
+/// the band and all threads work in a window of a few kd-by-kd blocks per
+/// thread, which stays in cache.
+///
+/// H(s, t) = I - tau v v^H, with v of length kd, v[0] = 1, is saved in
+/// Vs[ (s*nslot + t % nslot)*kd ], taus[ s*nslot + t % nslot ].
+/// With nslot >= number of blocks, all are kept for the back-
+/// transformation; with nslot = 2, only those needed by the next step.
+///
+/// On exit, D and E hold the diagonal and subdiagonal of T.
+template <typename scalar_t>
+void hb2st(
+    int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    blas::real_type< scalar_t >* D, scalar_t* E,
+    scalar_t* Vs, scalar_t* taus, int64_t nslot )
+{
+    using blas::conj;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const scalar_t half = 0.5;
+
+    int64_t ldd = ldab - 1;
+    auto B = [&]( int64_t i, int64_t j ) -> scalar_t& {
+        return AB[ i + j*ldd ];
+    };
+    auto nsteps = [&]( int64_t s ) {
+        return 2*((n - 1 - s + kd - 1) / kd) - 1;
+    };
+
+    // Step k of sweep s, with workspace w of length kd.
+    auto step = [&]( int64_t s, int64_t k, scalar_t* w ) {
+        int64_t t  = k / 2;
+        int64_t st = s + 1 + t*kd;
+        int64_t ed = min( st + kd - 1, n - 1 );
+        int64_t ln = ed - st + 1;
+        scalar_t* v    = &Vs[ (s*nslot + t % nslot)*kd ];
+        scalar_t& tauv = taus[ s*nslot + t % nslot ];
+        if (k % 2 == 0) {
+            if (t == 0) {
+                // H(s, 0) annihilates B( st+1:ed, s )
+                scalar_t alpha = B( st, s );
+                v[ 0 ] = one;
+                for (int64_t i = 1; i < ln; ++i) {
+                    v[ i ] = B( st + i, s );
+                    B( st + i, s ) = zero;
+                }
+                lapack::larfg( ln, &alpha, &v[ 1 ], 1, &tauv );
+                B( st, s ) = alpha;
+            }
+            // Diagonal block = H^H Bd H, as larfy with tau2 = conj( tau ):
+            // w = Bd v, w -= 1/2 tau2 (w^H v) v,
+            // Bd -= tau2 v w^H + conj( tau2 ) w v^H.
+            scalar_t tau2 = conj( tauv );
+            blas::hemv( blas::Layout::ColMajor, Uplo::Lower, ln,
+                        one, &B( st, st ), ldd, v, 1,
+                        zero, w, 1 );
+            scalar_t alpha = -half * tau2 * blas::dot( ln, w, 1, v, 1 );
+            blas::axpy( ln, alpha, v, 1, w, 1 );
+            blas::her2( blas::Layout::ColMajor, Uplo::Lower, ln,
+                        -tau2, v, 1, w, 1, &B( st, st ), ldd );
+        }
+        else {
+            int64_t j1 = ed + 1;
+            int64_t j2 = min( ed + kd, n - 1 );
+            int64_t lm = j2 - j1 + 1;
+
+            // Block below = Bb H: w = Bb v, Bb -= tau w v^H
+            scalar_t* Bb = &B( j1, st );
+            blas::gemv( blas::Layout::ColMajor, Op::NoTrans, lm, ln,
+                        one, Bb, ldd, v, 1, zero, w, 1 );
+            blas::ger( blas::Layout::ColMajor, lm, ln,
+                       -tauv, w, 1, v, 1, Bb, ldd );
+
+            // H(s, t+1) annihilates the bulge Bb( 1:lm-1, 0 )
+            scalar_t* v2    = &Vs[ (s*nslot + (t + 1) % nslot)*kd ];
+            scalar_t& tauv2 = taus[ s*nslot + (t + 1) % nslot ];
+            scalar_t alpha = Bb[ 0 ];
+            v2[ 0 ] = one;
+            for (int64_t i = 1; i < lm; ++i) {
+                v2[ i ] = Bb[ i ];
+                Bb[ i ] = zero;
+            }
+            lapack::larfg( lm, &alpha, &v2[ 1 ], 1, &tauv2 );
+            Bb[ 0 ] = alpha;
+
+            // Rest of the block = H^H Bb( :, 1:ln-1 ):
+            // w = Bb^H v2, Bb -= conj( tau ) v2 w^H
+            if (ln > 1) {
+                scalar_t* Bc = &Bb[ ldd ];
+                blas::gemv( blas::Layout::ColMajor, Op::ConjTrans, lm, ln - 1,
+                            one, Bc, ldd, v2, 1, zero, w, 1 );
+                blas::ger( blas::Layout::ColMajor, lm, ln - 1,
+                           -conj( tauv2 ), v2, 1, w, 1, Bc, ldd );
+            }
+        }
+    };
+
+    // Column n - 2 has a single subdiagonal entry; nothing to annihilate.
+    int64_t nsweeps = (kd > 1 ? max( 0, n - 2 ) : 0);
+    std::vector< std::atomic< int64_t > > done( nsweeps );
+    for (auto& d : done)
+        d.store( 0, std::memory_order_relaxed );
+
+    auto sweep = [&]( int64_t s, scalar_t* w ) {
+        int64_t ns = nsteps( s );
+        for (int64_t k = 0; k < ns; ++k) {
+            if (s > 0) {
+                int64_t need = min( k + 3, nsteps( s - 1 ) );
+                while (done[ s - 1 ].load( std::memory_order_acquire ) < need)
+                    std::this_thread::yield();
+            }
+            step( s, k, w );
+            done[ s ].store( k + 1, std::memory_order_release );
+        }
+    };
+
+    // Sweeps follow each other about 2 kd rows apart.
+    int nthreads = batch_num_threads( n / (2*kd) );
+    if (nthreads > 1) {
+        VendorSingleThread single_thread;
+        #pragma omp parallel num_threads( nthreads )
+        {
+            // Threads may be fewer than requested; all of them must
+            // run concurrently, since each waits on the previous sweep.
+            #ifdef _OPENMP
+                int thread  = omp_get_thread_num();
+                int nthread = omp_get_num_threads();
+            #else
+                int thread  = 0;
+                int nthread = 1;
+            #endif
+            std::vector< scalar_t > w( kd );
+            for (int64_t s = thread; s < nsweeps; s += nthread)
+                sweep( s, &w[ 0 ] );
+        }
+    }
+    else {
+        std::vector< scalar_t > w( kd );
+        for (int64_t s = 0; s < nsweeps; ++s)
+            sweep( s, &w[ 0 ] );
+    }
+
+    for (int64_t i = 0; i < n; ++i)
+        D[ i ] = std::real( B( i, i ) );
+    for (int64_t i = 0; i < n - 1; ++i)
+        E[ i ] = B( i + 1, i );
+}
+
+//------------------------------------------------------------------------------
+/// Back-transformation of stage 2: Z = Q2 Z, for the n-by-ncol matrix Z,
+/// with the reflectors H(s, t) from hb2st, all blocks kept (nslot).
+///
+/// H(s, t) and H(s+1, t) overlap in all but one row, so the reflectors of
+/// nb <= kd consecutive sweeps S, ..., S+nb-1 in block t form a
+/// diamond-shaped (kd + nb - 1)-by-nb block V, with G(S, t) =
+/// H(S, t) ... H(S+nb-1, t) = I - V T V^H, applied with one larfb.
+/// H(s, t+1) precedes H(s', t) for s < s', where they overlap, and they
+/// are disjoint for s >= s', so G(S, t+1) precedes G(S, t), and
+///     Q2 = prod_{S ascending} prod_{t descending} G(S, t).
+/// Hence Z = Q2 Z applies G(S, t) for S descending, t ascending.
+/// Column blocks of Z are independent and done in parallel.
+template <typename scalar_t>
+void hb2st_apply_q(
+    int64_t n, int64_t kd,
+    scalar_t const* Vs, scalar_t const* taus, int64_t nslot,
+    int64_t ncol, scalar_t* Z, int64_t ldz )
+{
+    const scalar_t zero = 0;
+
+    int64_t nsweeps = (kd > 1 ? max( 0, n - 2 ) : 0);
+    if (nsweeps == 0 || ncol == 0)
+        return;
+
+    int64_t nb = kd;
+    int64_t ngroups = (nsweeps + nb - 1) / nb;
+    int64_t ldv = kd + nb - 1;
+    int nthreads = batch_num_threads( (ncol + 31) / 32 );
+    int64_t cb = (ncol + nthreads - 1) / nthreads;
+    int64_t nblocks = (ncol + cb - 1) / cb;
+    std::vector< scalar_t > V( nthreads * ldv * nb );
+    std::vector< scalar_t > T( nthreads * nb * nb );
+    std::vector< scalar_t > tau( nthreads * nb );
+
+    batch_for( nblocks, [&]( int64_t i, int thread ) {
+        int64_t c0 = i*cb;
+        int64_t cw = min( cb, ncol - c0 );
+        scalar_t* Vt   = &V[ thread * ldv * nb ];
+        scalar_t* Tt   = &T[ thread * nb * nb ];
+        scalar_t* taut = &tau[ thread * nb ];
+        for (int64_t g = ngroups - 1; g >= 0; --g) {
+            int64_t S   = g*nb;
+            int64_t nbg = min( nb, nsweeps - S );
+            for (int64_t t = 0; S + 1 + t*kd < n; ++t) {
+                int64_t r0 = S + 1 + t*kd;
+                int64_t r1 = min( S + nbg - 1 + (t + 1)*kd, n - 1 );
+                int64_t mr = r1 - r0 + 1;
+
+                // V( j:j+len-1, j ) = v of H(S+j, t); near the bottom,
+                // only the first mr sweeps of the group have block t.
+                int64_t kt = min( nbg, mr );
+                lapack::laset( MatrixType::General, mr, kt, zero, zero,
+                               Vt, mr );
+                for (int64_t j = 0; j < kt; ++j) {
+                    int64_t len = min( kd, mr - j );
+                    int64_t slot = (S + j)*nslot + t;
+                    blas::copy( len, &Vs[ slot*kd ], 1, &Vt[ j + j*mr ], 1 );
+                    taut[ j ] = taus[ slot ];
+                }
+                lapack::larft( Direction::Forward, StoreV::Columnwise, mr, kt,
+                               Vt, mr, taut, Tt, nb );
+                lapack::larfb( Side::Left, Op::NoTrans, Direction::Forward,
+                               StoreV::Columnwise, mr, cw, kt,
+                               Vt, mr, Tt, nb, &Z[ r0 + c0*ldz ], ldz );
+            }
+        }
+    } );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t heev_2stage_native(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* W, bool dc )
+{
+    using blas::conj;
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+
+    // check arguments
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+
+    if (n == 0)
+        return 0;
+    bool wantz = (jobz == Job::Vec);
+
+    int64_t kd = heev_2stage_block_size();
+    if (kd == 0)
+        kd = (n < 2000 ? 32 : 64);
+    kd = max( 1, min( kd, n - 1 ) );
+
+    // Work in the lower triangle; if uplo = Upper, in a copy of A.
+    std::vector< scalar_t > Acopy;
+    scalar_t* Aw = A;
+    int64_t ldaw = lda;
+    if (uplo == Uplo::Upper) {
+        Acopy.resize( n * n );
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = j; i < n; ++i)
+                Acopy[ i + j*n ] = conj( A[ j + i*lda ] );
+        }
+        Aw = &Acopy[ 0 ];
+        ldaw = n;
+    }
+
+    // Stage 1: A to band B
+    std::vector< scalar_t > tau1( max( 1, n - kd ) );
+    he2hb( n, kd, Aw, ldaw, &tau1[ 0 ] );
+
+    // Stage 2: B to tridiagonal T, in compact band storage
+    int64_t ldab = 2*kd + 1;
+    std::vector< scalar_t > AB( ldab * n, zero );
+    for (int64_t j = 0; j < n; ++j) {
+        int64_t len = min( kd + 1, n - j );
+        blas::copy( len, &Aw[ j + j*ldaw ], 1, &AB[ j*ldab ], 1 );
+    }
+    int64_t nslot = (wantz ? (n - 1 + kd - 1) / kd : 2);
+    nslot = max( nslot, 2 );
+    std::vector< scalar_t > Vs( n * nslot * kd, zero ), taus( n * nslot, zero );
+    std::vector< scalar_t > E( max( 1, n - 1 ) );
+    hb2st( n, kd, &AB[ 0 ], ldab, W, &E[ 0 ], &Vs[ 0 ], &taus[ 0 ], nslot );
+    AB = std::vector< scalar_t >();
+
+    // T = P Tr P^H, with Tr real and P = diag( p ) unitary:
+    // p[ i+1 ] = p[ i ] e[ i ] / |e[ i ]|.
+    std::vector< real_t > Er( max( 1, n - 1 ) );
+    std::vector< scalar_t > p( n );
+    p[ 0 ] = 1;
+    for (int64_t i = 0; i < n - 1; ++i) {
+        Er[ i ] = std::abs( E[ i ] );
+        p[ i + 1 ] = (Er[ i ] == 0 ? p[ i ] : p[ i ] * (E[ i ] / Er[ i ]));
+    }
+
+    if (! wantz) {
+        return lapack::sterf( n, W, &Er[ 0 ] );
+    }
+
+    // Tr = Zr Lambda Zr^H
+    std::vector< real_t > Zr( n * n );
+    int64_t info = dc
+                 ? lapack::stedc( Job::Vec, n, W, &Er[ 0 ], &Zr[ 0 ], n )
+                 : lapack::steqr( Job::Vec, n, W, &Er[ 0 ], &Zr[ 0 ], n );
+    if (info != 0)
+        return info;
+
+    // Z = Q1 Q2 P Zr
+    std::vector< scalar_t > Z( n * n );
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < n; ++i)
+            Z[ i + j*n ] = p[ i ] * Zr[ i + j*n ];
+    }
+    Zr = std::vector< real_t >();
+    hb2st_apply_q( n, kd, &Vs[ 0 ], &taus[ 0 ], nslot, n, &Z[ 0 ], n );
+    if (n > kd) {
+        lapack::unmqr( Side::Left, Op::NoTrans, n - kd, n, n - kd,
+                       &Aw[ kd ], ldaw, &tau1[ 0 ], &Z[ kd ], n );
+    }
+    lapack::lacpy( MatrixType::General, n, n, &Z[ 0 ], n, A, lda );
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_HEEV_2STAGE_NATIVE_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t heev_2stage_native< scalar_t >( \
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n, \
+        scalar_t* A, int64_t lda, \
+        blas::real_type< scalar_t >* W, bool dc );
+
+LAPACK_HEEV_2STAGE_NATIVE_INSTANTIATE( float )
+LAPACK_HEEV_2STAGE_NATIVE_INSTANTIATE( double )
+LAPACK_HEEV_2STAGE_NATIVE_INSTANTIATE( std::complex<float> )
+LAPACK_HEEV_2STAGE_NATIVE_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_HEEV_2STAGE_NATIVE_INSTANTIATE
+
+}  // namespace internal
+}  // namespace lapack
@@ -0,0 +1,308 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/subspace.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+using blas::real;
+
+//------------------------------------------------------------------------------
+/// Returns an upper bound on the largest eigenvalue of A, from steps of
+/// Lanczos: the largest eigenvalue of the Lanczos tridiagonal T, plus
+/// the norm of the last residual, after Zhou and Li, Linear Algebra
+/// Appl., 2011; and at most ||A||_1.
+template <typename scalar_t>
+static blas::real_type< scalar_t > lanczos_bound(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    blas::real_type< scalar_t > Anorm,
+    int64_t* iseed )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const int64_t steps = min( n, 10 );
+
+    std::vector< scalar_t > v( n ), v0( n, zero ), f( n );
+    std::vector< real_t > d( steps ), e( steps );
+    lapack::larnv( 3, iseed, n, &v[ 0 ] );
+    blas::scal( n, one / blas::nrm2( n, &v[ 0 ], 1 ), &v[ 0 ], 1 );
+
+    real_t beta = 0;
+    int64_t j = 0;
+    for (; j < steps; ++j) {
+        // f = A v - beta v0 - alpha v
+        blas::hemv( blas::Layout::ColMajor, uplo, n,
+                    one, A, lda, &v[ 0 ], 1, zero, &f[ 0 ], 1 );
+        blas::axpy( n, -beta, &v0[ 0 ], 1, &f[ 0 ], 1 );
+        real_t alpha = real( blas::dot( n, &v[ 0 ], 1, &f[ 0 ], 1 ) );
+        blas::axpy( n, -alpha, &v[ 0 ], 1, &f[ 0 ], 1 );
+        d[ j ] = alpha;
+        beta = blas::nrm2( n, &f[ 0 ], 1 );
+        if (j == steps - 1 || beta <= Anorm * std::numeric_limits< real_t >::epsilon())
+            break;
+        e[ j ] = beta;
+        std::swap( v0, v );
+        for (int64_t i = 0; i < n; ++i)
+            v[ i ] = f[ i ] / beta;
+    }
+    lapack::sterf( j + 1, &d[ 0 ], &e[ 0 ] );
+    return min( d[ j ] + beta, Anorm );
+}
+
+//------------------------------------------------------------------------------
+/// Overwrites the n-by-l matrix Y with an orthonormal basis of its range,
+/// orthogonal to the n-by-nlock orthonormal matrix V, by two passes of
+/// block Gram-Schmidt against V, then geqrf and ungqr.
+template <typename scalar_t>
+static void orth(
+    int64_t n, int64_t nlock, int64_t l,
+    scalar_t const* V, scalar_t* Y, int64_t ldy,
+    scalar_t* C, scalar_t* tau )
+{
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    if (nlock > 0) {
+        for (int pass = 0; pass < 2; ++pass) {
+            blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                        nlock, l, n,
+                        one,  V, ldy, Y, ldy,
+                        zero, C, nlock );
+            blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                        n, l, nlock,
+                        -one, V, ldy, C, nlock,
+                        one,  Y, ldy );
+        }
+    }
+    lapack::geqrf( n, l, Y, ldy, tau );
+    lapack::ungqr( n, l, l, Y, ldy, tau );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t heev_subspace(
+    lapack::Uplo uplo, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    blas::real_type< scalar_t >* W,
+    scalar_t* X, int64_t ldx,
+    int64_t nstart,
+    int64_t* iters,
+    blas::real_type< scalar_t > tol,
+    int64_t degree,
+    int64_t maxiter )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // check arguments
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( k < 0 || k > n );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldx < max( 1, n ) );
+    lapack_error_if( nstart < 0 || nstart > k );
+    lapack_error_if( degree < 1 );
+    lapack_error_if( maxiter < 1 );
+
+    if (iters != nullptr)
+        *iters = 0;
+    if (k == 0)
+        return 0;
+
+    int64_t l = min( n, k + max( 10, k / 5 ) );
+
+    // The subspace is the whole space: solve directly.
+    if (l == n) {
+        std::vector< scalar_t > Z( n * n );
+        std::vector< real_t > Wz( n );
+        lapack::lacpy( MatrixType::General, n, n, A, lda, &Z[ 0 ], n );
+        int64_t info = lapack::heevd( Job::Vec, uplo, n, &Z[ 0 ], n, &Wz[ 0 ] );
+        if (info != 0)
+            return k + info;
+        std::copy( Wz.begin(), Wz.begin() + k, W );
+        lapack::lacpy( MatrixType::General, n, k, &Z[ 0 ], n, X, ldx );
+        return 0;
+    }
+
+    real_t Anorm = lapack::lanhe( Norm::One, uplo, n, A, lda );
+    if (tol <= 0)
+        tol = n * std::numeric_limits< real_t >::epsilon();
+
+    // V = orth( [ X( :, 0:nstart-1 ), random ] ), n-by-l
+    int64_t iseed[ 4 ] = { 0, 0, 0, 1 };
+    std::vector< scalar_t > V( n * l ), AV( n * l ), Y0( n * l ), Y1( n * l );
+    std::vector< scalar_t > H( l * l ), C( l * l ), tau( l );
+    std::vector< real_t > theta( l );
+    lapack::lacpy( MatrixType::General, n, nstart, X, ldx, &V[ 0 ], n );
+    lapack::larnv( 3, iseed, n * (l - nstart), &V[ n*nstart ] );
+    orth( n, 0, l, &V[ 0 ], &V[ 0 ], n, &C[ 0 ], &tau[ 0 ] );
+
+    real_t upper = lanczos_bound( uplo, n, A, lda, Anorm, iseed );
+
+    std::vector< int64_t > perm( l );
+    std::vector< real_t > theta2( l );
+    int64_t nlock = 0;
+    int64_t iter = 0;
+    while (true) {
+        ++iter;
+
+        // Rayleigh-Ritz on the unlocked columns Va, la of them:
+        // H = Va^H A Va = Q Theta Q^H; Va = Va Q, AVa = AVa Q.
+        int64_t la = l - nlock;
+        scalar_t* Va  = &V[ n*nlock ];
+        scalar_t* AVa = &AV[ n*nlock ];
+        blas::hemm( blas::Layout::ColMajor, Side::Left, uplo, n, la,
+                    one,  A, lda, Va, n,
+                    zero, AVa, n );
+        blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                    la, la, n,
+                    one,  Va, n, AVa, n,
+                    zero, &H[ 0 ], la );
+        // If heev fails, theta and V are inconsistent; leave W and X.
+        int64_t info = lapack::heev( Job::Vec, Uplo::Upper, la,
+                                     &H[ 0 ], la, &theta[ nlock ] );
+        if (info != 0) {
+            if (iters != nullptr)
+                *iters = iter;
+            return k + info;
+        }
+        blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                    n, la, la,
+                    one,  Va, n, &H[ 0 ], la,
+                    zero, &Y0[ 0 ], n );
+        lapack::lacpy( MatrixType::General, n, la, &Y0[ 0 ], n, Va, n );
+        blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                    n, la, la,
+                    one,  AVa, n, &H[ 0 ], la,
+                    zero, &Y0[ 0 ], n );
+        lapack::lacpy( MatrixType::General, n, la, &Y0[ 0 ], n, AVa, n );
+
+        // Lock every converged Ritz pair among the k smallest, moving
+        // them to the front of the unlocked columns; the rest follow
+        // in ascending order.
+        int64_t nconv = 0;
+        int64_t nrest = 0;
+        for (int64_t j = nlock; j < l; ++j) {
+            bool conv = false;
+            if (j < k) {
+                for (int64_t i = 0; i < n; ++i)
+                    Y0[ i ] = AV[ i + n*j ] - theta[ j ] * V[ i + n*j ];
+                conv = blas::nrm2( n, &Y0[ 0 ], 1 ) <= tol * Anorm;
+            }
+            if (conv)
+                perm[ nconv++ ] = j;
+            else
+                perm[ la - 1 - nrest++ ] = j;
+        }
+        if (nconv > 0 && nconv < la) {
+            std::reverse( &perm[ nconv ], &perm[ la ] );
+            for (int64_t j = 0; j < la; ++j) {
+                blas::copy( n, &V[ n*perm[ j ] ], 1, &Y0[ n*j ], 1 );
+                blas::copy( n, &AV[ n*perm[ j ] ], 1, &Y1[ n*j ], 1 );
+                theta2[ j ] = theta[ perm[ j ] ];
+            }
+            lapack::lacpy( MatrixType::General, n, la, &Y0[ 0 ], n, Va, n );
+            lapack::lacpy( MatrixType::General, n, la, &Y1[ 0 ], n, AVa, n );
+            std::copy( &theta2[ 0 ], &theta2[ la ], &theta[ nlock ] );
+        }
+        nlock += nconv;
+        if (nlock >= k || iter >= maxiter)
+            break;
+
+        // Chebyshev filter on the unlocked columns, damping [ a, upper ],
+        // scaled by its value at a0, the smallest unlocked Ritz value,
+        // using the 3-term recurrence
+        //     Y_{i+1} = 2 sigma_{i+1}/e (A - c I) Y_i
+        //               - sigma_i sigma_{i+1} Y_{i-1}.
+        la  = l - nlock;
+        Va  = &V[ n*nlock ];
+        AVa = &AV[ n*nlock ];
+        real_t a  = theta[ l - 1 ];
+        real_t a0 = theta[ nlock ];
+        if (upper <= a)
+            upper = Anorm;
+        if (upper > a) {
+            real_t e = (upper - a) / 2;
+            real_t c = (upper + a) / 2;
+            real_t sigma = e / (a0 - c);
+            real_t tau2 = 2 / sigma;
+
+            // Y1 = (A - c I) Va sigma/e, with A Va in AVa
+            scalar_t* Yprev = Va;
+            scalar_t* Ycurr = &Y1[ 0 ];
+            scalar_t* Ynext = &Y0[ 0 ];
+            for (int64_t i = 0; i < n*la; ++i)
+                Ycurr[ i ] = (AVa[ i ] - c * Va[ i ]) * (sigma / e);
+            for (int64_t deg = 1; deg < degree; ++deg) {
+                real_t sigma_new = 1 / (tau2 - sigma);
+                blas::hemm( blas::Layout::ColMajor, Side::Left, uplo, n, la,
+                            one,  A, lda, Ycurr, n,
+                            zero, Ynext, n );
+                for (int64_t i = 0; i < n*la; ++i) {
+                    Ynext[ i ] = (Ynext[ i ] - c * Ycurr[ i ])
+                                     * (2 * sigma_new / e)
+                                 - (sigma * sigma_new) * Yprev[ i ];
+                }
+                // Va is not needed after the first step, so it is
+                // reused as workspace.
+                scalar_t* tmp = Yprev;
+                Yprev = Ycurr;
+                Ycurr = Ynext;
+                Ynext = tmp;
+                sigma = sigma_new;
+            }
+            if (Ycurr != Va)
+                lapack::lacpy( MatrixType::General, n, la, Ycurr, n, Va, n );
+        }
+        orth( n, nlock, la, &V[ 0 ], Va, n, &C[ 0 ], &tau[ 0 ] );
+    }
+    if (iters != nullptr)
+        *iters = iter;
+
+    // W, X = the k Ritz pairs in ascending order; locked pairs may be
+    // out of order.
+    for (int64_t j = 0; j < k; ++j)
+        perm[ j ] = j;
+    std::sort( &perm[ 0 ], &perm[ k ],
+               [&]( int64_t i, int64_t j ) { return theta[ i ] < theta[ j ]; } );
+    for (int64_t j = 0; j < k; ++j) {
+        W[ j ] = theta[ perm[ j ] ];
+        blas::copy( n, &V[ n*perm[ j ] ], 1, &X[ ldx*j ], 1 );
+    }
+    return k - min( nlock, k );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_HEEV_SUBSPACE_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t heev_subspace< scalar_t >( \
+        lapack::Uplo uplo, int64_t n, int64_t k, \
+        scalar_t const* A, int64_t lda, \
+        blas::real_type< scalar_t >* W, \
+        scalar_t* X, int64_t ldx, \
+        int64_t nstart, \
+        int64_t* iters, \
+        blas::real_type< scalar_t > tol, \
+        int64_t degree, \
+        int64_t maxiter );
+
+LAPACK_HEEV_SUBSPACE_INSTANTIATE( float )
+LAPACK_HEEV_SUBSPACE_INSTANTIATE( double )
+LAPACK_HEEV_SUBSPACE_INSTANTIATE( std::complex<float> )
+LAPACK_HEEV_SUBSPACE_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_HEEV_SUBSPACE_INSTANTIATE
+
+}  // namespace lapack
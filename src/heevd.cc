@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -15,6 +18,28 @@ using blas::max;
 using blas::min;
 using blas::real;
 
+// -----------------------------------------------------------------------------
+// Size of rwork for heevd, from documentation.
+static int64_t heevd_lrwork( lapack::Job jobz, int64_t n )
+{
+    if (n <= 1)
+        return 1;
+    else if (jobz == lapack::Job::NoVec)
+        return n;
+    else
+        return 1 + 5*n + 2*n*n;
+}
+
+// -----------------------------------------------------------------------------
+// Size of iwork for heevd, from documentation.
+static int64_t heevd_liwork( lapack::Job jobz, int64_t n )
+{
+    if (n <= 1 || jobz == lapack::Job::NoVec)
+        return 1;
+    else
+        return 3 + 5*n;
+}
+
 // -----------------------------------------------------------------------------
 /// @ingroup heev
 int64_t heevd(
@@ -22,54 +47,13 @@ int64_t heevd(
     std::complex<float>* A, int64_t lda,
     float* W )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobz_ = job2char( jobz );
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    float qry_rwork[1];
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cheevd(
-        &jobz_, &uplo_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        W,
-        (lapack_complex_float*) qry_work, &ineg_one,
-        qry_rwork, &ineg_one,
-        qry_iwork, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = real(qry_rwork[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
+    size_t work_size;
+    heevd_work_size_bytes( jobz, uplo, n, A, lda, W, &work_size );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_cheevd(
-        &jobz_, &uplo_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        W,
-        (lapack_complex_float*) &work[0], &lwork_,
-        &rwork[0], &lrwork_,
-        &iwork[0], &liwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return heevd( jobz, uplo, n, A, lda, W, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -137,6 +121,87 @@ int64_t heevd(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
     std::complex<double>* A, int64_t lda,
     double* W )
+{
+    size_t work_size;
+    heevd_work_size_bytes( jobz, uplo, n, A, lda, W, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return heevd( jobz, uplo, n, A, lda, W, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* W,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "cheevd", { jobz_, uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    float qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cheevd(
+        &jobz_, &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        W,
+        (lapack_complex_float*) qry_work, &ineg_one,
+        qry_rwork, &ineg_one,
+        qry_iwork, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // iwork, rwork, then work
+    *host_work_size = internal::workspace_bytes< lapack_int >( heevd_liwork( jobz, n ) )
+                    + internal::workspace_bytes< float >( heevd_lrwork( jobz, n ) )
+                    + internal::workspace_bytes< std::complex<float> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::heevd`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+/// For real matrices, this is an alias for `lapack::syevd_work_size_bytes`.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::heevd`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::heevd`.
+///
+/// @ingroup heev
+void heevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* W,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -149,6 +214,11 @@ int64_t heevd(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "zheevd", { jobz_, uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     std::complex<double> qry_work[1];
     double qry_rwork[1];
@@ -166,21 +236,124 @@ int64_t heevd(
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = real(qry_rwork[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    // iwork, rwork, then work
+    *host_work_size = internal::workspace_bytes< lapack_int >( heevd_liwork( jobz, n ) )
+                    + internal::workspace_bytes< double >( heevd_lrwork( jobz, n ) )
+                    + internal::workspace_bytes< std::complex<double> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* W,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "heevd", 'c', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int liwork_ = heevd_liwork( jobz, n );
+    lapack_int lrwork_ = heevd_lrwork( jobz, n );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    float* rwork = workspace.take< float >( lrwork_ );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_cheevd(
+        &jobz_, &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        W,
+        (lapack_complex_float*) work, &lwork_,
+        rwork, &lrwork_,
+        iwork, &liwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Computes all eigenvalues and, optionally, eigenvectors of a
+/// Hermitian matrix A,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::heevd` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+/// For real matrices, this is an alias for `lapack::syevd`.
+///
+/// @param[in,out] jobz, uplo, n, A, lda, W
+///     As for `lapack::heevd` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::heevd_work_size_bytes`.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i and jobz = NoVec, then the algorithm failed
+///              to converge; i off-diagonal elements of an intermediate
+///              tridiagonal form did not converge to zero;
+///              if return value = i and jobz = Vec, then the algorithm failed
+///              to compute an eigenvalue while working on the submatrix
+///              lying in rows and columns info/(n+1) through
+///              mod(info,n+1).
+///
+/// @ingroup heev
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* W,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "heevd", 'z', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int liwork_ = heevd_liwork( jobz, n );
+    lapack_int lrwork_ = heevd_lrwork( jobz, n );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    double* rwork = workspace.take< double >( lrwork_ );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zheevd(
         &jobz_, &uplo_, &n_,
         (lapack_complex_double*) A, &lda_,
         W,
-        (lapack_complex_double*) &work[0], &lwork_,
-        &rwork[0], &lrwork_,
-        &iwork[0], &liwork_, &info_
+        (lapack_complex_double*) work, &lwork_,
+        rwork, &lrwork_,
+        iwork, &liwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
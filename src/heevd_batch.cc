@@ -0,0 +1,192 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "NoConstructAllocator.hh"
+#include "batch.hh"
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Computes all eigenvalues and, optionally, eigenvectors of a batch of
+/// Hermitian (or real symmetric) matrices, using the divide and conquer
+/// algorithm. See `lapack::heevd` and `lapack::syevd`.
+/// Matrices are processed in parallel; see lapack/batch.hh.
+/// The workspace is queried once and allocated once per thread.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+/// For real matrices, `lapack::syevd_batch` is an alias.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: Compute eigenvalues only;
+///     - lapack::Job::Vec:   Compute eigenvalues and eigenvectors.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of each A is stored;
+///     - lapack::Uplo::Lower: Lower triangle of each A is stored.
+///
+/// @param[in] n
+///     The order of each matrix A. n >= 0.
+///
+/// @param[in,out] Aarray
+///     Array of batch_count pointers to n-by-n matrices A, each stored in
+///     an lda-by-n array. On exit, if jobz = Vec, the orthonormal
+///     eigenvectors; otherwise the stored triangle is destroyed.
+///
+/// @param[in] lda
+///     The leading dimension of each A. lda >= max(1,n).
+///
+/// @param[out] Warray
+///     Array of batch_count pointers to vectors W, each of length n.
+///     If successful, the eigenvalues in ascending order.
+///
+/// @param[out] info
+///     Array of length batch_count. info[ i ] is the `lapack::heevd` return
+///     value for the i-th matrix: 0 on success; > 0 if it failed to converge.
+///
+/// @param[in] batch_count
+///     The number of matrices. batch_count >= 0.
+///
+/// @ingroup heev
+template <typename scalar_t>
+void heevd_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    blas::real_type<scalar_t>* const* Warray,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( batch_count < 0 );
+    if (batch_count == 0)
+        return;
+
+    // one workspace per thread
+    size_t work_size;
+    heevd_work_size_bytes( jobz, uplo, n, Aarray[ 0 ], lda, Warray[ 0 ],
+                           &work_size );
+    int nthreads = internal::batch_num_threads( batch_count );
+    lapack::vector< char > work( work_size * nthreads );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int thread ) {
+        info[ i ] = heevd( jobz, uplo, n, Aarray[ i ], lda, Warray[ i ],
+                           &work[ thread*work_size ], work_size );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes eigenvalues and, optionally, eigenvectors of a batch of
+/// Hermitian matrices stored with a fixed stride.
+/// Otherwise the same as `lapack::heevd_batch`.
+/// For real matrices, `lapack::syevd_strided_batch` is an alias.
+///
+/// @param[in,out] A
+///     The i-th matrix A is stored at A + i*strideA.
+///
+/// @param[in] strideA
+///     Stride between matrices in A. strideA >= lda*n.
+///
+/// @param[out] W
+///     The i-th vector of eigenvalues is stored at W + i*strideW.
+///
+/// @param[in] strideW
+///     Stride between vectors W. strideW >= n.
+///
+/// @ingroup heev
+template <typename scalar_t>
+void heevd_strided_batch(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    blas::real_type<scalar_t>* W, int64_t strideW,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( strideW < n );
+    lapack_error_if( batch_count < 0 );
+    if (batch_count == 0)
+        return;
+
+    // one workspace per thread
+    size_t work_size;
+    heevd_work_size_bytes( jobz, uplo, n, A, lda, W, &work_size );
+    int nthreads = internal::batch_num_threads( batch_count );
+    lapack::vector< char > work( work_size * nthreads );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int thread ) {
+        info[ i ] = heevd( jobz, uplo, n, &A[ i*strideA ], lda,
+                           &W[ i*strideW ],
+                           &work[ thread*work_size ], work_size );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void heevd_batch<float>(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* const* Aarray, int64_t lda,
+    float* const* Warray,
+    int64_t* info, int64_t batch_count );
+
+template
+void heevd_batch<double>(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* const* Aarray, int64_t lda,
+    double* const* Warray,
+    int64_t* info, int64_t batch_count );
+
+template
+void heevd_batch< std::complex<float> >(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* const* Aarray, int64_t lda,
+    float* const* Warray,
+    int64_t* info, int64_t batch_count );
+
+template
+void heevd_batch< std::complex<double> >(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* const* Aarray, int64_t lda,
+    double* const* Warray,
+    int64_t* info, int64_t batch_count );
+
+template
+void heevd_strided_batch<float>(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    float* W, int64_t strideW,
+    int64_t* info, int64_t batch_count );
+
+template
+void heevd_strided_batch<double>(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    double* W, int64_t strideW,
+    int64_t* info, int64_t batch_count );
+
+template
+void heevd_strided_batch< std::complex<float> >(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    float* W, int64_t strideW,
+    int64_t* info, int64_t batch_count );
+
+template
+void heevd_strided_batch< std::complex<double> >(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    double* W, int64_t strideW,
+    int64_t* info, int64_t batch_count );
+
+}  // namespace lapack
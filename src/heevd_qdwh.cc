@@ -0,0 +1,192 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/polar.hh"
+#include "qdwh.hh"
+#include "sketch.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Eigenvalues W, ascending, and eigenvectors Z of the n-by-n Hermitian
+/// matrix A, with both triangles stored, by spectral divide and conquer.
+/// A is destroyed.
+///
+/// With sigma the median of diag( A ), the polar factor U of A - sigma I
+/// is sign( A - sigma I ), so P = (U + I) / 2 is the spectral projector
+/// onto the invariant subspace of eigenvalues > sigma, of dimension
+/// k = trace( P ). Two passes of a randomized range finder on P give an
+/// orthonormal basis V1 of it, completed to V = [ V1 V2 ] by the
+/// Householder QR of V1. Then
+///     V^H A V = [ A1  0  ]
+///               [ 0   A2 ],
+/// up to errors of order eps ||A||, and the eigenproblems of A1 (eigenvalues
+/// > sigma) and A2 (< sigma) are solved recursively. Blocks of order
+/// <= min_size, with all eigenvalues on one side of sigma, or with sigma
+/// too close to an eigenvalue to split accurately, use heevd.
+template <typename scalar_t>
+static int64_t heevd_qdwh_rec(
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* iseed )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const int64_t min_size = 128;
+    const real_t tol = 10 * n * std::numeric_limits< real_t >::epsilon();
+
+    auto base_case = [&]() {
+        lapack::lacpy( MatrixType::Lower, n, n, A, lda, Z, ldz );
+        return lapack::heevd( Job::Vec, Uplo::Lower, n, Z, ldz, W );
+    };
+    if (n <= min_size)
+        return base_case();
+
+    // sigma = median of diag( A )
+    std::vector< real_t > diag( n );
+    for (int64_t i = 0; i < n; ++i)
+        diag[ i ] = std::real( A[ i + i*lda ] );
+    std::nth_element( diag.begin(), diag.begin() + n/2, diag.end() );
+    real_t sigma = diag[ n/2 ];
+
+    // P = (polar( A - sigma I ) + I) / 2, k = trace( P )
+    std::vector< scalar_t > P( n * n );
+    lapack::lacpy( MatrixType::General, n, n, A, lda, &P[ 0 ], n );
+    for (int64_t i = 0; i < n; ++i)
+        P[ i + i*n ] -= sigma;
+    if (internal::qdwh_iterate( n, n, &P[ 0 ], n ) != 0)
+        return base_case();
+    real_t trace = 0;
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < n; ++i)
+            P[ i + j*n ] /= real_t( 2 );
+        P[ j + j*n ] += real_t( 0.5 );
+        trace += std::real( P[ j + j*n ] );
+    }
+    int64_t k = std::llround( trace );
+    if (k <= 0 || k >= n)
+        return base_case();
+
+    // V1 = orth( P orth( P Omega ) ), then V = [ V1 V2 ] from its QR
+    std::vector< scalar_t > Y( n * k ), V( n * n ), tau( k );
+    internal::sketch( Side::Right, Sketch::Gaussian, n, n, k,
+                      &P[ 0 ], n, &Y[ 0 ], n, iseed );
+    lapack::geqrf( n, k, &Y[ 0 ], n, &tau[ 0 ] );
+    lapack::ungqr( n, k, k, &Y[ 0 ], n, &tau[ 0 ] );
+    blas::hemm( blas::Layout::ColMajor, Side::Left, Uplo::Lower, n, k,
+                one,  &P[ 0 ], n, &Y[ 0 ], n,
+                zero, &V[ 0 ], n );
+    lapack::geqrf( n, k, &V[ 0 ], n, &tau[ 0 ] );
+    lapack::ungqr( n, n, k, &V[ 0 ], n, &tau[ 0 ] );
+
+    // C = V^H A V, reusing P; A1 = C( 0:k-1, 0:k-1 ), A2 = C( k:n-1, k:n-1 )
+    blas::hemm( blas::Layout::ColMajor, Side::Left, Uplo::Lower, n, n,
+                one,  A, lda, &V[ 0 ], n,
+                zero, Z, ldz );
+    blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                n, n, n,
+                one,  &V[ 0 ], n, Z, ldz,
+                zero, &P[ 0 ], n );
+
+    // If sigma is too close to an eigenvalue, P is not accurately a
+    // projector, and the off-diagonal block C( k:n-1, 0:k-1 ) is not small.
+    real_t Cnorm = lapack::lange( Norm::Fro, n, n, &P[ 0 ], n );
+    real_t offnorm = lapack::lange( Norm::Fro, n - k, k, &P[ k ], n );
+    if (offnorm > tol * Cnorm)
+        return base_case();
+
+    // Solve A2 into the first n - k eigenpairs, A1 into the last k;
+    // Z1, Z2 go in the free array A, then Z = [ V2 Z2, V1 Z1 ].
+    int64_t n2 = n - k;
+    int64_t info = heevd_qdwh_rec( n2, &P[ k + k*n ], n, W, A, lda, iseed );
+    if (info == 0)
+        info = heevd_qdwh_rec( k, &P[ 0 ], n, &W[ n2 ], &A[ n2*lda ], lda, iseed );
+    if (info != 0)
+        return info;
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                n, n2, n2,
+                one,  &V[ k*n ], n, A, lda,
+                zero, Z, ldz );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                n, k, k,
+                one,  &V[ 0 ], n, &A[ n2*lda ], lda,
+                zero, &Z[ n2*ldz ], ldz );
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t heevd_qdwh(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* W )
+{
+    using blas::conj;
+
+    // check arguments
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+
+    if (n == 0)
+        return 0;
+
+    // B = A, with both triangles
+    std::vector< scalar_t > B( n * n );
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < n; ++i) {
+            bool stored = (uplo == Uplo::Lower ? i >= j : i <= j);
+            B[ i + j*n ] = stored ? A[ i + j*lda ] : conj( A[ j + i*lda ] );
+        }
+        B[ j + j*n ] = std::real( B[ j + j*n ] );
+    }
+
+    int64_t iseed[ 4 ] = { 0, 0, 0, 1 };
+    std::vector< scalar_t > Z( n * n );
+    int64_t info = heevd_qdwh_rec( n, &B[ 0 ], n, W, &Z[ 0 ], n, iseed );
+
+    // Eigenvalues within rounding of a split point may be out of order.
+    for (int64_t j = 1; j < n; ++j) {
+        for (int64_t i = j; i > 0 && W[ i ] < W[ i-1 ]; --i) {
+            std::swap( W[ i ], W[ i-1 ] );
+            blas::swap( n, &Z[ i*n ], 1, &Z[ (i-1)*n ], 1 );
+        }
+    }
+
+    if (jobz == Job::Vec)
+        lapack::lacpy( MatrixType::General, n, n, &Z[ 0 ], n, A, lda );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_HEEVD_QDWH_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t heevd_qdwh< scalar_t >( \
+        lapack::Job jobz, lapack::Uplo uplo, int64_t n, \
+        scalar_t* A, int64_t lda, \
+        blas::real_type< scalar_t >* W );
+
+LAPACK_HEEVD_QDWH_INSTANTIATE( float )
+LAPACK_HEEVD_QDWH_INSTANTIATE( double )
+LAPACK_HEEVD_QDWH_INSTANTIATE( std::complex<float> )
+LAPACK_HEEVD_QDWH_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_HEEVD_QDWH_INSTANTIATE
+
+}  // namespace lapack
@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -15,6 +18,20 @@ using blas::max;
 using blas::min;
 using blas::real;
 
+// -----------------------------------------------------------------------------
+// Size of rwork for heevr, from documentation.
+static int64_t heevr_lrwork( int64_t n )
+{
+    return max( 1, 24*n );
+}
+
+// -----------------------------------------------------------------------------
+// Size of iwork for heevr, from documentation.
+static int64_t heevr_liwork( int64_t n )
+{
+    return max( 1, 10*n );
+}
+
 // -----------------------------------------------------------------------------
 /// @ingroup heev
 int64_t heevr(
@@ -25,77 +42,13 @@ int64_t heevr(
     std::complex<float>* Z, int64_t ldz,
     int64_t* isuppz )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobz_ = job2char( jobz );
-    char range_ = range2char( range );
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int il_ = (lapack_int) il;
-    lapack_int iu_ = (lapack_int) iu;
-    lapack_int nfound_ = (lapack_int) *nfound;
-    lapack_int ldz_ = (lapack_int) ldz;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was max(1,nfound), n >= nfound
-        lapack_int* isuppz_ptr = &isuppz_[0];
-    #else
-        lapack_int* isuppz_ptr = isuppz;
-    #endif
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    float qry_rwork[1];
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cheevr(
-        &jobz_, &range_, &uplo_, &n_,
-        (lapack_complex_float*) A, &lda_, &vl, &vu, &il_, &iu_, &abstol, &nfound_,
-        W,
-        (lapack_complex_float*) Z, &ldz_,
-        isuppz_ptr,
-        (lapack_complex_float*) qry_work, &ineg_one,
-        qry_rwork, &ineg_one,
-        qry_iwork, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = real(qry_rwork[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
+    size_t work_size;
+    heevr_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, &work_size );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_cheevr(
-        &jobz_, &range_, &uplo_, &n_,
-        (lapack_complex_float*) A, &lda_, &vl, &vu, &il_, &iu_, &abstol, &nfound_,
-        W,
-        (lapack_complex_float*) Z, &ldz_,
-        isuppz_ptr,
-        (lapack_complex_float*) &work[0], &lwork_,
-        &rwork[0], &lrwork_,
-        &iwork[0], &liwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    *nfound = nfound_;
-    #ifndef LAPACK_ILP64
-        std::copy( isuppz_.begin(), isuppz_.end(), isuppz );
-    #endif
-    return info_;
+    return heevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -300,6 +253,26 @@ int64_t heevr(
     double* W,
     std::complex<double>* Z, int64_t ldz,
     int64_t* isuppz )
+{
+    size_t work_size;
+    heevr_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return heevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* nfound,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    int64_t* isuppz,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -316,28 +289,110 @@ int64_t heevr(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int il_ = (lapack_int) il;
     lapack_int iu_ = (lapack_int) iu;
-    lapack_int nfound_ = (lapack_int) *nfound;
     lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int nfound_ = 0;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "cheevr", { jobz_, range_, uplo_, n_, lda_, ldz_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    float qry_rwork[1];
+    lapack_int qry_iwork[1];
+    lapack_int qry_isuppz[2];
+    lapack_int ineg_one = -1;
+    LAPACK_cheevr(
+        &jobz_, &range_, &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_, &vl, &vu, &il_, &iu_, &abstol, &nfound_,
+        W,
+        (lapack_complex_float*) Z, &ldz_,
+        qry_isuppz,
+        (lapack_complex_float*) qry_work, &ineg_one,
+        qry_rwork, &ineg_one,
+        qry_iwork, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // [32-bit isuppz copy], iwork, [rwork], then work
+    size_t size = 0;
     #ifndef LAPACK_ILP64
-        // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was max(1,nfound), n >= nfound
-        lapack_int* isuppz_ptr = &isuppz_[0];
-    #else
-        lapack_int* isuppz_ptr = isuppz;
+        size += internal::workspace_bytes< lapack_int >( 2*max( 1, n ) );
     #endif
+    size += internal::workspace_bytes< lapack_int >( heevr_liwork( n ) );
+    size += internal::workspace_bytes< float >( heevr_lrwork( n ) );
+    size += internal::workspace_bytes< std::complex<float> >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::heevr`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+/// For real matrices, this is an alias for `lapack::syevr_work_size_bytes`.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::heevr`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::heevr`.
+///
+/// @ingroup heev
+void heevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    int64_t* isuppz,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int nfound_ = 0;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "zheevr", { jobz_, range_, uplo_, n_, lda_, ldz_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     std::complex<double> qry_work[1];
     double qry_rwork[1];
     lapack_int qry_iwork[1];
+    lapack_int qry_isuppz[2];
     lapack_int ineg_one = -1;
     LAPACK_zheevr(
         &jobz_, &range_, &uplo_, &n_,
         (lapack_complex_double*) A, &lda_, &vl, &vu, &il_, &iu_, &abstol, &nfound_,
         W,
         (lapack_complex_double*) Z, &ldz_,
-        isuppz_ptr,
+        qry_isuppz,
         (lapack_complex_double*) qry_work, &ineg_one,
         qry_rwork, &ineg_one,
         qry_iwork, &ineg_one, &info_
@@ -346,13 +401,155 @@ int64_t heevr(
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = real(qry_rwork[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    // [32-bit isuppz copy], iwork, [rwork], then work
+    size_t size = 0;
+    #ifndef LAPACK_ILP64
+        size += internal::workspace_bytes< lapack_int >( 2*max( 1, n ) );
+    #endif
+    size += internal::workspace_bytes< lapack_int >( heevr_liwork( n ) );
+    size += internal::workspace_bytes< double >( heevr_lrwork( n ) );
+    size += internal::workspace_bytes< std::complex<double> >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* nfound,
+    float* W,
+    std::complex<float>* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "heevr", 'c', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    #ifndef LAPACK_ILP64
+        // 32-bit copy
+        lapack_int* isuppz_ptr = workspace.take< lapack_int >( 2*max( 1, n ) );
+    #else
+        lapack_int* isuppz_ptr = isuppz;
+    #endif
+    lapack_int liwork_ = heevr_liwork( n );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    lapack_int lrwork_ = heevr_lrwork( n );
+    float* rwork = workspace.take< float >( lrwork_ );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_cheevr(
+        &jobz_, &range_, &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_, &vl, &vu, &il_, &iu_, &abstol, &nfound_,
+        W,
+        (lapack_complex_float*) Z, &ldz_,
+        isuppz_ptr,
+        (lapack_complex_float*) work, &lwork_,
+        rwork, &lrwork_,
+        iwork, &liwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *nfound = nfound_;
+    #ifndef LAPACK_ILP64
+        std::copy( isuppz_ptr, isuppz_ptr + 2*max( 1, n ), isuppz );
+    #endif
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Computes selected eigenvalues and, optionally, eigenvectors
+/// of a Hermitian matrix A,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::heevr` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+/// For real matrices, this is an alias for `lapack::syevr`.
+///
+/// @param[in,out] jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz
+///     As for `lapack::heevr` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::heevr_work_size_bytes`.
+///
+/// @return = 0: successful exit
+/// @return > 0: Internal error
+///
+/// @ingroup heev
+int64_t heevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    std::complex<double>* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "heevr", 'z', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    #ifndef LAPACK_ILP64
+        // 32-bit copy
+        lapack_int* isuppz_ptr = workspace.take< lapack_int >( 2*max( 1, n ) );
+    #else
+        lapack_int* isuppz_ptr = isuppz;
+    #endif
+    lapack_int liwork_ = heevr_liwork( n );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    lapack_int lrwork_ = heevr_lrwork( n );
+    double* rwork = workspace.take< double >( lrwork_ );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zheevr(
         &jobz_, &range_, &uplo_, &n_,
@@ -360,16 +557,16 @@ int64_t heevr(
         W,
         (lapack_complex_double*) Z, &ldz_,
         isuppz_ptr,
-        (lapack_complex_double*) &work[0], &lwork_,
-        &rwork[0], &lrwork_,
-        &iwork[0], &liwork_, &info_
+        (lapack_complex_double*) work, &lwork_,
+        rwork, &lrwork_,
+        iwork, &liwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
     *nfound = nfound_;
     #ifndef LAPACK_ILP64
-        std::copy( isuppz_.begin(), isuppz_.end(), isuppz );
+        std::copy( isuppz_ptr, isuppz_ptr + 2*max( 1, n ), isuppz );
     #endif
     return info_;
 }
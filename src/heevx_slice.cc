@@ -0,0 +1,74 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/slice.hh"
+#include "slice.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t heevx_slice(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t > vl, blas::real_type< scalar_t > vu,
+    int64_t il, int64_t iu,
+    int64_t* nfound,
+    blas::real_type< scalar_t >* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // check arguments; the rest are checked by stevx_slice,
+    // but checking uplo and lda here avoids reducing A for nothing.
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+
+    std::vector< real_t > D( max( 1, n ) ), E( max( 1, n-1 ) );
+    std::vector< scalar_t > tau( max( 1, n-1 ) );
+    if (n > 0)
+        lapack::hetrd( uplo, n, A, lda, &D[ 0 ], &E[ 0 ], &tau[ 0 ] );
+
+    int64_t info = internal::stevx_slice( jobz, range, n, &D[ 0 ], &E[ 0 ],
+                                          vl, vu, il, iu,
+                                          nfound, W, Z, ldz, ifail );
+
+    // Z = Q Z, with Q from hetrd
+    if (jobz == Job::Vec && *nfound > 0) {
+        lapack::unmtr( Side::Left, uplo, Op::NoTrans, n, *nfound,
+                       A, lda, &tau[ 0 ], Z, ldz );
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_HEEVX_SLICE_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t heevx_slice< scalar_t >( \
+        lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n, \
+        scalar_t* A, int64_t lda, \
+        blas::real_type< scalar_t > vl, blas::real_type< scalar_t > vu, \
+        int64_t il, int64_t iu, \
+        int64_t* nfound, \
+        blas::real_type< scalar_t >* W, \
+        scalar_t* Z, int64_t ldz, \
+        int64_t* ifail );
+
+LAPACK_HEEVX_SLICE_INSTANTIATE( float )
+LAPACK_HEEVX_SLICE_INSTANTIATE( double )
+LAPACK_HEEVX_SLICE_INSTANTIATE( std::complex<float> )
+LAPACK_HEEVX_SLICE_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_HEEVX_SLICE_INSTANTIATE
+
+}  // namespace lapack
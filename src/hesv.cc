@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -23,6 +24,9 @@ int64_t hesv(
     int64_t* ipiv,
     std::complex<float>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "hesv", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::hesv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -163,6 +167,9 @@ int64_t hesv(
     int64_t* ipiv,
     std::complex<double>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "hesv", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::hesv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
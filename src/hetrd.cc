@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -24,47 +27,13 @@ int64_t hetrd(
     float* E,
     std::complex<float>* tau )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_chetrd(
-        &uplo_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        D,
-        E,
-        (lapack_complex_float*) tau,
-        (lapack_complex_float*) qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    hetrd_work_size_bytes( uplo, n, A, lda, D, E, tau, &work_size );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_chetrd(
-        &uplo_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        D,
-        E,
-        (lapack_complex_float*) tau,
-        (lapack_complex_float*) &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return hetrd( uplo, n, A, lda, D, E, tau, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -181,6 +150,85 @@ int64_t hetrd(
     double* D,
     double* E,
     std::complex<double>* tau )
+{
+    size_t work_size;
+    hetrd_work_size_bytes( uplo, n, A, lda, D, E, tau, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return hetrd( uplo, n, A, lda, D, E, tau, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev_computational
+void hetrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* D,
+    float* E,
+    std::complex<float>* tau,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "chetrd", { uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_chetrd(
+        &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        D,
+        E,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< std::complex<float> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::hetrd`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+/// For real matrices, this is an alias for `lapack::sytrd_work_size_bytes`.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::hetrd`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::hetrd`.
+///
+/// @ingroup heev_computational
+void hetrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* D,
+    double* E,
+    std::complex<double>* tau,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -192,6 +240,11 @@ int64_t hetrd(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "zhetrd", { uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     std::complex<double> qry_work[1];
     lapack_int ineg_one = -1;
@@ -208,8 +261,101 @@ int64_t hetrd(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    *host_work_size = internal::workspace_bytes< std::complex<double> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev_computational
+int64_t hetrd(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* D,
+    float* E,
+    std::complex<float>* tau,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "hetrd", 'c', n, n, 0,
+                             Gflop< std::complex<float> >::hetrd( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_chetrd(
+        &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        D,
+        E,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Reduces a Hermitian matrix A to real symmetric tridiagonal form T,
+/// $Q^H A Q = T$,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::hetrd` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+/// For real matrices, this is an alias for `lapack::sytrd`.
+///
+/// @param[in,out] uplo, n, A, lda, D, E, tau
+///     As for `lapack::hetrd` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::hetrd_work_size_bytes`.
+///
+/// @return = 0: successful exit
+///
+/// @ingroup heev_computational
+int64_t hetrd(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* D,
+    double* E,
+    std::complex<double>* tau,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "hetrd", 'z', n, n, 0,
+                             Gflop< std::complex<double> >::hetrd( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zhetrd(
         &uplo_, &n_,
@@ -217,7 +363,7 @@ int64_t hetrd(
         D,
         E,
         (lapack_complex_double*) tau,
-        (lapack_complex_double*) &work[0], &lwork_, &info_
+        (lapack_complex_double*) work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
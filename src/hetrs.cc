@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -23,6 +24,9 @@ int64_t hetrs(
     int64_t const* ipiv,
     std::complex<float>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "hetrs", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::hetrs( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -111,6 +115,9 @@ int64_t hetrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "hetrs", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::hetrs( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -144,4 +151,87 @@ int64_t hetrs(
     return info_;
 }
 
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// @ingroup hesv_computational
+int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "hetrs", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::hetrs( n, nrhs ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_chetrs(
+        &uplo_, &n_, &nrhs_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) B, &ldb_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Overloaded versions taking `lapack_int` pivots, for LP64 builds
+/// (32-bit lapack_int), pass ipiv directly to LAPACK, instead of
+/// copying to and from a temporary `int64_t` array.
+/// Otherwise the same as the `int64_t` pivot version.
+/// @see lapack::hetrs
+/// @ingroup hesv_computational
+int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb )
+{
+    LAPACK_INSTRUMENT_SCOPE( "hetrs", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::hetrs( n, nrhs ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(nrhs) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldb) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+    lapack_int info_ = 0;
+
+    LAPACK_zhetrs(
+        &uplo_, &n_, &nrhs_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) B, &ldb_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
@@ -7,11 +7,14 @@
 
 #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_SYCL))
 
+#include "lapack.hh"
 #include "lapack/device.hh"
 
 //==============================================================================
 namespace lapack {
 
+using blas::max;
+
 //------------------------------------------------------------------------------
 // Wrapper around workspace query.
 // dA is only for templating scalar_t; it isn't referenced.
@@ -22,13 +25,16 @@ void geqrf_work_size_bytes(
     size_t* dev_work_size, size_t* host_work_size,
     lapack::Queue& queue )
 {
-    *dev_work_size  = 0;
+    // "Device" workspace is host memory used as host LAPACK's workspace.
+    // dA doubles as tau, which is also not referenced.
+    lapack::geqrf_work_size_bytes( m, n, dA, ldda, dA, dev_work_size );
     *host_work_size = 0;
 }
 
 //------------------------------------------------------------------------------
-// Wrapper stub.
-// This is async. Once finished, the return info is in dev_info on the device.
+// Wrapper around host LAPACK.
+// This is async. Once finished, the return info is in dev_info.
+// Arguments are checked before enqueueing, so errors throw here.
 template <typename scalar_t>
 void geqrf(
     int64_t m, int64_t n,
@@ -37,7 +43,14 @@ void geqrf(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue )
 {
-    throw lapack::Error( "device LAPACK not available", __func__ );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldda < max( 1, m ) );
+
+    queue.enqueue( [=]() {
+        *dev_info = lapack::geqrf( m, n, dA, ldda, dtau,
+                                   dev_work, dev_work_size );
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -7,14 +7,18 @@
 
 #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_SYCL))
 
+#include "lapack.hh"
 #include "lapack/device.hh"
 
 //==============================================================================
 namespace lapack {
 
+using blas::max;
+
 //------------------------------------------------------------------------------
 // Wrapper around workspace query.
 // dA is only for templating scalar_t; it isn't referenced.
+// Host getrf needs no workspace.
 template <typename scalar_t>
 void getrf_work_size_bytes(
     int64_t m, int64_t n,
@@ -27,8 +31,9 @@ void getrf_work_size_bytes(
 }
 
 //------------------------------------------------------------------------------
-// Wrapper stub.
-// This is async. Once finished, the return info is in dev_info on the device.
+// Wrapper around host LAPACK.
+// This is async. Once finished, the return info is in dev_info.
+// Arguments are checked before enqueueing, so errors throw here.
 template <typename scalar_t>
 void getrf(
     int64_t m, int64_t n,
@@ -37,7 +42,13 @@ void getrf(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue )
 {
-    throw lapack::Error( "device LAPACK not available", __func__ );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldda < max( 1, m ) );
+
+    queue.enqueue( [=]() {
+        *dev_info = lapack::getrf( m, n, dA, ldda, dipiv );
+    });
 }
 
 //------------------------------------------------------------------------------
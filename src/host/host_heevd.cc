@@ -7,15 +7,17 @@
 
 #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_SYCL))
 
+#include "lapack.hh"
 #include "lapack/device.hh"
 
-
 //==============================================================================
 namespace lapack {
 
+using blas::max;
+
 //------------------------------------------------------------------------------
 // Wrapper around workspace query.
-// dA is only for templating scalar_t; it isn't referenced.
+// dA and dW are only for templating scalar_t; they aren't referenced.
 template <typename scalar_t>
 void heevd_work_size_bytes(
     lapack::Job jobz, lapack::Uplo uplo,
@@ -23,13 +25,15 @@ void heevd_work_size_bytes(
     size_t* dev_work_size, size_t* host_work_size,
     lapack::Queue& queue )
 {
-    *dev_work_size  = 0;
+    // "Device" workspace is host memory used as host LAPACK's workspace.
+    lapack::heevd_work_size_bytes( jobz, uplo, n, dA, ldda, dW, dev_work_size );
     *host_work_size = 0;
 }
 
 //------------------------------------------------------------------------------
-// Wrapper stub.
-// This is async. Once finished, the return info is in dev_info on the device.
+// Wrapper around host LAPACK.
+// This is async. Once finished, the return info is in dev_info.
+// Arguments are checked before enqueueing, so errors throw here.
 template <typename scalar_t>
 void heevd(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
@@ -38,7 +42,15 @@ void heevd(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue )
 {
-    throw lapack::Error( "device LAPACK not available", __func__ );
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldda < max( 1, n ) );
+
+    queue.enqueue( [=]() {
+        *dev_info = lapack::heevd( jobz, uplo, n, dA, ldda, dW,
+                                   dev_work, dev_work_size );
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -106,5 +118,5 @@ void heevd(
 
 } // namespace lapack
 
-#endif // LAPACK_HAVE_CUBLAS
+#endif // ! (LAPACK_HAVE_ROCBLAS || LAPACK_HAVE_CUBLAS || LAPACK_HAVE_SYCL)
 
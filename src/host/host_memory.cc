@@ -0,0 +1,71 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_SYCL))
+
+#include "lapack.hh"
+#include "lapack/device.hh"
+
+#include <cstdlib>
+#include <cstring>
+
+//==============================================================================
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Allocates "device" memory, which is host memory. Like cudaMalloc,
+/// this is synchronous. Throws Error if allocation fails.
+void* host_device_malloc( size_t bytes )
+{
+    void* ptr = std::malloc( bytes > 0 ? bytes : 1 );
+    lapack_error_if_msg( ptr == nullptr, "device_malloc failed" );
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+/// Frees memory from host_device_malloc, after routines already enqueued.
+void host_device_free( void* ptr, lapack::Queue& queue )
+{
+    queue.enqueue( [=]() {
+        std::free( ptr );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Sets bytes of ptr to value. This is async.
+void host_device_memset(
+    void* ptr, int value, size_t bytes, lapack::Queue& queue )
+{
+    queue.enqueue( [=]() {
+        std::memset( ptr, value, bytes );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Copies height rows of width bytes, with pitches in bytes between rows.
+/// This is async.
+void host_device_memcpy_2d(
+    void* dst, size_t dst_pitch,
+    void const* src, size_t src_pitch,
+    size_t width, int64_t height, lapack::Queue& queue )
+{
+    if (width == 0 || height <= 0)
+        return;
+
+    queue.enqueue( [=]() {
+        char*       d = static_cast<char*>( dst );
+        char const* s = static_cast<char const*>( src );
+        for (int64_t i = 0; i < height; ++i)
+            std::memcpy( d + i*dst_pitch, s + i*src_pitch, width );
+    });
+}
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // ! (LAPACK_HAVE_ROCBLAS || LAPACK_HAVE_CUBLAS || LAPACK_HAVE_SYCL)
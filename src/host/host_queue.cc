@@ -0,0 +1,133 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_SYCL))
+
+#include "lapack/device.hh"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+//==============================================================================
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Runs tasks in FIFO order on one worker thread, similar to a GPU stream.
+/// An exception thrown by a task is saved and rethrown by sync;
+/// later tasks still run.
+class HostQueue
+{
+public:
+    HostQueue():
+        busy_( false ),
+        done_( false ),
+        thread_( &HostQueue::run, this )
+    {}
+
+    /// Runs the remaining tasks, then joins the worker thread.
+    ~HostQueue()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            done_ = true;
+        }
+        task_ready_.notify_one();
+        thread_.join();
+    }
+
+    void enqueue( std::function< void () > task )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            tasks_.push_back( std::move( task ) );
+        }
+        task_ready_.notify_one();
+    }
+
+    void sync()
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        idle_.wait( lock, [this] { return tasks_.empty() && ! busy_; } );
+        if (error_) {
+            std::exception_ptr error = error_;
+            error_ = nullptr;
+            std::rethrow_exception( error );
+        }
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        while (true) {
+            task_ready_.wait( lock, [this] { return done_ || ! tasks_.empty(); } );
+            if (tasks_.empty())
+                return;  // done_ and drained
+
+            std::function< void () > task = std::move( tasks_.front() );
+            tasks_.pop_front();
+            busy_ = true;
+            lock.unlock();
+
+            std::exception_ptr error;
+            try {
+                task();
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            if (error && ! error_)
+                error_ = error;
+            busy_ = false;
+            if (tasks_.empty())
+                idle_.notify_all();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable task_ready_;
+    std::condition_variable idle_;
+    std::deque< std::function< void () > > tasks_;
+    std::exception_ptr error_;
+    bool busy_;
+    bool done_;
+    std::thread thread_;  // last, so it starts after the members above
+};
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+void Queue::enqueue( std::function< void () > task )
+{
+    if (host_queue_ == nullptr)
+        host_queue_ = new internal::HostQueue();
+    host_queue_->enqueue( std::move( task ) );
+}
+
+//------------------------------------------------------------------------------
+void Queue::sync()
+{
+    if (host_queue_ != nullptr)
+        host_queue_->sync();
+}
+
+//------------------------------------------------------------------------------
+void Queue::host_queue_free()
+{
+    delete host_queue_;
+    host_queue_ = nullptr;
+}
+
+}  // namespace lapack
+
+#endif // ! (LAPACK_HAVE_ROCBLAS || LAPACK_HAVE_CUBLAS || LAPACK_HAVE_SYCL)
@@ -0,0 +1,252 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "Instrument.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Key for instrumentation records. routine must be a string literal,
+/// as only the pointer is kept; keys compare by string, not pointer.
+struct InstrumentKey
+{
+    char const* routine;
+    char type;
+    int64_t m, n, k;
+
+    bool operator < ( InstrumentKey const& other ) const
+    {
+        int cmp = strcmp( routine, other.routine );
+        if (cmp != 0)
+            return cmp < 0;
+        return std::tie( type, m, n, k )
+             < std::tie( other.type, other.m, other.n, other.k );
+    }
+};
+
+struct InstrumentTotal
+{
+    int64_t calls = 0;
+    double time = 0;
+    double gflop = 0;
+};
+
+//------------------------------------------------------------------------------
+/// Process-wide instrumentation records and callbacks, guarded by a mutex.
+/// Callbacks are copied under the mutex and invoked outside it, so a
+/// callback may itself call LAPACK++ or replace the callbacks.
+class Instrument
+{
+public:
+    void add( InstrumentEvent const& event )
+    {
+        InstrumentKey key = { event.routine, event.type,
+                              event.m, event.n, event.k };
+        std::lock_guard< std::mutex > guard( mutex_ );
+        InstrumentTotal& total = map_[ key ];
+        total.calls += 1;
+        total.time  += event.time;
+        total.gflop += event.gflop;
+    }
+
+    void clear()
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        map_.clear();
+    }
+
+    std::vector< InstrumentRecord > records()
+    {
+        std::vector< InstrumentRecord > list;
+        {
+            std::lock_guard< std::mutex > guard( mutex_ );
+            list.reserve( map_.size() );
+            for (auto const& iter : map_) {
+                InstrumentKey const& key = iter.first;
+                InstrumentTotal const& total = iter.second;
+                list.push_back( { key.routine, key.type, key.m, key.n, key.k,
+                                  total.calls, total.time, total.gflop } );
+            }
+        }
+        std::stable_sort(
+            list.begin(), list.end(),
+            []( InstrumentRecord const& a, InstrumentRecord const& b ) {
+                return a.time > b.time;
+            } );
+        return list;
+    }
+
+    void set_callbacks( InstrumentCallback begin, InstrumentCallback end )
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        begin_ = std::move( begin );
+        end_   = std::move( end );
+    }
+
+    /// @return copy of the begin callback, so it can be called unlocked.
+    InstrumentCallback begin_callback()
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        return begin_;
+    }
+
+    /// @return copy of the end callback, so it can be called unlocked.
+    InstrumentCallback end_callback()
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        return end_;
+    }
+
+private:
+    std::mutex mutex_;
+    InstrumentCallback begin_;
+    InstrumentCallback end_;
+    std::map< InstrumentKey, InstrumentTotal > map_;
+};
+
+//------------------------------------------------------------------------------
+/// @return the process-wide records, constructed on first use.
+static Instrument& instrument()
+{
+    static Instrument s_instrument;
+    return s_instrument;
+}
+
+std::atomic< bool > instrument_on( false );
+
+//------------------------------------------------------------------------------
+void instrument_begin( InstrumentEvent const& event )
+{
+    InstrumentCallback begin = instrument().begin_callback();
+    if (begin)
+        begin( event );
+}
+
+//------------------------------------------------------------------------------
+void instrument_end( InstrumentEvent const& event )
+{
+    Instrument& inst = instrument();
+    inst.add( event );
+    InstrumentCallback end = inst.end_callback();
+    if (end)
+        end( event );
+}
+
+//------------------------------------------------------------------------------
+/// Prints one row of instrument_dump. Negative dimensions are omitted.
+static void print_record( FILE* file, InstrumentRecord const& rec )
+{
+    fprintf( file, "%-10s %c", rec.routine.c_str(), rec.type );
+    for (int64_t dim : { rec.m, rec.n, rec.k }) {
+        if (dim >= 0)
+            fprintf( file, "  %7lld", llong( dim ) );
+        else
+            fprintf( file, "  %7s", "" );
+    }
+    fprintf( file, "  %9lld  %11.4e  %11.4e",
+             llong( rec.calls ), rec.time, rec.time / rec.calls );
+    if (rec.gflop > 0 && rec.time > 0)
+        fprintf( file, "  %9.3f\n", rec.gflop / rec.time );
+    else
+        fprintf( file, "  %9s\n", "-" );
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+bool instrument_available()
+{
+    #ifdef LAPACK_INSTRUMENT
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void instrument_enable( bool enable )
+{
+    internal::instrument_on = enable && instrument_available();
+}
+
+//------------------------------------------------------------------------------
+bool instrument_enabled()
+{
+    return internal::instrument_on;
+}
+
+//------------------------------------------------------------------------------
+void instrument_reset()
+{
+    internal::instrument().clear();
+}
+
+//------------------------------------------------------------------------------
+std::vector< InstrumentRecord > instrument_records()
+{
+    return internal::instrument().records();
+}
+
+//------------------------------------------------------------------------------
+void instrument_dump( FILE* file )
+{
+    std::vector< InstrumentRecord > list = instrument_records();
+
+    // Sum over dimensions, keyed by routine and type.
+    // Dimensions are -1 so print_record omits them.
+    std::vector< InstrumentRecord > summary;
+    for (auto const& rec : list) {
+        auto iter = std::find_if(
+            summary.begin(), summary.end(),
+            [&rec]( InstrumentRecord const& sum ) {
+                return sum.routine == rec.routine && sum.type == rec.type;
+            } );
+        if (iter == summary.end()) {
+            summary.push_back( { rec.routine, rec.type, -1, -1, -1, 0, 0, 0 } );
+            iter = summary.end() - 1;
+        }
+        iter->calls += rec.calls;
+        iter->time  += rec.time;
+        // If any size's gflop is unknown, NaN makes the sum unknown.
+        iter->gflop += (rec.gflop > 0 ? rec.gflop : nan( "" ));
+    }
+    std::stable_sort(
+        summary.begin(), summary.end(),
+        []( InstrumentRecord const& a, InstrumentRecord const& b ) {
+            return a.time > b.time;
+        } );
+
+    char const* header =
+        "routine    t        m        n        k      calls     time (s)"
+        "     avg (s)    Gflop/s\n";
+
+    fprintf( file, "LAPACK++ instrumentation, per routine\n%s", header );
+    for (auto const& rec : summary)
+        internal::print_record( file, rec );
+
+    fprintf( file, "\nLAPACK++ instrumentation, per routine and size\n%s",
+             header );
+    for (auto const& rec : list)
+        internal::print_record( file, rec );
+}
+
+//------------------------------------------------------------------------------
+void instrument_set_callbacks(
+    InstrumentCallback begin, InstrumentCallback end )
+{
+    internal::instrument().set_callbacks( std::move( begin ), std::move( end ) );
+}
+
+}  // namespace lapack
@@ -35,8 +35,19 @@ void laswp(
     lapack_int k1_ = (lapack_int) k1;
     lapack_int k2_ = (lapack_int) k2;
     #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(k1+(k2-k1)*std::abs(incx))] );
+        // 32-bit copy. For incx > 0, copy only the entries
+        // ipiv( k1 + (k - k1)*incx ), k = k1, ..., k2, that laswp reads,
+        // leaving the rest of ipiv_ uninitialized. For incx < 0,
+        // implementations differ in which entries they read, so copy all.
+        int64_t len = k1 + (k2 - k1)*std::abs( incx );
+        lapack::vector< lapack_int > ipiv_( max( 1, len ) );
+        if (incx > 0) {
+            for (int64_t i = k1 - 1; i < len; i += incx)
+                ipiv_[ i ] = ipiv[ i ];
+        }
+        else {
+            std::copy( &ipiv[0], &ipiv[ max( 0, len ) ], ipiv_.begin() );
+        }
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -69,8 +80,19 @@ void laswp(
     lapack_int k1_ = (lapack_int) k1;
     lapack_int k2_ = (lapack_int) k2;
     #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(k1+(k2-k1)*std::abs(incx))] );
+        // 32-bit copy. For incx > 0, copy only the entries
+        // ipiv( k1 + (k - k1)*incx ), k = k1, ..., k2, that laswp reads,
+        // leaving the rest of ipiv_ uninitialized. For incx < 0,
+        // implementations differ in which entries they read, so copy all.
+        int64_t len = k1 + (k2 - k1)*std::abs( incx );
+        lapack::vector< lapack_int > ipiv_( max( 1, len ) );
+        if (incx > 0) {
+            for (int64_t i = k1 - 1; i < len; i += incx)
+                ipiv_[ i ] = ipiv[ i ];
+        }
+        else {
+            std::copy( &ipiv[0], &ipiv[ max( 0, len ) ], ipiv_.begin() );
+        }
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -103,8 +125,19 @@ void laswp(
     lapack_int k1_ = (lapack_int) k1;
     lapack_int k2_ = (lapack_int) k2;
     #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(k1+(k2-k1)*std::abs(incx))] );
+        // 32-bit copy. For incx > 0, copy only the entries
+        // ipiv( k1 + (k - k1)*incx ), k = k1, ..., k2, that laswp reads,
+        // leaving the rest of ipiv_ uninitialized. For incx < 0,
+        // implementations differ in which entries they read, so copy all.
+        int64_t len = k1 + (k2 - k1)*std::abs( incx );
+        lapack::vector< lapack_int > ipiv_( max( 1, len ) );
+        if (incx > 0) {
+            for (int64_t i = k1 - 1; i < len; i += incx)
+                ipiv_[ i ] = ipiv[ i ];
+        }
+        else {
+            std::copy( &ipiv[0], &ipiv[ max( 0, len ) ], ipiv_.begin() );
+        }
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -175,8 +208,19 @@ void laswp(
     lapack_int k1_ = (lapack_int) k1;
     lapack_int k2_ = (lapack_int) k2;
     #ifndef LAPACK_ILP64
-        // 32-bit copy
-        std::vector< lapack_int > ipiv_( &ipiv[0], &ipiv[(k1+(k2-k1)*std::abs(incx))] );
+        // 32-bit copy. For incx > 0, copy only the entries
+        // ipiv( k1 + (k - k1)*incx ), k = k1, ..., k2, that laswp reads,
+        // leaving the rest of ipiv_ uninitialized. For incx < 0,
+        // implementations differ in which entries they read, so copy all.
+        int64_t len = k1 + (k2 - k1)*std::abs( incx );
+        lapack::vector< lapack_int > ipiv_( max( 1, len ) );
+        if (incx > 0) {
+            for (int64_t i = k1 - 1; i < len; i += incx)
+                ipiv_[ i ] = ipiv[ i ];
+        }
+        else {
+            std::copy( &ipiv[0], &ipiv[ max( 0, len ) ], ipiv_.begin() );
+        }
         lapack_int const* ipiv_ptr = &ipiv_[0];
     #else
         lapack_int const* ipiv_ptr = ipiv;
@@ -189,4 +233,121 @@ void laswp(
         ipiv_ptr, &incx_ );
 }
 
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    float* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k1) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k2) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int k1_ = (lapack_int) k1;
+    lapack_int k2_ = (lapack_int) k2;
+    lapack_int incx_ = (lapack_int) incx;
+
+    LAPACK_slaswp(
+        &n_,
+        A, &lda_, &k1_, &k2_,
+        ipiv, &incx_ );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    double* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k1) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k2) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int k1_ = (lapack_int) k1;
+    lapack_int k2_ = (lapack_int) k2;
+    lapack_int incx_ = (lapack_int) incx;
+
+    LAPACK_dlaswp(
+        &n_,
+        A, &lda_, &k1_, &k2_,
+        ipiv, &incx_ );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k1) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k2) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int k1_ = (lapack_int) k1;
+    lapack_int k2_ = (lapack_int) k2;
+    lapack_int incx_ = (lapack_int) incx;
+
+    LAPACK_claswp(
+        &n_,
+        (lapack_complex_float*) A, &lda_, &k1_, &k2_,
+        ipiv, &incx_ );
+}
+
+// -----------------------------------------------------------------------------
+/// Overloaded versions taking `lapack_int` pivots, for LP64 builds
+/// (32-bit lapack_int), pass ipiv directly to LAPACK, instead of
+/// copying to and from a temporary `int64_t` array.
+/// Otherwise the same as the `int64_t` pivot version.
+/// @see lapack::laswp
+/// @ingroup gesv_computational
+void laswp(
+    int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t k1, int64_t k2,
+    lapack_int const* ipiv, int64_t incx )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k1) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k2) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(incx) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int k1_ = (lapack_int) k1;
+    lapack_int k2_ = (lapack_int) k2;
+    lapack_int incx_ = (lapack_int) incx;
+
+    LAPACK_zlaswp(
+        &n_,
+        (lapack_complex_double*) A, &lda_, &k1_, &k2_,
+        ipiv, &incx_ );
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
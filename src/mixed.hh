@@ -0,0 +1,118 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_MIXED_HH
+#define LAPACK_MIXED_HH
+
+#include "lapack.hh"
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <type_traits>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Low precision type for mixed-precision solvers:
+/// float for double, std::complex<float> for std::complex<double>.
+template <typename scalar_t>
+using low_precision = std::conditional_t<
+    blas::is_complex< scalar_t >::value, std::complex<float>, float >;
+
+//------------------------------------------------------------------------------
+/// Converts general matrix A to low precision SA.
+/// @return 0 on success, or 1 if an entry overflows the low precision.
+inline int64_t to_low(
+    int64_t m, int64_t n,
+    double const* A, int64_t lda,
+    float* SA, int64_t ldsa )
+{
+    return lag2s( m, n, A, lda, SA, ldsa );
+}
+
+inline int64_t to_low(
+    int64_t m, int64_t n,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<float>* SA, int64_t ldsa )
+{
+    return lag2c( m, n, A, lda, SA, ldsa );
+}
+
+//------------------------------------------------------------------------------
+/// Converts triangle uplo of n-by-n matrix A to low precision SA,
+/// as LAPACK's dlat2s and zlat2c do. The other triangle is not referenced.
+/// @return 0 on success, or 1 if an entry overflows the low precision.
+template <typename scalar_t>
+int64_t to_low(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    low_precision< scalar_t >* SA, int64_t ldsa )
+{
+    using low_t = low_precision< scalar_t >;
+    const double rmax = std::numeric_limits< float >::max();
+
+    for (int64_t j = 0; j < n; ++j) {
+        int64_t ibegin = (uplo == Uplo::Lower ? j : 0);
+        int64_t iend   = (uplo == Uplo::Lower ? n : j + 1);
+        for (int64_t i = ibegin; i < iend; ++i) {
+            scalar_t a = A[ i + j*lda ];
+            if (std::abs( std::real( a ) ) > rmax
+                || std::abs( std::imag( a ) ) > rmax)
+                return 1;
+            SA[ i + j*ldsa ] = low_t( a );
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Converts low precision matrix SA to A.
+inline void to_high(
+    int64_t m, int64_t n,
+    float const* SA, int64_t ldsa,
+    double* A, int64_t lda )
+{
+    lag2d( m, n, SA, ldsa, A, lda );
+}
+
+inline void to_high(
+    int64_t m, int64_t n,
+    std::complex<float> const* SA, int64_t ldsa,
+    std::complex<double>* A, int64_t lda )
+{
+    lag2z( m, n, SA, ldsa, A, lda );
+}
+
+//------------------------------------------------------------------------------
+/// Stopping test of LAPACK's dsgesv and dsposv: each column j of the
+/// residual R = B - A X satisfies
+///     max_i |R(i,j)| <= max_i |X(i,j)| * cte,
+/// where cte = ||A||_inf * eps * sqrt(n), and |z| = |Re(z)| + |Im(z)|.
+template <typename scalar_t>
+bool mixed_converged(
+    int64_t n, int64_t nrhs,
+    scalar_t const* X, int64_t ldx,
+    scalar_t const* R, int64_t ldr,
+    blas::real_type< scalar_t > cte )
+{
+    auto abs1 = []( scalar_t z ) {
+        return std::abs( std::real( z ) ) + std::abs( std::imag( z ) );
+    };
+    for (int64_t j = 0; j < nrhs; ++j) {
+        int64_t ix = blas::iamax( n, &X[ j*ldx ], 1 );
+        int64_t ir = blas::iamax( n, &R[ j*ldr ], 1 );
+        // negated test so NaN is not converged
+        if (! (abs1( R[ ir + j*ldr ] ) <= abs1( X[ ix + j*ldx ] ) * cte))
+            return false;
+    }
+    return true;
+}
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_MIXED_HH
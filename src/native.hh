@@ -0,0 +1,97 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_NATIVE_HH
+#define LAPACK_NATIVE_HH
+
+#include "lapack/util.hh"
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Native LU factorization, used by getrf when getrf_method() is
+/// Method::Native. Same arguments and return value as getrf,
+/// with block size nb >= 1.
+/// Defined in getrf_native.cc for float, double, std::complex<float>,
+/// std::complex<double>, and int64_t and lapack_int pivots.
+template <typename scalar_t, typename pivot_t>
+int64_t getrf_native(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    pivot_t* ipiv, int64_t nb );
+
+//------------------------------------------------------------------------------
+/// Native tiled Cholesky routines, used by potrf, potrs, potri, and posv
+/// when potrf_method() is Method::Native. Same arguments and return
+/// values as those routines. Defined in potrf_native.cc for float,
+/// double, std::complex<float>, and std::complex<double>.
+template <typename scalar_t>
+int64_t potrf_native(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda );
+
+template <typename scalar_t>
+int64_t potrs_native(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb );
+
+template <typename scalar_t>
+int64_t potri_native(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda );
+
+template <typename scalar_t>
+int64_t posv_native(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb );
+
+//------------------------------------------------------------------------------
+/// @return tile size of the native Cholesky routines for order n.
+int64_t potrf_tile_size( int64_t n );
+
+//------------------------------------------------------------------------------
+/// Native TSQR, used by geqr when geqr_method() is Method::Native and
+/// m >= n, and by gemqr when T was produced by it.
+/// Same arguments and return values as geqr and gemqr.
+/// Defined in geqr_tsqr.cc for float, double, std::complex<float>,
+/// and std::complex<double>.
+template <typename scalar_t>
+int64_t geqr_tsqr(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t tsize );
+
+template <typename scalar_t>
+int64_t gemqr_tsqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T, int64_t tsize,
+    scalar_t* C, int64_t ldc );
+
+/// @return true if T, of size tsize, was produced by geqr_tsqr.
+template <typename scalar_t>
+bool is_tsqr( scalar_t const* T, int64_t tsize );
+
+//------------------------------------------------------------------------------
+/// Native two-stage Hermitian eigensolver, used by heev_2stage and
+/// heevd_2stage (and syev_2stage, syevd_2stage) when
+/// heev_2stage_method() is Method::Native. Same arguments and return
+/// value as those routines; the tridiagonal eigenproblem is solved with
+/// stedc if dc is true, otherwise with steqr (sterf for eigenvalues only).
+/// Defined in heev_2stage_native.cc for float, double,
+/// std::complex<float>, and std::complex<double>.
+template <typename scalar_t>
+int64_t heev_2stage_native(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* W, bool dc );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_NATIVE_HH
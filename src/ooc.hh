@@ -0,0 +1,54 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_OOC_INTERNAL_HH
+#define LAPACK_OOC_INTERNAL_HH
+
+#include "lapack/util.hh"
+
+#include <string>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Memory map of a file, unmapped on destruction. POSIX only;
+/// elsewhere, the constructor throws Error.
+class MappedFile
+{
+public:
+    /// Maps the first size bytes of the file at path.
+    /// If writable, the file is opened read-write and extended to size
+    /// bytes if shorter; otherwise, throws Error if it is shorter.
+    MappedFile( std::string const& path, size_t size, bool writable );
+
+    ~MappedFile();
+
+    // not copyable
+    MappedFile( MappedFile const& ) = delete;
+    MappedFile& operator = ( MappedFile const& ) = delete;
+
+    char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    /// Hints that bytes [begin, end) will be read sequentially.
+    void advise_sequential( size_t begin, size_t end );
+
+    /// Hints that bytes [begin, end) are not needed again soon, so their
+    /// pages can be dropped from memory (after writing back, if dirty).
+    /// Whole pages overlapping the range are dropped; since the mapping is
+    /// shared, this never loses data.
+    void release( size_t begin, size_t end );
+
+private:
+    char* data_;
+    size_t size_;
+    bool writable_;
+};
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_OOC_INTERNAL_HH
@@ -0,0 +1,267 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/ooc.hh"
+#include "ooc.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace lapack {
+namespace internal {
+
+#ifndef _WIN32
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// @return "path: strerror( errno )", for Error messages.
+std::string errno_msg( std::string const& path )
+{
+    return path + ": " + std::strerror( errno );
+}
+
+//------------------------------------------------------------------------------
+/// Rounds [begin, end) outward to whole pages of the mapping at data,
+/// which is page aligned, clipped to size bytes.
+/// @return false if the range is empty.
+bool page_range( char* data, size_t size, size_t& begin, size_t& end )
+{
+    if (data == nullptr || begin >= end)
+        return false;
+    size_t page = sysconf( _SC_PAGESIZE );
+    begin = (begin / page) * page;
+    end   = std::min( ((end + page - 1) / page) * page, size );
+    return begin < end;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+MappedFile::MappedFile( std::string const& path, size_t size, bool writable ):
+    data_( nullptr ),
+    size_( size ),
+    writable_( writable )
+{
+    int fd = open( path.c_str(), writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644 );
+    if (fd < 0)
+        throw Error( errno_msg( path ) );
+
+    struct stat st;
+    if (fstat( fd, &st ) != 0) {
+        std::string msg = errno_msg( path );
+        close( fd );
+        throw Error( msg );
+    }
+    if (size_t( st.st_size ) < size) {
+        if (! writable) {
+            close( fd );
+            throw Error( path + ": file is smaller than the matrix" );
+        }
+        if (ftruncate( fd, size ) != 0) {
+            std::string msg = errno_msg( path );
+            close( fd );
+            throw Error( msg );
+        }
+    }
+
+    if (size > 0) {
+        int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* ptr = mmap( nullptr, size, prot, MAP_SHARED, fd, 0 );
+        if (ptr == MAP_FAILED) {
+            std::string msg = errno_msg( path );
+            close( fd );
+            throw Error( msg );
+        }
+        data_ = static_cast< char* >( ptr );
+    }
+    // The mapping stays valid after closing the descriptor.
+    close( fd );
+}
+
+//------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    if (data_)
+        munmap( data_, size_ );
+}
+
+//------------------------------------------------------------------------------
+void MappedFile::advise_sequential( size_t begin, size_t end )
+{
+    #ifdef MADV_SEQUENTIAL
+        if (page_range( data_, size_, begin, end ))
+            madvise( data_ + begin, end - begin, MADV_SEQUENTIAL );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void MappedFile::release( size_t begin, size_t end )
+{
+    if (! page_range( data_, size_, begin, end ))
+        return;
+    if (writable_)
+        msync( data_ + begin, end - begin, MS_ASYNC );
+    #ifdef MADV_DONTNEED
+        // For a shared file mapping, this drops only the page table entries;
+        // the data stay in the file (and page cache), so pages partly
+        // outside [begin, end) are simply faulted in again when next used.
+        madvise( data_ + begin, end - begin, MADV_DONTNEED );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// OocStorage on a memory-mapped file.
+class MmapStorage: public OocStorage
+{
+public:
+    MmapStorage( std::string const& path, int64_t size ):
+        file_( path, size, true )
+    {}
+
+    void read( int64_t offset, int64_t size, void* buffer ) override
+    {
+        lapack_error_if( offset < 0 || size < 0
+                         || size_t( offset + size ) > file_.size() );
+        std::memcpy( buffer, file_.data() + offset, size );
+        file_.release( offset, offset + size );
+    }
+
+    void write( int64_t offset, int64_t size, void const* buffer ) override
+    {
+        lapack_error_if( offset < 0 || size < 0
+                         || size_t( offset + size ) > file_.size() );
+        std::memcpy( file_.data() + offset, buffer, size );
+        file_.release( offset, offset + size );
+    }
+
+private:
+    MappedFile file_;
+};
+
+//------------------------------------------------------------------------------
+/// OocStorage on a file, using pread and pwrite.
+class PreadStorage: public OocStorage
+{
+public:
+    PreadStorage( std::string const& path, int64_t size ):
+        path_( path ),
+        size_( size )
+    {
+        fd_ = open( path.c_str(), O_RDWR | O_CREAT, 0644 );
+        if (fd_ < 0)
+            throw Error( errno_msg( path ) );
+
+        struct stat st;
+        if (fstat( fd_, &st ) != 0
+            || (st.st_size < size && ftruncate( fd_, size ) != 0)) {
+            std::string msg = errno_msg( path );
+            close( fd_ );
+            throw Error( msg );
+        }
+    }
+
+    ~PreadStorage()
+    {
+        close( fd_ );
+    }
+
+    void read( int64_t offset, int64_t size, void* buffer ) override
+    {
+        lapack_error_if( offset < 0 || size < 0 || offset + size > size_ );
+        char* buf = static_cast< char* >( buffer );
+        while (size > 0) {
+            ssize_t got = pread( fd_, buf, size, offset );
+            if (got < 0 && errno == EINTR)
+                continue;
+            if (got < 0)
+                throw Error( errno_msg( path_ ) );
+            if (got == 0)
+                throw Error( path_ + ": unexpected end of file" );
+            buf    += got;
+            offset += got;
+            size   -= got;
+        }
+    }
+
+    void write( int64_t offset, int64_t size, void const* buffer ) override
+    {
+        lapack_error_if( offset < 0 || size < 0 || offset + size > size_ );
+        char const* buf = static_cast< char const* >( buffer );
+        while (size > 0) {
+            ssize_t put = pwrite( fd_, buf, size, offset );
+            if (put < 0 && errno == EINTR)
+                continue;
+            if (put < 0)
+                throw Error( errno_msg( path_ ) );
+            buf    += put;
+            offset += put;
+            size   -= put;
+        }
+    }
+
+private:
+    std::string path_;
+    int64_t size_;
+    int fd_;
+};
+
+#else  // _WIN32
+
+//------------------------------------------------------------------------------
+MappedFile::MappedFile( std::string const& path, size_t size, bool writable ):
+    data_( nullptr ),
+    size_( size ),
+    writable_( writable )
+{
+    throw Error( path + ": memory-mapped files are not supported on Windows" );
+}
+
+MappedFile::~MappedFile()
+{}
+
+void MappedFile::advise_sequential( size_t begin, size_t end )
+{}
+
+void MappedFile::release( size_t begin, size_t end )
+{}
+
+#endif  // _WIN32
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+std::shared_ptr< OocStorage > mmap_storage(
+    std::string const& path, int64_t size )
+{
+    lapack_error_if( size < 0 );
+    #ifndef _WIN32
+        return std::make_shared< internal::MmapStorage >( path, size );
+    #else
+        throw Error( path + ": mmap_storage is not supported on Windows" );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+std::shared_ptr< OocStorage > pread_storage(
+    std::string const& path, int64_t size )
+{
+    lapack_error_if( size < 0 );
+    #ifndef _WIN32
+        return std::make_shared< internal::PreadStorage >( path, size );
+    #else
+        throw Error( path + ": pread_storage is not supported on Windows" );
+    #endif
+}
+
+}  // namespace lapack
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +23,9 @@ int64_t orgqr(
     float* A, int64_t lda,
     float const* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "orgqr", 's', m, n, k,
+                             Gflop< float >::orgqr( m, n, k ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -70,6 +74,9 @@ int64_t orgqr(
     double* A, int64_t lda,
     double const* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "orgqr", 'd', m, n, k,
+                             Gflop< double >::orgqr( m, n, k ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -23,6 +24,9 @@ int64_t ormlq(
     float const* tau,
     float* C, int64_t ldc )
 {
+    LAPACK_INSTRUMENT_SCOPE( "ormlq", 's', m, n, k,
+                             Gflop< float >::ormlq( side, m, n, k ) );
+
     // for real, map ConjTrans to Trans
     if (trans == Op::ConjTrans)
         trans = Op::Trans;
@@ -84,6 +88,9 @@ int64_t ormlq(
     double const* tau,
     double* C, int64_t ldc )
 {
+    LAPACK_INSTRUMENT_SCOPE( "ormlq", 'd', m, n, k,
+                             Gflop< double >::ormlq( side, m, n, k ) );
+
     // for real, map ConjTrans to Trans
     if (trans == Op::ConjTrans)
         trans = Op::Trans;
@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -22,6 +25,42 @@ int64_t ormqr(
     float const* A, int64_t lda,
     float const* tau,
     float* C, int64_t ldc )
+{
+    size_t work_size;
+    ormqr_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @see lapack::unmqr
+/// @ingroup geqrf
+int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc )
+{
+    size_t work_size;
+    ormqr_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geqrf
+void ormqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    size_t* host_work_size )
 {
     // for real, map ConjTrans to Trans
     if (trans == Op::ConjTrans)
@@ -44,6 +83,11 @@ int64_t ormqr(
     lapack_int ldc_ = (lapack_int) ldc;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "sormqr", { side_, trans_, m_, n_, k_, lda_, ldc_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     float qry_work[1];
     lapack_int ineg_one = -1;
@@ -59,31 +103,77 @@ int64_t ormqr(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    *host_work_size = internal::workspace_bytes< float >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
 
-    LAPACK_sormqr(
+// -----------------------------------------------------------------------------
+/// @see lapack::unmqr_work_size_bytes
+/// @ingroup geqrf
+void ormqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    size_t* host_work_size )
+{
+    // for real, map ConjTrans to Trans
+    if (trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "dormqr", { side_, trans_, m_, n_, k_, lda_, ldc_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dormqr(
         &side_, &trans_, &m_, &n_, &k_,
         A, &lda_,
         tau,
         C, &ldc_,
-        &work[0], &lwork_, &info_
+        qry_work, &ineg_one, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
-    return info_;
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< double >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
 }
 
 // -----------------------------------------------------------------------------
-/// @see lapack::unmqr
 /// @ingroup geqrf
 int64_t ormqr(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
-    double const* A, int64_t lda,
-    double const* tau,
-    double* C, int64_t ldc )
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    void* host_work, size_t host_work_size )
 {
+    LAPACK_INSTRUMENT_SCOPE( "ormqr", 's', m, n, k,
+                             Gflop< float >::ormqr( side, m, n, k ) );
+
     // for real, map ConjTrans to Trans
     if (trans == Op::ConjTrans)
         trans = Op::Trans;
@@ -105,30 +195,69 @@ int64_t ormqr(
     lapack_int ldc_ = (lapack_int) ldc;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    double qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dormqr(
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_sormqr(
         &side_, &trans_, &m_, &n_, &k_,
         A, &lda_,
         tau,
         C, &ldc_,
-        qry_work, &ineg_one, &info_
+        work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    return info_;
+}
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// @see lapack::unmqr
+/// @ingroup geqrf
+int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "ormqr", 'd', m, n, k,
+                             Gflop< double >::ormqr( side, m, n, k ) );
+
+    // for real, map ConjTrans to Trans
+    if (trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
 
     LAPACK_dormqr(
         &side_, &trans_, &m_, &n_, &k_,
         A, &lda_,
         tau,
         C, &ldc_,
-        &work[0], &lwork_, &info_
+        work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
@@ -5,6 +5,8 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
+#include "native.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +24,13 @@ int64_t posv(
     float* A, int64_t lda,
     float* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "posv", 's', n, n, nrhs,
+                             Gflop< float >::posv( n, nrhs ) );
+
+    if (potrf_method() == Method::Native) {
+        return internal::posv_native( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -54,6 +63,13 @@ int64_t posv(
     double* A, int64_t lda,
     double* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "posv", 'd', n, n, nrhs,
+                             Gflop< double >::posv( n, nrhs ) );
+
+    if (potrf_method() == Method::Native) {
+        return internal::posv_native( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -86,6 +102,13 @@ int64_t posv(
     std::complex<float>* A, int64_t lda,
     std::complex<float>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "posv", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::posv( n, nrhs ) );
+
+    if (potrf_method() == Method::Native) {
+        return internal::posv_native( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -124,6 +147,9 @@ int64_t posv(
 /// matrix. The factored form of A is then used to solve the system of
 /// equations $A X = B$.
 ///
+/// potrf_set_method selects whether it calls the vendor LAPACK (default)
+/// or LAPACK++'s native, multithreaded tiled Cholesky.
+///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
 ///
@@ -177,6 +203,13 @@ int64_t posv(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "posv", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::posv( n, nrhs ) );
+
+    if (potrf_method() == Method::Native) {
+        return internal::posv_native( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -210,6 +243,9 @@ int64_t posv(
     double* X, int64_t ldx,
     int64_t* iter )
 {
+    LAPACK_INSTRUMENT_SCOPE( "posv", 'd', n, n, nrhs,
+                             Gflop< double >::posv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -254,6 +290,9 @@ int64_t posv(
     std::complex<double>* X, int64_t ldx,
     int64_t* iter )
 {
+    LAPACK_INSTRUMENT_SCOPE( "posv", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::posv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
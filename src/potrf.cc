@@ -5,6 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
+#include "fixed.hh"
+#include "native.hh"
 
 #include <vector>
 
@@ -20,6 +23,19 @@ int64_t potrf(
     lapack::Uplo uplo, int64_t n,
     float* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potrf", 's', n, n, 0,
+                             Gflop< float >::potrf( n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && lda >= n
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        return internal::fixed_potrf( uplo, n, A, lda );
+    }
+
+    if (potrf_method() == Method::Native) {
+        return internal::potrf_native( uplo, n, A, lda );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -46,6 +62,19 @@ int64_t potrf(
     lapack::Uplo uplo, int64_t n,
     double* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potrf", 'd', n, n, 0,
+                             Gflop< double >::potrf( n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && lda >= n
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        return internal::fixed_potrf( uplo, n, A, lda );
+    }
+
+    if (potrf_method() == Method::Native) {
+        return internal::potrf_native( uplo, n, A, lda );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -72,6 +101,19 @@ int64_t potrf(
     lapack::Uplo uplo, int64_t n,
     std::complex<float>* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potrf", 'c', n, n, 0,
+                             Gflop< std::complex<float> >::potrf( n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && lda >= n
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        return internal::fixed_potrf( uplo, n, A, lda );
+    }
+
+    if (potrf_method() == Method::Native) {
+        return internal::potrf_native( uplo, n, A, lda );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -104,6 +146,9 @@ int64_t potrf(
 ///
 /// This is the block version of the algorithm, calling Level 3 BLAS.
 ///
+/// potrf_set_method selects whether it calls the vendor LAPACK (default)
+/// or LAPACK++'s native, multithreaded tiled Cholesky.
+///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
 ///
@@ -143,6 +188,19 @@ int64_t potrf(
     lapack::Uplo uplo, int64_t n,
     std::complex<double>* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potrf", 'z', n, n, 0,
+                             Gflop< std::complex<double> >::potrf( n ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && lda >= n
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        return internal::fixed_potrf( uplo, n, A, lda );
+    }
+
+    if (potrf_method() == Method::Native) {
+        return internal::potrf_native( uplo, n, A, lda );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -0,0 +1,141 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "batch.hh"
+
+namespace lapack {
+
+using blas::max;
+
+//------------------------------------------------------------------------------
+/// Computes Cholesky factorizations of a batch of Hermitian positive
+/// definite matrices, $A_i = U_i^H U_i$ or $A_i = L_i L_i^H$.
+/// See `lapack::potrf`.
+/// Matrices are factored in parallel; see lapack/batch.hh.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of each A is stored;
+///     - lapack::Uplo::Lower: Lower triangle of each A is stored.
+///
+/// @param[in] n
+///     The order of each matrix A. n >= 0.
+///
+/// @param[in,out] Aarray
+///     Array of batch_count pointers to n-by-n matrices A, each stored in
+///     an lda-by-n array. On exit, the Cholesky factors.
+///
+/// @param[in] lda
+///     The leading dimension of each A. lda >= max(1,n).
+///
+/// @param[out] info
+///     Array of length batch_count. info[ i ] is the `lapack::potrf` return
+///     value for the i-th matrix: 0 on success; > 0 if the leading minor of
+///     order info[ i ] is not positive definite.
+///
+/// @param[in] batch_count
+///     The number of matrices. batch_count >= 0.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrf_batch(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( batch_count < 0 );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int ) {
+        info[ i ] = potrf( uplo, n, Aarray[ i ], lda );
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Computes Cholesky factorizations of a batch of Hermitian positive
+/// definite matrices stored with a fixed stride.
+/// Otherwise the same as `lapack::potrf_batch`.
+///
+/// @param[in,out] A
+///     The i-th matrix A is stored at A + i*strideA.
+///
+/// @param[in] strideA
+///     Stride between matrices in A. strideA >= lda*n.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrf_strided_batch(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t strideA,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( strideA < lda*n );
+    lapack_error_if( batch_count < 0 );
+
+    internal::batch_for( batch_count, [&]( int64_t i, int ) {
+        info[ i ] = potrf( uplo, n, &A[ i*strideA ], lda );
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrf_batch<float>(
+    lapack::Uplo uplo, int64_t n,
+    float* const* Aarray, int64_t lda,
+    int64_t* info, int64_t batch_count );
+
+template
+void potrf_batch<double>(
+    lapack::Uplo uplo, int64_t n,
+    double* const* Aarray, int64_t lda,
+    int64_t* info, int64_t batch_count );
+
+template
+void potrf_batch< std::complex<float> >(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* const* Aarray, int64_t lda,
+    int64_t* info, int64_t batch_count );
+
+template
+void potrf_batch< std::complex<double> >(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* const* Aarray, int64_t lda,
+    int64_t* info, int64_t batch_count );
+
+template
+void potrf_strided_batch<float>(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, int64_t strideA,
+    int64_t* info, int64_t batch_count );
+
+template
+void potrf_strided_batch<double>(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, int64_t strideA,
+    int64_t* info, int64_t batch_count );
+
+template
+void potrf_strided_batch< std::complex<float> >(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda, int64_t strideA,
+    int64_t* info, int64_t batch_count );
+
+template
+void potrf_strided_batch< std::complex<double> >(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda, int64_t strideA,
+    int64_t* info, int64_t batch_count );
+
+}  // namespace lapack
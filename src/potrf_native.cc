@@ -0,0 +1,679 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "batch.hh"
+#include "native.hh"
+
+#include <atomic>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace {
+
+std::atomic< char >    g_potrf_method( char( Method::Vendor ) );
+std::atomic< int64_t > g_potrf_nb( 0 );
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+void potrf_set_method( Method method )
+{
+    g_potrf_method.store( char( method ), std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+Method potrf_method()
+{
+    return Method( g_potrf_method.load( std::memory_order_relaxed ) );
+}
+
+//------------------------------------------------------------------------------
+void potrf_set_block_size( int64_t nb )
+{
+    lapack_error_if( nb < 0 );
+    g_potrf_nb.store( nb, std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+int64_t potrf_block_size()
+{
+    return g_potrf_nb.load( std::memory_order_relaxed );
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return tile size for the native Cholesky routines of order n:
+/// potrf_block_size() if set, otherwise n divided into about
+/// 2 sqrt( threads ) tile columns (at least 4), so the trailing updates
+/// have several tasks per thread, rounded up to a multiple of 32
+/// and limited to [ 128, 512 ] to keep BLAS calls efficient.
+int64_t potrf_tile_size( int64_t n )
+{
+    int64_t nb = potrf_block_size();
+    if (nb > 0)
+        return nb;
+
+    int nthreads = 1;
+    #ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+    #endif
+    int64_t nt = max( 4, 2 * int64_t( std::ceil( std::sqrt( nthreads ) ) ) );
+    nb = (n + nt - 1) / nt;
+    nb = (nb + 31) / 32 * 32;
+    return min( max( nb, 128 ), 512 );
+}
+
+//------------------------------------------------------------------------------
+/// Tiles of a Hermitian n-by-n matrix A, stored in the uplo triangle,
+/// addressed as the lower triangle: tile( i, j ), i >= j, is block (i, j)
+/// of L if uplo = Lower, and block (j, i) = L(i, j)^H if uplo = Upper,
+/// with L = U^H. Each tile has a token to order OpenMP task dependencies.
+template <typename scalar_t>
+class HermitianTiles
+{
+public:
+    HermitianTiles( Uplo uplo, int64_t n, scalar_t* A, int64_t lda,
+                    int64_t nb ):
+        uplo_( uplo ), n_( n ), nb_( nb ), nt_( (n + nb - 1) / nb ),
+        A_( A ), lda_( lda ), deps_( nt_ * nt_ )
+    {}
+
+    Uplo uplo() const { return uplo_; }
+    int64_t nt() const { return nt_; }
+    int64_t lda() const { return lda_; }
+
+    /// @return order of tile row or column i.
+    int64_t size( int64_t i ) const { return min( nb_, n_ - i*nb_ ); }
+
+    /// @return pointer to tile( i, j ), i >= j.
+    scalar_t* operator () ( int64_t i, int64_t j )
+    {
+        if (uplo_ == Uplo::Lower)
+            return &A_[ i*nb_ + j*nb_*lda_ ];
+        else
+            return &A_[ j*nb_ + i*nb_*lda_ ];
+    }
+
+    /// @return dependency token of tile( i, j ), i >= j.
+    char* dep( int64_t i, int64_t j ) { return &deps_[ i + j*nt_ ]; }
+
+private:
+    Uplo uplo_;
+    int64_t n_, nb_, nt_;
+    scalar_t* A_;
+    int64_t lda_;
+    std::vector< char > deps_;
+};
+
+//------------------------------------------------------------------------------
+/// Tiles of an n-by-nrhs right hand side B, with the same row tiles as A.
+template <typename scalar_t>
+class RhsTiles
+{
+public:
+    RhsTiles( int64_t n, int64_t nrhs, scalar_t* B, int64_t ldb, int64_t nb ):
+        nrhs_( nrhs ), nb_( nb ),
+        mt_( (n + nb - 1) / nb ), ct_( (nrhs + nb - 1) / nb ),
+        B_( B ), ldb_( ldb ), deps_( mt_ * ct_ )
+    {}
+
+    int64_t ct() const { return ct_; }
+    int64_t ldb() const { return ldb_; }
+
+    /// @return number of columns in tile column c.
+    int64_t cols( int64_t c ) const { return min( nb_, nrhs_ - c*nb_ ); }
+
+    scalar_t* operator () ( int64_t i, int64_t c )
+        { return &B_[ i*nb_ + c*nb_*ldb_ ]; }
+
+    char* dep( int64_t i, int64_t c ) { return &deps_[ i + c*mt_ ]; }
+
+private:
+    int64_t nrhs_, nb_, mt_, ct_;
+    scalar_t* B_;
+    int64_t ldb_;
+    std::vector< char > deps_;
+};
+
+//------------------------------------------------------------------------------
+/// Limits the vendor BLAS to one thread per task while tasks may run
+/// concurrently, i.e., if OpenMP has more than one thread.
+class NativeThreads
+{
+public:
+    NativeThreads()
+    {
+        #ifdef _OPENMP
+            if (omp_get_max_threads() > 1)
+                single_thread_.emplace();
+        #endif
+    }
+
+private:
+    std::optional< VendorSingleThread > single_thread_;
+};
+
+//------------------------------------------------------------------------------
+/// Inserts tasks for the Cholesky factorization A = L L^H of tiles A.
+/// Right-looking: factor tile( k, k ), solve the tiles below it,
+/// and update the trailing matrix; tasks in column k + 1 have higher
+/// priority so the next panel is ready early.
+/// On failure in tile( k, k ), sets info to its global index and
+/// failed_col to k; tasks writing tile columns >= failed_col are skipped.
+template <typename scalar_t>
+void potrf_tasks(
+    HermitianTiles< scalar_t >& A,
+    std::atomic< int64_t >& info, std::atomic< int64_t >& failed_col,
+    int64_t nb )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t one = 1.0;
+    const Uplo uplo = A.uplo();
+    const int64_t lda = A.lda();
+    const int64_t nt = A.nt();
+
+    for (int64_t k = 0; k < nt; ++k) {
+        int64_t kb = A.size( k );
+        char* dkk = A.dep( k, k );
+
+        #pragma omp task depend( inout: dkk[ 0 ] ) priority( 2 ) \
+            firstprivate( k, kb ) shared( A, info, failed_col )
+        {
+            if (k < failed_col.load()) {
+                int64_t iinfo = lapack::potrf2( uplo, kb, A( k, k ), lda );
+                if (iinfo > 0) {
+                    info.store( k*nb + iinfo );
+                    failed_col.store( k );
+                }
+            }
+        }
+
+        // L(m, k) = L(m, k) L(k, k)^{-H}
+        for (int64_t m = k + 1; m < nt; ++m) {
+            int64_t mb = A.size( m );
+            char* dmk = A.dep( m, k );
+            #pragma omp task depend( in: dkk[ 0 ] ) depend( inout: dmk[ 0 ] ) \
+                priority( 1 ) firstprivate( k, m, kb, mb ) \
+                shared( A, failed_col )
+            {
+                if (k < failed_col.load()) {
+                    if (uplo == Uplo::Lower) {
+                        blas::trsm( Layout::ColMajor, Side::Right, Uplo::Lower,
+                                    Op::ConjTrans, Diag::NonUnit, mb, kb,
+                                    one, A( k, k ), lda, A( m, k ), lda );
+                    }
+                    else {
+                        blas::trsm( Layout::ColMajor, Side::Left, Uplo::Upper,
+                                    Op::ConjTrans, Diag::NonUnit, kb, mb,
+                                    one, A( k, k ), lda, A( m, k ), lda );
+                    }
+                }
+            }
+        }
+
+        // L(m, j) -= L(m, k) L(j, k)^H, for k < j <= m
+        for (int64_t m = k + 1; m < nt; ++m) {
+            int64_t mb = A.size( m );
+            char* dmk = A.dep( m, k );
+            char* dmm = A.dep( m, m );
+            #pragma omp task depend( in: dmk[ 0 ] ) depend( inout: dmm[ 0 ] ) \
+                priority( m == k + 1 ? 1 : 0 ) firstprivate( k, m, kb, mb ) \
+                shared( A, failed_col )
+            {
+                if (m < failed_col.load()) {
+                    Op op = (uplo == Uplo::Lower ? Op::NoTrans : Op::ConjTrans);
+                    blas::herk( Layout::ColMajor, uplo, op, mb, kb,
+                                real_t( -1.0 ), A( m, k ), lda,
+                                real_t(  1.0 ), A( m, m ), lda );
+                }
+            }
+
+            for (int64_t j = k + 1; j < m; ++j) {
+                int64_t jb = A.size( j );
+                char* djk = A.dep( j, k );
+                char* dmj = A.dep( m, j );
+                #pragma omp task depend( in: dmk[ 0 ], djk[ 0 ] ) \
+                    depend( inout: dmj[ 0 ] ) \
+                    priority( j == k + 1 ? 1 : 0 ) \
+                    firstprivate( k, m, j, kb, mb, jb ) shared( A, failed_col )
+                {
+                    if (j < failed_col.load()) {
+                        if (uplo == Uplo::Lower) {
+                            blas::gemm( Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                                        mb, jb, kb,
+                                        -one, A( m, k ), lda, A( j, k ), lda,
+                                        one,  A( m, j ), lda );
+                        }
+                        else {
+                            blas::gemm( Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                                        jb, mb, kb,
+                                        -one, A( j, k ), lda, A( m, k ), lda,
+                                        one,  A( m, j ), lda );
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Inserts tasks to solve A X = B with the Cholesky factor in tiles A,
+/// overwriting B with X: forward substitution with L, then backward
+/// substitution with L^H. Tasks are skipped if info != 0, i.e., if a
+/// preceding potrf_tasks failed.
+template <typename scalar_t>
+void potrs_tasks(
+    HermitianTiles< scalar_t >& A, RhsTiles< scalar_t >& B,
+    std::atomic< int64_t >& info )
+{
+    const scalar_t one = 1.0;
+    const Uplo uplo = A.uplo();
+    const int64_t lda = A.lda();
+    const int64_t ldb = B.ldb();
+    const int64_t nt = A.nt();
+    const int64_t ct = B.ct();
+
+    // B(k) = op( L(k, k) )^{-1} B(k); with L = U^H if uplo = Upper.
+    auto solve = [&A, &B, &info, uplo, lda, ldb, one](
+        Op op, int64_t k, int64_t c )
+    {
+        if (info.load() != 0)
+            return;
+        Op op_stored = op;
+        if (uplo == Uplo::Upper)
+            op_stored = (op == Op::NoTrans ? Op::ConjTrans : Op::NoTrans);
+        blas::trsm( Layout::ColMajor, Side::Left, uplo, op_stored,
+                    Diag::NonUnit, A.size( k ), B.cols( c ),
+                    one, A( k, k ), lda, B( k, c ), ldb );
+    };
+
+    // B(m) -= op( L(i, j) ) B(k), where tile( i, j ) is in lower view.
+    auto update = [&A, &B, &info, uplo, lda, ldb, one](
+        Op op, int64_t i, int64_t j, int64_t m, int64_t k, int64_t c )
+    {
+        if (info.load() != 0)
+            return;
+        Op op_stored = op;
+        if (uplo == Uplo::Upper)
+            op_stored = (op == Op::NoTrans ? Op::ConjTrans : Op::NoTrans);
+        blas::gemm( Layout::ColMajor, op_stored, Op::NoTrans,
+                    A.size( m ), B.cols( c ), A.size( k ),
+                    -one, A( i, j ), lda, B( k, c ), ldb,
+                    one,  B( m, c ), ldb );
+    };
+
+    // Solve L Y = B.
+    for (int64_t k = 0; k < nt; ++k) {
+        char* dkk = A.dep( k, k );
+        for (int64_t c = 0; c < ct; ++c) {
+            char* bkc = B.dep( k, c );
+            #pragma omp task depend( in: dkk[ 0 ] ) depend( inout: bkc[ 0 ] ) \
+                priority( 1 ) firstprivate( k, c )
+            solve( Op::NoTrans, k, c );
+        }
+        for (int64_t m = k + 1; m < nt; ++m) {
+            char* dmk = A.dep( m, k );
+            for (int64_t c = 0; c < ct; ++c) {
+                char* bkc = B.dep( k, c );
+                char* bmc = B.dep( m, c );
+                #pragma omp task depend( in: dmk[ 0 ], bkc[ 0 ] ) \
+                    depend( inout: bmc[ 0 ] ) firstprivate( k, m, c )
+                update( Op::NoTrans, m, k, m, k, c );
+            }
+        }
+    }
+
+    // Solve L^H X = Y.
+    for (int64_t k = nt - 1; k >= 0; --k) {
+        char* dkk = A.dep( k, k );
+        for (int64_t c = 0; c < ct; ++c) {
+            char* bkc = B.dep( k, c );
+            #pragma omp task depend( in: dkk[ 0 ] ) depend( inout: bkc[ 0 ] ) \
+                priority( 1 ) firstprivate( k, c )
+            solve( Op::ConjTrans, k, c );
+        }
+        for (int64_t m = 0; m < k; ++m) {
+            char* dkm = A.dep( k, m );
+            for (int64_t c = 0; c < ct; ++c) {
+                char* bkc = B.dep( k, c );
+                char* bmc = B.dep( m, c );
+                #pragma omp task depend( in: dkm[ 0 ], bkc[ 0 ] ) \
+                    depend( inout: bmc[ 0 ] ) firstprivate( k, m, c )
+                update( Op::ConjTrans, k, m, m, k, c );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Inserts tasks to invert the triangular factor in tiles A,
+/// L = L^{-1}, one tile column at a time, as in PLASMA's pztrtri.
+template <typename scalar_t>
+void trtri_tasks( HermitianTiles< scalar_t >& A )
+{
+    const scalar_t one = 1.0;
+    const Uplo uplo = A.uplo();
+    const int64_t lda = A.lda();
+    const int64_t nt = A.nt();
+
+    for (int64_t k = 0; k < nt; ++k) {
+        int64_t kb = A.size( k );
+        char* dkk = A.dep( k, k );
+
+        // L(m, k) = -L(m, k) L(k, k)^{-1}
+        for (int64_t m = k + 1; m < nt; ++m) {
+            int64_t mb = A.size( m );
+            char* dmk = A.dep( m, k );
+            #pragma omp task depend( in: dkk[ 0 ] ) depend( inout: dmk[ 0 ] ) \
+                firstprivate( k, m, kb, mb ) shared( A )
+            {
+                if (uplo == Uplo::Lower) {
+                    blas::trsm( Layout::ColMajor, Side::Right, Uplo::Lower,
+                                Op::NoTrans, Diag::NonUnit, mb, kb,
+                                -one, A( k, k ), lda, A( m, k ), lda );
+                }
+                else {
+                    blas::trsm( Layout::ColMajor, Side::Left, Uplo::Upper,
+                                Op::NoTrans, Diag::NonUnit, kb, mb,
+                                -one, A( k, k ), lda, A( m, k ), lda );
+                }
+            }
+        }
+
+        // L(m, j) += L(m, k) L(k, j), for j < k < m
+        for (int64_t m = k + 1; m < nt; ++m) {
+            int64_t mb = A.size( m );
+            char* dmk = A.dep( m, k );
+            for (int64_t j = 0; j < k; ++j) {
+                int64_t jb = A.size( j );
+                char* dkj = A.dep( k, j );
+                char* dmj = A.dep( m, j );
+                #pragma omp task depend( in: dmk[ 0 ], dkj[ 0 ] ) \
+                    depend( inout: dmj[ 0 ] ) \
+                    firstprivate( k, m, j, kb, mb, jb ) shared( A )
+                {
+                    if (uplo == Uplo::Lower) {
+                        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                                    mb, jb, kb,
+                                    one, A( m, k ), lda, A( k, j ), lda,
+                                    one, A( m, j ), lda );
+                    }
+                    else {
+                        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                                    jb, mb, kb,
+                                    one, A( k, j ), lda, A( m, k ), lda,
+                                    one, A( m, j ), lda );
+                    }
+                }
+            }
+        }
+
+        // L(k, j) = L(k, k)^{-1} L(k, j), for j < k
+        for (int64_t j = 0; j < k; ++j) {
+            int64_t jb = A.size( j );
+            char* dkj = A.dep( k, j );
+            #pragma omp task depend( in: dkk[ 0 ] ) depend( inout: dkj[ 0 ] ) \
+                firstprivate( k, j, kb, jb ) shared( A )
+            {
+                if (uplo == Uplo::Lower) {
+                    blas::trsm( Layout::ColMajor, Side::Left, Uplo::Lower,
+                                Op::NoTrans, Diag::NonUnit, kb, jb,
+                                one, A( k, k ), lda, A( k, j ), lda );
+                }
+                else {
+                    blas::trsm( Layout::ColMajor, Side::Right, Uplo::Upper,
+                                Op::NoTrans, Diag::NonUnit, jb, kb,
+                                one, A( k, k ), lda, A( k, j ), lda );
+                }
+            }
+        }
+
+        #pragma omp task depend( inout: dkk[ 0 ] ) firstprivate( k, kb ) shared( A )
+        lapack::trtri( uplo, Diag::NonUnit, kb, A( k, k ), lda );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Inserts tasks to compute L^H L from the triangular tiles A,
+/// overwriting A, as in PLASMA's pzlauum.
+template <typename scalar_t>
+void lauum_tasks( HermitianTiles< scalar_t >& A )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t one = 1.0;
+    const Uplo uplo = A.uplo();
+    const int64_t lda = A.lda();
+    const int64_t nt = A.nt();
+
+    for (int64_t k = 0; k < nt; ++k) {
+        int64_t kb = A.size( k );
+        char* dkk = A.dep( k, k );
+
+        for (int64_t j = 0; j < k; ++j) {
+            int64_t jb = A.size( j );
+            char* dkj = A.dep( k, j );
+            char* djj = A.dep( j, j );
+
+            // L(j, j) += L(k, j)^H L(k, j)
+            #pragma omp task depend( in: dkj[ 0 ] ) depend( inout: djj[ 0 ] ) \
+                firstprivate( k, j, kb, jb ) shared( A )
+            {
+                Op op = (uplo == Uplo::Lower ? Op::ConjTrans : Op::NoTrans);
+                blas::herk( Layout::ColMajor, uplo, op, jb, kb,
+                            real_t( 1.0 ), A( k, j ), lda,
+                            real_t( 1.0 ), A( j, j ), lda );
+            }
+
+            // L(m, j) += L(k, m)^H L(k, j), for j < m < k
+            for (int64_t m = j + 1; m < k; ++m) {
+                int64_t mb = A.size( m );
+                char* dkm = A.dep( k, m );
+                char* dmj = A.dep( m, j );
+                #pragma omp task depend( in: dkm[ 0 ], dkj[ 0 ] ) \
+                    depend( inout: dmj[ 0 ] ) \
+                    firstprivate( k, m, j, kb, mb, jb ) shared( A )
+                {
+                    if (uplo == Uplo::Lower) {
+                        blas::gemm( Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                                    mb, jb, kb,
+                                    one, A( k, m ), lda, A( k, j ), lda,
+                                    one, A( m, j ), lda );
+                    }
+                    else {
+                        blas::gemm( Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                                    jb, mb, kb,
+                                    one, A( k, j ), lda, A( k, m ), lda,
+                                    one, A( m, j ), lda );
+                    }
+                }
+            }
+        }
+
+        // L(k, j) = L(k, k)^H L(k, j), for j < k
+        for (int64_t j = 0; j < k; ++j) {
+            int64_t jb = A.size( j );
+            char* dkj = A.dep( k, j );
+            #pragma omp task depend( in: dkk[ 0 ] ) depend( inout: dkj[ 0 ] ) \
+                firstprivate( k, j, kb, jb ) shared( A )
+            {
+                if (uplo == Uplo::Lower) {
+                    blas::trmm( Layout::ColMajor, Side::Left, Uplo::Lower,
+                                Op::ConjTrans, Diag::NonUnit, kb, jb,
+                                one, A( k, k ), lda, A( k, j ), lda );
+                }
+                else {
+                    blas::trmm( Layout::ColMajor, Side::Right, Uplo::Upper,
+                                Op::ConjTrans, Diag::NonUnit, jb, kb,
+                                one, A( k, k ), lda, A( k, j ), lda );
+                }
+            }
+        }
+
+        #pragma omp task depend( inout: dkk[ 0 ] ) firstprivate( k, kb ) shared( A )
+        lapack::lauum( uplo, kb, A( k, k ), lda );
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t potrf_native(
+    Uplo uplo, int64_t n, scalar_t* A, int64_t lda )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+
+    if (n == 0)
+        return 0;
+
+    int64_t nb = potrf_tile_size( n );
+    HermitianTiles< scalar_t > tiles( uplo, n, A, lda, nb );
+    std::atomic< int64_t > info( 0 );
+    std::atomic< int64_t > failed_col( tiles.nt() );
+
+    NativeThreads threads;
+    #pragma omp parallel
+    #pragma omp master
+    potrf_tasks( tiles, info, failed_col, nb );
+
+    return info.load();
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t potrs_native(
+    Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldb < max( 1, n ) );
+
+    if (n == 0 || nrhs == 0)
+        return 0;
+
+    // Tasks only read A.
+    int64_t nb = potrf_tile_size( n );
+    HermitianTiles< scalar_t > tiles(
+        uplo, n, const_cast< scalar_t* >( A ), lda, nb );
+    RhsTiles< scalar_t > rhs( n, nrhs, B, ldb, nb );
+    std::atomic< int64_t > info( 0 );
+
+    NativeThreads threads;
+    #pragma omp parallel
+    #pragma omp master
+    potrs_tasks( tiles, rhs, info );
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t potri_native(
+    Uplo uplo, int64_t n, scalar_t* A, int64_t lda )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+
+    // As in trtri, check for singularity before overwriting A.
+    const scalar_t zero = 0.0;
+    for (int64_t i = 0; i < n; ++i) {
+        if (A[ i + i*lda ] == zero)
+            return i + 1;
+    }
+    if (n == 0)
+        return 0;
+
+    int64_t nb = potrf_tile_size( n );
+    HermitianTiles< scalar_t > tiles( uplo, n, A, lda, nb );
+
+    NativeThreads threads;
+    #pragma omp parallel
+    #pragma omp master
+    {
+        trtri_tasks( tiles );
+        lauum_tasks( tiles );
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t posv_native(
+    Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldb < max( 1, n ) );
+
+    if (n == 0)
+        return 0;
+
+    int64_t nb = potrf_tile_size( n );
+    HermitianTiles< scalar_t > tiles( uplo, n, A, lda, nb );
+    RhsTiles< scalar_t > rhs( n, nrhs, B, ldb, nb );
+    std::atomic< int64_t > info( 0 );
+    std::atomic< int64_t > failed_col( tiles.nt() );
+
+    // Solve tasks start as soon as the tiles they read are factored.
+    NativeThreads threads;
+    #pragma omp parallel
+    #pragma omp master
+    {
+        potrf_tasks( tiles, info, failed_col, nb );
+        potrs_tasks( tiles, rhs, info );
+    }
+
+    return info.load();
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_POTRF_NATIVE_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t potrf_native< scalar_t >( \
+        Uplo uplo, int64_t n, scalar_t* A, int64_t lda ); \
+    \
+    template \
+    int64_t potrs_native< scalar_t >( \
+        Uplo uplo, int64_t n, int64_t nrhs, \
+        scalar_t const* A, int64_t lda, scalar_t* B, int64_t ldb ); \
+    \
+    template \
+    int64_t potri_native< scalar_t >( \
+        Uplo uplo, int64_t n, scalar_t* A, int64_t lda ); \
+    \
+    template \
+    int64_t posv_native< scalar_t >( \
+        Uplo uplo, int64_t n, int64_t nrhs, \
+        scalar_t* A, int64_t lda, scalar_t* B, int64_t ldb );
+
+LAPACK_POTRF_NATIVE_INSTANTIATE( float )
+LAPACK_POTRF_NATIVE_INSTANTIATE( double )
+LAPACK_POTRF_NATIVE_INSTANTIATE( std::complex<float> )
+LAPACK_POTRF_NATIVE_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_POTRF_NATIVE_INSTANTIATE
+
+}  // namespace internal
+}  // namespace lapack
@@ -0,0 +1,243 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/ooc.hh"
+#include "NoConstructAllocator.hh"
+
+#include <future>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Rows i0 : i0 + mb - 1 and columns j0 : j0 + nb - 1 of a column-major
+/// matrix in storage, with leading dimension lda.
+struct Block
+{
+    int64_t i0, j0, mb, nb;
+};
+
+//------------------------------------------------------------------------------
+/// Reads block blk of the matrix in storage A into the mb-by-nb array B
+/// (ldb = mb), one contiguous read per column, or one in all if possible.
+template <typename scalar_t>
+void read_block( OocStorage& A, int64_t lda, Block blk, scalar_t* B )
+{
+    const int64_t size = sizeof( scalar_t );
+    if (blk.mb == lda) {
+        A.read( (blk.i0 + blk.j0*lda) * size, blk.mb*blk.nb * size, B );
+    }
+    else {
+        for (int64_t j = 0; j < blk.nb; ++j)
+            A.read( (blk.i0 + (blk.j0 + j)*lda) * size, blk.mb * size,
+                    &B[ j*blk.mb ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Writes the mb-by-nb array B (ldb = mb) to block blk of storage A.
+template <typename scalar_t>
+void write_block( OocStorage& A, int64_t lda, Block blk, scalar_t const* B )
+{
+    const int64_t size = sizeof( scalar_t );
+    if (blk.mb == lda) {
+        A.write( (blk.i0 + blk.j0*lda) * size, blk.mb*blk.nb * size, B );
+    }
+    else {
+        for (int64_t j = 0; j < blk.nb; ++j)
+            A.write( (blk.i0 + (blk.j0 + j)*lda) * size, blk.mb * size,
+                     &B[ j*blk.mb ] );
+    }
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Panel k is block column k of L, rows k0 : n-1 (h-by-kb), for Lower,
+/// or block row k of U, columns k0 : n-1 (kb-by-h), for Upper.
+/// Panel buffers P[ 2 ] alternate: P[ c ] holds panel k while P[ 1-c ],
+/// holding panel k-1, is written back and applied to panel k.
+/// Stream buffers S[ 2 ] alternate between panels j and j+1 read back.
+template <typename scalar_t>
+int64_t potrf_ooc(
+    lapack::Uplo uplo, int64_t n,
+    OocStorage& A, int64_t lda,
+    int64_t nb )
+{
+    const scalar_t one = 1.0;
+    using real_t = blas::real_type< scalar_t >;
+
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( nb < 0 );
+
+    if (n == 0)
+        return 0;
+
+    if (nb == 0)
+        nb = 256;
+    nb = min( nb, n );
+    int64_t nt = (n + nb - 1) / nb;
+    bool lower = (uplo == Uplo::Lower);
+
+    // @return block of panel j, restricted to rows (Lower) or
+    // columns (Upper) k0 : n-1.
+    auto panel = [&]( int64_t j, int64_t k0 ) {
+        int64_t j0 = j*nb;
+        int64_t jb = min( nb, n - j0 );
+        return lower ? Block{ k0, j0, n - k0, jb }
+                     : Block{ j0, k0, jb, n - k0 };
+    };
+
+    // Buffers must outlive the futures below, whose destructors wait.
+    lapack::vector< scalar_t > buffer( 4 * n * nb );
+    scalar_t* P[ 2 ] = { &buffer[ 0 ],      &buffer[ n*nb ] };
+    scalar_t* S[ 2 ] = { &buffer[ 2*n*nb ], &buffer[ 3*n*nb ] };
+    std::future< void > writes[ 2 ], read_P, read_S;
+
+    // Subtracts the contribution of panel j (jb wide), in array Lj
+    // with leading dimension ldl, whose first row or column is k0,
+    // from panel k (kb wide, h long) in Pk.
+    auto update = [&]( scalar_t const* Lj, int64_t ldl, int64_t jb,
+                       scalar_t* Pk, int64_t kb, int64_t h )
+    {
+        if (lower) {
+            blas::herk( Layout::ColMajor, Uplo::Lower, Op::NoTrans, kb, jb,
+                        real_t( -1.0 ), Lj, ldl, real_t( 1.0 ), Pk, h );
+            if (h > kb) {
+                blas::gemm( Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                            h - kb, kb, jb,
+                            -one, &Lj[ kb ], ldl, Lj, ldl,
+                            one,  &Pk[ kb ], h );
+            }
+        }
+        else {
+            blas::herk( Layout::ColMajor, Uplo::Upper, Op::ConjTrans, kb, jb,
+                        real_t( -1.0 ), Lj, ldl, real_t( 1.0 ), Pk, kb );
+            if (h > kb) {
+                blas::gemm( Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                            kb, h - kb, jb,
+                            -one, Lj, ldl, &Lj[ kb*ldl ], ldl,
+                            one,  &Pk[ kb*kb ], kb );
+            }
+        }
+    };
+
+    int c = 0;
+    int64_t info = 0;
+    for (int64_t k = 0; k < nt; ++k) {
+        int64_t k0 = k*nb;
+        int64_t kb = min( nb, n - k0 );
+        int64_t h  = n - k0;
+        Block blk = panel( k, k0 );
+
+        // P[ c ] was last written back for panel k-2; wait for that,
+        // which also makes panels up to k-2 readable.
+        if (writes[ c ].valid())
+            writes[ c ].get();
+
+        read_P = std::async( std::launch::async, [&, blk, c]() {
+            read_block( A, lda, blk, P[ c ] );
+        });
+
+        // Apply panels 0 : k-2 from storage, reading ahead one panel.
+        int64_t nj = k - 1;
+        if (nj > 0) {
+            read_S = std::async( std::launch::async, [&, k0]() {
+                read_block( A, lda, panel( 0, k0 ), S[ 0 ] );
+            });
+        }
+        read_P.get();
+        for (int64_t j = 0; j < nj; ++j) {
+            read_S.get();
+            if (j + 1 < nj) {
+                read_S = std::async( std::launch::async, [&, j, k0]() {
+                    read_block( A, lda, panel( j + 1, k0 ), S[ (j + 1) % 2 ] );
+                });
+            }
+            // Lower: h-by-nb, ld = h; Upper: nb-by-h, ld = nb.
+            update( S[ j % 2 ], (lower ? h : nb), nb, P[ c ], kb, h );
+        }
+
+        // Apply panel k-1 from memory. Its first nb rows (Lower) or
+        // columns (Upper) are above or left of panel k; skip them.
+        if (k > 0) {
+            int64_t h_prev = h + nb;
+            if (lower)
+                update( &P[ 1-c ][ nb ], h_prev, nb, P[ c ], kb, h );
+            else
+                update( &P[ 1-c ][ nb*nb ], nb, nb, P[ c ], kb, h );
+        }
+
+        // Factor panel k.
+        if (lower) {
+            info = potrf( Uplo::Lower, kb, P[ c ], h );
+            if (info == 0 && h > kb) {
+                blas::trsm( Layout::ColMajor, Side::Right, Uplo::Lower,
+                            Op::ConjTrans, Diag::NonUnit, h - kb, kb,
+                            one, P[ c ], h, &P[ c ][ kb ], h );
+            }
+        }
+        else {
+            info = potrf( Uplo::Upper, kb, P[ c ], kb );
+            if (info == 0 && h > kb) {
+                blas::trsm( Layout::ColMajor, Side::Left, Uplo::Upper,
+                            Op::ConjTrans, Diag::NonUnit, kb, h - kb,
+                            one, P[ c ], kb, &P[ c ][ kb*kb ], kb );
+            }
+        }
+        if (info > 0) {
+            info += k0;
+            break;
+        }
+
+        // Write panel k back while the next panel proceeds.
+        writes[ c ] = std::async( std::launch::async, [&, blk, c]() {
+            write_block( A, lda, blk, P[ c ] );
+        });
+        c = 1 - c;
+    }
+
+    // Wait for writes, propagating any exception.
+    for (auto& w : writes) {
+        if (w.valid())
+            w.get();
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t potrf_ooc< float >(
+    lapack::Uplo uplo, int64_t n,
+    OocStorage& A, int64_t lda,
+    int64_t nb );
+
+template
+int64_t potrf_ooc< double >(
+    lapack::Uplo uplo, int64_t n,
+    OocStorage& A, int64_t lda,
+    int64_t nb );
+
+template
+int64_t potrf_ooc< std::complex<float> >(
+    lapack::Uplo uplo, int64_t n,
+    OocStorage& A, int64_t lda,
+    int64_t nb );
+
+template
+int64_t potrf_ooc< std::complex<double> >(
+    lapack::Uplo uplo, int64_t n,
+    OocStorage& A, int64_t lda,
+    int64_t nb );
+
+}  // namespace lapack
@@ -0,0 +1,129 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/update.hh"
+
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::conj;
+
+//------------------------------------------------------------------------------
+/// For Lower, the rotation zeroing x(j) against L(j,j) mixes column j of L
+/// with x. For Upper, row j of U = conj( column j of L ), so x is conjugated
+/// and the rotation applied with conj( s ), giving the same result.
+template <typename scalar_t>
+void potrf_update(
+    lapack::Uplo uplo, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t* X, int64_t ldx )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( k < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldx < max( 1, n ) );
+
+    real_t c;
+    scalar_t s, r;
+    for (int64_t l = 0; l < k; ++l) {
+        scalar_t* x = &X[ l*ldx ];
+        if (uplo == Uplo::Lower) {
+            for (int64_t j = 0; j < n; ++j) {
+                lapack::lartg( A[ j + j*lda ], x[ j ], &c, &s, &r );
+                A[ j + j*lda ] = r;
+                blas::rot( n-j-1, &A[ (j+1) + j*lda ], 1, &x[ j+1 ], 1, c, s );
+            }
+        }
+        else {
+            lapack::lacgv( n, x, 1 );
+            for (int64_t j = 0; j < n; ++j) {
+                lapack::lartg( A[ j + j*lda ], conj( x[ j ] ), &c, &s, &r );
+                A[ j + j*lda ] = r;
+                blas::rot( n-j-1, &A[ j + (j+1)*lda ], lda, &x[ j+1 ], 1,
+                           c, conj( s ) );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Row w, appended below U, starts at zero. Rotations i = n-1, ..., 0 in the
+/// planes (w, row i) reduce [p; rho] to e_{n+1}; applied to [U; w], they keep
+/// U upper triangular with positive diagonal, U(i,i) *= c_i, and leave
+/// w = x^H, so the new U^H U = U^H U - x x^H. For Lower, as in update,
+/// w is conjugated and the rotation applied with conj( s ).
+template <typename scalar_t>
+int64_t potrf_downdate(
+    lapack::Uplo uplo, int64_t n, int64_t k,
+    scalar_t* A, int64_t lda,
+    scalar_t* X, int64_t ldx )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( k < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldx < max( 1, n ) );
+
+    std::vector< scalar_t > w( n );
+    real_t c;
+    scalar_t s, r;
+    for (int64_t l = 0; l < k; ++l) {
+        // Solve L p = x, or U^H p = x, overwriting x with p.
+        scalar_t* p = &X[ l*ldx ];
+        blas::trsv( blas::Layout::ColMajor, uplo,
+                    (uplo == Uplo::Lower ? Op::NoTrans : Op::ConjTrans),
+                    Diag::NonUnit, n, A, lda, p, 1 );
+        real_t pnorm = blas::nrm2( n, p, 1 );
+        if (! (pnorm < 1))
+            return l + 1;  // also catches NaN
+        real_t rho = std::sqrt( (1 - pnorm) * (1 + pnorm) );
+
+        std::fill( w.begin(), w.end(), zero );
+        for (int64_t i = n-1; i >= 0; --i) {
+            lapack::lartg( scalar_t( rho ), p[ i ], &c, &s, &r );
+            rho = std::real( r );
+            if (uplo == Uplo::Upper) {
+                blas::rot( n-i, &w[ i ], 1, &A[ i + i*lda ], lda, c, s );
+            }
+            else {
+                blas::rot( n-i, &w[ i ], 1, &A[ i + i*lda ], 1, c, conj( s ) );
+            }
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_UPDATE_INSTANTIATE( scalar_t ) \
+    template \
+    void potrf_update< scalar_t >( \
+        lapack::Uplo uplo, int64_t n, int64_t k, \
+        scalar_t* A, int64_t lda, \
+        scalar_t* X, int64_t ldx ); \
+    \
+    template \
+    int64_t potrf_downdate< scalar_t >( \
+        lapack::Uplo uplo, int64_t n, int64_t k, \
+        scalar_t* A, int64_t lda, \
+        scalar_t* X, int64_t ldx );
+
+LAPACK_UPDATE_INSTANTIATE( float )
+LAPACK_UPDATE_INSTANTIATE( double )
+LAPACK_UPDATE_INSTANTIATE( std::complex<float> )
+LAPACK_UPDATE_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_UPDATE_INSTANTIATE
+
+}  // namespace lapack
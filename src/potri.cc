@@ -5,6 +5,8 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
+#include "native.hh"
 
 #include <vector>
 
@@ -20,6 +22,13 @@ int64_t potri(
     lapack::Uplo uplo, int64_t n,
     float* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potri", 's', n, n, 0,
+                             Gflop< float >::potri( n ) );
+
+    if (potrf_method() == Method::Native) {
+        return internal::potri_native( uplo, n, A, lda );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -46,6 +55,13 @@ int64_t potri(
     lapack::Uplo uplo, int64_t n,
     double* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potri", 'd', n, n, 0,
+                             Gflop< double >::potri( n ) );
+
+    if (potrf_method() == Method::Native) {
+        return internal::potri_native( uplo, n, A, lda );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -72,6 +88,13 @@ int64_t potri(
     lapack::Uplo uplo, int64_t n,
     std::complex<float>* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potri", 'c', n, n, 0,
+                             Gflop< std::complex<float> >::potri( n ) );
+
+    if (potrf_method() == Method::Native) {
+        return internal::potri_native( uplo, n, A, lda );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -97,6 +120,9 @@ int64_t potri(
 /// matrix A using the Cholesky factorization $A = U^H U$ or $A = L L^H$
 /// computed by `lapack::potrf`.
 ///
+/// potrf_set_method selects whether it calls the vendor LAPACK (default)
+/// or LAPACK++'s native, multithreaded tiled Cholesky.
+///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
 ///
@@ -127,6 +153,13 @@ int64_t potri(
     lapack::Uplo uplo, int64_t n,
     std::complex<double>* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potri", 'z', n, n, 0,
+                             Gflop< std::complex<double> >::potri( n ) );
+
+    if (potrf_method() == Method::Native) {
+        return internal::potri_native( uplo, n, A, lda );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
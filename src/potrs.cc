@@ -5,6 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
+#include "fixed.hh"
+#include "native.hh"
 
 #include <vector>
 
@@ -21,6 +24,19 @@ int64_t potrs(
     float const* A, int64_t lda,
     float* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potrs", 's', n, n, nrhs,
+                             Gflop< float >::potrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        return internal::fixed_potrs( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
+    if (potrf_method() == Method::Native) {
+        return internal::potrs_native( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -53,6 +69,19 @@ int64_t potrs(
     double const* A, int64_t lda,
     double* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potrs", 'd', n, n, nrhs,
+                             Gflop< double >::potrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        return internal::fixed_potrs( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
+    if (potrf_method() == Method::Native) {
+        return internal::potrs_native( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -85,6 +114,19 @@ int64_t potrs(
     std::complex<float> const* A, int64_t lda,
     std::complex<float>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potrs", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::potrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        return internal::fixed_potrs( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
+    if (potrf_method() == Method::Native) {
+        return internal::potrs_native( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -115,6 +157,9 @@ int64_t potrs(
 /// positive definite matrix A using the Cholesky factorization
 /// $A = U^H U$ or $A = L L^H$ computed by `lapack::potrf`.
 ///
+/// potrf_set_method selects whether it calls the vendor LAPACK (default)
+/// or LAPACK++'s native, multithreaded tiled Cholesky.
+///
 /// Overloaded versions are available for
 /// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
 ///
@@ -153,6 +198,19 @@ int64_t potrs(
     std::complex<double> const* A, int64_t lda,
     std::complex<double>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "potrs", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::potrs( n, nrhs ) );
+
+    // dispatch tiny matrices to fixed-size kernels
+    if (internal::use_fixed( n ) && nrhs >= 0 && lda >= n && ldb >= n
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        return internal::fixed_potrs( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
+    if (potrf_method() == Method::Native) {
+        return internal::potrs_native( uplo, n, nrhs, A, lda, B, ldb );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -0,0 +1,291 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/polar.hh"
+#include "qdwh.hh"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Completes the m-by-n matrix U, m >= n, the limit of QDWH, to have
+/// orthonormal columns. Exact zero singular values of A stay zero in the
+/// QDWH iteration, and tiny ones do not reach 1, so for rank-deficient A,
+/// U is only a partial isometry. With the eigendecomposition
+/// U^H U = Q diag( g ) Q^H, the columns of U Q are orthogonal with norms sqrt( g ):
+/// those with g > 1/2 are normalized, the others replaced by an
+/// orthonormal basis of random vectors orthogonal to them, and U = (U Q) Q^H.
+/// These directions belong to singular values of A below O(eps) ||A||,
+/// so A = U H still holds to that accuracy.
+template <typename scalar_t>
+static void qdwh_complete(
+    int64_t m, int64_t n,
+    scalar_t* U, int64_t ldu )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const real_t eps = std::numeric_limits< real_t >::epsilon();
+
+    // G = U^H U; done if || G - I ||_1 is small.
+    std::vector< scalar_t > G( n * n );
+    blas::herk( blas::Layout::ColMajor, Uplo::Upper, Op::ConjTrans, n, m,
+                real_t( 1 ), U, ldu, real_t( 0 ), &G[ 0 ], n );
+    for (int64_t i = 0; i < n; ++i)
+        G[ i + i*n ] -= one;
+    if (lapack::lanhe( Norm::One, Uplo::Upper, n, &G[ 0 ], n )
+        <= std::sqrt( eps ))
+        return;
+    for (int64_t i = 0; i < n; ++i)
+        G[ i + i*n ] += one;
+
+    // G = Q diag( g ) Q^H, g ascending; Y = U Q
+    std::vector< real_t > g( n );
+    lapack::heev( Job::Vec, Uplo::Upper, n, &G[ 0 ], n, &g[ 0 ] );
+    std::vector< scalar_t > Y( m * n ), C( n * n ), tau( n );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                m, n, n,
+                one,  U, ldu, &G[ 0 ], n,
+                zero, &Y[ 0 ], m );
+    int64_t r = 0;
+    while (r < n && g[ r ] <= real_t( 0.5 ))
+        ++r;
+    for (int64_t j = r; j < n; ++j)
+        blas::scal( m, one / std::sqrt( g[ j ] ), &Y[ j*m ], 1 );
+
+    if (r > 0) {
+        // Y1 = orth( random ), orthogonal to Y2 = Y( :, r:n-1 ), by two
+        // passes of block Gram-Schmidt.
+        int64_t iseed[ 4 ] = { 0, 0, 0, 1 };
+        lapack::larnv( 3, iseed, m * r, &Y[ 0 ] );
+        int64_t n2 = n - r;
+        if (n2 > 0) {
+            for (int pass = 0; pass < 2; ++pass) {
+                blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                            n2, r, m,
+                            one,  &Y[ r*m ], m, &Y[ 0 ], m,
+                            zero, &C[ 0 ], n2 );
+                blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                            m, r, n2,
+                            -one, &Y[ r*m ], m, &C[ 0 ], n2,
+                            one,  &Y[ 0 ], m );
+            }
+        }
+        lapack::geqrf( m, r, &Y[ 0 ], m, &tau[ 0 ] );
+        lapack::ungqr( m, r, r, &Y[ 0 ], m, &tau[ 0 ] );
+    }
+
+    // U = Y Q^H
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                m, n, n,
+                one,  &Y[ 0 ], m, &G[ 0 ], n,
+                zero, U, ldu );
+}
+
+//------------------------------------------------------------------------------
+/// QDWH, after Nakatsukasa, Bai, and Gygi, "Optimizing Halley's iteration
+/// for computing the matrix polar decomposition", SIAM J. Matrix Anal.
+/// Appl., 2010, with the QR and Cholesky forms of Nakatsukasa and Higham,
+/// SIAM J. Sci. Comput., 2013. X0 = A / alpha, alpha >= ||A||_2, and
+///     X_{k+1} = (b/c) X_k + (a - b/c) X_k (I + c X_k^H X_k)^{-1},
+/// with weights a, b, c from a lower bound l on sigma_min( X_k ), so all
+/// singular values of X_k map into [l, 1], and l -> 1 in at most 6
+/// iterations for cond( A ) <= 1e16. If A is rank deficient, the limit is
+/// completed to orthonormal columns by qdwh_complete.
+template <typename scalar_t>
+int64_t qdwh_iterate(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const real_t eps = std::numeric_limits< real_t >::epsilon();
+    const real_t tol_l = 5 * eps;
+    const real_t tol_x = std::cbrt( tol_l );
+    const int64_t max_iter = 20;
+
+    if (n == 0)
+        return 0;
+
+    // X0 = A / ||A||_F, so ||X0||_2 <= 1
+    real_t alpha = lapack::lange( Norm::Fro, m, n, A, lda );
+    if (alpha == 0) {
+        // polar factor of 0 is any U; take the first n columns of I
+        lapack::laset( MatrixType::General, m, n, zero, one, A, lda );
+        return 0;
+    }
+    lapack::lascl( MatrixType::General, 0, 0, alpha, 1, m, n, A, lda );
+
+    // l0 <= sigma_min( X0 ) = sigma_min( R ), from the 1-norm condition
+    // estimate of R in X0 = Q R: 1 / ||R^{-1}||_2 >= 1 / (sqrt(n) ||R^{-1}||_1).
+    std::vector< scalar_t > W( m * n ), tau( n );
+    lapack::lacpy( MatrixType::General, m, n, A, lda, &W[ 0 ], m );
+    lapack::geqrf( m, n, &W[ 0 ], m, &tau[ 0 ] );
+    real_t rcond;
+    lapack::trcon( Norm::One, Uplo::Upper, Diag::NonUnit, n,
+                   &W[ 0 ], m, &rcond );
+    real_t Rnorm = lapack::lantr( Norm::One, Uplo::Upper, Diag::NonUnit, n, n,
+                                  &W[ 0 ], m );
+    real_t l = max( real_t( 0.9 ) * rcond * Rnorm / std::sqrt( real_t( n ) ),
+                    eps );
+
+    // QR form workspace, (m + n)-by-n, and Cholesky form workspace, n-by-n
+    std::vector< scalar_t > S, Z( n * n );
+    int64_t lds = m + n;
+
+    real_t dx = 1;
+    int64_t iter = 0;
+    while (dx > tol_x || std::abs( 1 - l ) > tol_l) {
+        if (iter++ == max_iter)
+            return 1;
+
+        // dynamic weights
+        real_t l2 = l*l;
+        real_t d = std::cbrt( 4 * (1 - l2) / (l2 * l2) );
+        real_t sqd = std::sqrt( 1 + d );
+        real_t a = sqd + std::sqrt( 8 - 4*d + 8 * (2 - l2) / (l2 * sqd) ) / 2;
+        real_t b = (a - 1) * (a - 1) / 4;
+        real_t c = a + b - 1;
+        l = min( l * (a + b*l2) / (1 + c*l2), real_t( 1 ) );
+
+        // W = X_k, to measure the step
+        lapack::lacpy( MatrixType::General, m, n, A, lda, &W[ 0 ], m );
+
+        if (c > 100) {
+            // QR form: [ sqrt(c) X; I ] = [ Q1; Q2 ] R,
+            // X = (b/c) X + (a - b/c) / sqrt(c) Q1 Q2^H
+            S.resize( lds * n );
+            real_t sqc = std::sqrt( c );
+            for (int64_t j = 0; j < n; ++j) {
+                for (int64_t i = 0; i < m; ++i)
+                    S[ i + j*lds ] = sqc * A[ i + j*lda ];
+            }
+            lapack::laset( MatrixType::General, n, n, zero, one, &S[ m ], lds );
+            lapack::geqrf( lds, n, &S[ 0 ], lds, &tau[ 0 ] );
+            lapack::ungqr( lds, n, n, &S[ 0 ], lds, &tau[ 0 ] );
+            blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                        m, n, n,
+                        scalar_t( (a - b/c) / sqc ), &S[ 0 ], lds, &S[ m ], lds,
+                        scalar_t( b/c ), A, lda );
+        }
+        else {
+            // Cholesky form: Z = I + c X^H X = R^H R,
+            // X = (b/c) X + (a - b/c) X R^{-1} R^{-H}
+            lapack::laset( MatrixType::Upper, n, n, zero, one, &Z[ 0 ], n );
+            blas::herk( blas::Layout::ColMajor, Uplo::Upper, Op::ConjTrans,
+                        n, m,
+                        c, A, lda, real_t( 1 ), &Z[ 0 ], n );
+            lapack::potrf( Uplo::Upper, n, &Z[ 0 ], n );
+            blas::trsm( blas::Layout::ColMajor, Side::Right, Uplo::Upper,
+                        Op::NoTrans, Diag::NonUnit, m, n,
+                        one, &Z[ 0 ], n, &W[ 0 ], m );
+            blas::trsm( blas::Layout::ColMajor, Side::Right, Uplo::Upper,
+                        Op::ConjTrans, Diag::NonUnit, m, n,
+                        one, &Z[ 0 ], n, &W[ 0 ], m );
+            // W = X R^{-1} R^{-H}; A = (b/c) A + (a - b/c) W, then W = X_k
+            for (int64_t j = 0; j < n; ++j) {
+                for (int64_t i = 0; i < m; ++i) {
+                    scalar_t x = A[ i + j*lda ];
+                    A[ i + j*lda ] = real_t( b/c ) * x + real_t( a - b/c ) * W[ i + j*m ];
+                    W[ i + j*m ] = x;
+                }
+            }
+        }
+
+        // dx = ||X_{k+1} - X_k||_F, with X_{k+1} near unitary, ||X_{k+1}||_F ~ sqrt(n)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i)
+                W[ i + j*m ] -= A[ i + j*lda ];
+        }
+        dx = lapack::lange( Norm::Fro, m, n, &W[ 0 ], m );
+    }
+    qdwh_complete( m, n, A, lda );
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_QDWH_ITERATE_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t qdwh_iterate< scalar_t >( \
+        int64_t m, int64_t n, \
+        scalar_t* A, int64_t lda );
+
+LAPACK_QDWH_ITERATE_INSTANTIATE( float )
+LAPACK_QDWH_ITERATE_INSTANTIATE( double )
+LAPACK_QDWH_ITERATE_INSTANTIATE( std::complex<float> )
+LAPACK_QDWH_ITERATE_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_QDWH_ITERATE_INSTANTIATE
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t qdwh(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* H, int64_t ldh )
+{
+    using blas::conj;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // check arguments
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 || n > m );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldh < max( 1, n ) );
+
+    if (n == 0)
+        return 0;
+
+    std::vector< scalar_t > A0( m * n );
+    lapack::lacpy( MatrixType::General, m, n, A, lda, &A0[ 0 ], m );
+
+    int64_t info = internal::qdwh_iterate( m, n, A, lda );
+
+    // H = U^H A, made exactly Hermitian
+    blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                n, n, m,
+                one,  A, lda, &A0[ 0 ], m,
+                zero, H, ldh );
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i <= j; ++i) {
+            scalar_t h = (H[ i + j*ldh ] + conj( H[ j + i*ldh ] )) / scalar_t( 2 );
+            H[ i + j*ldh ] = h;
+            H[ j + i*ldh ] = conj( h );
+        }
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_QDWH_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t qdwh< scalar_t >( \
+        int64_t m, int64_t n, \
+        scalar_t* A, int64_t lda, \
+        scalar_t* H, int64_t ldh );
+
+LAPACK_QDWH_INSTANTIATE( float )
+LAPACK_QDWH_INSTANTIATE( double )
+LAPACK_QDWH_INSTANTIATE( std::complex<float> )
+LAPACK_QDWH_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_QDWH_INSTANTIATE
+
+}  // namespace lapack
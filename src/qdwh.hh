@@ -0,0 +1,27 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_QDWH_INTERNAL_HH
+#define LAPACK_QDWH_INTERNAL_HH
+
+#include "lapack/util.hh"
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Overwrites the m-by-n matrix A, m >= n, with its unitary polar factor U,
+/// A = U H, by QDWH iterations; see lapack::qdwh. U has orthonormal
+/// columns also if A is rank deficient.
+/// @return 0, or 1 if QDWH did not converge within its iteration limit.
+template <typename scalar_t>
+int64_t qdwh_iterate(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_QDWH_INTERNAL_HH
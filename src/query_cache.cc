@@ -0,0 +1,144 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "QueryCache.hh"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+struct QueryKeyHash
+{
+    size_t operator () ( QueryKey const& key ) const
+        { return key.hash(); }
+};
+
+//------------------------------------------------------------------------------
+/// Process-wide cache of workspace sizes, guarded by a mutex.
+/// The enabled flag and counters are atomic, so a disabled cache
+/// costs only an atomic load per query.
+class QueryCache
+{
+public:
+    QueryCache():
+        enabled_( false ),
+        hits_( 0 ),
+        misses_( 0 )
+    {}
+
+    bool lookup( QueryKey const& key, size_t* value )
+    {
+        if (! enabled_.load( std::memory_order_relaxed ))
+            return false;
+
+        {
+            std::lock_guard< std::mutex > guard( mutex_ );
+            auto iter = map_.find( key );
+            if (iter != map_.end()) {
+                *value = iter->second;
+                hits_ += 1;
+                return true;
+            }
+        }
+        misses_ += 1;
+        return false;
+    }
+
+    void insert( QueryKey const& key, size_t value )
+    {
+        if (! enabled_.load( std::memory_order_relaxed ))
+            return;
+
+        std::lock_guard< std::mutex > guard( mutex_ );
+        map_[ key ] = value;
+    }
+
+    void clear()
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        map_.clear();
+        hits_ = 0;
+        misses_ = 0;
+    }
+
+    int64_t size()
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        return map_.size();
+    }
+
+    std::atomic< bool > enabled_;
+    std::atomic< int64_t > hits_;
+    std::atomic< int64_t > misses_;
+
+private:
+    std::mutex mutex_;
+    std::unordered_map< QueryKey, size_t, QueryKeyHash > map_;
+};
+
+//------------------------------------------------------------------------------
+/// @return the process-wide cache, constructed on first use.
+static QueryCache& query_cache()
+{
+    static QueryCache s_cache;
+    return s_cache;
+}
+
+//------------------------------------------------------------------------------
+bool query_cache_lookup( QueryKey const& key, size_t* value )
+{
+    return query_cache().lookup( key, value );
+}
+
+//------------------------------------------------------------------------------
+void query_cache_insert( QueryKey const& key, size_t value )
+{
+    query_cache().insert( key, value );
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+void query_cache_enable( bool enable )
+{
+    internal::query_cache().enabled_ = enable;
+}
+
+//------------------------------------------------------------------------------
+bool query_cache_enabled()
+{
+    return internal::query_cache().enabled_;
+}
+
+//------------------------------------------------------------------------------
+void query_cache_clear()
+{
+    internal::query_cache().clear();
+}
+
+//------------------------------------------------------------------------------
+int64_t query_cache_hits()
+{
+    return internal::query_cache().hits_;
+}
+
+//------------------------------------------------------------------------------
+int64_t query_cache_misses()
+{
+    return internal::query_cache().misses_;
+}
+
+//------------------------------------------------------------------------------
+int64_t query_cache_size()
+{
+    return internal::query_cache().size();
+}
+
+}  // namespace lapack
@@ -0,0 +1,171 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "batch.hh"
+#include "sketch.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// In-place, unnormalized Walsh-Hadamard transform x = H x of a vector of
+/// length p, a power of 2.
+template <typename scalar_t>
+static void fwht( int64_t p, scalar_t* x )
+{
+    for (int64_t h = 1; h < p; h *= 2) {
+        for (int64_t j0 = 0; j0 < p; j0 += 2*h) {
+            for (int64_t j = j0; j < j0 + h; ++j) {
+                scalar_t a = x[ j ];
+                scalar_t b = x[ j + h ];
+                x[ j ]     = a + b;
+                x[ j + h ] = a - b;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// SRHT sketch along dimension q of A (n for Right, m for Left).
+/// Each vector of A along q (a row for Right, a column for Left) is
+/// copied, with signs, into a zero-padded buffer of length p, transformed,
+/// and l of its entries are selected into Y. Vectors are processed in
+/// blocks, in parallel, with one buffer per thread.
+template <typename scalar_t>
+static void sketch_srht(
+    lapack::Side side,
+    int64_t m, int64_t n, int64_t l,
+    scalar_t const* A, int64_t lda,
+    scalar_t* Y, int64_t ldy,
+    int64_t* iseed )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // q = length of the transformed vectors, nv = number of them
+    int64_t q  = (side == Side::Right ? n : m);
+    int64_t nv = (side == Side::Right ? m : n);
+    int64_t p = 1;
+    while (p < q)
+        p *= 2;
+
+    // random signs D, and random selection S of l of p entries by a
+    // partial Fisher-Yates shuffle
+    std::vector< real_t > sign( q ), r( l );
+    lapack::larnv( 2, iseed, q, &sign[ 0 ] );
+    for (auto& s : sign)
+        s = (s < 0 ? -1 : 1);
+    lapack::larnv( 1, iseed, l, &r[ 0 ] );
+    std::vector< int64_t > perm( p );
+    for (int64_t i = 0; i < p; ++i)
+        perm[ i ] = i;
+    for (int64_t c = 0; c < l; ++c) {
+        int64_t i = c + min( int64_t( r[ c ] * (p - c) ), p - c - 1 );
+        std::swap( perm[ c ], perm[ i ] );
+    }
+
+    // Buffers of about 256 KiB per thread.
+    int64_t vb = max( 1, min( nv, int64_t( (1 << 15) / p ) ) );
+    int64_t nblocks = (nv + vb - 1) / vb;
+    std::vector< std::vector< scalar_t > > buffer(
+        internal::batch_num_threads( nblocks ) );
+    real_t scale = 1 / std::sqrt( real_t( l ) );
+
+    internal::batch_for( nblocks, [&]( int64_t b, int thread ) {
+        int64_t v0 = b*vb;
+        int64_t nvb = min( vb, nv - v0 );
+        std::vector< scalar_t >& buf = buffer[ thread ];
+        buf.assign( p*nvb, scalar_t( 0 ) );
+        for (int64_t v = 0; v < nvb; ++v) {
+            // x = D (vector v0 + v of A)
+            scalar_t* x = &buf[ v*p ];
+            if (side == Side::Right) {
+                for (int64_t j = 0; j < q; ++j)
+                    x[ j ] = sign[ j ] * A[ (v0 + v) + j*lda ];
+            }
+            else {
+                scalar_t const* a = &A[ (v0 + v)*lda ];
+                for (int64_t i = 0; i < q; ++i)
+                    x[ i ] = sign[ i ] * a[ i ];
+            }
+            fwht( p, x );
+            if (side == Side::Right) {
+                for (int64_t c = 0; c < l; ++c)
+                    Y[ (v0 + v) + c*ldy ] = scale * x[ perm[ c ] ];
+            }
+            else {
+                scalar_t* y = &Y[ (v0 + v)*ldy ];
+                for (int64_t c = 0; c < l; ++c)
+                    y[ c ] = scale * x[ perm[ c ] ];
+            }
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void sketch(
+    lapack::Side side, lapack::Sketch sketch,
+    int64_t m, int64_t n, int64_t l,
+    scalar_t const* A, int64_t lda,
+    scalar_t* Y, int64_t ldy,
+    int64_t* iseed )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+
+    if (sketch == Sketch::SRHT) {
+        sketch_srht( side, m, n, l, A, lda, Y, ldy, iseed );
+        return;
+    }
+
+    // Gaussian
+    const scalar_t scale = 1 / std::sqrt( real_t( l ) );
+    const int64_t idist = 3;  // normal (0, 1)
+    if (side == Side::Right) {
+        std::vector< scalar_t > Omega( n * l );
+        lapack::larnv( idist, iseed, Omega.size(), &Omega[ 0 ] );
+        blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                    m, l, n,
+                    scale, A, lda, &Omega[ 0 ], n,
+                    zero,  Y, ldy );
+    }
+    else {
+        std::vector< scalar_t > Omega( l * m );
+        lapack::larnv( idist, iseed, Omega.size(), &Omega[ 0 ] );
+        blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                    l, n, m,
+                    scale, &Omega[ 0 ], l, A, lda,
+                    zero,  Y, ldy );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_SKETCH_INSTANTIATE( scalar_t ) \
+    template \
+    void sketch< scalar_t >( \
+        lapack::Side side, lapack::Sketch sketch, \
+        int64_t m, int64_t n, int64_t l, \
+        scalar_t const* A, int64_t lda, \
+        scalar_t* Y, int64_t ldy, \
+        int64_t* iseed );
+
+LAPACK_SKETCH_INSTANTIATE( float )
+LAPACK_SKETCH_INSTANTIATE( double )
+LAPACK_SKETCH_INSTANTIATE( std::complex<float> )
+LAPACK_SKETCH_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_SKETCH_INSTANTIATE
+
+}  // namespace internal
+}  // namespace lapack
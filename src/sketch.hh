@@ -0,0 +1,42 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_SKETCH_INTERNAL_HH
+#define LAPACK_SKETCH_INTERNAL_HH
+
+#include "lapack/util.hh"
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Computes a random sketch of the m-by-n matrix A:
+/// - side = Right: the m-by-l matrix Y = A Omega, Omega n-by-l;
+/// - side = Left:  the l-by-n matrix Y = Omega A, Omega l-by-m.
+///
+/// Omega is scaled by 1/sqrt(l), so Y has about the norm of A:
+/// - Sketch::Gaussian: entries are normal, from larnv (idist = 3);
+///   Y is one gemm.
+/// - Sketch::SRHT: subsampled randomized Hadamard transform,
+///   Omega = D H S / sqrt(l) (Right), with D random signs, H the
+///   Walsh-Hadamard matrix of order p, the power of 2 >= n (A is padded
+///   with zeros), and S a random selection of l of its p columns.
+///   Takes $O( m p \log p )$ operations, instead of $O( m n l )$,
+///   in parallel over blocks of rows (Right) or columns (Left) of A.
+///
+/// iseed is the larnv seed, updated on exit.
+/// Requires l <= n (Right) or l <= m (Left).
+template <typename scalar_t>
+void sketch(
+    lapack::Side side, lapack::Sketch sketch,
+    int64_t m, int64_t n, int64_t l,
+    scalar_t const* A, int64_t lda,
+    scalar_t* Y, int64_t ldy,
+    int64_t* iseed );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_SKETCH_INTERNAL_HH
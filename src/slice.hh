@@ -0,0 +1,33 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_SLICE_INTERNAL_HH
+#define LAPACK_SLICE_INTERNAL_HH
+
+#include "lapack/util.hh"
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// stevx_slice with eigenvectors Z of type scalar_t, which may be complex,
+/// as in the complex stein, for heevx_slice to back-transform in place.
+/// Arguments are as in lapack::stevx_slice.
+template <typename scalar_t>
+int64_t stevx_slice(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    blas::real_type< scalar_t > const* D,
+    blas::real_type< scalar_t > const* E,
+    blas::real_type< scalar_t > vl, blas::real_type< scalar_t > vu,
+    int64_t il, int64_t iu,
+    int64_t* nfound,
+    blas::real_type< scalar_t >* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_SLICE_INTERNAL_HH
@@ -0,0 +1,264 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/slice.hh"
+#include "batch.hh"
+#include "slice.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Slices end where the gap to the next eigenvalue exceeds stein's
+/// cluster tolerance ortol, once they have at least target eigenvalues,
+/// target = m / threads. Slices of 2*target eigenvalues without such a gap
+/// are split within a cluster, at the widest gap of their second half, if
+/// it exceeds septol = sqrt( eps ) ||T||_1, else at the next gap that does.
+/// Vectors after such a split are made orthogonal to the earlier part of
+/// their cluster by block classical Gram-Schmidt, twice, then to each
+/// other by QR. Inverse iteration gives each vector with components of
+/// size eps ||T|| / gap along its neighbors, so with gaps > septol this
+/// only removes errors, whereas across smaller gaps, the two slices could
+/// compute nearly the same vector.
+template <typename scalar_t>
+int64_t stevx_slice(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    blas::real_type< scalar_t > const* D,
+    blas::real_type< scalar_t > const* E,
+    blas::real_type< scalar_t > vl, blas::real_type< scalar_t > vu,
+    int64_t il, int64_t iu,
+    int64_t* nfound,
+    blas::real_type< scalar_t >* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+    const real_t inf = std::numeric_limits< real_t >::infinity();
+
+    // Minimum number of eigenvalues per slice, so tiny slices do not
+    // cost more in stein setup and reorthogonalization than they save.
+    const int64_t min_slice = 16;
+
+    // check arguments
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( range != Range::All && range != Range::Value
+                     && range != Range::Index );
+    lapack_error_if( n < 0 );
+    if (range == Range::Value) {
+        lapack_error_if( n > 0 && ! (vl < vu) );
+    }
+    else if (range == Range::Index) {
+        lapack_error_if( il < 1 || il > max( 1, n ) );
+        lapack_error_if( iu < min( n, il ) || iu > n );
+    }
+    lapack_error_if( ldz < 1 || (jobz == Job::Vec && ldz < n) );
+
+    *nfound = 0;
+    if (n == 0)
+        return 0;
+
+    // Eigenvalue indices il:iu. Sturm counts eigenvalues < u; counting
+    // below the next larger number counts eigenvalues <= u, for (vl, vu].
+    if (range == Range::All) {
+        il = 1;
+        iu = n;
+    }
+    else if (range == Range::Value) {
+        real_t u[ 2 ] = { std::nextafter( vl, inf ), std::nextafter( vu, inf ) };
+        int64_t count[ 2 ];
+        lapack::sturm( n, D, E, 2, u, count );
+        il = count[ 0 ] + 1;
+        iu = count[ 1 ];
+    }
+    int64_t m = iu - il + 1;
+    if (m <= 0)
+        return 0;
+
+    lapack::sturm_bisect( n, D, E, il, iu, W );
+    *nfound = m;
+    if (jobz == Job::NoVec)
+        return 0;
+
+    // ||T||_1 and cluster tolerance, as stein computes them
+    real_t onenrm = std::abs( D[ 0 ] );
+    for (int64_t i = 0; i < n; ++i) {
+        onenrm = max( onenrm, std::abs( D[ i ] )
+                              + (i > 0   ? std::abs( E[ i-1 ] ) : 0)
+                              + (i < n-1 ? std::abs( E[ i   ] ) : 0) );
+    }
+    real_t ortol = real_t( 1e-3 ) * onenrm;
+    real_t septol = std::sqrt( std::numeric_limits< real_t >::epsilon() ) * onenrm;
+
+    // ---------- divide eigenvalues 0:m-1 into slices
+    int nthreads = internal::batch_num_threads( m );
+    int64_t target = max( (m + nthreads - 1) / nthreads, min_slice );
+    std::vector< int64_t > start = { 0 };
+    std::vector< bool > split_cluster;
+    for (int64_t j = 1; j < m; ++j) {
+        int64_t size = j - start.back();
+        real_t gap = W[ j ] - W[ j-1 ];
+        if (size >= target && gap > ortol) {
+            start.push_back( j );
+            split_cluster.push_back( false );
+        }
+        else if (size == 2*target) {
+            int64_t jc = j;
+            for (int64_t k = start.back() + target; k < j; ++k) {
+                if (W[ k ] - W[ k-1 ] > W[ jc ] - W[ jc-1 ])
+                    jc = k;
+            }
+            if (W[ jc ] - W[ jc-1 ] > septol) {
+                start.push_back( jc );
+                split_cluster.push_back( true );
+            }
+        }
+        else if (size > 2*target && gap > septol) {
+            start.push_back( j );
+            split_cluster.push_back( true );
+        }
+    }
+    start.push_back( m );
+    int64_t nslice = start.size() - 1;
+
+    // ---------- eigenvectors of each slice by stein, in parallel.
+    // T is one block: iblock = 1, isplit = n.
+    std::vector< int64_t > iblock( n, 1 ), isplit( n, n );
+    std::vector< int64_t > info_slice( nslice );
+    internal::batch_for( nslice, [&]( int64_t s, int /* thread */ ) {
+        int64_t j0 = start[ s ];
+        info_slice[ s ] = lapack::stein(
+            n, D, E, start[ s+1 ] - j0, &W[ j0 ], &iblock[ 0 ], &isplit[ 0 ],
+            &Z[ j0*ldz ], ldz, &ifail[ j0 ] );
+    });
+
+    // ---------- reorthogonalize across clusters split between slices
+    for (int64_t s = 1; s < nslice; ++s) {
+        if (! split_cluster[ s-1 ])
+            continue;
+        // Z1 = Z( :, c0:j0-1 ), the cluster before the split, already
+        // orthonormal; Z2 = Z( :, j0:c1-1 ), the cluster after it.
+        int64_t j0 = start[ s ];
+        int64_t c0 = j0 - 1;
+        while (c0 > 0 && W[ c0 ] - W[ c0-1 ] <= ortol)
+            --c0;
+        int64_t c1 = j0 + 1;
+        while (c1 < start[ s+1 ] && W[ c1 ] - W[ c1-1 ] <= ortol)
+            ++c1;
+        int64_t k1 = j0 - c0;
+        int64_t k2 = c1 - j0;
+        scalar_t* Z1 = &Z[ c0*ldz ];
+        scalar_t* Z2 = &Z[ j0*ldz ];
+
+        std::vector< scalar_t > C( k1 * k2 );
+        for (int pass = 0; pass < 2; ++pass) {
+            blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                        k1, k2, n,
+                        one,  Z1, ldz, Z2, ldz,
+                        zero, &C[ 0 ], k1 );
+            blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                        n, k2, k1,
+                        -one, Z1, ldz, &C[ 0 ], k1,
+                        one,  Z2, ldz );
+        }
+
+        // Z2 = Q R; R is near diagonal, so Q times the phases of diag( R )
+        // stays close to Z2.
+        std::vector< scalar_t > tau( k2 ), phase( k2 );
+        lapack::geqrf( n, k2, Z2, ldz, &tau[ 0 ] );
+        for (int64_t j = 0; j < k2; ++j) {
+            scalar_t rjj = Z2[ j + j*ldz ];
+            phase[ j ] = (rjj == zero ? one : rjj / std::abs( rjj ));
+        }
+        lapack::ungqr( n, k2, k2, Z2, ldz, &tau[ 0 ] );
+        for (int64_t j = 0; j < k2; ++j)
+            blas::scal( n, phase[ j ], &Z2[ j*ldz ], 1 );
+    }
+
+    // ---------- gather failures, as 1-based indices into W
+    std::vector< int64_t > failed;
+    for (int64_t s = 0; s < nslice; ++s) {
+        for (int64_t k = 0; k < info_slice[ s ]; ++k)
+            failed.push_back( ifail[ start[ s ] + k ] + start[ s ] );
+    }
+    std::fill( ifail, ifail + m, 0 );
+    std::copy( failed.begin(), failed.end(), ifail );
+
+    return failed.size();
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_SLICE_INSTANTIATE( scalar_t ) \
+    template \
+    int64_t stevx_slice< scalar_t >( \
+        lapack::Job jobz, lapack::Range range, int64_t n, \
+        blas::real_type< scalar_t > const* D, \
+        blas::real_type< scalar_t > const* E, \
+        blas::real_type< scalar_t > vl, blas::real_type< scalar_t > vu, \
+        int64_t il, int64_t iu, \
+        int64_t* nfound, \
+        blas::real_type< scalar_t >* W, \
+        scalar_t* Z, int64_t ldz, \
+        int64_t* ifail );
+
+LAPACK_SLICE_INSTANTIATE( float )
+LAPACK_SLICE_INSTANTIATE( double )
+LAPACK_SLICE_INSTANTIATE( std::complex<float> )
+LAPACK_SLICE_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_SLICE_INSTANTIATE
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t stevx_slice(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    scalar_t const* D, scalar_t const* E,
+    scalar_t vl, scalar_t vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    scalar_t* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t* ifail )
+{
+    return internal::stevx_slice( jobz, range, n, D, E, vl, vu, il, iu,
+                                  nfound, W, Z, ldz, ifail );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t stevx_slice<float>(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    float const* D, float const* E,
+    float vl, float vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* ifail );
+
+template
+int64_t stevx_slice<double>(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    double const* D, double const* E,
+    double vl, double vu, int64_t il, int64_t iu,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* ifail );
+
+}  // namespace lapack
@@ -5,7 +5,9 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "sturm.hh"
 
+#include <algorithm>
 #include <vector>
 
 namespace lapack {
@@ -71,12 +73,23 @@ namespace lapack {
 // Pm1_0 is used like the classical Sturm sequence; meaning we must calculate
 // sign changes.
 //
-// s is computed given the vector X[] = M[i]*P[i-1] above.
-// PHI is set to 10^{10}, UPSILON is set to 10^{-10}. Then:
-//    w = max(fabs(X[0]), fabs(X[1])).
-//    if w > PHI then s = PHI/w;
-//    else if w < UPSILON then s = UPSILON/w;
-//    else s=1.0 (or, do not scale X).
+// s is computed given the vector P[i-1], before the multiply.
+// Zhang sets PHI to 10^{10} and scales by PHI/w or UPSILON/w; here
+// PHI = 2^(max_exponent/4), depending on the precision, see
+// internal::sturm_phi, UPSILON = 1/PHI, and the scaling factors are PHI and
+// UPSILON themselves, which are powers of 2, so scaling is exact. Then:
+//    w = max(fabs(P[i-1][0]), fabs(P[i-1][1])).
+//    if w > PHI then s = UPSILON;
+//    else if w < UPSILON then s = PHI;
+//    else s=1.0 (or, do not scale).
+// internal::sturm_lanes evaluates the same recurrence, so the multi-shift
+// sturm gives identical counts.
+//
+// Before starting, T and u are scaled by sigma, a power of 2, so T's
+// largest entry is in [1, 2), and u is clamped to [-8, 8], beyond the
+// Gershgorin bounds; see internal::sturm_scale. This is exact and does not
+// change the count, but keeps offd^2 and the growth per step in range
+// regardless of the scale of T, which the rescaling alone cannot.
 //
 // This algorithm is backward stable.
 // Execution time is 1.5 times classic Sturm.
@@ -101,17 +114,20 @@ int64_t sturm(
     int64_t n, scalar_t const* diag, scalar_t const* offd, scalar_t u )
 {
     int64_t i, isneg=0;
-    scalar_t s, w, v0, v1, Pm1_0, Pm1_1, phi, upsilon;
+    scalar_t s, w, v0, v1, Pm1_0, Pm1_1, phi, upsilon, sigma, e;
     if (n == 0)
         return 0;
 
-    // todo: adjust for float. Use constants like epsilon.
-    phi = scalar_t( int64_t( 1 ) << 34 );  // Roughly 1.718e+10.
+    // Scale T and u by a power of 2 so T's largest entry is in [1, 2).
+    sigma = internal::sturm_scale( n, diag, offd, 1 );
+    u = internal::sturm_shift( sigma, u );
+
+    phi = internal::sturm_phi< scalar_t >();
     const scalar_t one=1.0;
     upsilon = one/phi;
 
     Pm1_1 = one;
-    Pm1_0 = (diag[0]-u);
+    Pm1_0 = (sigma*diag[0]-u);
     // Our first test.
     if (Pm1_0 < 0)
         isneg = 1;
@@ -124,20 +140,19 @@ int64_t sturm(
 
         // Go ahead and calculate P[i]:
         s = Pm1_0;
-        Pm1_0 = (diag[i]-u)*Pm1_0 -((offd[i-1]*offd[i-1])*Pm1_1);
+        e = sigma*offd[i-1];
+        Pm1_0 = (sigma*diag[i]-u)*Pm1_0 -((e*e)*Pm1_1);
         Pm1_1 = s;
 
         // Now determine whether to scale these new values.
-        if (w > phi) {  // If the largest magnitude > big,
-            s = phi/w;  // compute scaling ratio,
-            Pm1_0 *= s; // apply it.
-            Pm1_1 *= s;
+        if (w > phi) {         // If the largest magnitude > big,
+            Pm1_0 *= upsilon;  // scale down by a power of 2.
+            Pm1_1 *= upsilon;
         }
         else {
             if (w < upsilon) {  // if largest magnitude < tiny,
-                s = upsilon/w;  // compute scaling ratio,
-                Pm1_0 *= s;     // apply it.
-                Pm1_1 *= s;
+                Pm1_0 *= phi;   // scale up by a power of 2.
+                Pm1_1 *= phi;
             }
         }
 
@@ -150,6 +165,66 @@ int64_t sturm(
     return isneg;
 }
 
+//------------------------------------------------------------------------------
+/// @ingroup heev_computational
+/// Multi-shift Sturm count: for each of nshift shifts u[ k ], computes the
+/// number of eigenvalues of the symmetric tridiagonal matrix strictly less
+/// than u[ k ], using the same scaled Sturm sequence as the single-shift
+/// sturm. The shifts are processed several at a time across SIMD lanes,
+/// so counting many shifts costs little more than counting one.
+///
+/// @param[in] n
+///     The order of the matrix. n >= 0.
+///
+/// @param[in] diag
+///     The vector diag of length n, the diagonal elements.
+///
+/// @param[in] offd
+///     The vector offd of length n-1, the off-diagonal elements.
+///
+/// @param[in] nshift
+///     The number of shifts. nshift >= 0.
+///
+/// @param[in] u
+///     The vector u of length nshift, the shifts, in any order.
+///
+/// @param[out] count
+///     The vector count of length nshift.
+///     count[ k ] is the number of eigenvalues strictly less than u[ k ].
+///
+template <typename scalar_t>
+void sturm(
+    int64_t n, scalar_t const* diag, scalar_t const* offd,
+    int64_t nshift, scalar_t const* u, int64_t* count )
+{
+    constexpr int W = internal::sturm_width;
+
+    lapack_error_if( n < 0 );
+    lapack_error_if( nshift < 0 );
+
+    if (n == 0) {
+        std::fill( count, count + nshift, 0 );
+        return;
+    }
+
+    scalar_t sigma = internal::sturm_scale( n, diag, offd, 1 );
+
+    int64_t k = 0;
+    for (; k + W <= nshift; k += W)
+        internal::sturm_lanes<W>( n, diag, offd, sigma, &u[ k ], &count[ k ] );
+
+    // remainder: pad the lanes with the last shift
+    if (k < nshift) {
+        scalar_t u_pad[ W ];
+        int64_t count_pad[ W ];
+        for (int l = 0; l < W; ++l)
+            u_pad[ l ] = u[ std::min( k + l, nshift - 1 ) ];
+        internal::sturm_lanes<W>( n, diag, offd, sigma, u_pad, count_pad );
+        for (int l = 0; k + l < nshift; ++l)
+            count[ k + l ] = count_pad[ l ];
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template
@@ -160,4 +235,14 @@ template
 int64_t sturm<double>(
     int64_t n, double const* diag, double const* offd, double u );
 
+template
+void sturm<float>(
+    int64_t n, float const* diag, float const* offd,
+    int64_t nshift, float const* u, int64_t* count );
+
+template
+void sturm<double>(
+    int64_t n, double const* diag, double const* offd,
+    int64_t nshift, double const* u, int64_t* count );
+
 } // namespace lapack
@@ -0,0 +1,179 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_STURM_INTERNAL_HH
+#define LAPACK_STURM_INTERNAL_HH
+
+#include "lapack/util.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Number of shifts that sturm_lanes evaluates together. Each step of the
+/// recurrence has a long dependency chain (multiply-add, abs, max, compare,
+/// select, multiply), so one vector of shifts is latency bound; 32 shifts,
+/// e.g., 8 AVX2 vectors of doubles, give enough independent chains to keep
+/// the FMA units busy. Measured about 4x faster per shift than 4-16 lanes.
+constexpr int sturm_width = 32;
+
+//------------------------------------------------------------------------------
+/// @return the rescaling threshold phi of the scaled Sturm sequence: values
+/// are rescaled when their magnitude leaves [1/phi, phi].
+/// phi = 2^(max_exponent / 4), i.e., 2^256 for double and 2^32 for float,
+/// which leaves 3/4 of the exponent range, in both directions, as margin
+/// for one step's growth before overflow or underflow. A fixed constant
+/// cannot balance these for both precisions. Rescaling is by phi or 1/phi,
+/// powers of 2, so it is exact.
+template <typename scalar_t>
+inline scalar_t sturm_phi()
+{
+    return std::ldexp( scalar_t( 1 ),
+                       std::numeric_limits< scalar_t >::max_exponent / 4 );
+}
+
+//------------------------------------------------------------------------------
+/// @return the prescaling sigma of the tridiagonal matrix T: the power of 2
+/// with 1 <= sigma max_i( |diag_i|, |offd_i| ) < 2, or 1 if T is zero.
+/// Element i of diag and offd is at index i*inc.
+///
+/// Sturm counts of sigma T at sigma u equal those of T at u, as scaling by
+/// a power of 2 is exact. Scaled, |offd_i|^2 cannot overflow or underflow
+/// merely because T is large or small, and each step of the recurrence
+/// grows the sequence by at most 14x, given shifts clamped to [-8, 8]
+/// (by Gershgorin, sigma T's eigenvalues are in (-6, 6), so clamping
+/// does not change counts). Then phi's margin always suffices.
+template <typename scalar_t>
+inline scalar_t sturm_scale(
+    int64_t n, scalar_t const* diag, scalar_t const* offd, int64_t inc )
+{
+    scalar_t amax = 0;
+    for (int64_t i = 0; i < n; ++i)
+        amax = std::max( amax, std::abs( diag[ i*inc ] ) );
+    for (int64_t i = 0; i < n-1; ++i)
+        amax = std::max( amax, std::abs( offd[ i*inc ] ) );
+    if (amax == 0 || ! std::isfinite( amax ))
+        return 1;
+    // For subnormal amax, limit sigma to 2^(-min_exponent+1), which is finite.
+    int e = std::max( std::ilogb( amax ),
+                      std::numeric_limits< scalar_t >::min_exponent - 1 );
+    return std::ldexp( scalar_t( 1 ), -e );
+}
+
+//------------------------------------------------------------------------------
+/// @return the shift u scaled by sigma from sturm_scale, clamped to [-8, 8].
+template <typename scalar_t>
+inline scalar_t sturm_shift( scalar_t sigma, scalar_t u )
+{
+    return std::min( std::max( sigma*u, scalar_t( -8 ) ), scalar_t( 8 ) );
+}
+
+//------------------------------------------------------------------------------
+/// Scaled Sturm count for W shifts at once, one shift per SIMD lane.
+/// Same recurrence and scaling as the single-shift sturm, written without
+/// branches so the compiler vectorizes the lane loops: each step is a
+/// select between the three scaling factors and an integer sign test.
+/// Counts are kept in an integer type as wide as scalar_t, so they share
+/// vector registers with the recurrence.
+/// T and u are scaled by sigma, from sturm_scale, on the fly.
+template <int W, typename scalar_t>
+inline void sturm_lanes(
+    int64_t n, scalar_t const* diag, scalar_t const* offd, scalar_t sigma,
+    scalar_t const* u, int64_t* count )
+{
+    using count_t = std::conditional_t< sizeof(scalar_t) == 4, int32_t, int64_t >;
+
+    const scalar_t phi = sturm_phi< scalar_t >();
+    const scalar_t upsilon = 1 / phi;
+
+    scalar_t p0[ W ], p1[ W ], ul[ W ];
+    count_t isneg[ W ];
+    for (int l = 0; l < W; ++l) {
+        ul[ l ] = sturm_shift( sigma, u[ l ] );
+        p1[ l ] = 1;
+        p0[ l ] = sigma*diag[ 0 ] - ul[ l ];
+        isneg[ l ] = (p0[ l ] < 0);
+    }
+    for (int64_t i = 1; i < n; ++i) {
+        scalar_t di = sigma*diag[ i ];
+        scalar_t ei = sigma*offd[ i-1 ];
+        scalar_t e2 = ei*ei;
+        // GCC's SLP vectorizer misses this loop after fully unrolling it;
+        // omp simd makes it vectorize the loop as written.
+        #ifdef _OPENMP
+        #pragma omp simd
+        #endif
+        for (int l = 0; l < W; ++l) {
+            scalar_t w = std::max( std::abs( p0[ l ] ), std::abs( p1[ l ] ) );
+            scalar_t t = (di - ul[ l ])*p0[ l ] - e2*p1[ l ];
+            scalar_t s = (w > phi     ? upsilon
+                       : (w < upsilon ? phi
+                       :  scalar_t( 1 )));
+            p1[ l ] = s*p0[ l ];
+            p0[ l ] = s*t;
+            isneg[ l ] += count_t( p0[ l ] < 0 ) ^ count_t( p1[ l ] < 0 );
+        }
+    }
+    for (int l = 0; l < W; ++l)
+        count[ l ] = isneg[ l ];
+}
+
+//------------------------------------------------------------------------------
+/// Scaled Sturm count for W matrices at once, one matrix per SIMD lane,
+/// each at its own shift u[ l ]. The matrices are interleaved
+/// (structure of arrays): element i of matrix l is diag[ l + i*ldd ] and
+/// offd[ l + i*ldd ], so each step loads one contiguous vector per array.
+/// Matrix l is scaled by its own sigma[ l ], from sturm_scale.
+/// Otherwise the same as sturm_lanes, with the same results per matrix.
+template <int W, typename scalar_t>
+inline void sturm_lanes_soa(
+    int64_t n, scalar_t const* diag, scalar_t const* offd, int64_t ldd,
+    scalar_t const* sigma, scalar_t const* u, int64_t* count )
+{
+    using count_t = std::conditional_t< sizeof(scalar_t) == 4, int32_t, int64_t >;
+
+    const scalar_t phi = sturm_phi< scalar_t >();
+    const scalar_t upsilon = 1 / phi;
+
+    scalar_t p0[ W ], p1[ W ], ul[ W ];
+    count_t isneg[ W ];
+    for (int l = 0; l < W; ++l) {
+        ul[ l ] = sturm_shift( sigma[ l ], u[ l ] );
+        p1[ l ] = 1;
+        p0[ l ] = sigma[ l ]*diag[ l ] - ul[ l ];
+        isneg[ l ] = (p0[ l ] < 0);
+    }
+    for (int64_t i = 1; i < n; ++i) {
+        scalar_t const* di = &diag[ i*ldd ];
+        scalar_t const* ei = &offd[ (i-1)*ldd ];
+        #ifdef _OPENMP
+        #pragma omp simd
+        #endif
+        for (int l = 0; l < W; ++l) {
+            scalar_t e = sigma[ l ]*ei[ l ];
+            scalar_t e2 = e*e;
+            scalar_t w = std::max( std::abs( p0[ l ] ), std::abs( p1[ l ] ) );
+            scalar_t t = (sigma[ l ]*di[ l ] - ul[ l ])*p0[ l ] - e2*p1[ l ];
+            scalar_t s = (w > phi     ? upsilon
+                       : (w < upsilon ? phi
+                       :  scalar_t( 1 )));
+            p1[ l ] = s*p0[ l ];
+            p0[ l ] = s*t;
+            isneg[ l ] += count_t( p0[ l ] < 0 ) ^ count_t( p1[ l ] < 0 );
+        }
+    }
+    for (int l = 0; l < W; ++l)
+        count[ l ] = isneg[ l ];
+}
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif  // LAPACK_STURM_INTERNAL_HH
@@ -0,0 +1,168 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "batch.hh"
+#include "sturm.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace lapack {
+
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Multi-matrix Sturm count: for each of batch_count symmetric tridiagonal
+/// n-by-n matrices $T_b$, and each of its nshift shifts $u_{bk}$, computes
+/// the number of eigenvalues of $T_b$ strictly less than $u_{bk}$, using
+/// the same scaled Sturm sequence as `lapack::sturm`, with the same results.
+/// Each matrix is first scaled by a power of 2, exactly, so counts are
+/// reliable for float and double matrices of any magnitude.
+///
+/// The matrices are interleaved (structure of arrays), so one SIMD vector
+/// holds the same element of consecutive matrices: 32 matrices are
+/// processed at once, one per lane, for each shift. Groups of 32 matrices
+/// and shifts are processed in parallel over OpenMP threads, if OpenMP is
+/// enabled. Intended for many small matrices, e.g., to slice the spectra
+/// of thousands of matrices; for one matrix at many shifts, the
+/// multi-shift `lapack::sturm` vectorizes across shifts instead.
+///
+/// @param[in] n
+///     The order of each matrix. n >= 0.
+///
+/// @param[in] diag
+///     The n-by-batch_count array diag, stored in an ldd-by-n array
+///     (column i holds element i of each matrix): diag[ b + i*ldd ] is
+///     diagonal element i of matrix b.
+///
+/// @param[in] offd
+///     The (n-1)-by-batch_count array offd, stored in an ldd-by-(n-1)
+///     array: offd[ b + i*ldd ] is off-diagonal element i of matrix b.
+///
+/// @param[in] ldd
+///     The leading dimension of diag and offd. ldd >= batch_count.
+///
+/// @param[in] nshift
+///     The number of shifts per matrix. nshift >= 0.
+///
+/// @param[in] u
+///     The shifts, in an ldu-by-nshift array: u[ b + k*ldu ] is shift k of
+///     matrix b. Shifts may be in any order. For shifts common to all
+///     matrices, replicate them.
+///
+/// @param[in] ldu
+///     The leading dimension of u. ldu >= batch_count.
+///
+/// @param[out] count
+///     The counts, in an ldc-by-nshift array: count[ b + k*ldc ] is the
+///     number of eigenvalues of matrix b strictly less than u[ b + k*ldu ].
+///
+/// @param[in] ldc
+///     The leading dimension of count. ldc >= batch_count.
+///
+/// @param[in] batch_count
+///     The number of matrices. batch_count >= 0.
+///
+/// @ingroup heev_computational
+template <typename scalar_t>
+void sturm_batch(
+    int64_t n,
+    scalar_t const* diag, scalar_t const* offd, int64_t ldd,
+    int64_t nshift,
+    scalar_t const* u, int64_t ldu,
+    int64_t* count, int64_t ldc,
+    int64_t batch_count )
+{
+    constexpr int W = internal::sturm_width;
+
+    lapack_error_if( n < 0 );
+    lapack_error_if( nshift < 0 );
+    lapack_error_if( batch_count < 0 );
+    lapack_error_if( ldd < batch_count );
+    lapack_error_if( ldu < batch_count );
+    lapack_error_if( ldc < batch_count );
+    if (batch_count == 0 || nshift == 0)
+        return;
+
+    if (n == 0) {
+        for (int64_t k = 0; k < nshift; ++k)
+            std::fill( &count[ k*ldc ], &count[ k*ldc + batch_count ], 0 );
+        return;
+    }
+
+    // The last group, if partial, is copied into W lanes, padded with its
+    // last matrix, so the kernel always runs full width.
+    int64_t ngroup = (batch_count + W - 1) / W;
+    int64_t nb_last = batch_count - (ngroup - 1)*W;
+    int64_t b_last = (ngroup - 1)*W;
+    std::vector< scalar_t > diag_pad, offd_pad;
+    if (nb_last < W) {
+        diag_pad.resize( W*n );
+        offd_pad.resize( W*(n - 1) );
+        for (int64_t i = 0; i < n; ++i) {
+            for (int l = 0; l < W; ++l) {
+                int64_t b = b_last + min( l, nb_last - 1 );
+                diag_pad[ l + i*W ] = diag[ b + i*ldd ];
+                if (i < n-1)
+                    offd_pad[ l + i*W ] = offd[ b + i*ldd ];
+            }
+        }
+    }
+
+    // Power-of-2 prescaling of each matrix, computed once for all shifts,
+    // padded like the matrices.
+    std::vector< scalar_t > sigma( ngroup*W );
+    internal::batch_for( batch_count, [&]( int64_t b, int /* thread */ ) {
+        sigma[ b ] = internal::sturm_scale( n, &diag[ b ], &offd[ b ], ldd );
+    });
+    std::fill( sigma.begin() + batch_count, sigma.end(), sigma[ batch_count-1 ] );
+
+    // Task t is group t / nshift at shift k = t % nshift, so even a few
+    // groups with many shifts use all threads.
+    internal::batch_for( ngroup * nshift, [&]( int64_t t, int thread ) {
+        int64_t g = t / nshift;
+        int64_t k = t % nshift;
+        int64_t b0 = g*W;
+        if (g < ngroup - 1 || nb_last == W) {
+            internal::sturm_lanes_soa<W>(
+                n, &diag[ b0 ], &offd[ b0 ], ldd, &sigma[ b0 ],
+                &u[ b0 + k*ldu ], &count[ b0 + k*ldc ] );
+        }
+        else {
+            scalar_t u_pad[ W ];
+            int64_t count_pad[ W ];
+            for (int l = 0; l < W; ++l)
+                u_pad[ l ] = u[ b0 + min( l, nb_last - 1 ) + k*ldu ];
+            internal::sturm_lanes_soa<W>(
+                n, &diag_pad[ 0 ], (n > 1 ? &offd_pad[ 0 ] : nullptr), W,
+                &sigma[ b0 ], u_pad, count_pad );
+            std::copy( count_pad, count_pad + nb_last, &count[ b0 + k*ldc ] );
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void sturm_batch<float>(
+    int64_t n,
+    float const* diag, float const* offd, int64_t ldd,
+    int64_t nshift,
+    float const* u, int64_t ldu,
+    int64_t* count, int64_t ldc,
+    int64_t batch_count );
+
+template
+void sturm_batch<double>(
+    int64_t n,
+    double const* diag, double const* offd, int64_t ldd,
+    int64_t nshift,
+    double const* u, int64_t ldu,
+    int64_t* count, int64_t ldc,
+    int64_t batch_count );
+
+}  // namespace lapack
@@ -0,0 +1,182 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "batch.hh"
+#include "sturm.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// @ingroup heev_computational
+/// Computes eigenvalues il through iu of a real symmetric tridiagonal
+/// matrix by bisection on the scaled Sturm count. Similar to LAPACK stebz
+/// with range = Index and order = Entire, but without splitting the
+/// matrix.
+///
+/// The eigenvalues are divided into groups, processed in parallel over
+/// OpenMP threads, if OpenMP is enabled, so selecting many eigenvalues
+/// scales with the number of cores. Within a group, each step evaluates
+/// the multi-shift Sturm count at 32 points at once, one per SIMD lane,
+/// and every count narrows every interval of the group. When a group has
+/// fewer than 32 eigenvalues, as when few are selected, their intervals
+/// are multisected, which takes fewer steps than bisection.
+///
+/// @param[in] n
+///     The order of the matrix T. n >= 0.
+///
+/// @param[in] diag
+///     The vector diag of length n, the diagonal elements of T.
+///
+/// @param[in] offd
+///     The vector offd of length n-1, the off-diagonal elements of T.
+///
+/// @param[in] il
+///     The index of the smallest eigenvalue to compute, 1-based.
+///     1 <= il <= max( 1, n ).
+///
+/// @param[in] iu
+///     The index of the largest eigenvalue to compute, 1-based.
+///     min( il, n ) <= iu <= n.
+///     If iu < il, no eigenvalues are computed.
+///
+/// @param[out] W
+///     The vector W of length iu - il + 1.
+///     W[ k ] is the (il + k)-th smallest eigenvalue of T, in ascending
+///     order. Each is accurate to about eps * ||T||, as in stebz with
+///     abstol = 0.
+///
+/// If diag or offd has an Inf or NaN, W is set to NaN.
+///
+/// @return = 0: successful exit.
+///
+template <typename scalar_t>
+int64_t sturm_bisect(
+    int64_t n, scalar_t const* diag, scalar_t const* offd,
+    int64_t il, int64_t iu, scalar_t* W )
+{
+    constexpr int L = internal::sturm_width;
+    const scalar_t eps = std::numeric_limits< scalar_t >::epsilon();
+
+    // check arguments
+    lapack_error_if( n < 0 );
+    lapack_error_if( il < 1 || il > std::max( int64_t( 1 ), n ) );
+    lapack_error_if( iu < std::min( n, il ) || iu > n );
+
+    int64_t m = iu - il + 1;
+    if (n == 0 || m <= 0)
+        return 0;
+
+    // Gershgorin interval [gl, gu] containing all eigenvalues
+    scalar_t gl = diag[ 0 ];
+    scalar_t gu = diag[ 0 ];
+    for (int64_t i = 0; i < n; ++i) {
+        scalar_t r = (i > 0   ? std::abs( offd[ i-1 ] ) : 0)
+                   + (i < n-1 ? std::abs( offd[ i   ] ) : 0);
+        gl = std::min( gl, diag[ i ] - r );
+        gu = std::max( gu, diag[ i ] + r );
+    }
+    scalar_t tnorm = std::max( std::abs( gl ), std::abs( gu ) );
+    if (! std::isfinite( tnorm )) {
+        std::fill( W, W + m, std::numeric_limits< scalar_t >::quiet_NaN() );
+        return 0;
+    }
+    if (tnorm == 0) {
+        std::fill( W, W + m, scalar_t( 0 ) );
+        return 0;
+    }
+    // widen as stebz does, so rounding cannot exclude an eigenvalue
+    scalar_t fudge = scalar_t( 2.1 ) * eps * tnorm * n;
+    gl -= fudge;
+    gu += fudge;
+
+    // Converged when hi - lo <= max( atol, rtol * max( |lo|, |hi| ) ).
+    scalar_t atol = eps * tnorm;
+    scalar_t rtol = 2 * eps;
+    // Width is relative to tnorm, so gu - gl cannot overflow; the bound
+    // keeps the conversion to int defined even if gu or gl did.
+    scalar_t steps = std::log2( (gu / tnorm - gl / tnorm) / eps );
+    steps = std::min( steps, scalar_t( 2 * std::numeric_limits< scalar_t >::digits ) );
+    int64_t max_iter = int64_t( steps ) + 2;
+    scalar_t sigma = internal::sturm_scale( n, diag, offd, 1 );
+
+    // Split the m eigenvalues into groups of up to L, at least one group
+    // per thread when m allows.
+    int nthreads = internal::batch_num_threads( m );
+    int64_t group_size = std::min( int64_t( L ), (m + nthreads - 1) / nthreads );
+    int64_t ngroups = (m + group_size - 1) / group_size;
+
+    internal::batch_for( ngroups, [&]( int64_t g, int /* thread */ ) {
+        // Group g finds the eigenvalues with 1-based indices j[ 0:nt-1 ],
+        // each in an interval [ lo, hi ). Lane l evaluates a point in the
+        // interval of eigenvalue a = l % nt; with nt < L, each interval
+        // gets several lanes and is multisected instead of bisected.
+        int64_t j0 = g*group_size;
+        int nt = int( std::min( group_size, m - j0 ) );
+        int64_t j[ L ];
+        scalar_t lo[ L ], hi[ L ], x[ L ];
+        int64_t count[ L ];
+        for (int a = 0; a < nt; ++a) {
+            j[ a ] = il + j0 + a;
+            lo[ a ] = gl;
+            hi[ a ] = gu;
+        }
+
+        for (int64_t iter = 0; iter < max_iter; ++iter) {
+            for (int l = 0; l < L; ++l) {
+                int a = l % nt;
+                int r = l / nt;                  // rank of lane l within a
+                int k = (L - 1 - a) / nt + 1;    // number of lanes for a
+                x[ l ] = lo[ a ] + (hi[ a ] - lo[ a ]) * (r + 1) / (k + 1);
+            }
+
+            internal::sturm_lanes< L >( n, diag, offd, sigma, x, count );
+
+            // count[ l ] eigenvalues are < x[ l ]: eigenvalue j is below
+            // x[ l ] if j <= count[ l ], else at or above it. Every lane's
+            // count narrows every interval containing its point.
+            bool converged = true;
+            for (int a = 0; a < nt; ++a) {
+                for (int l = 0; l < L; ++l) {
+                    if (x[ l ] > lo[ a ] && x[ l ] < hi[ a ]) {
+                        if (j[ a ] <= count[ l ])
+                            hi[ a ] = x[ l ];
+                        else
+                            lo[ a ] = x[ l ];
+                    }
+                }
+                scalar_t tol = std::max( atol, rtol * std::max( std::abs( lo[ a ] ),
+                                                                std::abs( hi[ a ] ) ) );
+                if (hi[ a ] - lo[ a ] > tol)
+                    converged = false;
+            }
+            if (converged)
+                break;
+        }
+
+        for (int a = 0; a < nt; ++a)
+            W[ j0 + a ] = (lo[ a ] + hi[ a ]) / 2;
+    });
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t sturm_bisect<float>(
+    int64_t n, float const* diag, float const* offd,
+    int64_t il, int64_t iu, float* W );
+
+template
+int64_t sturm_bisect<double>(
+    int64_t n, double const* diag, double const* offd,
+    int64_t il, int64_t iu, double* W );
+
+}  // namespace lapack
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +23,8 @@ int64_t syev(
     float* A, int64_t lda,
     float* W )
 {
+    LAPACK_INSTRUMENT_SCOPE( "syev", 's', n, n, 0, 0 );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -70,6 +73,8 @@ int64_t syev(
     double* A, int64_t lda,
     double* W )
 {
+    LAPACK_INSTRUMENT_SCOPE( "syev", 'd', n, n, 0, 0 );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -15,12 +18,56 @@ using blas::max;
 using blas::min;
 using blas::real;
 
+// -----------------------------------------------------------------------------
+// Size of iwork for syevd, from documentation.
+static int64_t syevd_liwork( lapack::Job jobz, int64_t n )
+{
+    if (n <= 1 || jobz == lapack::Job::NoVec)
+        return 1;
+    else
+        return 3 + 5*n;
+}
+
 // -----------------------------------------------------------------------------
 /// @ingroup heev
 int64_t syevd(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
     float* A, int64_t lda,
     float* W )
+{
+    size_t work_size;
+    syevd_work_size_bytes( jobz, uplo, n, A, lda, W, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return syevd( jobz, uplo, n, A, lda, W, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @see lapack::heevd
+/// @ingroup heev
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W )
+{
+    size_t work_size;
+    syevd_work_size_bytes( jobz, uplo, n, A, lda, W, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return syevd( jobz, uplo, n, A, lda, W, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev
+void syevd_work_size_bytes(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -33,6 +80,11 @@ int64_t syevd(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "ssyevd", { jobz_, uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     float qry_work[1];
     lapack_int qry_iwork[1];
@@ -48,32 +100,21 @@ int64_t syevd(
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
-
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
 
-    LAPACK_ssyevd(
-        &jobz_, &uplo_, &n_,
-        A, &lda_,
-        W,
-        &work[0], &lwork_,
-        &iwork[0], &liwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    // iwork, then work
+    *host_work_size = internal::workspace_bytes< lapack_int >( syevd_liwork( jobz, n ) )
+                    + internal::workspace_bytes< float >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
 }
 
 // -----------------------------------------------------------------------------
-/// @see lapack::heevd
+/// @see lapack::heevd_work_size_bytes
 /// @ingroup heev
-int64_t syevd(
+void syevd_work_size_bytes(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
     double* A, int64_t lda,
-    double* W )
+    double* W,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -86,6 +127,11 @@ int64_t syevd(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "dsyevd", { jobz_, uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     double qry_work[1];
     lapack_int qry_iwork[1];
@@ -101,18 +147,90 @@ int64_t syevd(
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    // iwork, then work
+    *host_work_size = internal::workspace_bytes< lapack_int >( syevd_liwork( jobz, n ) )
+                    + internal::workspace_bytes< double >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "syevd", 's', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int liwork_ = syevd_liwork( jobz, n );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_ssyevd(
+        &jobz_, &uplo_, &n_,
+        A, &lda_,
+        W,
+        work, &lwork_,
+        iwork, &liwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Workspace version of `lapack::syevd`.
+/// @see lapack::heevd_work_size_bytes
+/// @ingroup heev
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "syevd", 'd', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int liwork_ = syevd_liwork( jobz, n );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
 
     LAPACK_dsyevd(
         &jobz_, &uplo_, &n_,
         A, &lda_,
         W,
-        &work[0], &lwork_,
-        &iwork[0], &liwork_, &info_
+        work, &lwork_,
+        iwork, &liwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "native.hh"
 #include "NoConstructAllocator.hh"
 
 #if LAPACK_VERSION >= 30700  // >= 3.7
@@ -24,6 +25,10 @@ int64_t syevd_2stage(
     float* A, int64_t lda,
     float* W )
 {
+    if (heev_2stage_method() == Method::Native) {
+        return internal::heev_2stage_native( jobz, uplo, n, A, lda, W, true );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -77,6 +82,10 @@ int64_t syevd_2stage(
     double* A, int64_t lda,
     double* W )
 {
+    if (heev_2stage_method() == Method::Native) {
+        return internal::heev_2stage_native( jobz, uplo, n, A, lda, W, true );
+    }
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
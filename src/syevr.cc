@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -15,6 +18,13 @@ using blas::max;
 using blas::min;
 using blas::real;
 
+// -----------------------------------------------------------------------------
+// Size of iwork for syevr, from documentation.
+static int64_t syevr_liwork( int64_t n )
+{
+    return max( 1, 10*n );
+}
+
 // -----------------------------------------------------------------------------
 /// @ingroup heev
 int64_t syevr(
@@ -24,6 +34,46 @@ int64_t syevr(
     float* W,
     float* Z, int64_t ldz,
     int64_t* isuppz )
+{
+    size_t work_size;
+    syevr_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return syevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @see lapack::heevr
+/// @ingroup heev
+int64_t syevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* isuppz )
+{
+    size_t work_size;
+    syevr_work_size_bytes( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return syevr( jobz, range, uplo, n, A, lda, vl, vu, il, iu, abstol, nfound, W, Z, ldz, isuppz, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev
+void syevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
+    int64_t* nfound,
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* isuppz,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -40,27 +90,26 @@ int64_t syevr(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int il_ = (lapack_int) il;
     lapack_int iu_ = (lapack_int) iu;
-    lapack_int nfound_;  // output
     lapack_int ldz_ = (lapack_int) ldz;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was max(1,m), n >= m
-        lapack_int* isuppz_ptr = &isuppz_[0];
-    #else
-        lapack_int* isuppz_ptr = isuppz;
-    #endif
+    lapack_int nfound_ = 0;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "ssyevr", { jobz_, range_, uplo_, n_, lda_, ldz_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     float qry_work[1];
     lapack_int qry_iwork[1];
+    lapack_int qry_isuppz[2];
     lapack_int ineg_one = -1;
     LAPACK_ssyevr(
         &jobz_, &range_, &uplo_, &n_,
         A, &lda_, &vl, &vu, &il_, &iu_, &abstol, &nfound_,
         W,
         Z, &ldz_,
-        isuppz_ptr,
+        qry_isuppz,
         qry_work, &ineg_one,
         qry_iwork, &ineg_one, &info_
     );
@@ -68,42 +117,97 @@ int64_t syevr(
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+    // [32-bit isuppz copy], iwork, [rwork], then work
+    size_t size = 0;
+    #ifndef LAPACK_ILP64
+        size += internal::workspace_bytes< lapack_int >( 2*max( 1, n ) );
+    #endif
+    size += internal::workspace_bytes< lapack_int >( syevr_liwork( n ) );
+    size += internal::workspace_bytes< float >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
 
-    LAPACK_ssyevr(
+// -----------------------------------------------------------------------------
+/// @see lapack::heevr_work_size_bytes
+/// @ingroup heev
+void syevr_work_size_bytes(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* isuppz,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int nfound_ = 0;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "dsyevr", { jobz_, range_, uplo_, n_, lda_, ldz_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int qry_iwork[1];
+    lapack_int qry_isuppz[2];
+    lapack_int ineg_one = -1;
+    LAPACK_dsyevr(
         &jobz_, &range_, &uplo_, &n_,
         A, &lda_, &vl, &vu, &il_, &iu_, &abstol, &nfound_,
         W,
         Z, &ldz_,
-        isuppz_ptr,
-        &work[0], &lwork_,
-        &iwork[0], &liwork_, &info_
+        qry_isuppz,
+        qry_work, &ineg_one,
+        qry_iwork, &ineg_one, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
-    *nfound = nfound_;
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // [32-bit isuppz copy], iwork, [rwork], then work
+    size_t size = 0;
     #ifndef LAPACK_ILP64
-        std::copy( isuppz_.begin(), isuppz_.end(), isuppz );
+        size += internal::workspace_bytes< lapack_int >( 2*max( 1, n ) );
     #endif
-    return info_;
+    size += internal::workspace_bytes< lapack_int >( syevr_liwork( n ) );
+    size += internal::workspace_bytes< double >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
 }
 
 // -----------------------------------------------------------------------------
-/// @see lapack::heevr
 /// @ingroup heev
 int64_t syevr(
     lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
-    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    float* A, int64_t lda, float vl, float vu, int64_t il, int64_t iu, float abstol,
     int64_t* nfound,
-    double* W,
-    double* Z, int64_t ldz,
-    int64_t* isuppz )
+    float* W,
+    float* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size )
 {
+    LAPACK_INSTRUMENT_SCOPE( "syevr", 's', n, n, 0, 0 );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -119,39 +223,88 @@ int64_t syevr(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int il_ = (lapack_int) il;
     lapack_int iu_ = (lapack_int) iu;
-    lapack_int nfound_;  // output
     lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
     #ifndef LAPACK_ILP64
         // 32-bit copy
-        lapack::vector< lapack_int > isuppz_( (2*max( 1, n )) );  // was max(1,m), n >= m
-        lapack_int* isuppz_ptr = &isuppz_[0];
+        lapack_int* isuppz_ptr = workspace.take< lapack_int >( 2*max( 1, n ) );
     #else
         lapack_int* isuppz_ptr = isuppz;
     #endif
-    lapack_int info_ = 0;
+    lapack_int liwork_ = syevr_liwork( n );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
 
-    // query for workspace size
-    double qry_work[1];
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dsyevr(
+    LAPACK_ssyevr(
         &jobz_, &range_, &uplo_, &n_,
         A, &lda_, &vl, &vu, &il_, &iu_, &abstol, &nfound_,
         W,
         Z, &ldz_,
         isuppz_ptr,
-        qry_work, &ineg_one,
-        qry_iwork, &ineg_one, &info_
+        work, &lwork_,
+        iwork, &liwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
+    *nfound = nfound_;
+    #ifndef LAPACK_ILP64
+        std::copy( isuppz_ptr, isuppz_ptr + 2*max( 1, n ), isuppz );
+    #endif
+    return info_;
+}
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+// -----------------------------------------------------------------------------
+/// Workspace version of `lapack::syevr`.
+/// @see lapack::heevr_work_size_bytes
+/// @ingroup heev
+int64_t syevr(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda, double vl, double vu, int64_t il, int64_t iu, double abstol,
+    int64_t* nfound,
+    double* W,
+    double* Z, int64_t ldz,
+    int64_t* isuppz,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "syevr", 'd', n, n, 0, 0 );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(il) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(iu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldz) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char range_ = range2char( range );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int il_ = (lapack_int) il;
+    lapack_int iu_ = (lapack_int) iu;
+    lapack_int ldz_ = (lapack_int) ldz;
+    lapack_int nfound_ = (lapack_int) *nfound;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    #ifndef LAPACK_ILP64
+        // 32-bit copy
+        lapack_int* isuppz_ptr = workspace.take< lapack_int >( 2*max( 1, n ) );
+    #else
+        lapack_int* isuppz_ptr = isuppz;
+    #endif
+    lapack_int liwork_ = syevr_liwork( n );
+    lapack_int* iwork = workspace.take< lapack_int >( liwork_ );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
 
     LAPACK_dsyevr(
         &jobz_, &range_, &uplo_, &n_,
@@ -159,15 +312,15 @@ int64_t syevr(
         W,
         Z, &ldz_,
         isuppz_ptr,
-        &work[0], &lwork_,
-        &iwork[0], &liwork_, &info_
+        work, &lwork_,
+        iwork, &liwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
     *nfound = nfound_;
     #ifndef LAPACK_ILP64
-        std::copy( isuppz_.begin(), isuppz_.end(), isuppz );
+        std::copy( isuppz_ptr, isuppz_ptr + 2*max( 1, n ), isuppz );
     #endif
     return info_;
 }
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -23,6 +24,9 @@ int64_t sysv(
     int64_t* ipiv,
     float* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "sysv", 's', n, n, nrhs,
+                             Gflop< float >::sysv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -86,6 +90,9 @@ int64_t sysv(
     int64_t* ipiv,
     double* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "sysv", 'd', n, n, nrhs,
+                             Gflop< double >::sysv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -149,6 +156,9 @@ int64_t sysv(
     int64_t* ipiv,
     std::complex<float>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "sysv", 'c', n, n, nrhs,
+                             Gflop< std::complex<float> >::sysv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -291,6 +301,9 @@ int64_t sysv(
     int64_t* ipiv,
     std::complex<double>* B, int64_t ldb )
 {
+    LAPACK_INSTRUMENT_SCOPE( "sysv", 'z', n, n, nrhs,
+                             Gflop< std::complex<double> >::sysv( n, nrhs ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
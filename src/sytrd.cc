@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -23,6 +26,44 @@ int64_t sytrd(
     float* D,
     float* E,
     float* tau )
+{
+    size_t work_size;
+    sytrd_work_size_bytes( uplo, n, A, lda, D, E, tau, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return sytrd( uplo, n, A, lda, D, E, tau, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @see lapack::hetrd
+/// @ingroup heev_computational
+int64_t sytrd(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau )
+{
+    size_t work_size;
+    sytrd_work_size_bytes( uplo, n, A, lda, D, E, tau, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return sytrd( uplo, n, A, lda, D, E, tau, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup heev_computational
+void sytrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -34,6 +75,11 @@ int64_t sytrd(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "ssytrd", { uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     float qry_work[1];
     lapack_int ineg_one = -1;
@@ -50,33 +96,69 @@ int64_t sytrd(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    *host_work_size = internal::workspace_bytes< float >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
 
-    LAPACK_ssytrd(
+// -----------------------------------------------------------------------------
+/// @see lapack::hetrd_work_size_bytes
+/// @ingroup heev_computational
+void sytrd_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "dsytrd", { uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dsytrd(
         &uplo_, &n_,
         A, &lda_,
         D,
         E,
         tau,
-        &work[0], &lwork_, &info_
+        qry_work, &ineg_one, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
-    return info_;
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< double >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
 }
 
 // -----------------------------------------------------------------------------
-/// @see lapack::hetrd
 /// @ingroup heev_computational
 int64_t sytrd(
     lapack::Uplo uplo, int64_t n,
-    double* A, int64_t lda,
-    double* D,
-    double* E,
-    double* tau )
+    float* A, int64_t lda,
+    float* D,
+    float* E,
+    float* tau,
+    void* host_work, size_t host_work_size )
 {
+    LAPACK_INSTRUMENT_SCOPE( "sytrd", 's', n, n, 0,
+                             Gflop< float >::sytrd( n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -87,24 +169,53 @@ int64_t sytrd(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    double qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dsytrd(
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_ssytrd(
         &uplo_, &n_,
         A, &lda_,
         D,
         E,
         tau,
-        qry_work, &ineg_one, &info_
+        work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    return info_;
+}
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// @see lapack::hetrd
+/// @ingroup heev_computational
+int64_t sytrd(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* D,
+    double* E,
+    double* tau,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "sytrd", 'd', n, n, 0,
+                             Gflop< double >::sytrd( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
 
     LAPACK_dsytrd(
         &uplo_, &n_,
@@ -112,7 +223,7 @@ int64_t sytrd(
         D,
         E,
         tau,
-        &work[0], &lwork_, &info_
+        work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -22,53 +25,13 @@ int64_t sytrf(
     float* A, int64_t lda,
     int64_t* ipiv )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( (n) );
-        lapack_int* ipiv_ptr = &ipiv_[0];
-    #else
-        lapack_int* ipiv_ptr = ipiv;
-    #endif
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    float qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_ssytrf(
-        &uplo_, &n_,
-        A, &lda_,
-        ipiv_ptr,
-        qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    sytrf_work_size_bytes( uplo, n, A, lda, ipiv, &work_size );
 
     // allocate workspace
-    lapack::vector< float > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_ssytrf(
-        &uplo_, &n_,
-        A, &lda_,
-        ipiv_ptr,
-        &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    #ifndef LAPACK_ILP64
-        std::copy( ipiv_.begin(), ipiv_.end(), ipiv );
-    #endif
-    return info_;
+    return sytrf( uplo, n, A, lda, ipiv, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -78,53 +41,13 @@ int64_t sytrf(
     double* A, int64_t lda,
     int64_t* ipiv )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( (n) );
-        lapack_int* ipiv_ptr = &ipiv_[0];
-    #else
-        lapack_int* ipiv_ptr = ipiv;
-    #endif
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    double qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dsytrf(
-        &uplo_, &n_,
-        A, &lda_,
-        ipiv_ptr,
-        qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    sytrf_work_size_bytes( uplo, n, A, lda, ipiv, &work_size );
 
     // allocate workspace
-    lapack::vector< double > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_dsytrf(
-        &uplo_, &n_,
-        A, &lda_,
-        ipiv_ptr,
-        &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    #ifndef LAPACK_ILP64
-        std::copy( ipiv_.begin(), ipiv_.end(), ipiv );
-    #endif
-    return info_;
+    return sytrf( uplo, n, A, lda, ipiv, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -134,53 +57,13 @@ int64_t sytrf(
     std::complex<float>* A, int64_t lda,
     int64_t* ipiv )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    char uplo_ = uplo2char( uplo );
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    #ifndef LAPACK_ILP64
-        // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( (n) );
-        lapack_int* ipiv_ptr = &ipiv_[0];
-    #else
-        lapack_int* ipiv_ptr = ipiv;
-    #endif
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_csytrf(
-        &uplo_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        ipiv_ptr,
-        (lapack_complex_float*) qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    sytrf_work_size_bytes( uplo, n, A, lda, ipiv, &work_size );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_csytrf(
-        &uplo_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        ipiv_ptr,
-        (lapack_complex_float*) &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    #ifndef LAPACK_ILP64
-        std::copy( ipiv_.begin(), ipiv_.end(), ipiv );
-    #endif
-    return info_;
+    return sytrf( uplo, n, A, lda, ipiv, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -298,6 +181,23 @@ int64_t sytrf(
     lapack::Uplo uplo, int64_t n,
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv )
+{
+    size_t work_size;
+    sytrf_work_size_bytes( uplo, n, A, lda, ipiv, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return sytrf( uplo, n, A, lda, ipiv, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup sysv_computational
+void sytrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -307,45 +207,608 @@ int64_t sytrf(
     char uplo_ = uplo2char( uplo );
     lapack_int n_ = (lapack_int) n;
     lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "ssytrf", { uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    float qry_work[1];
+    lapack_int qry_ipiv[1];
+    lapack_int ineg_one = -1;
+    LAPACK_ssytrf(
+        &uplo_, &n_,
+        A, &lda_,
+        qry_ipiv,
+        qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // [32-bit ipiv copy], then work
+    size_t size = 0;
     #ifndef LAPACK_ILP64
-        // 32-bit copy
-        lapack::vector< lapack_int > ipiv_( (n) );
-        lapack_int* ipiv_ptr = &ipiv_[0];
-    #else
-        lapack_int* ipiv_ptr = ipiv;
+        size += internal::workspace_bytes< lapack_int >( n );
     #endif
+    size += internal::workspace_bytes< float >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup sysv_computational
+void sytrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "dsytrf", { uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
-    std::complex<double> qry_work[1];
+    double qry_work[1];
+    lapack_int qry_ipiv[1];
     lapack_int ineg_one = -1;
-    LAPACK_zsytrf(
+    LAPACK_dsytrf(
         &uplo_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        ipiv_ptr,
-        (lapack_complex_double*) qry_work, &ineg_one, &info_
+        A, &lda_,
+        qry_ipiv,
+        qry_work, &ineg_one, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    // [32-bit ipiv copy], then work
+    size_t size = 0;
+    #ifndef LAPACK_ILP64
+        size += internal::workspace_bytes< lapack_int >( n );
+    #endif
+    size += internal::workspace_bytes< double >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup sysv_computational
+void sytrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "csytrf", { uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    lapack_int qry_ipiv[1];
+    lapack_int ineg_one = -1;
+    LAPACK_csytrf(
+        &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        qry_ipiv,
+        (lapack_complex_float*) qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // [32-bit ipiv copy], then work
+    size_t size = 0;
+    #ifndef LAPACK_ILP64
+        size += internal::workspace_bytes< lapack_int >( n );
+    #endif
+    size += internal::workspace_bytes< std::complex<float> >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::sytrf`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::sytrf`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::sytrf`.
+///
+/// @ingroup sysv_computational
+void sytrf_work_size_bytes(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "zsytrf", { uplo_, n_, lda_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<double> qry_work[1];
+    lapack_int qry_ipiv[1];
+    lapack_int ineg_one = -1;
     LAPACK_zsytrf(
         &uplo_, &n_,
         (lapack_complex_double*) A, &lda_,
-        ipiv_ptr,
-        (lapack_complex_double*) &work[0], &lwork_, &info_
+        qry_ipiv,
+        (lapack_complex_double*) qry_work, &ineg_one, &info_
     );
     if (info_ < 0) {
         throw Error();
     }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // [32-bit ipiv copy], then work
+    size_t size = 0;
     #ifndef LAPACK_ILP64
-        std::copy( ipiv_.begin(), ipiv_.end(), ipiv );
+        size += internal::workspace_bytes< lapack_int >( n );
     #endif
-    return info_;
+    size += internal::workspace_bytes< std::complex<double> >( lwork_ );
+    *host_work_size = size;
+    internal::query_cache_insert( key, *host_work_size );
 }
 
+// -----------------------------------------------------------------------------
+/// @ingroup sysv_computational
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "sytrf", 's', n, n, 0,
+                             Gflop< float >::sytrf( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    #ifndef LAPACK_ILP64
+        // 32-bit copy
+        lapack_int* ipiv_ptr = workspace.take< lapack_int >( n );
+    #else
+        lapack_int* ipiv_ptr = ipiv;
+    #endif
+    lapack_int lwork_;
+    float* work = workspace.take_remaining< float >( &lwork_ );
+
+    LAPACK_ssytrf(
+        &uplo_, &n_,
+        A, &lda_,
+        ipiv_ptr,
+        work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( ipiv_ptr, ipiv_ptr + n, ipiv );
+    #endif
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup sysv_computational
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "sytrf", 'd', n, n, 0,
+                             Gflop< double >::sytrf( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    #ifndef LAPACK_ILP64
+        // 32-bit copy
+        lapack_int* ipiv_ptr = workspace.take< lapack_int >( n );
+    #else
+        lapack_int* ipiv_ptr = ipiv;
+    #endif
+    lapack_int lwork_;
+    double* work = workspace.take_remaining< double >( &lwork_ );
+
+    LAPACK_dsytrf(
+        &uplo_, &n_,
+        A, &lda_,
+        ipiv_ptr,
+        work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( ipiv_ptr, ipiv_ptr + n, ipiv );
+    #endif
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup sysv_computational
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "sytrf", 'c', n, n, 0,
+                             Gflop< std::complex<float> >::sytrf( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    #ifndef LAPACK_ILP64
+        // 32-bit copy
+        lapack_int* ipiv_ptr = workspace.take< lapack_int >( n );
+    #else
+        lapack_int* ipiv_ptr = ipiv;
+    #endif
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_csytrf(
+        &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv_ptr,
+        (lapack_complex_float*) work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( ipiv_ptr, ipiv_ptr + n, ipiv );
+    #endif
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the Bunch-Kaufman factorization of a symmetric matrix A,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::sytrf` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in,out] uplo, n, A, lda, ipiv
+///     As for `lapack::sytrf` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::sytrf_work_size_bytes`.
+///
+/// @return = 0: successful exit; otherwise as for `lapack::sytrf`
+///     without workspace.
+///
+/// @ingroup sysv_computational
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    int64_t* ipiv,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "sytrf", 'z', n, n, 0,
+                             Gflop< std::complex<double> >::sytrf( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    #ifndef LAPACK_ILP64
+        // 32-bit copy
+        lapack_int* ipiv_ptr = workspace.take< lapack_int >( n );
+    #else
+        lapack_int* ipiv_ptr = ipiv;
+    #endif
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
+
+    LAPACK_zsytrf(
+        &uplo_, &n_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv_ptr,
+        (lapack_complex_double*) work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    #ifndef LAPACK_ILP64
+        std::copy( ipiv_ptr, ipiv_ptr + n, ipiv );
+    #endif
+    return info_;
+}
+
+#ifndef LAPACK_ILP64
+
+// -----------------------------------------------------------------------------
+/// @ingroup sysv_computational
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "sytrf", 's', n, n, 0,
+                             Gflop< float >::sytrf( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    float qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_ssytrf(
+        &uplo_, &n_,
+        A, &lda_,
+        ipiv,
+        qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::vector< float > work( lwork_ );
+
+    LAPACK_ssytrf(
+        &uplo_, &n_,
+        A, &lda_,
+        ipiv,
+        &work[0], &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup sysv_computational
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "sytrf", 'd', n, n, 0,
+                             Gflop< double >::sytrf( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    double qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_dsytrf(
+        &uplo_, &n_,
+        A, &lda_,
+        ipiv,
+        qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::vector< double > work( lwork_ );
+
+    LAPACK_dsytrf(
+        &uplo_, &n_,
+        A, &lda_,
+        ipiv,
+        &work[0], &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup sysv_computational
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "sytrf", 'c', n, n, 0,
+                             Gflop< std::complex<float> >::sytrf( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_csytrf(
+        &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::vector< std::complex<float> > work( lwork_ );
+
+    LAPACK_csytrf(
+        &uplo_, &n_,
+        (lapack_complex_float*) A, &lda_,
+        ipiv,
+        (lapack_complex_float*) &work[0], &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Overloaded versions taking `lapack_int` pivots, for LP64 builds
+/// (32-bit lapack_int), pass ipiv directly to LAPACK, instead of
+/// copying to and from a temporary `int64_t` array.
+/// Otherwise the same as the `int64_t` pivot version.
+/// @see lapack::sytrf
+/// @ingroup sysv_computational
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    LAPACK_INSTRUMENT_SCOPE( "sytrf", 'z', n, n, 0,
+                             Gflop< std::complex<double> >::sytrf( n ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size
+    std::complex<double> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_zsytrf(
+        &uplo_, &n_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    // allocate workspace
+    lapack::vector< std::complex<double> > work( lwork_ );
+
+    LAPACK_zsytrf(
+        &uplo_, &n_,
+        (lapack_complex_double*) A, &lda_,
+        ipiv,
+        (lapack_complex_double*) &work[0], &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+#endif  // LAPACK_ILP64
+
 }  // namespace lapack
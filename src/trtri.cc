@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 
 #include <vector>
 
@@ -19,6 +20,9 @@ int64_t trtri(
     lapack::Uplo uplo, lapack::Diag diag, int64_t n,
     float* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "trtri", 's', n, n, 0,
+                             Gflop< float >::trtri( n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -45,6 +49,9 @@ int64_t trtri(
     lapack::Uplo uplo, lapack::Diag diag, int64_t n,
     double* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "trtri", 'd', n, n, 0,
+                             Gflop< double >::trtri( n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -71,6 +78,9 @@ int64_t trtri(
     lapack::Uplo uplo, lapack::Diag diag, int64_t n,
     std::complex<float>* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "trtri", 'c', n, n, 0,
+                             Gflop< std::complex<float> >::trtri( n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -97,6 +107,9 @@ int64_t trtri(
     lapack::Uplo uplo, lapack::Diag diag, int64_t n,
     std::complex<double>* A, int64_t lda )
 {
+    LAPACK_INSTRUMENT_SCOPE( "trtri", 'z', n, n, 0,
+                             Gflop< std::complex<double> >::trtri( n ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +23,9 @@ int64_t unglq(
     std::complex<float>* A, int64_t lda,
     std::complex<float> const* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "unglq", 'c', m, n, k,
+                             Gflop< std::complex<float> >::unglq( m, n, k ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -107,6 +111,9 @@ int64_t unglq(
     std::complex<double>* A, int64_t lda,
     std::complex<double> const* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "unglq", 'z', m, n, k,
+                             Gflop< std::complex<double> >::unglq( m, n, k ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -22,6 +23,9 @@ int64_t ungqr(
     std::complex<float>* A, int64_t lda,
     std::complex<float> const* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "ungqr", 'c', m, n, k,
+                             Gflop< std::complex<float> >::ungqr( m, n, k ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -108,6 +112,9 @@ int64_t ungqr(
     std::complex<double>* A, int64_t lda,
     std::complex<double> const* tau )
 {
+    LAPACK_INSTRUMENT_SCOPE( "ungqr", 'z', m, n, k,
+                             Gflop< std::complex<double> >::ungqr( m, n, k ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
 
 #include <vector>
@@ -23,6 +24,9 @@ int64_t unmlq(
     std::complex<float> const* tau,
     std::complex<float>* C, int64_t ldc )
 {
+    LAPACK_INSTRUMENT_SCOPE( "unmlq", 'c', m, n, k,
+                             Gflop< std::complex<float> >::unmlq( side, m, n, k ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
@@ -145,6 +149,9 @@ int64_t unmlq(
     std::complex<double> const* tau,
     std::complex<double>* C, int64_t ldc )
 {
+    LAPACK_INSTRUMENT_SCOPE( "unmlq", 'z', m, n, k,
+                             Gflop< std::complex<double> >::unmlq( side, m, n, k ) );
+
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
         lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
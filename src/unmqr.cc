@@ -5,7 +5,10 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "Instrument.hh"
 #include "NoConstructAllocator.hh"
+#include "Workspace.hh"
+#include "QueryCache.hh"
 
 #include <vector>
 
@@ -23,52 +26,13 @@ int64_t unmqr(
     std::complex<float> const* tau,
     std::complex<float>* C, int64_t ldc )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
-    }
-    char side_ = side2char( side );
-    char trans_ = op2char( trans );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int k_ = (lapack_int) k;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldc_ = (lapack_int) ldc;
-    lapack_int info_ = 0;
-
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cunmqr(
-        &side_, &trans_, &m_, &n_, &k_,
-        (lapack_complex_float*) A, &lda_,
-        (lapack_complex_float*) tau,
-        (lapack_complex_float*) C, &ldc_,
-        (lapack_complex_float*) qry_work, &ineg_one, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    size_t work_size;
+    unmqr_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, &work_size );
 
     // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::vector< char > work( work_size );
 
-    LAPACK_cunmqr(
-        &side_, &trans_, &m_, &n_, &k_,
-        (lapack_complex_float*) A, &lda_,
-        (lapack_complex_float*) tau,
-        (lapack_complex_float*) C, &ldc_,
-        (lapack_complex_float*) &work[0], &lwork_, &info_
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return unmqr( side, trans, m, n, k, A, lda, tau, C, ldc, &work[0], work_size );
 }
 
 // -----------------------------------------------------------------------------
@@ -146,6 +110,89 @@ int64_t unmqr(
     std::complex<double> const* A, int64_t lda,
     std::complex<double> const* tau,
     std::complex<double>* C, int64_t ldc )
+{
+    size_t work_size;
+    unmqr_work_size_bytes( side, trans, m, n, k, A, lda, tau, C, ldc, &work_size );
+
+    // allocate workspace
+    lapack::vector< char > work( work_size );
+
+    return unmqr( side, trans, m, n, k, A, lda, tau, C, ldc, &work[0], work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geqrf
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* tau,
+    std::complex<float>* C, int64_t ldc,
+    size_t* host_work_size )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // check cache of workspace queries
+    internal::QueryKey key( "cunmqr", { side_, trans_, m_, n_, k_, lda_, ldc_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
+    // query for workspace size
+    std::complex<float> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_cunmqr(
+        &side_, &trans_, &m_, &n_, &k_,
+        (lapack_complex_float*) A, &lda_,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) C, &ldc_,
+        (lapack_complex_float*) qry_work, &ineg_one, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    lapack_int lwork_ = real(qry_work[0]);
+
+    *host_work_size = internal::workspace_bytes< std::complex<float> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the size of host workspace, in bytes, that `lapack::unmqr`
+/// needs when the caller supplies the workspace. The workspace can then be
+/// allocated once and reused for many calls of the same size,
+/// avoiding a workspace query and allocation in each call.
+/// For real matrices, this is an alias for `lapack::ormqr_work_size_bytes`.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// Arguments are the same as for `lapack::unmqr`; the arrays are not
+/// referenced.
+///
+/// @param[out] host_work_size
+///     Size of host workspace, in bytes, for `lapack::unmqr`.
+///
+/// @ingroup geqrf
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* tau,
+    std::complex<double>* C, int64_t ldc,
+    size_t* host_work_size )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -164,6 +211,11 @@ int64_t unmqr(
     lapack_int ldc_ = (lapack_int) ldc;
     lapack_int info_ = 0;
 
+    // check cache of workspace queries
+    internal::QueryKey key( "zunmqr", { side_, trans_, m_, n_, k_, lda_, ldc_ } );
+    if (internal::query_cache_lookup( key, host_work_size ))
+        return;
+
     // query for workspace size
     std::complex<double> qry_work[1];
     lapack_int ineg_one = -1;
@@ -179,15 +231,118 @@ int64_t unmqr(
     }
     lapack_int lwork_ = real(qry_work[0]);
 
-    // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    *host_work_size = internal::workspace_bytes< std::complex<double> >( lwork_ );
+    internal::query_cache_insert( key, *host_work_size );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup geqrf
+int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* tau,
+    std::complex<float>* C, int64_t ldc,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "unmqr", 'c', m, n, k,
+                             Gflop< std::complex<float> >::unmqr( side, m, n, k ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<float>* work = workspace.take_remaining< std::complex<float> >( &lwork_ );
+
+    LAPACK_cunmqr(
+        &side_, &trans_, &m_, &n_, &k_,
+        (lapack_complex_float*) A, &lda_,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) C, &ldc_,
+        (lapack_complex_float*) work, &lwork_, &info_
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// Multiplies the general m-by-n matrix C by Q from `lapack::geqrf`,
+/// using a caller-supplied host workspace. Otherwise the same as
+/// `lapack::unmqr` without workspace.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+/// For real matrices, this is an alias for `lapack::ormqr`.
+///
+/// @param[in,out] side, trans, m, n, k, A, lda, tau, C, ldc
+///     As for `lapack::unmqr` without workspace.
+///
+/// @param[out] host_work
+///     Host workspace of host_work_size bytes, aligned at least for the
+///     scalar type, as from `malloc` or `new`.
+///
+/// @param[in] host_work_size
+///     Size of host_work, in bytes; at least as computed by
+///     `lapack::unmqr_work_size_bytes`.
+///
+/// @return = 0: successful exit
+///
+/// @ingroup geqrf
+int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* tau,
+    std::complex<double>* C, int64_t ldc,
+    void* host_work, size_t host_work_size )
+{
+    LAPACK_INSTRUMENT_SCOPE( "unmqr", 'z', m, n, k,
+                             Gflop< std::complex<double> >::unmqr( side, m, n, k ) );
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+    }
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int info_ = 0;
+
+    // split workspace
+    internal::Workspace workspace( host_work, host_work_size );
+    lapack_int lwork_;
+    std::complex<double>* work = workspace.take_remaining< std::complex<double> >( &lwork_ );
 
     LAPACK_zunmqr(
         &side_, &trans_, &m_, &n_, &k_,
         (lapack_complex_double*) A, &lda_,
         (lapack_complex_double*) tau,
         (lapack_complex_double*) C, &ldc_,
-        (lapack_complex_double*) &work[0], &lwork_, &info_
+        (lapack_complex_double*) work, &lwork_, &info_
     );
     if (info_ < 0) {
         throw Error();
@@ -0,0 +1,228 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "bench.hh"
+#include "lapack/fortran.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Returns true if x was set by the test, i.e., is not no_data_flag or NaN.
+bool has_data( double x )
+{
+    return ! std::isnan( x ) && x != testsweeper::no_data_flag;
+}
+
+//------------------------------------------------------------------------------
+// Returns the q-th quantile of sorted x, 0 <= q <= 1, by nearest rank.
+double quantile( std::vector< double > const& x, double q )
+{
+    if (x.empty())
+        return testsweeper::no_data_flag;
+    size_t i = size_t( std::ceil( q * x.size() ) );
+    return x[ std::max( i, size_t( 1 ) ) - 1 ];
+}
+
+//------------------------------------------------------------------------------
+// Returns name = value pairs of routine parameters used by the test,
+// identifying the configuration.
+std::vector< std::pair< std::string, std::string > >
+used_params( Params& params )
+{
+    std::vector< std::pair< std::string, std::string > > list;
+    auto add_char = [&]( testsweeper::ParamBase& param, char const* name, char value ) {
+        if (param.used())
+            list.push_back( { name, std::string( 1, value ) } );
+    };
+    auto add_int = [&]( testsweeper::ParamBase& param, char const* name, int64_t value ) {
+        if (param.used())
+            list.push_back( { name, std::to_string( value ) } );
+    };
+
+    add_char( params.uplo,   "uplo",   blas::uplo2char( params.uplo() ) );
+    add_char( params.trans,  "trans",  blas::op2char( params.trans() ) );
+    add_char( params.side,   "side",   blas::side2char( params.side() ) );
+    add_char( params.diag,   "diag",   blas::diag2char( params.diag() ) );
+    add_char( params.norm,   "norm",   lapack::norm2char( params.norm() ) );
+    add_char( params.jobz,   "jobz",   lapack::job2char( params.jobz() ) );
+    add_char( params.jobu,   "jobu",   lapack::job2char( params.jobu() ) );
+    add_char( params.jobvt,  "jobvt",  lapack::job2char( params.jobvt() ) );
+    add_char( params.jobvl,  "jobvl",  lapack::job2char( params.jobvl() ) );
+    add_char( params.jobvr,  "jobvr",  lapack::job2char( params.jobvr() ) );
+    add_int( params.nrhs,    "nrhs",   params.nrhs() );
+    add_int( params.nb,      "nb",     params.nb() );
+    add_int( params.kd,      "kd",     params.kd() );
+    add_int( params.kl,      "kl",     params.kl() );
+    add_int( params.ku,      "ku",     params.ku() );
+    add_int( params.il_out,  "il",     params.il_out() );
+    add_int( params.iu_out,  "iu",     params.iu_out() );
+    add_int( params.batch,   "batch",  params.batch() );
+    add_int( params.align,   "align",  params.align() );
+    if (params.matrix.kind.used())
+        list.push_back( { "matrix", params.matrix.kind() } );
+    return list;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+Bench::Bench( char const* routine ):
+    routine_( routine ),
+    gflop_( testsweeper::no_data_flag ),
+    failed_( 0 )
+{
+    lapack_int major = 0, minor = 0, patch = 0;
+    LAPACK_ilaver( &major, &minor, &patch );
+    lapack_version_ = std::to_string( major ) + "." + std::to_string( minor )
+                    + "." + std::to_string( patch );
+}
+
+//------------------------------------------------------------------------------
+// Records the outputs of one run. Call before params.reset_output().
+void Bench::add( Params& params )
+{
+    if (has_data( params.time() )) {
+        times_.push_back( params.time() );
+        // gflop is the same each run; the test computes it with flops.hh
+        if (has_data( params.gflops() ))
+            gflop_ = params.gflops() * params.time();
+    }
+    if (has_data( params.ref_time() ))
+        ref_times_.push_back( params.ref_time() );
+    failed_ += ! params.okay();
+}
+
+//------------------------------------------------------------------------------
+// Prints statistics of the runs of one configuration, appends a record to
+// --bench-out, and clears the runs for the next configuration.
+void Bench::finish( Params& params )
+{
+    std::sort( times_.begin(), times_.end() );
+    std::sort( ref_times_.begin(), ref_times_.end() );
+
+    if (! times_.empty()) {
+        printf( "bench: %lld runs, time (s) min %.3e, median %.3e, p95 %.3e",
+                llong( times_.size() ), quantile( times_, 0 ),
+                quantile( times_, 0.5 ), quantile( times_, 0.95 ) );
+        if (has_data( gflop_ )) {
+            printf( "; gflop/s max %.3f, median %.3f, p5 %.3f",
+                    gflop_ / quantile( times_, 0 ),
+                    gflop_ / quantile( times_, 0.5 ),
+                    gflop_ / quantile( times_, 0.95 ) );
+        }
+        printf( "\n" );
+    }
+
+    std::string const& filename = params.bench_out();
+    if (! filename.empty()) {
+        bool csv = filename.size() >= 4
+                   && filename.compare( filename.size() - 4, 4, ".csv" ) == 0;
+        FILE* file = fopen( filename.c_str(), "a" );
+        if (file == nullptr) {
+            throw std::runtime_error( "cannot open " + filename + ": "
+                                      + strerror( errno ) );
+        }
+        bool header = (ftell( file ) == 0);
+        if (csv)
+            write_csv( file, params, header );
+        else
+            write_json( file, params );
+        fclose( file );
+    }
+
+    times_.clear();
+    ref_times_.clear();
+    gflop_ = testsweeper::no_data_flag;
+    failed_ = 0;
+}
+
+//------------------------------------------------------------------------------
+// Writes one JSON object on one line, with null for missing values.
+void Bench::write_json( FILE* file, Params& params )
+{
+    auto number = [file]( char const* name, double x ) {
+        if (has_data( x ))
+            fprintf( file, ", \"%s\": %.6e", name, x );
+        else
+            fprintf( file, ", \"%s\": null", name );
+    };
+
+    fprintf( file, "{\"routine\": \"%s\", \"type\": \"%c\", "
+             "\"m\": %lld, \"n\": %lld, \"k\": %lld",
+             routine_.c_str(), testsweeper::datatype2char( params.datatype() ),
+             llong( params.dim.m() ), llong( params.dim.n() ),
+             llong( params.dim.k() ) );
+
+    fprintf( file, ", \"params\": {" );
+    const char* sep = "";
+    for (auto const& param : used_params( params )) {
+        fprintf( file, "%s\"%s\": \"%s\"",
+                 sep, param.first.c_str(), param.second.c_str() );
+        sep = ", ";
+    }
+    fprintf( file, "}" );
+
+    bool flops = has_data( gflop_ ) && ! times_.empty();
+    fprintf( file, ", \"runs\": %lld, \"failed\": %d",
+             llong( times_.size() ), failed_ );
+    number( "time_min",      quantile( times_, 0 ) );
+    number( "time_median",   quantile( times_, 0.5 ) );
+    number( "time_p95",      quantile( times_, 0.95 ) );
+    number( "gflops_max",    flops ? gflop_ / quantile( times_, 0 )    : testsweeper::no_data_flag );
+    number( "gflops_median", flops ? gflop_ / quantile( times_, 0.5 )  : testsweeper::no_data_flag );
+    number( "gflops_p5",     flops ? gflop_ / quantile( times_, 0.95 ) : testsweeper::no_data_flag );
+    number( "ref_time_median", quantile( ref_times_, 0.5 ) );
+    fprintf( file, ", \"lapackpp\": \"%s\", \"lapack\": \"%s\"}\n",
+             lapack::lapackpp_id(), lapack_version_.c_str() );
+}
+
+//------------------------------------------------------------------------------
+// Writes one CSV row, with a header row if the file is empty.
+// Parameters are one column of space-separated name=value pairs,
+// so the columns are the same for every routine.
+void Bench::write_csv( FILE* file, Params& params, bool header )
+{
+    auto number = [file]( double x ) {
+        if (has_data( x ))
+            fprintf( file, ",%.6e", x );
+        else
+            fprintf( file, "," );
+    };
+
+    if (header) {
+        fprintf( file, "routine,type,m,n,k,params,runs,failed,"
+                       "time_min,time_median,time_p95,"
+                       "gflops_max,gflops_median,gflops_p5,"
+                       "ref_time_median,lapackpp,lapack\n" );
+    }
+
+    fprintf( file, "%s,%c,%lld,%lld,%lld,",
+             routine_.c_str(), testsweeper::datatype2char( params.datatype() ),
+             llong( params.dim.m() ), llong( params.dim.n() ),
+             llong( params.dim.k() ) );
+    const char* sep = "";
+    for (auto const& param : used_params( params )) {
+        fprintf( file, "%s%s=%s", sep, param.first.c_str(), param.second.c_str() );
+        sep = " ";
+    }
+
+    bool flops = has_data( gflop_ ) && ! times_.empty();
+    fprintf( file, ",%lld,%d", llong( times_.size() ), failed_ );
+    number( quantile( times_, 0 ) );
+    number( quantile( times_, 0.5 ) );
+    number( quantile( times_, 0.95 ) );
+    number( flops ? gflop_ / quantile( times_, 0 )    : testsweeper::no_data_flag );
+    number( flops ? gflop_ / quantile( times_, 0.5 )  : testsweeper::no_data_flag );
+    number( flops ? gflop_ / quantile( times_, 0.95 ) : testsweeper::no_data_flag );
+    number( quantile( ref_times_, 0.5 ) );
+    fprintf( file, ",%s,%s\n", lapack::lapackpp_id(), lapack_version_.c_str() );
+}
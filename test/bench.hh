@@ -0,0 +1,43 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef BENCH_HH
+#define BENCH_HH
+
+#include "test.hh"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// =============================================================================
+// Benchmark mode, enabled with `--bench y`.
+// Each test routine flushes the cache (--cache) before its timed call,
+// so each of the --repeat runs of a configuration is a cold-cache sample.
+// After the runs, Bench prints the min, median, and 95th percentile time,
+// with the matching Gflop/s, and appends a record to --bench-out:
+// CSV if the file name ends in .csv, else JSON Lines (one JSON object per
+// line). Records from different LAPACK versions can then be diffed.
+class Bench
+{
+public:
+    explicit Bench( char const* routine );
+
+    void add( Params& params );
+    void finish( Params& params );
+
+private:
+    void write_json( FILE* file, Params& params );
+    void write_csv( FILE* file, Params& params, bool header );
+
+    std::string routine_;
+    std::string lapack_version_;
+    std::vector< double > times_;
+    std::vector< double > ref_times_;
+    double gflop_;
+    int failed_;
+};
+
+#endif  // BENCH_HH
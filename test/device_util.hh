@@ -0,0 +1,65 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef DEVICE_UTIL_HH
+#define DEVICE_UTIL_HH
+
+#include "lapack/device.hh"
+
+// Device memory for the device tests, forwarding to BLAS++. Without a GPU
+// backend, lapack/device.hh overloads these for lapack::Queue to use host
+// memory, with copies enqueued on the queue. The tests sync the queue
+// after copying results back.
+namespace test_device {
+
+// -----------------------------------------------------------------------------
+inline bool available()
+{
+    #if defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_SYCL)
+        return blas::get_device_count() > 0;
+    #else
+        return true;
+    #endif
+}
+
+template< typename T >
+T* device_malloc( int64_t n, lapack::Queue& queue )
+{
+    return blas::device_malloc< T >( n, queue );
+}
+
+template< typename T >
+void device_free( T* ptr, lapack::Queue& queue )
+{
+    blas::device_free( ptr, queue );
+}
+
+template< typename T >
+void device_copy_matrix(
+    int64_t m, int64_t n,
+    T const* src, int64_t ld_src,
+    T*       dst, int64_t ld_dst, lapack::Queue& queue )
+{
+    blas::device_copy_matrix( m, n, src, ld_src, dst, ld_dst, queue );
+}
+
+template< typename T >
+void device_copy_vector(
+    int64_t n,
+    T const* src, int64_t inc_src,
+    T*       dst, int64_t inc_dst, lapack::Queue& queue )
+{
+    blas::device_copy_vector( n, src, inc_src, dst, inc_dst, queue );
+}
+
+template< typename T >
+void device_memcpy( T* dst, T const* src, int64_t n, lapack::Queue& queue )
+{
+    blas::device_memcpy( dst, src, n, queue );
+}
+
+}  // namespace test_device
+
+#endif  // DEVICE_UTIL_HH
@@ -1335,6 +1335,41 @@ inline lapack_int LAPACKE_gesv(
         (lapack_complex_double*) B, ldb );
 }
 
+// -----------------------------------------------------------------------------
+inline lapack_int LAPACKE_gesv_mixed(
+    lapack_int n, lapack_int nrhs,
+    double* A, lapack_int lda,
+    lapack_int* ipiv,
+    double* B, lapack_int ldb,
+    double* X, lapack_int ldx,
+    lapack_int* iter )
+{
+    return LAPACKE_dsgesv(
+        LAPACK_COL_MAJOR, n, nrhs,
+        A, lda,
+        ipiv,
+        B, ldb,
+        X, ldx,
+        iter );
+}
+
+inline lapack_int LAPACKE_gesv_mixed(
+    lapack_int n, lapack_int nrhs,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* ipiv,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx,
+    lapack_int* iter )
+{
+    return LAPACKE_zcgesv(
+        LAPACK_COL_MAJOR, n, nrhs,
+        (lapack_complex_double*) A, lda,
+        ipiv,
+        (lapack_complex_double*) B, ldb,
+        (lapack_complex_double*) X, ldx,
+        iter );
+}
+
 // -----------------------------------------------------------------------------
 inline lapack_int LAPACKE_gesvd(
     char jobu, char jobvt, lapack_int m, lapack_int n,
@@ -6874,6 +6909,37 @@ inline lapack_int LAPACKE_posv(
         (lapack_complex_double*) B, ldb );
 }
 
+// -----------------------------------------------------------------------------
+inline lapack_int LAPACKE_posv_mixed(
+    char uplo, lapack_int n, lapack_int nrhs,
+    double* A, lapack_int lda,
+    double* B, lapack_int ldb,
+    double* X, lapack_int ldx,
+    lapack_int* iter )
+{
+    return LAPACKE_dsposv(
+        LAPACK_COL_MAJOR, uplo, n, nrhs,
+        A, lda,
+        B, ldb,
+        X, ldx,
+        iter );
+}
+
+inline lapack_int LAPACKE_posv_mixed(
+    char uplo, lapack_int n, lapack_int nrhs,
+    std::complex<double>* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb,
+    std::complex<double>* X, lapack_int ldx,
+    lapack_int* iter )
+{
+    return LAPACKE_zcposv(
+        LAPACK_COL_MAJOR, uplo, n, nrhs,
+        (lapack_complex_double*) A, lda,
+        (lapack_complex_double*) B, ldb,
+        (lapack_complex_double*) X, ldx,
+        iter );
+}
+
 // -----------------------------------------------------------------------------
 inline lapack_int LAPACKE_potrf(
     char uplo, lapack_int n,
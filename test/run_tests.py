@@ -189,6 +189,9 @@ nk_tall  = dim
 nk_wide  = dim
 nk       = dim
 
+# tiny square sizes for lapack::fixed, both sides of the dispatch threshold
+tiny     = dim if (opts.dim) else ' --dim 1:16'
+
 if (not opts.dim):
     if (opts.quick):
         n        = ' --dim 100'
@@ -353,9 +356,14 @@ cmds = []
 if (opts.lu and opts.host):
     cmds += [
     [ 'gesv',  gen + dtype + align + n ],
+    [ 'gesv-mixed', gen + dtype_double + align + n ],
     # todo: equed
     [ 'gesvx', gen + dtype + align + n + factored + trans ],
     [ 'getrf', gen + dtype + align + mn ],
+    [ 'getrf', gen + dtype + align + mn + nb + ' --method native' ],
+    [ 'batch-getrf', gen + dtype + align + mn ],
+    [ 'fixed-getrf', gen + dtype + align + tiny ],
+    [ 'factor-getrf', gen + dtype + align + n + trans ],
     [ 'getrs', gen + dtype + align + n + trans ],
     [ 'getri', gen + dtype + align + n ],
     [ 'gecon', gen + dtype + align + n ],
@@ -394,9 +402,19 @@ if (opts.gt and opts.host):
 if (opts.chol and opts.host):
     cmds += [
     [ 'posv',  gen + dtype + align + n + uplo ],
+    [ 'posv',  gen + dtype + align + n + uplo + nb + ' --method native' ],
+    [ 'posv-mixed', gen + dtype_double + align + n + uplo ],
     [ 'potrf', gen + dtype + align + n + uplo ],
+    [ 'potrf', gen + dtype + align + n + uplo + nb + ' --method native' ],
+    [ 'potrf-ooc', gen + dtype + align + n + uplo + nb ],
+    [ 'potrf-update', gen + dtype + align + mnk + uplo ],
+    [ 'factor-potrf', gen + dtype + align + n + uplo ],
+    [ 'batch-potrf', gen + dtype + align + n + uplo ],
+    [ 'fixed-potrf', gen + dtype + align + tiny + uplo ],
     [ 'potrs', gen + dtype + align + n + uplo ],
+    [ 'potrs', gen + dtype + align + n + uplo + nb + ' --method native' ],
     [ 'potri', gen + dtype + align + n + uplo ],
+    [ 'potri', gen + dtype + align + n + uplo + nb + ' --method native' ],
     [ 'pocon', gen + dtype + align + n + uplo ],
     [ 'porfs', gen + dtype + align + n + uplo ],
     [ 'poequ', gen + dtype + align + n ],  # only diagonal elements (no uplo)
@@ -486,6 +504,7 @@ if (opts.hesv and opts.host):
     cmds += [
     [ 'hesv',  gen + dtype + align + n + uplo ],
     [ 'hetrf', gen + dtype + align + n + uplo ],
+    [ 'factor-hetrf', gen + dtype + align + n + uplo + ' --pivot b,r,k,a' ],
     [ 'hetrs', gen + dtype + align + n + uplo ],
     [ 'hetri', gen + dtype + align + n + uplo ],
     [ 'hecon', gen + dtype + align + n + uplo ],
@@ -504,11 +523,13 @@ if (opts.hesv and opts.host):
 if (opts.least_squares and opts.host):
     cmds += [
     [ 'gels',   gen + dtype + align + mn + trans_nc ],
+    [ 'factor-geqrf', gen + dtype + align + tall + trans_nc ],
     [ 'gelsy',  gen + dtype + align + mn ],
     # todo: gelsd is failing
     #[ 'gelsd',  gen + dtype + align + mn ],
     [ 'gelss',  gen + dtype + align + mn ],
     [ 'getsls', gen + dtype + align + mn + trans_nc ],
+    [ 'gels-stream', gen + dtype + layout + align + tall + nb ],
 
     # Generalized
     [ 'gglse', gen + dtype + align + mnk ],
@@ -520,7 +541,12 @@ if (opts.least_squares and opts.host):
 if (opts.qr and opts.host):
     cmds += [
     [ 'geqr',  gen + dtype + align + n + wide + tall ],
+    [ 'geqr',  gen + dtype + align + n + tall + nb + ' --method native' ],
     [ 'geqrf', gen + dtype + align + n + wide + tall ],
+    [ 'geqp3-rand', gen + dtype + align + n + wide + tall + ' --nb 16,32 --sketch g,h' ],
+    [ 'geqrf-update', gen + dtype + align + n + wide + tall ],
+    [ 'batch-geqrf', gen + dtype + align + n + wide + tall ],
+    [ 'fixed-geqrf', gen + dtype + align + tiny ],
     # todo: ggqrf is failing
     #[ 'ggqrf', gen + dtype + align + mnk ],
     [ 'ungqr', gen + dtype + align + mn ],  # m >= n
@@ -529,6 +555,7 @@ if (opts.qr and opts.host):
 
     [ 'orhr_col', gen + dtype_real + align + n + tall ],
     [ 'unhr_col', gen + dtype      + align + n + tall ],
+    [ 'getsqrhrt', gen + dtype     + align + n + tall + nb ],
 
     [ 'gemqrt', gen + dtype_real    + align + n + nb + side + trans    ],  # real does trans = N, T, C
     [ 'gemqrt', gen + dtype_complex + align + n + nb + side + trans_nc ],  # complex does trans = N, C, not T
@@ -588,9 +615,21 @@ if (opts.rq and opts.host):
 if (opts.syev and opts.host):
     cmds += [
     [ 'heev',  gen + dtype + align + n + jobz + uplo ],
+    [ 'heev-2stage', gen + dtype + align + n + uplo + ' --jobz n' ],
+    [ 'heev-2stage', gen + dtype + align + n + jobz + uplo + nb + ' --method native' ],
     [ 'heevx', gen + dtype + align + n + jobz + uplo + vl + vu ],
     [ 'heevx', gen + dtype + align + n + jobz + uplo + il + iu ],
+    [ 'heevx-slice', gen + dtype + align + n + jobz + uplo + vl + vu ],
+    [ 'heevx-slice', gen + dtype + align + n + jobz + uplo + il + iu ],
     [ 'heevd', gen + dtype + align + n + jobz + uplo ],
+    [ 'heevd-qdwh', gen + dtype + align + n + jobz + uplo ],
+    [ 'heevd-2stage', gen + dtype + align + n + uplo + ' --jobz n' ],
+    [ 'heevd-2stage', gen + dtype + align + n + jobz + uplo + nb + ' --method native' ],
+    [ 'heev-subspace', gen + dtype + align + mnk + uplo ],
+    [ 'sturm-bisect', gen + dtype_real + n ],
+    [ 'sturm-bisect', gen + dtype_real + n + il + iu ],
+    [ 'batch-heevd', gen + dtype + align + n + jobz + uplo ],
+    [ 'batch-sturm', gen + dtype_real + align + n ],
     [ 'heevr', gen + dtype + align + n + jobz + uplo + vl + vu ],
     [ 'heevr', gen + dtype + align + n + jobz + uplo + il + iu ],
     [ 'hetrd', gen + dtype + align + n + uplo ],
@@ -681,6 +720,11 @@ if (opts.svd and opts.host):
     [ 'gesvd',         gen + dtype + align + mn + " --jobu n,a" + jobvt ],
     [ 'gesvd',         gen + dtype + align + mn + " --jobu o,s --jobvt n" ],
     [ 'gesdd',         gen + dtype + align + mn + jobu ],
+    [ 'gesvd-rand',    gen + dtype + align + mnk + jobz + ' --sketch g,h' ],
+    [ 'gesvd-qdwh',    gen + dtype + align + mn + ' --jobu n,s' ],
+    [ 'gesvd-qdwh',    gen + dtype + align + mn + ' --jobu n,s --rank 1,10' ],
+    [ 'qdwh',          gen + dtype + align + n + tall ],
+    [ 'qdwh',          gen + dtype + align + n + tall + ' --rank 0,1,10' ],
     # todo: gesvdx is failing
     #[ 'gesvdx',        gen + dtype + align + mn + jobz + jobvr + vl + vu ],
     #[ 'gesvdx',        gen + dtype + align + mn + jobz + jobvr + il + iu ],
@@ -698,6 +742,11 @@ if (opts.aux and opts.host):
     [ 'laed4', gen + dtype_real + n ],
     [ 'laset', gen + dtype + align + mn + mtype ],
     [ 'laswp', gen + dtype + align + mn ],
+    [ 'arena', dtype + n ],
+    [ 'workspace', gen + dtype + align + mn + uplo ],
+    [ 'query-cache', dtype + mn ],
+    [ 'instrument', dtype + mn ],
+    [ 'ipiv32', gen + dtype + align + mn + uplo ],
     ]
 
 # auxilary - householder
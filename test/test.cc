@@ -10,6 +10,7 @@
 #include <unistd.h>
 
 #include "test.hh"
+#include "bench.hh"
 
 // -----------------------------------------------------------------------------
 using testsweeper::ParamType;
@@ -48,6 +49,7 @@ enum Section {
     blas1,
     blas2,
     blas3,
+    batch,
     gpu,
     num_sections,  // last
 };
@@ -71,6 +73,7 @@ const char* section_names[] = {
    "Level 1 BLAS (additional)",
    "Level 2 BLAS (additional)",
    "Level 3 BLAS (additional)",
+   "batched host functions",
    "GPU device functions",
 };
 
@@ -79,6 +82,7 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // LU
     { "gesv",               test_gesv,      Section::gesv },
+    { "gesv-mixed",         test_gesv_mixed, Section::gesv },
     { "gbsv",               test_gbsv,      Section::gesv },
     { "gtsv",               test_gtsv,      Section::gesv },
     { "",                   nullptr,        Section::newline },
@@ -91,6 +95,7 @@ std::vector< testsweeper::routines_t > routines = {
     { "getrf",              test_getrf,     Section::gesv },
     { "gbtrf",              test_gbtrf,     Section::gesv },
     { "gttrf",              test_gttrf,     Section::gesv },
+    { "factor-getrf",       test_getrf_factor, Section::gesv }, // tested numerically
     { "",                   nullptr,        Section::newline },
 
     { "getrs",              test_getrs,     Section::gesv },
@@ -118,6 +123,7 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // Cholesky
     { "posv",               test_posv,      Section::posv },
+    { "posv-mixed",         test_posv_mixed, Section::posv },
     { "ppsv",               test_ppsv,      Section::posv },
     { "pbsv",               test_pbsv,      Section::posv },
     { "ptsv",               test_ptsv,      Section::posv },
@@ -127,6 +133,9 @@ std::vector< testsweeper::routines_t > routines = {
     { "pptrf",              test_pptrf,     Section::posv },
     { "pbtrf",              test_pbtrf,     Section::posv },
     { "pttrf",              test_pttrf,     Section::posv },
+    { "potrf-ooc",          test_potrf_ooc, Section::posv },
+    { "potrf-update",       test_potrf_update, Section::posv }, // tested numerically
+    { "factor-potrf",       test_potrf_factor, Section::posv }, // tested numerically
     { "",                   nullptr,        Section::newline },
 
     { "potrs",              test_potrs,     Section::posv },
@@ -213,6 +222,7 @@ std::vector< testsweeper::routines_t > routines = {
 
     { "hetrf",              test_hetrf,     Section::hesv }, // tested via LAPACKE
     { "hptrf",              test_hptrf,     Section::hesv }, // tested via LAPACKE
+    { "factor-hetrf",       test_hetrf_factor, Section::hesv }, // tested numerically
     { "",                   nullptr,        Section::newline },
 
     { "hetrs",              test_hetrs,     Section::hesv }, // tested via LAPACKE
@@ -238,6 +248,8 @@ std::vector< testsweeper::routines_t > routines = {
     { "gelsd",              test_gelsd,     Section::gels }, // TODO: Segfaults for some Z sizes. src/gelsd.cc:275 lrwork_ too small?
     { "gelss",              test_gelss,     Section::gels }, // tested via LAPACKE using gcc/MKL TODO rcond=n
     { "getsls",             test_getsls,    Section::gels }, // tested via LAPACKE using gcc/MKL
+    { "gels-stream",        test_gels_stream, Section::gels }, // tested numerically
+    { "factor-geqrf",       test_geqrf_factor, Section::gels }, // tested numerically
     { "",                   nullptr,        Section::newline },
 
     { "gglse",              test_gglse,     Section::gels }, // tested via LAPACKE using gcc/MKL
@@ -248,6 +260,8 @@ std::vector< testsweeper::routines_t > routines = {
     // QR, LQ, RQ, QL
     { "geqr",               test_geqr,      Section::qr }, // tested numerically
     { "geqrf",              test_geqrf,     Section::qr }, // tested numerically
+    { "geqp3-rand",         test_geqp3_rand, Section::qr }, // tested numerically
+    { "geqrf-update",       test_geqrf_update, Section::qr }, // tested numerically
     { "gelqf",              test_gelqf,     Section::qr }, // tested numerically
     { "geqlf",              test_geqlf,     Section::qr }, // tested numerically
     { "gerqf",              test_gerqf,     Section::qr }, // tested numerically; R, Q are full sizeof(A), could be smaller
@@ -270,6 +284,7 @@ std::vector< testsweeper::routines_t > routines = {
 
     { "orhr_col",           test_orhr_col,  Section::qr },
     { "unhr_col",           test_unhr_col,  Section::qr },
+    { "getsqrhrt",          test_getsqrhrt, Section::qr }, // tested numerically
     { "",                   nullptr,        Section::newline },
 
     //{ "unmqr",              test_unmqr,     Section::qr }, // TODO segfaults
@@ -296,17 +311,23 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // symmetric/Hermitian eigenvalues
     { "heev",               test_heev,      Section::heev }, // tested via LAPACKE
+    { "heev-2stage",        test_heev_2stage, Section::heev },
     { "hpev",               test_hpev,      Section::heev }, // tested via LAPACKE
     { "hbev",               test_hbev,      Section::heev }, // tested via LAPACKE
     { "sturm",              test_sturm,     Section::heev },
+    { "sturm-bisect",       test_sturm_bisect, Section::heev },
     { "",                   nullptr,        Section::newline },
 
     { "heevx",              test_heevx,     Section::heev }, // tested via LAPACKE
+    { "heevx-slice",        test_heevx_slice, Section::heev },
     { "hpevx",              test_hpevx,     Section::heev }, // tested via LAPACKE
     { "hbevx",              test_hbevx,     Section::heev }, // tested via LAPACKE
     { "",                   nullptr,        Section::newline },
 
     { "heevd",              test_heevd,     Section::heev }, // tested via LAPACKE using gcc/MKL
+    { "heevd-qdwh",         test_heevd_qdwh, Section::heev },
+    { "heevd-2stage",       test_heevd_2stage, Section::heev },
+    { "heev-subspace",      test_heev_subspace, Section::heev },
     { "hpevd",              test_hpevd,     Section::heev }, // tested via LAPACKE using gcc/MKL
     { "hbevd",              test_hbevd,     Section::heev }, // tested via LAPACKE using gcc/MKL
     { "",                   nullptr,        Section::newline },
@@ -388,6 +409,9 @@ std::vector< testsweeper::routines_t > routines = {
 
     { "gesdd",              test_gesdd,         Section::svd },
     //{ "gesdd_2stage",       test_gesdd_2stage,  Section::svd }, // TODO No src
+    { "gesvd-rand",         test_gesvd_rand,    Section::svd },
+    { "gesvd-qdwh",         test_gesvd_qdwh,    Section::svd },
+    { "qdwh",               test_qdwh,          Section::svd },
     { "",                   nullptr,            Section::newline },
 
     { "gesvdx",             test_gesvdx,        Section::svd }, // tested via LAPACKE using gcc/MKL
@@ -406,6 +430,20 @@ std::vector< testsweeper::routines_t > routines = {
     { "laswp",              test_laswp,     Section::aux },
     { "",                   nullptr,        Section::newline },
 
+    // auxiliary: workspace
+    { "arena",              test_arena,     Section::aux },
+    { "workspace",          test_workspace, Section::aux },
+    { "query-cache",        test_query_cache, Section::aux },
+    { "",                   nullptr,        Section::newline },
+
+    // auxiliary: instrumentation
+    { "instrument",         test_instrument, Section::aux },
+    { "",                   nullptr,        Section::newline },
+
+    // auxiliary: 32-bit pivots
+    { "ipiv32",             test_ipiv32,    Section::aux },
+    { "",                   nullptr,        Section::newline },
+
     // auxiliary: Householder
     { "larfg",              test_larfg,     Section::aux_householder },
     { "larfgp",             test_larfgp,    Section::aux_householder },
@@ -456,6 +494,21 @@ std::vector< testsweeper::routines_t > routines = {
     { "symv",               test_symv,      Section::blas2 },
     { "",                   nullptr,        Section::newline },
 
+    //----------------------------------------
+    // batched host functions
+    { "batch-getrf",        test_getrf_batch,   Section::batch },
+    { "batch-potrf",        test_potrf_batch,   Section::batch },
+    { "batch-geqrf",        test_geqrf_batch,   Section::batch },
+    { "batch-heevd",        test_heevd_batch,   Section::batch },
+    { "batch-sturm",        test_sturm_batch,   Section::batch },
+    { "",                   nullptr,            Section::newline },
+
+    // tiny matrices, lapack::fixed< n > vs. Fortran
+    { "fixed-getrf",        test_getrf_fixed,   Section::batch },
+    { "fixed-potrf",        test_potrf_fixed,   Section::batch },
+    { "fixed-geqrf",        test_geqrf_fixed,   Section::batch },
+    { "",                   nullptr,            Section::newline },
+
     //----------------------------------------
     // GPU device functions
     { "dev-potrf",          test_potrf_device,  Section::gpu },
@@ -488,6 +541,8 @@ Params::Params():
     repeat    ( "repeat",  0,    ParamType::Value,   1,   1, 1000, "number of times to repeat each test" ),
     verbose   ( "verbose", 0,    ParamType::Value,   0,   0,   10, "verbose level" ),
     cache     ( "cache",   0,    ParamType::Value,  20,   1, 1024, "total cache size, in MiB" ),
+    bench     ( "bench",   0,    ParamType::Value, 'n', "ny",  "benchmark: report min, median, p95 time over repeats, each with cache flushed" ),
+    bench_out ( "bench-out", 0,  ParamType::Value,  "",        "with bench, append results to file: CSV if name ends in .csv, else JSON Lines" ),
 
     // ----- routine parameters
     //          name,      w,    type,            def,                    char2enum,         enum2char,         enum2str,         help
@@ -518,6 +573,9 @@ Params::Params():
                 "matrix type: g=general, l=lower, u=upper, h=Hessenberg, z=band-general, b=band-lower, q=band-upper" ),
     factored  ( "factored",    11,    ParamType::List, lapack::Factored::NotFactored, lapack::char2factored, lapack::factored2char, lapack::factored2str, "f=Factored, n=NotFactored, e=Equilibrate" ),
     equed     ( "equed",   9,    ParamType::List, lapack::Equed::None, lapack::char2equed, lapack::equed2char, lapack::equed2str, "n=None, r=Row, c=Col, b=Both, y=Yes" ),
+    method    ( "method",  6,    ParamType::List, lapack::Method::Vendor, lapack::char2method, lapack::method2char, lapack::method2str, "getrf, potrf, potrs, potri, posv, heev_2stage, heevd_2stage implementation: v=vendor LAPACK, n=native LAPACK++ (uses nb; for potrf, etc., nb=0 is automatic)" ),
+    pivot     ( "pivot",   6,    ParamType::List, lapack::LDLPivot::BunchKaufman, lapack::char2ldlpivot, lapack::ldlpivot2char, lapack::ldlpivot2str, "LDLFactor pivoting: b=Bunch-Kaufman, r=rook, k=rook (rk), a=Aasen" ),
+    sketch    ( "sketch",  8,    ParamType::List, lapack::Sketch::Gaussian, lapack::char2sketch, lapack::sketch2char, lapack::sketch2str, "gesvd_rand, geqp3_rand random sketch: g=Gaussian, h=SRHT" ),
 
     //          name,      w, p, type,            def,   min,     max, help
     dim       ( "dim",     6,    ParamType::List,          0, 1000000, "m by n by k dimensions" ),
@@ -530,6 +588,7 @@ Params::Params():
     ku        ( "ku",      6,    ParamType::List, 100,     0, 1000000, "upper bandwidth" ),
     nrhs      ( "nrhs",    6,    ParamType::List,  10,     0, 1000000, "number of right hand sides" ),
     nb        ( "nb",      4,    ParamType::List,  64,     0, 1000000, "block size" ),
+    rank      ( "rank",    6,    ParamType::List,  -1,    -1, 1000000, "rank of A, for rank-deficient tests (qdwh, gesvd_qdwh); -1 is full rank" ),
     vl        ( "vl",      7, 2, ParamType::List, -inf, -inf,     inf, "lower bound of eigen/singular values to find" ),
     vu        ( "vu",      7, 2, ParamType::List,  inf, -inf,     inf, "upper bound of eigen/singular values to find" ),
 
@@ -548,6 +607,7 @@ Params::Params():
     incy      ( "incy",    4,    ParamType::List,   1, -1000,    1000, "stride of y vector" ),
     align     ( "align",   0,    ParamType::List,   1,     1,    1024, "column alignment (sets lda, ldb, etc. to multiple of align)" ),
     device    ( "device",  6,    ParamType::List,   0,     0,     100, "device id" ),
+    batch     ( "batch",   6,    ParamType::List, 100,     0, 1000000, "number of matrices in batch" ),
 
     // ----- output parameters
     // min, max are ignored
@@ -608,6 +668,8 @@ Params::Params():
     repeat();
     verbose();
     cache();
+    bench();
+    bench_out();
 
     // routine's parameters are marked by the test routine; see main
 }
@@ -776,6 +838,8 @@ int main( int argc, char** argv )
 
         // run tests
         int repeat = params.repeat();
+        bool bench = (params.bench() == 'y');
+        Bench bench_stats( routine );
         testsweeper::DataType last = params.datatype();
         std::string matrix, matrixB;
         double cond = 0, condD = 0, condB = 0, condD_B = 0;
@@ -801,8 +865,12 @@ int main( int argc, char** argv )
                 params.print();
                 fflush( stdout );
                 status += ! params.okay();
+                if (bench)
+                    bench_stats.add( params );
                 params.reset_output();
             }
+            if (bench)
+                bench_stats.finish( params );
             if (repeat > 1) {
                 printf( "\n" );
             }
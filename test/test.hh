@@ -50,6 +50,8 @@ public:
     testsweeper::ParamInt    repeat;
     testsweeper::ParamInt    verbose;
     testsweeper::ParamInt    cache;
+    testsweeper::ParamChar   bench;
+    testsweeper::ParamString bench_out;
 
     // ----- routine parameters
     testsweeper::ParamEnum< testsweeper::DataType > datatype;
@@ -74,6 +76,9 @@ public:
     testsweeper::ParamEnum< lapack::MatrixType > matrixtype;
     testsweeper::ParamEnum< lapack::Factored >  factored;
     testsweeper::ParamEnum< lapack::Equed >     equed;
+    testsweeper::ParamEnum< lapack::Method >    method;
+    testsweeper::ParamEnum< lapack::LDLPivot >  pivot;  // LDLFactor
+    testsweeper::ParamEnum< lapack::Sketch >    sketch; // gesvd_rand, geqp3_rand
 
     testsweeper::ParamInt3   dim;
     testsweeper::ParamInt    i;
@@ -85,6 +90,7 @@ public:
     testsweeper::ParamInt    ku;
     testsweeper::ParamInt    nrhs;
     testsweeper::ParamInt    nb;
+    testsweeper::ParamInt    rank;   // qdwh, gesvd_qdwh
     testsweeper::ParamDouble vl;
     testsweeper::ParamDouble vu;
     testsweeper::ParamInt    il;
@@ -99,6 +105,7 @@ public:
     testsweeper::ParamInt    incy;
     testsweeper::ParamInt    align;
     testsweeper::ParamInt    device;
+    testsweeper::ParamInt    batch;
 
     // ----- output parameters
     testsweeper::ParamScientific error;
@@ -176,6 +183,7 @@ void require_( bool cond, const char* condstr, const char* file, int line )
 // LAPACK
 // LU, general
 void test_gesv  ( Params& params, bool run );
+void test_gesv_mixed( Params& params, bool run );
 void test_gesvx ( Params& params, bool run );
 void test_getrf ( Params& params, bool run );
 void test_getri ( Params& params, bool run );
@@ -204,8 +212,11 @@ void test_gtequ ( Params& params, bool run );
 
 // Cholesky
 void test_posv  ( Params& params, bool run );
+void test_posv_mixed( Params& params, bool run );
 void test_posvx ( Params& params, bool run );
 void test_potrf ( Params& params, bool run );
+void test_potrf_ooc( Params& params, bool run );
+void test_potrf_update( Params& params, bool run );
 void test_potri ( Params& params, bool run );
 void test_potrs ( Params& params, bool run );
 void test_pocon ( Params& params, bool run );
@@ -298,12 +309,15 @@ void test_gelsy ( Params& params, bool run );
 void test_gelsd ( Params& params, bool run );
 void test_gelss ( Params& params, bool run );
 void test_getsls( Params& params, bool run );
+void test_gels_stream( Params& params, bool run );
 void test_gglse ( Params& params, bool run );
 void test_ggglm ( Params& params, bool run );
 
 // QR, LQ, QL, RQ
 void test_geqr  ( Params& params, bool run );
 void test_geqrf ( Params& params, bool run );
+void test_geqp3_rand( Params& params, bool run );
+void test_geqrf_update( Params& params, bool run );
 void test_gelqf ( Params& params, bool run );
 void test_geqlf ( Params& params, bool run );
 void test_gerqf ( Params& params, bool run );
@@ -321,6 +335,7 @@ void test_ungrq ( Params& params, bool run );
 
 void test_orhr_col( Params& params, bool run );
 void test_unhr_col( Params& params, bool run );
+void test_getsqrhrt( Params& params, bool run );
 
 void test_unmqr ( Params& params, bool run );
 void test_unmlq ( Params& params, bool run );
@@ -341,11 +356,17 @@ void test_tprfb ( Params& params, bool run );
 
 // symmetric eigenvalues
 void test_heev  ( Params& params, bool run );
+void test_heev_2stage ( Params& params, bool run );
 void test_heevx ( Params& params, bool run );
+void test_heevx_slice ( Params& params, bool run );
 void test_heevd ( Params& params, bool run );
+void test_heevd_qdwh ( Params& params, bool run );
+void test_heevd_2stage ( Params& params, bool run );
+void test_heev_subspace ( Params& params, bool run );
 void test_heevr ( Params& params, bool run );
 void test_hetrd ( Params& params, bool run );
 void test_sturm ( Params& params, bool run );
+void test_sturm_bisect( Params& params, bool run );
 void test_ungtr ( Params& params, bool run );
 void test_unmtr ( Params& params, bool run );
 
@@ -410,6 +431,9 @@ void test_ggesx ( Params& params, bool run );
 void test_gesvd ( Params& params, bool run );
 void test_gesdd ( Params& params, bool run );
 void test_gesvdx( Params& params, bool run );
+void test_gesvd_rand( Params& params, bool run );
+void test_gesvd_qdwh( Params& params, bool run );
+void test_qdwh  ( Params& params, bool run );
 void test_gesvd_2stage ( Params& params, bool run );
 void test_gesdd_2stage ( Params& params, bool run );
 void test_gesvdx_2stage( Params& params, bool run );
@@ -422,6 +446,17 @@ void test_laed4 ( Params& params, bool run );
 void test_laset ( Params& params, bool run );
 void test_laswp ( Params& params, bool run );
 
+// auxiliary - workspace
+void test_arena ( Params& params, bool run );
+void test_workspace ( Params& params, bool run );
+void test_query_cache ( Params& params, bool run );
+
+// auxiliary - instrumentation
+void test_instrument ( Params& params, bool run );
+
+// auxiliary - 32-bit pivots
+void test_ipiv32 ( Params& params, bool run );
+
 // auxiliary - Householder
 void test_larfg ( Params& params, bool run );
 void test_larfgp( Params& params, bool run );
@@ -464,6 +499,24 @@ void test_lagtr ( Params& params, bool run );
 void test_syr   ( Params& params, bool run );
 void test_symv  ( Params& params, bool run );
 
+//----------------------------------------
+// batched host functions
+void test_getrf_batch ( Params& params, bool run );
+void test_potrf_batch ( Params& params, bool run );
+void test_geqrf_batch ( Params& params, bool run );
+void test_heevd_batch ( Params& params, bool run );
+void test_sturm_batch ( Params& params, bool run );
+void test_getrf_fixed ( Params& params, bool run );
+void test_potrf_fixed ( Params& params, bool run );
+void test_geqrf_fixed ( Params& params, bool run );
+
+//----------------------------------------
+// factorization objects
+void test_getrf_factor ( Params& params, bool run );
+void test_potrf_factor ( Params& params, bool run );
+void test_hetrf_factor ( Params& params, bool run );
+void test_geqrf_factor ( Params& params, bool run );
+
 //----------------------------------------
 // GPU device functions
 void test_potrf_device ( Params& params, bool run );
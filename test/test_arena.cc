@@ -0,0 +1,184 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/arena.hh"
+#include "../src/NoConstructAllocator.hh"
+
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Checks the workspace arena behind lapack::vector temporaries:
+// out-of-order releases, overflow to the heap, release on another thread,
+// and temporaries that outlive the thread that allocated them.
+template< typename scalar_t >
+void test_arena_work( Params& params, bool run )
+{
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t verbose = params.verbose();
+
+    if (! run)
+        return;
+
+    if (n < 1) {
+        params.msg() = "skipping: requires n >= 1";
+        return;
+    }
+
+    // ---------- setup
+    // Arena bytes for count elements: 64-byte header, rounded to 64 bytes.
+    auto bytes = []( int64_t count ) {
+        return 64 + (count*sizeof( scalar_t ) + 63) / 64 * 64;
+    };
+    size_t block = bytes( n );
+    size_t arena_size = 4 * block;
+    int64_t nbig = arena_size / sizeof( scalar_t );  // never fits
+    bool okay = true;
+    auto check = [&]( bool cond, char const* msg ) {
+        if (! cond) {
+            if (verbose >= 1)
+                printf( "failed: %s\n", msg );
+            okay = false;
+        }
+    };
+
+    double time = testsweeper::get_wtime();
+
+    // ---------- without arena, heap only
+    lapack::arena_set_size( 0 );
+    {
+        lapack::vector< scalar_t > a( n );
+        check( lapack::arena_size() == 0, "no arena size" );
+        check( lapack::arena_used() == 0, "no arena used" );
+    }
+
+    lapack::arena_set_size( arena_size );
+    check( lapack::arena_size() >= arena_size, "size" );
+
+    // ---------- LIFO and out-of-order releases
+    {
+        auto a = new lapack::vector< scalar_t >( n );
+        auto b = new lapack::vector< scalar_t >( n );
+        auto c = new lapack::vector< scalar_t >( n );
+        check( lapack::arena_used() == 3*block, "used 3 blocks" );
+        check( lapack::arena_overflows() == 0, "no overflows" );
+        delete b;  // out of order: held until c is released
+        check( lapack::arena_used() == 3*block, "used after middle release" );
+        delete c;  // reclaims c and b
+        check( lapack::arena_used() == block, "used after top release" );
+        b = new lapack::vector< scalar_t >( n );
+        check( lapack::arena_used() == 2*block, "used after reuse" );
+        delete a;
+        check( lapack::arena_used() == 2*block, "used after bottom release" );
+        delete b;
+        check( lapack::arena_used() == 0, "used after all released" );
+        check( lapack::arena_high_water() == 3*block, "high water" );
+    }
+
+    // ---------- overflow to the heap
+    lapack::arena_reset();
+    {
+        lapack::vector< scalar_t > a( n );
+        lapack::vector< scalar_t > big( nbig );
+        check( lapack::arena_overflows() == 1, "one overflow" );
+        check( lapack::arena_used() == block, "overflow not in arena" );
+        check( lapack::arena_high_water() == block + bytes( nbig ),
+               "overflow high water" );
+        big[ nbig - 1 ] = 1;
+        a[ n - 1 ] = 1;
+    }
+    check( lapack::arena_used() == 0, "used after overflow" );
+    lapack::arena_reset();
+    check( lapack::arena_high_water() == 0, "high water after reset" );
+    check( lapack::arena_overflows() == 0, "overflows after reset" );
+
+    // ---------- release on another thread, which has its own arena
+    {
+        auto a = new lapack::vector< scalar_t >( n );
+        auto big = new lapack::vector< scalar_t >( nbig );  // overflow
+        size_t other_used = 1;
+        std::thread worker( [&]() {
+            lapack::arena_set_size( arena_size );
+            lapack::vector< scalar_t > w( n );
+            delete big;
+            delete a;
+            other_used = lapack::arena_used();
+        } );
+        worker.join();
+        check( other_used == block, "other thread's arena unaffected" );
+        check( lapack::arena_used() == 0, "used after remote release" );
+        lapack::arena_reset();
+        check( lapack::arena_high_water() == 0, "overflow after remote release" );
+    }
+
+    // ---------- temporary outlives the thread that allocated it
+    {
+        lapack::vector< scalar_t >* a = nullptr;
+        std::thread worker( [&]() {
+            lapack::arena_set_size( arena_size );
+            a = new lapack::vector< scalar_t >( n );
+            for (int64_t i = 0; i < n; ++i)
+                (*a)[ i ] = scalar_t( i );
+        } );
+        worker.join();
+        bool same = true;
+        for (int64_t i = 0; i < n; ++i)
+            same = same && ((*a)[ i ] == scalar_t( i ));
+        check( same, "data after owner exited" );
+        delete a;  // deletes the detached arena
+    }
+
+    // ---------- resizing while in use throws
+    {
+        lapack::vector< scalar_t > a( n );
+        assert_throw( lapack::arena_set_size( 0 ), lapack::Error );
+    }
+
+    // ---------- a wrapper's temporaries are released on return
+    {
+        lapack::arena_reset();
+        std::vector< scalar_t > A( n*n );
+        std::vector< int64_t > ipiv( n );
+        for (int64_t i = 0; i < n; ++i)
+            A[ i + i*n ] = 1;
+        lapack::getrf( n, n, &A[0], n, &ipiv[0] );
+        check( lapack::arena_used() == 0, "used after getrf" );
+    }
+
+    time = testsweeper::get_wtime() - time;
+    lapack::arena_set_size( 0 );
+
+    params.time() = time;
+    params.okay() = okay;
+}
+
+// -----------------------------------------------------------------------------
+void test_arena( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_arena_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_arena_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_arena_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_arena_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,190 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "check_gels.hh"
+
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#if LAPACK_VERSION >= 30400  // >= 3.4
+
+// -----------------------------------------------------------------------------
+/// Writes the m-by-n matrix A to path, in the given layout.
+template< typename scalar_t >
+void write_matrix(
+    std::string const& path, blas::Layout layout,
+    int64_t m, int64_t n, scalar_t const* A, int64_t lda )
+{
+    FILE* file = fopen( path.c_str(), "wb" );
+    if (file == nullptr)
+        throw std::runtime_error( "can't open " + path );
+    if (layout == blas::Layout::ColMajor) {
+        for (int64_t j = 0; j < n; ++j)
+            fwrite( &A[ j*lda ], sizeof( scalar_t ), m, file );
+    }
+    else {
+        for (int64_t i = 0; i < m; ++i)
+            for (int64_t j = 0; j < n; ++j)
+                fwrite( &A[ i + j*lda ], sizeof( scalar_t ), 1, file );
+    }
+    fclose( file );
+}
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_gels_stream_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    blas::Layout layout = params.layout();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t mb = params.nb();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.error2();
+
+    if (! run)
+        return;
+
+    if (m < n) {
+        params.msg() = "skipping: requires m >= n";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldb = lda;
+    int64_t ldr = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+    size_t size_R = (size_t) ldr * n;
+
+    std::vector< scalar_t > A_ref( size_A );
+    std::vector< scalar_t > B_ref( size_B );
+    std::vector< scalar_t > R_tst( size_R );
+    std::vector< scalar_t > X_tst( size_B );
+    std::vector< real_t > resid_tst( nrhs );
+
+    lapack::generate_matrix( params.matrix, m, n, &A_ref[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_ref.size(), &B_ref[0] );
+
+    // A and B are read back from files, memory-mapped.
+    auto dir = std::filesystem::temp_directory_path();
+    std::string path_A = (dir / "lapackpp_gels_stream_A.bin").string();
+    std::string path_B = (dir / "lapackpp_gels_stream_B.bin").string();
+    write_matrix( path_A, layout, m, n, &A_ref[0], lda );
+    write_matrix( path_B, layout, m, nrhs, &B_ref[0], ldb );
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    auto read = lapack::mmap_row_reader< scalar_t >(
+        layout, m, n, nrhs, path_A, path_B );
+    int64_t info_tst = lapack::gels_stream(
+        n, nrhs, read, &R_tst[0], ldr, &X_tst[0], ldb, &resid_tst[0], mb );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::gels_stream returned error %lld\n", llong( info_tst ) );
+    }
+    read = nullptr;  // unmap
+    std::remove( path_A.c_str() );
+    std::remove( path_B.c_str() );
+
+    params.time() = time;
+
+    if (params.check() == 'y') {
+        // ---------- check error
+        real_t error[2];
+        check_gels( false, lapack::Op::NoTrans, m, n, nrhs,
+                    &A_ref[0], lda, // original A
+                    &X_tst[0], ldb, // X
+                    &B_ref[0], ldb, // original B
+                    error );
+
+        // resid should be || B - A X ||, up to rounding.
+        real_t error_resid = 0;
+        std::vector< scalar_t > Rs = B_ref;
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                    m, nrhs, n,
+                    -1.0, &A_ref[0], lda, &X_tst[0], ldb,
+                     1.0, &Rs[0], ldb );
+        for (int64_t j = 0; j < nrhs; ++j) {
+            real_t r = blas::nrm2( m, &Rs[ j*ldb ], 1 );
+            real_t bnorm = blas::nrm2( m, &B_ref[ j*ldb ], 1 );
+            if (bnorm > 0)
+                error_resid = blas::max( error_resid, std::abs( resid_tst[ j ] - r ) / bnorm );
+        }
+
+        params.error()  = error[0];
+        params.error2() = blas::max( error[1], error_resid );
+        params.okay() = (info_tst == 0) && (error[0] < tol)
+                        && (params.error2() < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference, in memory
+        std::vector< scalar_t > A_tmp = A_ref;
+        std::vector< scalar_t > B_tmp = B_ref;
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::gels( lapack::Op::NoTrans, m, n, nrhs,
+                                         &A_tmp[0], lda, &B_tmp[0], ldb );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::gels returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+    }
+}
+
+#endif  // LAPACK >= 3.4
+
+// -----------------------------------------------------------------------------
+void test_gels_stream( Params& params, bool run )
+{
+#if LAPACK_VERSION >= 30400  // >= 3.4
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gels_stream_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gels_stream_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gels_stream_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gels_stream_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+#else
+    fprintf( stderr, "gels_stream requires LAPACK >= 3.4.0\n\n" );
+    exit(0);
+#endif
+}
@@ -0,0 +1,208 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/randomized.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_geqp3_rand_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Sketch sketch = params.sketch();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.gflops();
+    params.ortho();
+    params.error2();
+    params.error2.name( "R ratio" );
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t minmn = blas::min( m, n );
+    size_t size_A = (size_t) lda * n;
+    size_t size_tau = (size_t) blas::max( 1, minmn );
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+    std::vector< scalar_t > tau_tst( size_tau );
+    std::vector< scalar_t > tau_ref( size_tau );
+    std::vector< int64_t > jpvt_tst( blas::max( 1, n ), 0 );
+    std::vector< int64_t > jpvt_ref( blas::max( 1, n ), 0 );
+    int64_t iseed[ 4 ] = { 0, 0, 0, 1 };
+
+    lapack::generate_matrix( params.matrix, m, n, &A_tst[0], lda );
+    A_ref = A_tst;
+
+    if (verbose >= 2) {
+        printf( "A = " );
+        print_matrix( m, n, &A_tst[0], lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Sketch;
+        assert_throw( lapack::geqp3_rand( -1,  n, &A_tst[0], lda, &jpvt_tst[0], &tau_tst[0], iseed ), lapack::Error );
+        assert_throw( lapack::geqp3_rand(  m, -1, &A_tst[0], lda, &jpvt_tst[0], &tau_tst[0], iseed ), lapack::Error );
+        assert_throw( lapack::geqp3_rand(  m,  n, &A_tst[0], m-1, &jpvt_tst[0], &tau_tst[0], iseed ), lapack::Error );
+        assert_throw( lapack::geqp3_rand(  m,  n, &A_tst[0], lda, &jpvt_tst[0], &tau_tst[0], iseed, 0 ), lapack::Error );
+        assert_throw( lapack::geqp3_rand(  m,  n, &A_tst[0], lda, &jpvt_tst[0], &tau_tst[0], iseed, nb, -1 ), lapack::Error );
+        assert_throw( lapack::geqp3_rand(  m,  n, &A_tst[0], lda, &jpvt_tst[0], &tau_tst[0], iseed, nb, 8, Sketch(0) ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::geqp3_rand( m, n, &A_tst[0], lda,
+                                           &jpvt_tst[0], &tau_tst[0], iseed,
+                                           nb, 8, sketch );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::geqp3_rand returned error %lld\n", llong( info_tst ) );
+    }
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::geqrf( m, n );
+    params.gflops() = gflop / time;
+
+    if (verbose >= 2) {
+        printf( "jpvt = [" );
+        for (int64_t j = 0; j < n; ++j)
+            printf( " %lld", llong( jpvt_tst[ j ] ) );
+        printf( " ];\n" );
+    }
+
+    if (params.check() == 'y') {
+        // ---------- check error
+        // As in test_geqrf, with A P in place of A.
+        int64_t ldq = m;
+        std::vector< scalar_t > Q( m * minmn ); // m by k
+        int64_t ldr = blas::max( 1, minmn );
+        std::vector< scalar_t > R( ldr * n );   // k by n
+        std::vector< scalar_t > AP( size_A );   // A P
+
+        lapack::lacpy( lapack::MatrixType::Lower, m, minmn, &A_tst[0], lda, &Q[0], ldq );
+        lapack::ungqr( m, minmn, minmn, &Q[0], ldq, &tau_tst[0] );
+
+        lapack::laset( lapack::MatrixType::Lower, minmn, n, 0.0, 0.0, &R[0], ldr );
+        lapack::lacpy( lapack::MatrixType::Upper, minmn, n, &A_tst[0], lda, &R[0], ldr );
+
+        // AP( :, j ) = A( :, jpvt( j ) ); check jpvt is a permutation
+        std::vector< int64_t > count( n, 0 );
+        bool perm_okay = true;
+        for (int64_t j = 0; j < n; ++j) {
+            int64_t jj = jpvt_tst[ j ] - 1;
+            if (jj < 0 || jj >= n || count[ jj ]++ > 0) {
+                perm_okay = false;
+                break;
+            }
+            blas::copy( m, &A_ref[ jj*lda ], 1, &AP[ j*lda ], 1 );
+        }
+
+        real_t error1 = 1;
+        real_t error2 = 1;
+        if (perm_okay) {
+            // Compute R - Q'*A P
+            blas::gemm( blas::Layout::ColMajor,
+                        blas::Op::ConjTrans, blas::Op::NoTrans, minmn, n, m,
+                        -1.0, &Q[0], ldq, &AP[0], lda, 1.0, &R[0], ldr );
+
+            real_t Anorm = lapack::lange( lapack::Norm::One, m, n, &A_ref[0], lda );
+            real_t resid1 = lapack::lange( lapack::Norm::One, minmn, n, &R[0], ldr );
+            error1 = 0;
+            if (Anorm > 0)
+                error1 = resid1 / ( n * Anorm );
+
+            // Compute I - Q'*Q
+            lapack::laset( lapack::MatrixType::Upper, minmn, minmn, 0.0, 1.0, &R[0], ldr );
+            blas::herk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::ConjTrans,
+                        minmn, m, -1.0, &Q[0], ldq, 1.0, &R[0], ldr );
+            real_t resid2 = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper, minmn, &R[0], ldr );
+            error2 = ( resid2 / n );
+        }
+
+        params.error() = error1;
+        params.ortho() = error2;
+        params.okay() = (error1 < tol) && (error2 < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::geqp3( m, n, &A_ref[0], lda,
+                                          &jpvt_ref[0], &tau_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::geqp3 returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check rank revealing compared to reference
+        // Pivots differ, but |R(i,i)| should be within a small factor of
+        // geqp3's, over the numerical rank.
+        real_t ratio = 0;
+        if (minmn > 0) {
+            real_t r0 = std::abs( A_ref[ 0 ] );
+            for (int64_t i = 0; i < minmn; ++i) {
+                real_t rii_tst = std::abs( A_tst[ i + i*lda ] );
+                real_t rii_ref = std::abs( A_ref[ i + i*lda ] );
+                if (rii_ref <= std::sqrt( eps ) * r0)
+                    break;
+                ratio = blas::max( ratio, rii_tst / rii_ref, rii_ref / rii_tst );
+            }
+        }
+        params.error2() = ratio;
+        params.okay() = params.okay() && (ratio < 10);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_geqp3_rand( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_geqp3_rand_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqp3_rand_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqp3_rand_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqp3_rand_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
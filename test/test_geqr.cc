@@ -10,6 +10,7 @@
 #include "error.hh"
 #include "lapacke_wrappers.hh"
 
+#include <limits>
 #include <vector>
 
 #if LAPACK_VERSION >= 30700  // >= 3.7.0
@@ -24,11 +25,21 @@ void test_geqr_work( Params& params, bool run )
     int64_t m = params.dim.m();
     int64_t n = params.dim.n();
     int64_t align = params.align();
+    lapack::Method method = params.method();
+    int64_t nb = params.nb();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
 
     // mark non-standard output values
     params.ref_time();
     params.ref_gflops();
     params.gflops();
+    if (method == lapack::Method::Native) {
+        params.ortho();
+        params.error2();
+        params.error2.name( "gemqr" );
+    }
 
     if (! run)
         return;
@@ -41,6 +52,11 @@ void test_geqr_work( Params& params, bool run )
     std::vector< scalar_t > A_ref( size_A );
     std::vector< scalar_t > T_tst( 5 );  // 5 is minimum
 
+    // select implementation of lapack::geqr; nb is the row block size
+    lapack::geqr_set_method( method );
+    if (method == lapack::Method::Native)
+        lapack::geqr_set_block_size( nb );
+
     // query for T size (pass tsize = -1 for optimal, tsize = -2 for minimum)
     int64_t info_tst = lapack::geqr( m, n, &A_tst[0], lda, &T_tst[0], -1 );
     if (info_tst != 0) {
@@ -61,6 +77,7 @@ void test_geqr_work( Params& params, bool run )
     double time = testsweeper::get_wtime();
     info_tst = lapack::geqr( m, n, &A_tst[0], lda, &T_tst[0], tsize );
     time = testsweeper::get_wtime() - time;
+    lapack::geqr_set_method( lapack::Method::Vendor );
     if (info_tst != 0) {
         fprintf( stderr, "lapack::geqr returned error %lld\n", llong( info_tst ) );
     }
@@ -69,7 +86,104 @@ void test_geqr_work( Params& params, bool run )
     double gflop = lapack::Gflop< scalar_t >::geqrf( m, n );
     params.gflops() = gflop / time;
 
-    if (params.ref() == 'y' || params.check() == 'y') {
+    // The native TSQR's T has a different layout than LAPACK's, and its
+    // R may differ in rounding, so check it numerically, applying Q with
+    // gemqr, as in lapack/TESTING/LIN/zqrt01.f.
+    bool native = (method == lapack::Method::Native && m >= n);
+    if (native && params.check() == 'y') {
+        int64_t ldq = lda;
+        std::vector< scalar_t > Q( size_A );
+        std::vector< scalar_t > R( size_A );
+
+        // R = A - Q [ R; 0 ], with R in the upper triangle of A_tst
+        lapack::laset( lapack::MatrixType::General, m, n, 0.0, 0.0, &R[0], lda );
+        lapack::lacpy( lapack::MatrixType::Upper, n, n, &A_tst[0], lda, &R[0], lda );
+        lapack::gemqr( lapack::Side::Left, lapack::Op::NoTrans, m, n, n,
+                       &A_tst[0], lda, &T_tst[0], tsize, &R[0], lda );
+        for (int64_t j = 0; j < n; ++j)
+            for (int64_t i = 0; i < m; ++i)
+                R[ i + j*lda ] = A_ref[ i + j*lda ] - R[ i + j*lda ];
+
+        real_t Anorm = lapack::lange( lapack::Norm::One, m, n, &A_ref[0], lda );
+        real_t resid1 = lapack::lange( lapack::Norm::One, m, n, &R[0], lda );
+        real_t error1 = 0;
+        if (Anorm > 0)
+            error1 = resid1 / ( m * Anorm );
+
+        // Q = Q [ I; 0 ], then I - Q^H Q
+        lapack::laset( lapack::MatrixType::General, m, n, 0.0, 1.0, &Q[0], ldq );
+        lapack::gemqr( lapack::Side::Left, lapack::Op::NoTrans, m, n, n,
+                       &A_tst[0], lda, &T_tst[0], tsize, &Q[0], ldq );
+        lapack::laset( lapack::MatrixType::Upper, n, n, 0.0, 1.0, &R[0], lda );
+        blas::herk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::ConjTrans,
+                    n, m, -1.0, &Q[0], ldq, 1.0, &R[0], lda );
+        real_t resid2 = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                       n, &R[0], lda );
+        real_t error2 = resid2 / m;
+
+        // Check gemqr for each side and trans against the explicit
+        // m-by-m Q = Q I: for random C, compare op( Q ) C or C op( Q )
+        // with gemm. C is m-by-n for Left, n-by-m for Right.
+        lapack::Op trans_h = blas::is_complex< scalar_t >::value
+                           ? lapack::Op::ConjTrans : lapack::Op::Trans;
+        int64_t ldqm = m;
+        std::vector< scalar_t > Qm( ldqm * m );
+        lapack::laset( lapack::MatrixType::General, m, m, 0.0, 1.0, &Qm[0], ldqm );
+        lapack::gemqr( lapack::Side::Left, lapack::Op::NoTrans, m, m, n,
+                       &A_tst[0], lda, &T_tst[0], tsize, &Qm[0], ldqm );
+        real_t error3 = 0;
+        for (auto side : { lapack::Side::Left, lapack::Side::Right }) {
+            for (auto trans : { lapack::Op::NoTrans, trans_h }) {
+                bool left = (side == lapack::Side::Left);
+                int64_t mc = left ? m : n;
+                int64_t nc = left ? n : m;
+                int64_t ldc = mc;
+                std::vector< scalar_t > C( ldc * nc ), QC( ldc * nc );
+                lapack::larnv( idist, iseed, C.size(), &C[0] );
+                if (left) {
+                    blas::gemm( blas::Layout::ColMajor, trans, blas::Op::NoTrans,
+                                m, nc, m, 1.0, &Qm[0], ldqm, &C[0], ldc,
+                                0.0, &QC[0], ldc );
+                }
+                else {
+                    blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, trans,
+                                mc, m, m, 1.0, &C[0], ldc, &Qm[0], ldqm,
+                                0.0, &QC[0], ldc );
+                }
+                real_t Cnorm = lapack::lange( lapack::Norm::One, mc, nc, &C[0], ldc );
+                lapack::gemqr( side, trans, mc, nc, n,
+                               &A_tst[0], lda, &T_tst[0], tsize, &C[0], ldc );
+                blas::axpy( C.size(), -1.0, &C[0], 1, &QC[0], 1 );
+                real_t resid3 = lapack::lange( lapack::Norm::One, mc, nc, &QC[0], ldc );
+                if (Cnorm > 0)
+                    error3 = blas::max( error3, resid3 / ( m * Cnorm ) );
+            }
+        }
+
+        params.error() = error1;
+        params.ortho() = error2;
+        params.error2() = error3;
+        params.okay() = (error1 < tol) && (error2 < tol) && (error3 < tol);
+    }
+
+    if (native && params.ref() == 'y') {
+        // ---------- run reference, for timing only
+        LAPACKE_geqr( m, n, &A_ref[0], lda, &T_ref[0], -1 );
+        int64_t tsize_ref = std::real( T_ref[0] );
+        T_ref.resize( tsize_ref );
+
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = LAPACKE_geqr( m, n, &A_ref[0], lda, &T_ref[0], tsize_ref );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "LAPACKE_geqr returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+    }
+    else if (! native && (params.ref() == 'y' || params.check() == 'y')) {
         // ---------- run reference
         testsweeper::flush_cache( params.cache() );
         time = testsweeper::get_wtime();
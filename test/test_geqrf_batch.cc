@@ -0,0 +1,137 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_geqrf_batch_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t minmn = blas::min( m, n );
+    size_t size_A = (size_t) lda * n;
+    size_t size_tau = (size_t) blas::max( 1, minmn );
+
+    std::vector< scalar_t > A_tst( size_A * batch );
+    std::vector< scalar_t > A_ref( size_A * batch );
+    std::vector< scalar_t > tau_tst( size_tau * batch );
+    std::vector< scalar_t > tau_ref( size_tau * batch );
+    std::vector< int64_t > info_tst( batch );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A_tst[ i*size_A ], lda );
+    }
+    A_ref = A_tst;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld, batch=%5lld\n",
+                llong( m ), llong( n ), llong( lda ), llong( batch ) );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::geqrf_strided_batch( -1,  n, &A_tst[0], lda, size_A, &tau_tst[0], size_tau, &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::geqrf_strided_batch(  m, -1, &A_tst[0], lda, size_A, &tau_tst[0], size_tau, &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::geqrf_strided_batch(  m,  n, &A_tst[0], m-1, size_A, &tau_tst[0], size_tau, &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::geqrf_strided_batch(  m,  n, &A_tst[0], lda, size_A, &tau_tst[0], size_tau, &info_tst[0],    -1 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::geqrf_strided_batch( m, n, &A_tst[0], lda, size_A,
+                                 &tau_tst[0], size_tau, &info_tst[0], batch );
+    time = testsweeper::get_wtime() - time;
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0) {
+            fprintf( stderr, "lapack::geqrf_strided_batch returned error %lld for matrix %lld\n",
+                     llong( info_tst[ i ] ), llong( i ) );
+        }
+    }
+
+    params.time() = time;
+    double gflop = batch * lapack::Gflop< scalar_t >::geqrf( m, n );
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference, looping over non-batched geqrf
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            int64_t info_ref = lapack::geqrf( m, n, &A_ref[ i*size_A ], lda,
+                                              &tau_ref[ i*size_tau ] );
+            if (info_ref != 0) {
+                fprintf( stderr, "lapack::geqrf returned error %lld for matrix %lld\n",
+                         llong( info_ref ), llong( i ) );
+            }
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        // ---------- check error compared to reference
+        real_t error = rel_error( A_tst, A_ref );
+        if (minmn > 0)
+            error += rel_error( tau_tst, tau_ref );
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_geqrf_batch( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_geqrf_batch_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrf_batch_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrf_batch_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrf_batch_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
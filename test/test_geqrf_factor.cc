@@ -0,0 +1,176 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "check_gels.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_geqrf_factor_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Op trans = params.trans();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.error2();
+    params.error3();
+
+    if (! run)
+        return;
+
+    if (m < n) {
+        params.msg() = "skipping: requires m >= n";
+        return;
+    }
+    if (blas::is_complex< scalar_t >::value && trans == lapack::Op::Trans) {
+        params.msg() = "skipping: invalid trans for complex";
+        return;
+    }
+
+    // ---------- setup
+    // B is m-by-nrhs; for trans = ConjTrans, only its first n rows are input.
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldb = lda;
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > B_ref( size_B );
+    std::vector< scalar_t > X_tst( size_B );
+
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_ref.size(), &B_ref[0] );
+    X_tst = B_ref;
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::QRFactor< scalar_t >( m, -1, &A[0], lda ), lapack::Error );
+        assert_throw( lapack::QRFactor< scalar_t >( n-1, n, &A[0], lda ), lapack::Error );
+        assert_throw( lapack::QRFactor< scalar_t >( m,  n, &A[0], m-1 ), lapack::Error );
+    }
+
+    // ---------- run test: factor once, solve with all columns at once
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::QRFactor< scalar_t > QR( m, n, &A[0], lda );
+    if (QR.info() == 0)
+        QR.solve( nrhs, &X_tst[0], ldb, trans );
+    time = testsweeper::get_wtime() - time;
+    if (QR.info() != 0) {
+        fprintf( stderr, "lapack::QRFactor returned error %lld\n", llong( QR.info() ) );
+    }
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::geqrf( m, n )
+                 + lapack::Gflop< scalar_t >::unmqr( lapack::Side::Left, m, nrhs, n )
+                 + blas::Gflop< scalar_t >::trsm( lapack::Side::Left, n, nrhs );
+    params.gflops() = gflop / time;
+
+    if (params.check() == 'y' && QR.info() == 0) {
+        // ---------- check error, as for gels
+        real_t error[2];
+        check_gels( false, trans, m, n, nrhs,
+                    &A[0], lda,     // original A
+                    &X_tst[0], ldb, // X
+                    &B_ref[0], ldb, // original B
+                    error );
+
+        // Column-by-column solves should agree with the batch solve.
+        std::vector< scalar_t > X_vec = B_ref;
+        for (int64_t j = 0; j < nrhs; ++j)
+            QR.solve( &X_vec[ j*ldb ], trans );
+        int64_t opAn = (trans == lapack::Op::NoTrans ? n : m);
+        real_t diff = 0, Xnorm = 0;
+        for (int64_t j = 0; j < nrhs; ++j) {
+            for (int64_t i = 0; i < opAn; ++i) {
+                diff  = blas::max( diff, std::abs( X_vec[ i + j*ldb ]
+                                                   - X_tst[ i + j*ldb ] ) );
+                Xnorm = blas::max( Xnorm, std::abs( X_tst[ i + j*ldb ] ) );
+            }
+        }
+        if (Xnorm > 0)
+            diff /= Xnorm;
+
+        // rcond should match trcon on R.
+        std::vector< scalar_t > QR_ref = A;
+        std::vector< scalar_t > tau_ref( n );
+        lapack::geqrf( m, n, &QR_ref[0], lda, &tau_ref[0] );
+        real_t rcond_ref;
+        lapack::trcon( lapack::Norm::One, lapack::Uplo::Upper,
+                       lapack::Diag::NonUnit, n, &QR_ref[0], lda, &rcond_ref );
+        real_t rcond_tst = QR.rcond();
+
+        params.error()  = error[0];
+        params.error2() = blas::max( error[1], diff );
+        params.error3() = std::abs( rcond_tst - rcond_ref ) / rcond_ref;
+        params.okay() = (error[0] < tol) && (params.error2() < tol)
+                        && (params.error3() < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference, gels
+        std::vector< scalar_t > A_tmp = A;
+        std::vector< scalar_t > X_ref = B_ref;
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::gels( trans, m, n, nrhs, &A_tmp[0], lda,
+                                         &X_ref[0], ldb );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::gels returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_geqrf_factor( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_geqrf_factor_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrf_factor_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrf_factor_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrf_factor_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
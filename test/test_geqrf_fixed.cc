@@ -0,0 +1,127 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "lapacke_wrappers.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Compares lapack::geqrf, which dispatches tiny matrices to lapack::fixed<n>,
+// with the Fortran geqrf, over batch matrices so times are measurable.
+template< typename scalar_t >
+void test_geqrf_fixed_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+
+    std::vector< scalar_t > A_tst( size_A * batch );
+    std::vector< scalar_t > A_ref( size_A * batch );
+    std::vector< scalar_t > tau_tst( n * batch );
+    std::vector< scalar_t > tau_ref( n * batch );
+
+    for (int64_t i = 0; i < batch; ++i)
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*size_A ], lda );
+    A_ref = A_tst;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld, batch=%5lld\n",
+                llong( n ), llong( lda ), llong( batch ) );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    for (int64_t i = 0; i < batch; ++i) {
+        int64_t info_tst = lapack::geqrf( n, n, &A_tst[ i*size_A ], lda,
+                                          &tau_tst[ i*n ] );
+        if (info_tst != 0) {
+            fprintf( stderr, "lapack::geqrf returned error %lld for matrix %lld\n",
+                     llong( info_tst ), llong( i ) );
+        }
+    }
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    double gflop = batch * lapack::Gflop< scalar_t >::geqrf( n, n );
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            int64_t info_ref = LAPACKE_geqrf( n, n, &A_ref[ i*size_A ], lda,
+                                              &tau_ref[ i*n ] );
+            if (info_ref != 0) {
+                fprintf( stderr, "LAPACKE_geqrf returned error %lld for matrix %lld\n",
+                         llong( info_ref ), llong( i ) );
+            }
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        // ---------- check error compared to reference
+        // R, the Householder vectors, and tau should all match LAPACK.
+        real_t error = rel_error( A_tst, A_ref );
+        error = blas::max( error, rel_error( tau_tst, tau_ref ) );
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_geqrf_fixed( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_geqrf_fixed_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrf_fixed_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrf_fixed_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrf_fixed_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
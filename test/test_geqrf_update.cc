@@ -0,0 +1,247 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Sets error = max( error, || A - Q R ||_1 / (max(m,n) ||A||_1) ) and
+// ortho = max( ortho, || I - Q^H Q ||_1 / m ), for the m-by-n A and R and
+// m-by-m Q. R's strictly lower part must be zero, so nonzeros there count
+// in the error.
+template< typename scalar_t >
+void check_qr_update(
+    int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* Q, int64_t ldq,
+    scalar_t const* R, int64_t ldr,
+    blas::real_type< scalar_t >& error,
+    blas::real_type< scalar_t >& ortho )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    if (m == 0 || n == 0)
+        return;
+
+    std::vector< scalar_t > E( lda * n );
+    lapack::lacpy( lapack::MatrixType::General, m, n, A, lda, &E[0], lda );
+    blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                m, n, m,
+                -1.0, Q, ldq, R, ldr,
+                 1.0, &E[0], lda );
+    real_t Anorm = lapack::lange( lapack::Norm::One, m, n, A, lda );
+    real_t Enorm = lapack::lange( lapack::Norm::One, m, n, &E[0], lda );
+    error = blas::max( error, Enorm / (blas::max( m, n ) * Anorm) );
+
+    std::vector< scalar_t > I( m * m );
+    lapack::laset( lapack::MatrixType::General, m, m, 0.0, 1.0, &I[0], m );
+    blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper, blas::Op::ConjTrans,
+                m, m, -1.0, Q, ldq, 1.0, &I[0], m );
+    real_t Inorm = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                  m, &I[0], m );
+    ortho = blas::max( ortho, Inorm / m );
+}
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_geqrf_update_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    // Arrays have room for one more row and column.
+    // A1 is A with a row inserted at i; A2 is A with a column inserted at j.
+    int64_t i = m / 2;
+    int64_t j = n / 2;
+    int64_t lda = roundup( m + 1, align );
+    int64_t ldq = lda;
+    int64_t ldr = lda;
+    size_t size_A = (size_t) lda * (n + 1);
+    size_t size_Q = (size_t) ldq * (m + 1);
+
+    std::vector< scalar_t > A( size_A, 0 );
+    std::vector< scalar_t > Q( size_Q, 0 );
+    std::vector< scalar_t > R( size_A, 0 );
+    std::vector< scalar_t > tau( blas::min( m, n ) );
+    std::vector< scalar_t > w( n ), a( m );
+
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, w.size(), &w[0] );
+    lapack::larnv( idist, iseed, a.size(), &a[0] );
+
+    std::vector< scalar_t > A1( size_A, 0 ), A2( size_A, 0 );
+    for (int64_t jj = 0; jj < n; ++jj) {
+        for (int64_t ii = 0; ii < m; ++ii)
+            A1[ ii + (ii >= i) + jj*lda ] = A[ ii + jj*lda ];
+        A1[ i + jj*lda ] = w[ jj ];
+    }
+    for (int64_t jj = 0; jj < n; ++jj) {
+        for (int64_t ii = 0; ii < m; ++ii)
+            A2[ ii + (jj + (jj >= j))*lda ] = A[ ii + jj*lda ];
+    }
+    for (int64_t ii = 0; ii < m; ++ii)
+        A2[ ii + j*lda ] = a[ ii ];
+
+    // Q and R of A, from geqrf and ungqr.
+    int64_t kk = blas::min( m, n );
+    lapack::lacpy( lapack::MatrixType::General, m, n, &A[0], lda, &R[0], lda );
+    lapack::geqrf( m, n, &R[0], ldr, &tau[0] );
+    lapack::lacpy( lapack::MatrixType::Lower, m, kk, &R[0], ldr, &Q[0], ldq );
+    lapack::ungqr( m, m, kk, &Q[0], ldq, &tau[0] );
+    if (m > 1)
+        lapack::laset( lapack::MatrixType::Lower, m-1, n, 0.0, 0.0, &R[1], ldr );
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::geqrf_insert_row( m, n, m+1, &Q[0], ldq, &R[0], ldr, &w[0], 1 ), lapack::Error );
+        assert_throw( lapack::geqrf_insert_row( m, n,   i, &Q[0],    m, &R[0], ldr, &w[0], 1 ), lapack::Error );
+        assert_throw( lapack::geqrf_insert_row( m, n,   i, &Q[0], ldq, &R[0],   m, &w[0], 1 ), lapack::Error );
+        assert_throw( lapack::geqrf_delete_row( m, n,   m, &Q[0], ldq, &R[0], ldr ), lapack::Error );
+        assert_throw( lapack::geqrf_delete_row( m, n,   i, (scalar_t*) nullptr, ldq, &R[0], ldr ), lapack::Error );
+        assert_throw( lapack::geqrf_insert_col( m, n, n+1, &Q[0], ldq, &R[0], ldr, &a[0] ), lapack::Error );
+        assert_throw( lapack::geqrf_delete_col( m, n,   n, &Q[0], ldq, &R[0], ldr ), lapack::Error );
+    }
+
+    // ---------- run test: insert and delete a row, then a column
+    real_t error = 0, ortho = 0;
+    double time = 0;
+    for (int step = 0; step < 4; ++step) {
+        testsweeper::flush_cache( params.cache() );
+        double t = testsweeper::get_wtime();
+        switch (step) {
+            case 0:
+                lapack::geqrf_insert_row( m, n, i, &Q[0], ldq, &R[0], ldr,
+                                          &w[0], 1 );
+                break;
+            case 1:
+                lapack::geqrf_delete_row( m+1, n, i, &Q[0], ldq, &R[0], ldr );
+                break;
+            case 2:
+                lapack::geqrf_insert_col( m, n, j, &Q[0], ldq, &R[0], ldr,
+                                          &a[0] );
+                break;
+            case 3:
+                lapack::geqrf_delete_col( m, n+1, j, &Q[0], ldq, &R[0], ldr );
+                break;
+        }
+        time += testsweeper::get_wtime() - t;
+
+        if (params.check() == 'y') {
+            switch (step) {
+                case 0:
+                    check_qr_update( m+1, n, &A1[0], lda, &Q[0], ldq,
+                                     &R[0], ldr, error, ortho );
+                    break;
+                case 2:
+                    check_qr_update( m, n+1, &A2[0], lda, &Q[0], ldq,
+                                     &R[0], ldr, error, ortho );
+                    break;
+                default:
+                    check_qr_update( m, n, &A[0], lda, &Q[0], ldq,
+                                     &R[0], ldr, error, ortho );
+                    break;
+            }
+        }
+    }
+
+    params.time() = time;
+
+    if (params.check() == 'y') {
+        // ---------- check error
+        // Without Q, inserting a row must give the same R^H R = A1^H A1.
+        std::vector< scalar_t > R_tmp( size_A, 0 );
+        lapack::lacpy( lapack::MatrixType::Upper, m, n, &R[0], ldr,
+                       &R_tmp[0], ldr );
+        lapack::geqrf_insert_row( m, n, 0, (scalar_t*) nullptr, 1,
+                                  &R_tmp[0], ldr, &w[0], 1 );
+        if (n > 0) {
+            std::vector< scalar_t > G( n * n ), G_ref( n * n );
+            blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                        blas::Op::ConjTrans, n, m+1,
+                        1.0, &A1[0], lda, 0.0, &G_ref[0], n );
+            blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                        blas::Op::ConjTrans, n, m+1,
+                        1.0, &R_tmp[0], ldr, 0.0, &G[0], n );
+            blas::axpy( G.size(), -1.0, &G_ref[0], 1, &G[0], 1 );
+            real_t Gnorm = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                          n, &G_ref[0], n );
+            real_t Enorm = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                          n, &G[0], n );
+            if (Gnorm > 0)
+                error = blas::max( error, Enorm / ((m + 1) * Gnorm) );
+        }
+
+        params.error() = error;
+        params.ortho() = ortho;
+        params.okay() = (error < tol) && (ortho < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference, refactor A1 with geqrf and ungqr
+        std::vector< scalar_t > R_ref = A1;
+        std::vector< scalar_t > Q_ref( size_Q );
+        int64_t kk1 = blas::min( m+1, n );
+        std::vector< scalar_t > tau_ref( kk1 );
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        lapack::geqrf( m+1, n, &R_ref[0], lda, &tau_ref[0] );
+        lapack::lacpy( lapack::MatrixType::Lower, m+1, kk1, &R_ref[0], lda,
+                       &Q_ref[0], ldq );
+        lapack::ungqr( m+1, m+1, kk1, &Q_ref[0], ldq, &tau_ref[0] );
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_geqrf_update( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_geqrf_update_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrf_update_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrf_update_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrf_update_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,213 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/polar.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "scale.hh"
+
+#include <algorithm>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_gesvd_qdwh_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // Constants
+    const scalar_t zero = 0.0;
+    const scalar_t one = 1.0;
+    const real_t   eps = std::numeric_limits< real_t >::epsilon();
+
+    // get & mark input values
+    lapack::Job jobu = params.jobu();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t rank = params.rank();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    real_t tol = params.tol() * eps;
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho_U();
+    params.ortho_V();
+    params.error2();
+    params.error2.name( "Sigma" );
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t minmn = blas::min( m, n );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldu = roundup( blas::max( 1, m ), align );
+    int64_t ldvt = roundup( blas::max( 1, minmn ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_U = (size_t) ldu * blas::max( 1, minmn );
+    size_t size_VT = (size_t) ldvt * blas::max( 1, n );
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< real_t > S_tst( blas::max( 1, minmn ) );
+    std::vector< real_t > S_ref( blas::max( 1, minmn ) );
+    std::vector< scalar_t > U( size_U );
+    std::vector< scalar_t > VT( size_VT );
+
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+
+    // For rank r < n, A( :, r:n-1 ) = A( :, 0:r-1 ) B, with B random
+    // except its first column is zero, so A( :, r ) = 0.
+    if (rank >= 0 && rank < n) {
+        std::vector< scalar_t > B( blas::max( 1, rank * (n - rank) ) );
+        int64_t iseed[ 4 ] = { 0, 0, 0, 1 };
+        lapack::larnv( 1, iseed, B.size(), &B[0] );
+        std::fill( B.begin(), B.begin() + rank, zero );
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans,
+                    blas::Op::NoTrans, m, n - rank, rank,
+                    one,  &A[0], lda, &B[0], blas::max( 1, rank ),
+                    zero, &A[ rank*lda ], lda );
+    }
+    A_tst = A;
+
+    if (verbose >= 1) {
+        printf( "\n" );
+        printf( "A m=%5lld, n=%5lld, lda=%5lld\n",
+                llong( m ), llong( n ), llong( lda ) );
+    }
+    if (verbose >= 2) {
+        printf( "A = " );
+        print_matrix( m, n, &A[0], lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Job;
+        assert_throw( lapack::gesvd_qdwh( Job::Vec, m,  n, &A_tst[0], lda, &S_tst[0], &U[0], ldu, &VT[0], ldvt ), lapack::Error );
+        assert_throw( lapack::gesvd_qdwh( jobu,    -1,  n, &A_tst[0], lda, &S_tst[0], &U[0], ldu, &VT[0], ldvt ), lapack::Error );
+        assert_throw( lapack::gesvd_qdwh( jobu,     m, -1, &A_tst[0], lda, &S_tst[0], &U[0], ldu, &VT[0], ldvt ), lapack::Error );
+        assert_throw( lapack::gesvd_qdwh( jobu,     m,  n, &A_tst[0], m-1, &S_tst[0], &U[0], ldu, &VT[0], ldvt ), lapack::Error );
+        assert_throw( lapack::gesvd_qdwh( Job::SomeVec, m, n, &A_tst[0], lda, &S_tst[0], &U[0], m-1, &VT[0], ldvt ), lapack::Error );
+        assert_throw( lapack::gesvd_qdwh( Job::SomeVec, m, n, &A_tst[0], lda, &S_tst[0], &U[0], ldu, &VT[0], minmn-1 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::gesvd_qdwh(
+                           jobu, m, n, &A_tst[0], lda, &S_tst[0],
+                           &U[0], ldu, &VT[0], ldvt );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::gesvd_qdwh returned error %lld\n", llong( info_tst ) );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "S = " );
+        print_vector( minmn, &S_tst[0], 1 );
+        if (jobu == lapack::Job::SomeVec) {
+            printf( "U = " );
+            print_matrix( m, minmn, &U[0], ldu );
+            printf( "VT = " );
+            print_matrix( minmn, n, &VT[0], ldvt );
+        }
+    }
+
+    if (params.check() == 'y' && jobu == lapack::Job::SomeVec && minmn > 0) {
+        // ---------- check error
+        // || A - U S VT ||_1 / (||A||_1 * max(m,n))
+        real_t Anorm = lapack::lange( lapack::Norm::One, m, n, &A[0], lda );
+        std::vector< scalar_t > R = A;
+        std::vector< scalar_t > US = U;
+        col_scale( m, minmn, &US[0], ldu, &S_tst[0] );
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans,
+                    blas::Op::NoTrans, m, n, minmn,
+                    -one, &US[0], ldu, &VT[0], ldvt,
+                    one,  &R[0], lda );
+        real_t error = lapack::lange( lapack::Norm::One, m, n, &R[0], lda );
+        if (Anorm != 0)
+            error /= Anorm;
+        error /= blas::max( m, n );
+
+        // || I - U^H U || / m and || I - VT VT^H || / n
+        std::vector< scalar_t > I( minmn * minmn );
+        lapack::laset( lapack::MatrixType::General, minmn, minmn,
+                       0.0, 1.0, &I[0], minmn );
+        blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                    blas::Op::ConjTrans, minmn, m,
+                    -1.0, &U[0], ldu, 1.0, &I[0], minmn );
+        real_t ortho_U = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                        minmn, &I[0], minmn ) / m;
+        lapack::laset( lapack::MatrixType::General, minmn, minmn,
+                       0.0, 1.0, &I[0], minmn );
+        blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                    blas::Op::NoTrans, minmn, n,
+                    -1.0, &VT[0], ldvt, 1.0, &I[0], minmn );
+        real_t ortho_V = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                        minmn, &I[0], minmn ) / n;
+
+        params.error()   = error;
+        params.ortho_U() = ortho_U;
+        params.ortho_V() = ortho_V;
+        params.okay() = (error < tol) && (ortho_U < tol) && (ortho_V < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        std::vector< scalar_t > A_ref = A;
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::gesdd( lapack::Job::NoVec, m, n,
+                                          &A_ref[0], lda, &S_ref[0],
+                                          &U[0], 1, &VT[0], 1 );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::gesdd returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference
+        real_t error = 0;
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        error += rel_error( S_tst, S_ref );
+        params.error2() = error;
+        params.okay() = params.okay() && (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_gesvd_qdwh( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gesvd_qdwh_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gesvd_qdwh_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gesvd_qdwh_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gesvd_qdwh_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,222 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/randomized.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "scale.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_gesvd_rand_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // Constants
+    const scalar_t one = 1.0;
+    const real_t   eps = std::numeric_limits< real_t >::epsilon();
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    lapack::Sketch sketch = params.sketch();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t k = params.dim.k();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    real_t tol = params.tol() * eps;
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho_U();
+    params.ortho_V();
+    params.error2();
+    params.error2.name( "Sigma" );
+
+    if (! run) {
+        // Low-rank approximation needs decaying singular values.
+        params.matrix.kind.set_default( "svd_geo" );
+        return;
+    }
+
+    // ---------- setup
+    int64_t minmn = blas::min( m, n );
+    k = blas::min( k, minmn );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldu = roundup( blas::max( 1, m ), align );
+    int64_t ldvt = roundup( blas::max( 1, k ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_U = (size_t) ldu * blas::max( 1, k );
+    size_t size_VT = (size_t) ldvt * blas::max( 1, n );
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< real_t > S_tst( blas::max( 1, k ) );
+    std::vector< real_t > S_ref( blas::max( 1, minmn ) );
+    std::vector< scalar_t > U( size_U );
+    std::vector< scalar_t > VT( size_VT );
+    int64_t iseed[ 4 ] = { 0, 0, 0, 1 };
+    int64_t rank;
+
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+
+    if (verbose >= 1) {
+        printf( "\n" );
+        printf( "A m=%5lld, n=%5lld, lda=%5lld, k=%5lld\n",
+                llong( m ), llong( n ), llong( lda ), llong( k ) );
+    }
+    if (verbose >= 2) {
+        printf( "A = " );
+        print_matrix( m, n, &A[0], lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Job;
+        using lapack::Sketch;
+        assert_throw( lapack::gesvd_rand( Job(0), m,  n,  k,   &A[0], lda, &rank, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( jobz,  -1,  n,  k,   &A[0], lda, &rank, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( jobz,   m, -1,  k,   &A[0], lda, &rank, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( jobz,   m,  n, -1,   &A[0], lda, &rank, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( jobz,   m,  n, minmn+1, &A[0], lda, &rank, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( jobz,   m,  n,  k,   &A[0], m-1, &rank, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( Job::Vec, m, n, k,   &A[0], lda, &rank, &S_tst[0], &U[0], m-1, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( Job::Vec, m, n, k,   &A[0], lda, &rank, &S_tst[0], &U[0], ldu, &VT[0], k-1,  iseed ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( jobz,   m,  n,  k,   &A[0], lda, &rank, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed, real_t( 0 ), -1 ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( jobz,   m,  n,  k,   &A[0], lda, &rank, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed, real_t( 0 ), 10, -1 ), lapack::Error );
+        assert_throw( lapack::gesvd_rand( jobz,   m,  n,  k,   &A[0], lda, &rank, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed, real_t( 0 ), 10, 2, Sketch(0) ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::gesvd_rand(
+                           jobz, m, n, k, &A[0], lda, &rank, &S_tst[0],
+                           &U[0], ldu, &VT[0], ldvt, iseed,
+                           real_t( 0 ), 10, 2, sketch );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::gesvd_rand returned error %lld\n", llong( info_tst ) );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "S = " );
+        print_vector( k, &S_tst[0], 1 );
+        if (jobz == lapack::Job::Vec) {
+            printf( "U = " );
+            print_matrix( m, k, &U[0], ldu );
+            printf( "VT = " );
+            print_matrix( k, n, &VT[0], ldvt );
+        }
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference, singular values of A
+        std::vector< scalar_t > A_ref = A;
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::gesdd( lapack::Job::NoVec, m, n,
+                                          &A_ref[0], lda, &S_ref[0],
+                                          &U[0], 1, &VT[0], 1 );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::gesdd returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+    }
+
+    if (params.check() == 'y' && k > 0) {
+        // ---------- check error
+        // Relative to the best rank-k approximation, from the
+        // singular values of A,
+        //     error = ||A - U S VT||_F / ||A - A_k||_F,
+        // which should be near 1.
+        real_t Anorm = lapack::lange( lapack::Norm::Fro, m, n, &A[0], lda );
+        real_t best = 0;
+        for (int64_t i = k; i < minmn; ++i)
+            best += S_ref[ i ] * S_ref[ i ];
+        best = blas::max( std::sqrt( best ), tol * Anorm );
+
+        real_t error   = testsweeper::no_data_flag;
+        real_t ortho_U = testsweeper::no_data_flag;
+        real_t ortho_V = testsweeper::no_data_flag;
+        if (jobz == lapack::Job::Vec) {
+            // A = A - (U S) VT
+            std::vector< scalar_t > US = U;
+            col_scale( m, k, &US[0], ldu, &S_tst[0] );
+            blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans,
+                        blas::Op::NoTrans, m, n, k,
+                        -one, &US[0], ldu, &VT[0], ldvt,
+                        one,  &A[0], lda );
+            error = lapack::lange( lapack::Norm::Fro, m, n, &A[0], lda ) / best;
+
+            // || I - U^H U || / m and || I - VT VT^H || / n
+            std::vector< scalar_t > I( k * k );
+            lapack::laset( lapack::MatrixType::General, k, k,
+                           0.0, 1.0, &I[0], k );
+            blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                        blas::Op::ConjTrans, k, m,
+                        -1.0, &U[0], ldu, 1.0, &I[0], k );
+            ortho_U = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                     k, &I[0], k ) / m;
+            lapack::laset( lapack::MatrixType::General, k, k,
+                           0.0, 1.0, &I[0], k );
+            blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                        blas::Op::NoTrans, k, n,
+                        -1.0, &VT[0], ldvt, 1.0, &I[0], k );
+            ortho_V = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                     k, &I[0], k ) / n;
+        }
+
+        // Leading singular values, relative to ||A||_2
+        real_t error2 = 0;
+        for (int64_t i = 0; i < k; ++i)
+            error2 = blas::max( error2, std::abs( S_tst[ i ] - S_ref[ i ] ) );
+        if (S_ref[ 0 ] > 0)
+            error2 /= S_ref[ 0 ];
+
+        params.error()   = error;
+        params.ortho_U() = ortho_U;
+        params.ortho_V() = ortho_V;
+        params.error2()  = error2;
+        params.okay() = (info_tst == 0 && rank == k)
+                        && (jobz == lapack::Job::NoVec
+                            || ((error < 2) && (ortho_U < tol) && (ortho_V < tol)))
+                        && (error2 < 1e-2);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_gesvd_rand( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gesvd_rand_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gesvd_rand_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gesvd_rand_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gesvd_rand_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -23,6 +23,8 @@ void test_getrf_work( Params& params, bool run )
     int64_t n = params.dim.n();
     int64_t align = params.align();
     int64_t verbose = params.verbose();
+    lapack::Method method = params.method();
+    int64_t nb = params.nb();
     params.matrix.mark();
 
     real_t eps = std::numeric_limits< real_t >::epsilon();
@@ -58,6 +60,11 @@ void test_getrf_work( Params& params, bool run )
         printf( "A = " ); print_matrix( m, n, &A_tst[0], lda );
     }
 
+    // select implementation of lapack::getrf
+    lapack::getrf_set_method( method );
+    if (method == lapack::Method::Native)
+        lapack::getrf_set_block_size( nb );
+
     // test error exits
     if (params.error_exit() == 'y') {
         assert_throw( lapack::getrf( -1,  n, &A_tst[0], lda, &ipiv_tst[0] ), lapack::Error );
@@ -70,6 +77,7 @@ void test_getrf_work( Params& params, bool run )
     double time = testsweeper::get_wtime();
     int64_t info_tst = lapack::getrf( m, n, &A_tst[0], lda, &ipiv_tst[0] );
     time = testsweeper::get_wtime() - time;
+    lapack::getrf_set_method( lapack::Method::Vendor );
     if (info_tst != 0) {
         fprintf( stderr, "lapack::getrf returned error %lld\n", llong( info_tst ) );
     }
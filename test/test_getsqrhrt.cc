@@ -0,0 +1,141 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <limits>
+#include <vector>
+
+#if LAPACK_VERSION >= 30900  // >= 3.9.0
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_getsqrhrt_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.gflops();
+    params.ortho();
+
+    if (! run)
+        return;
+
+    if (m < n) {
+        params.msg() = "skipping: requires m >= n";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldt = roundup( blas::max( 1, blas::min( nb, n ) ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_T = (size_t) ldt * n;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+    std::vector< scalar_t > T_tst( size_T );
+
+    lapack::generate_matrix( params.matrix, m, n, &A_tst[0], lda );
+    A_ref = A_tst;
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::getsqrhrt( m, n, nb, &A_tst[0], lda, &T_tst[0], ldt );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::getsqrhrt returned error %lld\n", llong( info_tst ) );
+    }
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::geqrf( m, n );
+    params.gflops() = gflop / time;
+
+    if (params.check() == 'y') {
+        // ---------- check error
+        // Following lapack/TESTING/LIN/zqrt04.f, applying Q with gemqrt.
+        int64_t ldq = lda;
+        std::vector< scalar_t > Q( size_A );
+        std::vector< scalar_t > R( size_A );
+
+        // R = A - Q [ R; 0 ]
+        lapack::laset( lapack::MatrixType::General, m, n, 0.0, 0.0, &R[0], lda );
+        lapack::lacpy( lapack::MatrixType::Upper, n, n, &A_tst[0], lda, &R[0], lda );
+        lapack::gemqrt( lapack::Side::Left, lapack::Op::NoTrans, m, n, n, nb,
+                        &A_tst[0], lda, &T_tst[0], ldt, &R[0], lda );
+        for (int64_t j = 0; j < n; ++j)
+            for (int64_t i = 0; i < m; ++i)
+                R[ i + j*lda ] = A_ref[ i + j*lda ] - R[ i + j*lda ];
+
+        real_t Anorm = lapack::lange( lapack::Norm::One, m, n, &A_ref[0], lda );
+        real_t resid1 = lapack::lange( lapack::Norm::One, m, n, &R[0], lda );
+        real_t error1 = 0;
+        if (Anorm > 0)
+            error1 = resid1 / ( m * Anorm );
+
+        // Q = Q [ I; 0 ], then I - Q^H Q
+        lapack::laset( lapack::MatrixType::General, m, n, 0.0, 1.0, &Q[0], ldq );
+        lapack::gemqrt( lapack::Side::Left, lapack::Op::NoTrans, m, n, n, nb,
+                        &A_tst[0], lda, &T_tst[0], ldt, &Q[0], ldq );
+        lapack::laset( lapack::MatrixType::Upper, n, n, 0.0, 1.0, &R[0], lda );
+        blas::herk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::ConjTrans,
+                    n, m, -1.0, &Q[0], ldq, 1.0, &R[0], lda );
+        real_t resid2 = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                       n, &R[0], lda );
+        real_t error2 = resid2 / m;
+
+        params.error() = error1;
+        params.ortho() = error2;
+        params.okay() = (error1 < tol) && (error2 < tol);
+    }
+}
+
+#endif  // LAPACK >= 3.9.0
+
+// -----------------------------------------------------------------------------
+void test_getsqrhrt( Params& params, bool run )
+{
+#if LAPACK_VERSION >= 30900  // >= 3.9.0
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_getsqrhrt_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_getsqrhrt_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_getsqrhrt_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_getsqrhrt_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+#else
+    fprintf( stderr, "getsqrhrt requires LAPACK >= 3.9.0\n\n" );
+    exit(0);
+#endif
+}
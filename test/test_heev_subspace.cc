@@ -0,0 +1,245 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/subspace.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "scale.hh"
+
+#include <algorithm>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_heev_subspace_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // Constants
+    const real_t   eps  = std::numeric_limits< real_t >::epsilon();
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t k = params.dim.k();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    real_t tol = params.tol() * eps;
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.iters();
+    params.ortho();
+    params.error2();
+    params.error2.name( "Lambda" );
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    k = blas::min( k, n );
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldx = lda;
+    size_t size_A = (size_t) lda * n;
+    size_t size_X = (size_t) ldx * blas::max( 1, k );
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > X( size_X );
+    std::vector< real_t > Lambda_tst( blas::max( 1, k ) );
+    std::vector< real_t > Lambda_ref( blas::max( 1, n ) );
+
+    lapack::generate_matrix( params.matrix, n, n, &A[0], lda );
+
+    if (verbose >= 1) {
+        printf( "\n" );
+        printf( "A n=%5lld, lda=%5lld, k=%5lld\n",
+                llong( n ), llong( lda ), llong( k ) );
+    }
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( n, n, &A[0], lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Uplo;
+        assert_throw( lapack::heev_subspace( Uplo(0), n,  k,   &A[0], lda, &Lambda_tst[0], &X[0], ldx, 0, nullptr ), lapack::Error );
+        assert_throw( lapack::heev_subspace( uplo,   -1,  k,   &A[0], lda, &Lambda_tst[0], &X[0], ldx, 0, nullptr ), lapack::Error );
+        assert_throw( lapack::heev_subspace( uplo,    n, -1,   &A[0], lda, &Lambda_tst[0], &X[0], ldx, 0, nullptr ), lapack::Error );
+        assert_throw( lapack::heev_subspace( uplo,    n, n+1,  &A[0], lda, &Lambda_tst[0], &X[0], ldx, 0, nullptr ), lapack::Error );
+        assert_throw( lapack::heev_subspace( uplo,    n,  k,   &A[0], n-1, &Lambda_tst[0], &X[0], ldx, 0, nullptr ), lapack::Error );
+        assert_throw( lapack::heev_subspace( uplo,    n,  k,   &A[0], lda, &Lambda_tst[0], &X[0], n-1, 0, nullptr ), lapack::Error );
+        assert_throw( lapack::heev_subspace( uplo,    n,  k,   &A[0], lda, &Lambda_tst[0], &X[0], ldx, k+1, nullptr ), lapack::Error );
+        assert_throw( lapack::heev_subspace( uplo,    n,  k,   &A[0], lda, &Lambda_tst[0], &X[0], ldx, 0, nullptr, real_t( 0 ), 0 ), lapack::Error );
+        assert_throw( lapack::heev_subspace( uplo,    n,  k,   &A[0], lda, &Lambda_tst[0], &X[0], ldx, 0, nullptr, real_t( 0 ), 10, 0 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    int64_t iters = 0;
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::heev_subspace(
+        uplo, n, k, &A[0], lda, &Lambda_tst[0], &X[0], ldx, 0, &iters );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::heev_subspace returned error %lld\n", llong( info_tst ) );
+    }
+
+    params.time() = time;
+    params.iters() = iters;
+
+    if (verbose >= 2) {
+        printf( "X = " ); print_matrix( n, k, &X[0], ldx );
+        printf( "Lambda = " ); print_vector( k, &Lambda_tst[0], 1 );
+    }
+
+    // A warm start from the converged eigenvectors needs few iterations.
+    std::vector< real_t > Lambda_warm( blas::max( 1, k ) );
+    std::vector< scalar_t > X_warm( X );
+    int64_t iters_warm = 0;
+    int64_t info_warm = lapack::heev_subspace(
+        uplo, n, k, &A[0], lda, &Lambda_warm[0], &X_warm[0], ldx, k,
+        &iters_warm );
+    if (info_warm != 0) {
+        fprintf( stderr, "lapack::heev_subspace warm start returned error %lld\n", llong( info_warm ) );
+    }
+    bool okay_warm = (info_warm == 0) && (iters_warm <= 3);
+
+    // For a perturbed matrix A2 = A + E, ||E|| ~ sqrt( eps ) ||A||,
+    // a warm start from the eigenvectors of A takes fewer iterations
+    // than a cold start, unless heevd is used (iterations = 0).
+    if (params.check() == 'y' && k > 0) {
+        real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, &A[0], lda );
+        real_t delta = std::sqrt( eps ) * Anorm / blas::max( 1, n );
+        std::vector< scalar_t > A2( A );
+        std::vector< scalar_t > E( n );
+        int64_t idist = 2;
+        int64_t iseed[4] = { 0, 1, 2, 3 };
+        for (int64_t j = 0; j < n; ++j) {
+            lapack::larnv( idist, iseed, n, &E[0] );
+            blas::axpy( n, delta, &E[0], 1, &A2[ j*lda ], 1 );
+        }
+        // A2 is read only in its uplo triangle, so it stays Hermitian;
+        // make the diagonal real.
+        for (int64_t j = 0; j < n; ++j)
+            A2[ j + j*lda ] = std::real( A2[ j + j*lda ] );
+
+        int64_t iters_cold2 = 0;
+        int64_t info_cold2 = lapack::heev_subspace(
+            uplo, n, k, &A2[0], lda, &Lambda_warm[0], &X_warm[0], ldx, 0,
+            &iters_cold2 );
+        std::copy( X.begin(), X.end(), X_warm.begin() );
+        int64_t iters_warm2 = 0;
+        int64_t info_warm2 = lapack::heev_subspace(
+            uplo, n, k, &A2[0], lda, &Lambda_warm[0], &X_warm[0], ldx, k,
+            &iters_warm2 );
+        if (verbose >= 1) {
+            printf( "iters cold %lld, warm %lld, perturbed cold %lld, warm %lld\n",
+                    llong( iters ), llong( iters_warm ),
+                    llong( iters_cold2 ), llong( iters_warm2 ) );
+        }
+        okay_warm = okay_warm && (info_cold2 == 0) && (info_warm2 == 0)
+                    && (iters_cold2 == 0 || iters_warm2 < iters_cold2);
+    }
+
+    if (params.check() == 'y' && k > 0) {
+        // ---------- check error
+        // Relative backwards error =
+        //     ||A X - X Lambda|| / (n * ||A|| * ||X||)
+        real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, &A[0], lda );
+        real_t Xnorm = lapack::lange( lapack::Norm::One, n, k, &X[0], ldx );
+
+        std::vector< scalar_t > W( size_X );  // workspace
+        int64_t ldw = ldx;
+        // W = X Lambda
+        lapack::lacpy( lapack::MatrixType::General, n, k,
+                       &X[0], ldx,
+                       &W[0], ldw );
+        col_scale( n, k, &W[0], ldw, &Lambda_tst[0] );
+        // W = A X - (X Lambda)
+        blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo, n, k,
+                    1.0,  &A[0], lda,
+                          &X[0], ldx,
+                    -1.0, &W[0], ldw );
+        real_t error = lapack::lange( lapack::Norm::One, n, k, &W[0], ldw );
+        if (Anorm != 0)
+            error /= (n * Anorm * Xnorm);
+
+        // || I - X^H X || / n
+        std::vector< scalar_t > I( k * k );
+        lapack::laset( lapack::MatrixType::General, k, k,
+                       0.0, 1.0, &I[0], k );
+        blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                    blas::Op::ConjTrans, k, n,
+                    -1.0, &X[0], ldx, 1.0, &I[0], k );
+        real_t ortho = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                      k, &I[0], k ) / n;
+
+        params.error() = error;
+        params.ortho() = ortho;
+        params.okay() = (info_tst == 0) && okay_warm
+                        && (error < tol) && (ortho < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::heevd(
+            lapack::Job::NoVec, uplo, n, &A[0], lda, &Lambda_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::heevd returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference,
+        // relative to ||A||_2
+        real_t error = 0;
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        real_t Lambda_max = 0;
+        for (int64_t i = 0; i < n; ++i)
+            Lambda_max = blas::max( Lambda_max, std::abs( Lambda_ref[ i ] ) );
+        real_t diff = 0;
+        for (int64_t i = 0; i < k; ++i)
+            diff = blas::max( diff, std::abs( Lambda_tst[ i ] - Lambda_ref[ i ] ) );
+        if (Lambda_max > 0)
+            diff /= Lambda_max;
+        error += diff;
+        params.error2() = error;
+        params.okay() = params.okay() && (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_heev_subspace( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_heev_subspace_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_heev_subspace_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_heev_subspace_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_heev_subspace_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
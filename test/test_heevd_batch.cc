@@ -0,0 +1,139 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_heevd_batch_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_W = (size_t) n;
+
+    std::vector< scalar_t > A_tst( size_A * batch );
+    std::vector< scalar_t > A_ref( size_A * batch );
+    std::vector< real_t > Lambda_tst( size_W * batch );
+    std::vector< real_t > Lambda_ref( size_W * batch );
+    std::vector< int64_t > info_tst( batch );
+
+    std::vector< scalar_t* > Aarray( batch );
+    std::vector< real_t* > Warray( batch );
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*size_A ], lda );
+        Aarray[ i ] = &A_tst[ i*size_A ];
+        Warray[ i ] = &Lambda_tst[ i*size_W ];
+    }
+    A_ref = A_tst;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld, batch=%5lld\n",
+                llong( n ), llong( lda ), llong( batch ) );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Job;
+        using lapack::Uplo;
+        assert_throw( lapack::heevd_batch( Job(0), uplo,     n, &Aarray[0], lda, &Warray[0], &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::heevd_batch( jobz,   Uplo(0),  n, &Aarray[0], lda, &Warray[0], &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::heevd_batch( jobz,   uplo,    -1, &Aarray[0], lda, &Warray[0], &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::heevd_batch( jobz,   uplo,     n, &Aarray[0], n-1, &Warray[0], &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::heevd_batch( jobz,   uplo,     n, &Aarray[0], lda, &Warray[0], &info_tst[0],    -1 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::heevd_batch( jobz, uplo, n, &Aarray[0], lda, &Warray[0],
+                         &info_tst[0], batch );
+    time = testsweeper::get_wtime() - time;
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0) {
+            fprintf( stderr, "lapack::heevd_batch returned error %lld for matrix %lld\n",
+                     llong( info_tst[ i ] ), llong( i ) );
+        }
+    }
+
+    params.time() = time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference, looping over non-batched heevd
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            int64_t info_ref = lapack::heevd( jobz, uplo, n, &A_ref[ i*size_A ], lda,
+                                              &Lambda_ref[ i*size_W ] );
+            if (info_ref != 0) {
+                fprintf( stderr, "lapack::heevd returned error %lld for matrix %lld\n",
+                         llong( info_ref ), llong( i ) );
+            }
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference
+        real_t error = 0;
+        if (n > 0)
+            error = rel_error( Lambda_tst, Lambda_ref );
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_heevd_batch( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_heevd_batch_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_heevd_batch_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_heevd_batch_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_heevd_batch_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
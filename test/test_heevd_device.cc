@@ -7,6 +7,7 @@
 #include "lapack.hh"
 #include "scale.hh"
 #include "lapack/device.hh"
+#include "device_util.hh"
 #include "lapack/flops.hh"
 #include "print_matrix.hh"
 #include "error.hh"
@@ -43,8 +44,8 @@ void test_heevd_device_work( Params& params, bool run )
     if (! run)
         return;
 
-    if (blas::get_device_count() == 0) {
-        params.msg() = "skipping: no GPU devices or no GPU support";
+    if (! test_device::available()) {
+        params.msg() = "skipping: no GPU devices";
         return;
     }
 
@@ -65,17 +66,17 @@ void test_heevd_device_work( Params& params, bool run )
 
     // Allocate and copy to GPU
     lapack::Queue queue( device );
-    scalar_t*        dA_tst = blas::device_malloc< scalar_t >( size_A, queue );
-    real_t*          dW_tst = blas::device_malloc< real_t >  ( size_W, queue );
-    device_info_int* d_info = blas::device_malloc< device_info_int >( 1, queue );
-    blas::device_copy_matrix( n, n, A.data(), lda, dA_tst, lda, queue );
+    scalar_t*        dA_tst = test_device::device_malloc< scalar_t >( size_A, queue );
+    real_t*          dW_tst = test_device::device_malloc< real_t >  ( size_W, queue );
+    device_info_int* d_info = test_device::device_malloc< device_info_int >( 1, queue );
+    test_device::device_copy_matrix( n, n, A.data(), lda, dA_tst, lda, queue );
 
 
     // Allocate workspace
     size_t d_size, h_size;
     lapack::heevd_work_size_bytes( jobz, uplo, n, dA_tst, lda, dW_tst,
                                    &d_size, &h_size, queue );
-    char* d_work = blas::device_malloc< char >( d_size, queue );
+    char* d_work = test_device::device_malloc< char >( d_size, queue );
     std::vector<char> h_work_vector( h_size );
     char* h_work = h_work_vector.data();
 
@@ -105,9 +106,9 @@ void test_heevd_device_work( Params& params, bool run )
 
     // Copy result back to CPU.
     device_info_int info_tst;
-    blas::device_copy_matrix( n, n, dA_tst, lda, Z.data(), ldz, queue );
-    blas::device_copy_vector( n, dW_tst, 1, Lambda_tst.data(), 1, queue );
-    blas::device_memcpy( &info_tst, d_info, 1, queue );
+    test_device::device_copy_matrix( n, n, dA_tst, lda, Z.data(), ldz, queue );
+    test_device::device_copy_vector( n, dW_tst, 1, Lambda_tst.data(), 1, queue );
+    test_device::device_memcpy( &info_tst, d_info, 1, queue );
     queue.sync();
 
 
@@ -116,10 +117,10 @@ void test_heevd_device_work( Params& params, bool run )
     }
 
     // Cleanup GPU memory
-    blas::device_free( dA_tst, queue );
-    blas::device_free( dW_tst, queue );
-    blas::device_free( d_work, queue );
-    blas::device_free( d_info, queue );
+    test_device::device_free( dA_tst, queue );
+    test_device::device_free( dW_tst, queue );
+    test_device::device_free( d_work, queue );
+    test_device::device_free( d_info, queue );
 
     if (verbose >= 2) {
         printf( "Z = " ); print_matrix( n, n, &Z[0], ldz );
@@ -0,0 +1,177 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/polar.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "scale.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_heevd_qdwh_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // Constants
+    const real_t   eps  = std::numeric_limits< real_t >::epsilon();
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    real_t tol = params.tol() * eps;
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho();
+    params.error2();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldz = lda;  // vectors overwrite matrix A
+    size_t size_A = (size_t) lda * n;
+    size_t size_Z = size_A;
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > Z( size_Z );  // eigenvectors
+    std::vector< real_t > Lambda_tst( n );
+    std::vector< real_t > Lambda_ref( n );
+
+    lapack::generate_matrix( params.matrix,  n, n, &A[0], lda );
+    Z = A;
+
+    if (verbose >= 1) {
+        printf( "\n" );
+        printf( "A n=%5lld, lda=%5lld\n", llong( n ), llong( lda ) );
+    }
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( n, n, &A[0], lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Job;
+        using lapack::Uplo;
+        assert_throw( lapack::heevd_qdwh( Job::SomeVec, uplo, n, &Z[0], lda, &Lambda_tst[0] ), lapack::Error );
+        assert_throw( lapack::heevd_qdwh( jobz, Uplo(0), n, &Z[0], lda, &Lambda_tst[0] ), lapack::Error );
+        assert_throw( lapack::heevd_qdwh( jobz, uplo,   -1, &Z[0], lda, &Lambda_tst[0] ), lapack::Error );
+        assert_throw( lapack::heevd_qdwh( jobz, uplo,    n, &Z[0], n-1, &Lambda_tst[0] ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::heevd_qdwh(
+        jobz, uplo, n, &Z[0], lda, &Lambda_tst[0] );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::heevd_qdwh returned error %lld\n", llong( info_tst ) );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "Z = " ); print_matrix( n, n, &Z[0], ldz );
+        printf( "Lambda = " ); print_vector( n, &Lambda_tst[0], 1 );
+    }
+
+    if (params.check() == 'y' && jobz == lapack::Job::Vec && n > 0) {
+        // ---------- check error
+        // Relative backwards error =
+        //     ||A Z - Z Lambda|| / (n * ||A|| * ||Z||)
+        real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, &A[0], lda );
+        real_t Znorm = lapack::lange( lapack::Norm::One, n, n, &Z[0], ldz );
+
+        std::vector< scalar_t > W( size_A );  // workspace
+        int64_t ldw = ldz;
+        // W = Z
+        lapack::lacpy( lapack::MatrixType::General, n, n,
+                       &Z[0], ldz,
+                       &W[0], ldw );
+        // W = Z Lambda
+        col_scale( n, n, &W[0], ldw, &Lambda_tst[0] );
+        // W = A Z - (Z Lambda)
+        blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo, n, n,
+                    1.0,  &A[0], lda,
+                          &Z[0], ldz,
+                    -1.0, &W[0], ldw );
+        real_t error = lapack::lange( lapack::Norm::One, n, n, &W[0], ldw );
+        if (Anorm != 0)
+            error /= (n * Anorm * Znorm);
+
+        // || I - Z^H Z || / n
+        std::vector< scalar_t > I( n * n );
+        lapack::laset( lapack::MatrixType::General, n, n,
+                       0.0, 1.0, &I[0], n );
+        blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                    blas::Op::ConjTrans, n, n,
+                    -1.0, &Z[0], ldz, 1.0, &I[0], n );
+        real_t ortho = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                      n, &I[0], n ) / n;
+
+        params.error() = error;
+        params.ortho() = ortho;
+        params.okay() = (error < tol) && (ortho < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::heevd(
+            lapack::Job::NoVec, uplo, n, &A[0], lda, &Lambda_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::heevd returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference
+        real_t error = 0;
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        error += rel_error( Lambda_tst, Lambda_ref );
+        params.error2() = error;
+        params.okay() = params.okay() && (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_heevd_qdwh( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_heevd_qdwh_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_heevd_qdwh_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_heevd_qdwh_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_heevd_qdwh_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
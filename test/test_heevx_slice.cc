@@ -0,0 +1,219 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/slice.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "scale.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_heevx_slice_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // Constants
+    const scalar_t one  = 1.0;
+    const real_t   eps  = std::numeric_limits< real_t >::epsilon();
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    real_t tol = params.tol() * eps;
+    params.matrix.mark();
+
+    real_t  vl;  // = params.vl();
+    real_t  vu;  // = params.vu();
+    int64_t il;  // = params.il();
+    int64_t iu;  // = params.iu();
+    lapack::Range range;  // derived from vl,vu,il,iu
+    params.get_range( n, &range, &vl, &vu, &il, &iu );
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho();
+    params.error2();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t nfound;
+    int64_t nfound_ref;
+    int64_t ldz = (jobz == lapack::Job::Vec
+                   ? roundup( blas::max( 1, n ), align )
+                   : 1 );
+    size_t size_A = (size_t) lda * n;
+    size_t size_Z = (size_t) ldz * n;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+    std::vector< scalar_t > Z( size_Z );  // eigenvectors
+    std::vector< real_t > Lambda_tst( n );
+    std::vector< real_t > Lambda_ref( n );
+    std::vector< int64_t > ifail_tst( n );
+    std::vector< int64_t > ifail_ref( n );
+
+    lapack::generate_matrix( params.matrix, n, n, &A_tst[0], lda );
+    A_ref = A_tst;
+
+    if (verbose >= 1) {
+        printf( "\n" );
+        printf( "A n=%5lld, lda=%5lld\n", llong( n ), llong( lda ) );
+    }
+    if (verbose >= 2) {
+        printf( "A = " );
+        print_matrix( n, n, &A_tst[0], lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Job;
+        using lapack::Range;
+        using lapack::Uplo;
+        assert_throw( lapack::heevx_slice( Job(0), range,    uplo,    n, &A_tst[0], lda, vl, vu, il, iu, &nfound, &Lambda_tst[0], &Z[0], ldz, &ifail_tst[0] ), lapack::Error );
+        assert_throw( lapack::heevx_slice( jobz,   Range(0), uplo,    n, &A_tst[0], lda, vl, vu, il, iu, &nfound, &Lambda_tst[0], &Z[0], ldz, &ifail_tst[0] ), lapack::Error );
+        assert_throw( lapack::heevx_slice( jobz,   range,    Uplo(0), n, &A_tst[0], lda, vl, vu, il, iu, &nfound, &Lambda_tst[0], &Z[0], ldz, &ifail_tst[0] ), lapack::Error );
+        assert_throw( lapack::heevx_slice( jobz,   range,    uplo,   -1, &A_tst[0], lda, vl, vu, il, iu, &nfound, &Lambda_tst[0], &Z[0], ldz, &ifail_tst[0] ), lapack::Error );
+        assert_throw( lapack::heevx_slice( jobz,   range,    uplo,    n, &A_tst[0], n-1, vl, vu, il, iu, &nfound, &Lambda_tst[0], &Z[0], ldz, &ifail_tst[0] ), lapack::Error );
+        if (n > 0)
+            assert_throw( lapack::heevx_slice( jobz, Range::Value, uplo, n, &A_tst[0], lda, real_t( 1 ), real_t( 0 ), il, iu, &nfound, &Lambda_tst[0], &Z[0], ldz, &ifail_tst[0] ), lapack::Error );
+        assert_throw( lapack::heevx_slice( jobz,   Range::Index, uplo, n, &A_tst[0], lda, vl, vu, 0, iu, &nfound, &Lambda_tst[0], &Z[0], ldz, &ifail_tst[0] ), lapack::Error );
+        assert_throw( lapack::heevx_slice( Job::Vec, range,  uplo,    n, &A_tst[0], lda, vl, vu, il, iu, &nfound, &Lambda_tst[0], &Z[0], n-1, &ifail_tst[0] ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::heevx_slice(
+                           jobz, range, uplo, n,
+                           &A_tst[0], lda,
+                           vl, vu, il, iu, &nfound,
+                           &Lambda_tst[0], &Z[0], ldz, &ifail_tst[0] );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::heevx_slice returned error %lld\n", llong( info_tst ) );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "nfound = %lld\n", llong( nfound ) );
+        printf( "Lambda = " );
+        print_vector( n, &Lambda_tst[0], 1 );
+        if (jobz == lapack::Job::Vec) {
+            printf( "Z = " );
+            print_matrix( n, nfound, &Z[0], ldz );
+        }
+    }
+
+    if (params.check() == 'y' && jobz == lapack::Job::Vec && nfound > 0) {
+        // ---------- check error
+        // Relative backwards error =
+        //     ||A Z - Z Lambda|| / (n * ||A|| * ||Z||)
+        real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, &A_ref[0], lda );
+        real_t Znorm = lapack::lange( lapack::Norm::One, n, nfound, &Z[0], ldz );
+
+        std::vector< scalar_t > W( size_Z );  // workspace
+        int64_t ldw = ldz;
+        // W = Z Lambda
+        lapack::lacpy( lapack::MatrixType::General, n, nfound,
+                       &Z[0], ldz,
+                       &W[0], ldw );
+        col_scale( n, nfound, &W[0], ldw, &Lambda_tst[0] );
+        // W = A Z - (Z Lambda)
+        blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo, n, nfound,
+                    one,  &A_ref[0], lda,
+                    &Z[0], ldz,
+                    -one, &W[0], ldw );
+        real_t error = lapack::lange( lapack::Norm::One, n, nfound, &W[0], ldw );
+        error /= (n * Anorm * Znorm);
+
+        // Orthogonality = || I - Z^H Z || / n; eigenvectors from different
+        // slices are computed independently, so this checks slicing.
+        std::vector< scalar_t > I( nfound * nfound );
+        lapack::laset( lapack::MatrixType::General, nfound, nfound,
+                       0.0, 1.0, &I[0], nfound );
+        blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                    blas::Op::ConjTrans, nfound, n,
+                    -1.0, &Z[0], ldz, 1.0, &I[0], nfound );
+        real_t ortho = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                      nfound, &I[0], nfound ) / n;
+
+        params.error() = error;
+        params.ortho() = ortho;
+        params.okay() = (error < tol) && (ortho < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        std::vector< scalar_t > Z_ref( size_Z );
+        real_t abstol = 0;
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::heevx(
+                               jobz, range, uplo, n,
+                               &A_ref[0], lda,
+                               vl, vu, il, iu, abstol, &nfound_ref,
+                               &Lambda_ref[0], &Z_ref[0], ldz, &ifail_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::heevx returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference
+        // Eigenvalues are accurate to about eps ||A||.
+        real_t error = 0;
+        if (nfound != nfound_ref || info_tst != info_ref) {
+            error = 1;
+        }
+        else if (nfound > 0) {
+            real_t Lnorm = blas::max( std::abs( Lambda_ref[ 0 ] ),
+                                      std::abs( Lambda_ref[ nfound-1 ] ) );
+            for (int64_t i = 0; i < nfound; ++i)
+                error = blas::max( error, std::abs( Lambda_tst[ i ] - Lambda_ref[ i ] ) );
+            if (Lnorm > 0)
+                error /= (n * Lnorm);
+        }
+        params.error2() = error;
+        params.okay() = params.okay() && (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_heevx_slice( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_heevx_slice_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_heevx_slice_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_heevx_slice_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_heevx_slice_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,197 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/instrument.hh"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Checks the instrument API: calls a few wrappers with instrumentation
+// enabled and checks the recorded routine names, precisions, dimensions,
+// and call counts, the callbacks, the dump, reset, and that nothing is
+// recorded while disabled.
+template< typename scalar_t >
+void test_instrument_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t verbose = params.verbose();
+
+    if (! run)
+        return;
+
+    if (! lapack::instrument_available()) {
+        params.msg() = "skipping: requires LAPACK++ built with instrument";
+        return;
+    }
+    if (m < 1 || n < 1 || nrhs < 1) {
+        params.msg() = "skipping: requires m, n, nrhs >= 1";
+        return;
+    }
+
+    // ---------- setup
+    char type = std::is_same< real_t, float >::value
+              ? (blas::is_complex< scalar_t >::value ? 'c' : 's')
+              : (blas::is_complex< scalar_t >::value ? 'z' : 'd');
+    int64_t lda = blas::max( 1, m );
+    int64_t ldan = n;
+    std::vector< scalar_t > A( lda * n ), An( ldan * n ), B( ldan * nrhs );
+    std::vector< scalar_t > tau( blas::min( m, n ) );
+    std::vector< int64_t > ipiv( n );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+
+    bool okay = true;
+    auto check = [&]( bool cond, char const* msg ) {
+        if (! cond) {
+            if (verbose >= 1)
+                printf( "failed: %s\n", msg );
+            okay = false;
+        }
+    };
+
+    // Calls getrf twice and getrs once on n-by-n, and geqrf on m-by-n.
+    auto call_wrappers = [&]() {
+        for (int rep = 0; rep < 2; ++rep) {
+            lapack::larnv( idist, iseed, An.size(), &An[0] );
+            for (int64_t i = 0; i < n; ++i)
+                An[ i + i*ldan ] += real_t( n );  // diagonally dominant
+            lapack::getrf( n, n, &An[0], ldan, &ipiv[0] );
+        }
+        lapack::larnv( idist, iseed, B.size(), &B[0] );
+        lapack::getrs( lapack::Op::NoTrans, n, nrhs, &An[0], ldan, &ipiv[0],
+                       &B[0], ldan );
+        lapack::larnv( idist, iseed, A.size(), &A[0] );
+        lapack::geqrf( m, n, &A[0], lda, &tau[0] );
+    };
+
+    // Events seen by the callbacks.
+    std::vector< std::string > begin_names, end_names;
+    bool begin_time_zero = true, end_time_set = true, type_okay = true;
+    lapack::instrument_set_callbacks(
+        [&]( lapack::InstrumentEvent const& event ) {
+            begin_names.push_back( event.routine );
+            begin_time_zero = begin_time_zero && event.time == 0;
+        },
+        [&]( lapack::InstrumentEvent const& event ) {
+            end_names.push_back( event.routine );
+            end_time_set = end_time_set && event.time >= 0;
+            type_okay = type_okay && event.type == type;
+        } );
+
+    double time = testsweeper::get_wtime();
+
+    // ---------- disabled: no records, no callbacks
+    lapack::instrument_enable( false );
+    lapack::instrument_reset();
+    call_wrappers();
+    check( ! lapack::instrument_enabled(), "enabled after disable" );
+    check( lapack::instrument_records().empty(), "records while disabled" );
+    check( begin_names.empty() && end_names.empty(),
+           "callbacks while disabled" );
+
+    // ---------- enabled
+    lapack::instrument_enable( true );
+    check( lapack::instrument_enabled(), "not enabled" );
+    call_wrappers();
+    lapack::instrument_enable( false );
+
+    std::vector< lapack::InstrumentRecord > records
+        = lapack::instrument_records();
+    if (verbose >= 2)
+        lapack::instrument_dump( stdout );
+
+    // Each routine has one record for its dimensions.
+    auto find = [&]( char const* routine ) -> lapack::InstrumentRecord const* {
+        for (auto const& rec : records) {
+            if (rec.routine == routine)
+                return &rec;
+        }
+        return nullptr;
+    };
+    check( records.size() == 3, "number of records" );
+    auto getrf_rec = find( "getrf" );
+    auto getrs_rec = find( "getrs" );
+    auto geqrf_rec = find( "geqrf" );
+    check( getrf_rec && getrf_rec->type == type
+           && getrf_rec->m == n && getrf_rec->n == n && getrf_rec->k == 0
+           && getrf_rec->calls == 2 && getrf_rec->gflop > 0,
+           "getrf record" );
+    check( getrs_rec && getrs_rec->type == type
+           && getrs_rec->m == n && getrs_rec->n == n && getrs_rec->k == nrhs
+           && getrs_rec->calls == 1,
+           "getrs record" );
+    check( geqrf_rec && geqrf_rec->type == type
+           && geqrf_rec->m == m && geqrf_rec->n == n && geqrf_rec->k == 0
+           && geqrf_rec->calls == 1,
+           "geqrf record" );
+    for (size_t i = 1; i < records.size(); ++i)
+        check( records[ i-1 ].time >= records[ i ].time, "records order" );
+
+    std::vector< std::string > names = { "getrf", "getrf", "getrs", "geqrf" };
+    check( begin_names == names, "begin callbacks" );
+    check( end_names == names, "end callbacks" );
+    check( begin_time_zero, "begin callback time" );
+    check( end_time_set && type_okay, "end callback event" );
+
+    // ---------- dump has a summary and a row per record
+    FILE* file = tmpfile();
+    if (file) {
+        lapack::instrument_dump( file );
+        rewind( file );
+        int getrf_rows = 0;
+        char line[ 1024 ];
+        while (fgets( line, sizeof( line ), file )) {
+            if (strncmp( line, "getrf ", 6 ) == 0)
+                ++getrf_rows;
+        }
+        fclose( file );
+        check( getrf_rows == 2, "dump rows" );
+    }
+
+    // ---------- reset removes records
+    lapack::instrument_reset();
+    check( lapack::instrument_records().empty(), "records after reset" );
+
+    lapack::instrument_set_callbacks( nullptr, nullptr );
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    params.okay() = okay;
+}
+
+// -----------------------------------------------------------------------------
+void test_instrument( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_instrument_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_instrument_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_instrument_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_instrument_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,260 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// @return max | x[i] - y[i] | / max | y[i] |, or the absolute difference if
+// y is zero.
+template< typename T >
+blas::real_type< T > max_diff( std::vector< T > const& x,
+                               std::vector< T > const& y )
+{
+    using real_t = blas::real_type< T >;
+    real_t diff = 0, ymax = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        diff = blas::max( diff, std::abs( x[ i ] - y[ i ] ) );
+        ymax = blas::max( ymax, std::abs( y[ i ] ) );
+    }
+    return ymax > 0 ? diff / ymax : diff;
+}
+
+//------------------------------------------------------------------------------
+// @return true if the 32-bit and 64-bit pivots are the same.
+inline bool same_pivots( std::vector< lapack_int > const& ipiv32,
+                         std::vector< int64_t > const& ipiv64 )
+{
+    for (size_t i = 0; i < ipiv64.size(); ++i) {
+        if (ipiv32[ i ] != ipiv64[ i ])
+            return false;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Checks the overloads that take lapack_int pivots, declared in LP64 builds,
+// against the int64_t overloads: getrf, getrs, getri, gesv, gesv_mixed,
+// sytrf, sytrs, hetrf, hetrs, and laswp must give the same factors,
+// pivots, and solutions.
+template< typename scalar_t >
+void test_ipiv32_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    if (! run)
+        return;
+
+    #ifdef LAPACK_ILP64
+        params.msg() = "skipping: lapack_int is int64_t in ILP64 builds";
+        return;
+    #else
+
+    if (m < 1 || n < 1 || nrhs < 1) {
+        params.msg() = "skipping: requires m, n, nrhs >= 1";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldan = roundup( blas::max( 1, n ), align );
+    int64_t ldb = ldan;
+    int64_t minmn = blas::min( m, n );
+
+    // m-by-n general matrix A; n-by-n matrix An, diagonally dominant so the
+    // solves are well conditioned, read as symmetric or Hermitian in its
+    // uplo triangle; right hand sides B.
+    std::vector< scalar_t > A( lda * n );
+    std::vector< scalar_t > An( ldan * n );
+    std::vector< scalar_t > B( ldb * nrhs );
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+    lapack::generate_matrix( params.matrix, n, n, &An[0], ldan );
+    for (int64_t i = 0; i < n; ++i)
+        An[ i + i*ldan ] = std::real( An[ i + i*ldan ] ) + real_t( n );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B.size(), &B[0] );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld, nrhs=%5lld\n",
+                llong( m ), llong( n ), llong( lda ), llong( nrhs ) );
+    }
+
+    bool okay = true;
+    real_t error = 0;
+    auto check = [&]( bool cond, char const* msg ) {
+        if (! cond) {
+            if (verbose >= 1)
+                printf( "failed: %s\n", msg );
+            okay = false;
+        }
+    };
+
+    double time = testsweeper::get_wtime();
+
+    // ---------- getrf, m-by-n
+    {
+        std::vector< scalar_t > A32( A ), A64( A );
+        std::vector< lapack_int > ipiv32( minmn );
+        std::vector< int64_t > ipiv64( minmn );
+        int64_t info32 = lapack::getrf( m, n, &A32[0], lda, &ipiv32[0] );
+        int64_t info64 = lapack::getrf( m, n, &A64[0], lda, &ipiv64[0] );
+        check( info32 == info64 && same_pivots( ipiv32, ipiv64 ), "getrf" );
+        error = blas::max( error, max_diff( A32, A64 ) );
+    }
+
+    // ---------- getrf, getrs, getri, laswp, n-by-n
+    {
+        std::vector< scalar_t > LU32( An ), LU64( An );
+        std::vector< lapack_int > ipiv32( n );
+        std::vector< int64_t > ipiv64( n );
+        int64_t info32 = lapack::getrf( n, n, &LU32[0], ldan, &ipiv32[0] );
+        int64_t info64 = lapack::getrf( n, n, &LU64[0], ldan, &ipiv64[0] );
+        check( info32 == info64 && same_pivots( ipiv32, ipiv64 ),
+               "getrf square" );
+        error = blas::max( error, max_diff( LU32, LU64 ) );
+
+        for (auto trans : { lapack::Op::NoTrans, lapack::Op::ConjTrans }) {
+            std::vector< scalar_t > B32( B ), B64( B );
+            info32 = lapack::getrs( trans, n, nrhs, &LU64[0], ldan,
+                                    &ipiv32[0], &B32[0], ldb );
+            info64 = lapack::getrs( trans, n, nrhs, &LU64[0], ldan,
+                                    &ipiv64[0], &B64[0], ldb );
+            check( info32 == info64, "getrs" );
+            error = blas::max( error, max_diff( B32, B64 ) );
+        }
+
+        std::vector< scalar_t > Ainv32( LU64 ), Ainv64( LU64 );
+        info32 = lapack::getri( n, &Ainv32[0], ldan, &ipiv32[0] );
+        info64 = lapack::getri( n, &Ainv64[0], ldan, &ipiv64[0] );
+        check( info32 == info64, "getri" );
+        error = blas::max( error, max_diff( Ainv32, Ainv64 ) );
+
+        // forward and backward row interchanges
+        for (int64_t incx : { 1, -1 }) {
+            std::vector< scalar_t > B32( B ), B64( B );
+            lapack::laswp( nrhs, &B32[0], ldb, 1, n, &ipiv32[0], incx );
+            lapack::laswp( nrhs, &B64[0], ldb, 1, n, &ipiv64[0], incx );
+            error = blas::max( error, max_diff( B32, B64 ) );
+        }
+    }
+
+    // ---------- gesv
+    {
+        std::vector< scalar_t > A32( An ), A64( An ), B32( B ), B64( B );
+        std::vector< lapack_int > ipiv32( n );
+        std::vector< int64_t > ipiv64( n );
+        int64_t info32 = lapack::gesv( n, nrhs, &A32[0], ldan, &ipiv32[0],
+                                       &B32[0], ldb );
+        int64_t info64 = lapack::gesv( n, nrhs, &A64[0], ldan, &ipiv64[0],
+                                       &B64[0], ldb );
+        check( info32 == info64 && same_pivots( ipiv32, ipiv64 ), "gesv" );
+        error = blas::max( error, max_diff( A32, A64 ) );
+        error = blas::max( error, max_diff( B32, B64 ) );
+    }
+
+    // ---------- gesv_mixed, only in double precision
+    if constexpr (std::is_same< real_t, double >::value) {
+        std::vector< scalar_t > A32( An ), A64( An );
+        std::vector< scalar_t > X32( B.size() ), X64( B.size() );
+        std::vector< lapack_int > ipiv32( n );
+        std::vector< int64_t > ipiv64( n );
+        int64_t iter32 = 0, iter64 = 0;
+        int64_t info32 = lapack::gesv_mixed( n, nrhs, &A32[0], ldan,
+                                             &ipiv32[0], &B[0], ldb,
+                                             &X32[0], ldb, &iter32 );
+        int64_t info64 = lapack::gesv_mixed( n, nrhs, &A64[0], ldan,
+                                             &ipiv64[0], &B[0], ldb,
+                                             &X64[0], ldb, &iter64 );
+        check( info32 == info64 && iter32 == iter64
+               && same_pivots( ipiv32, ipiv64 ), "gesv_mixed" );
+        error = blas::max( error, max_diff( X32, X64 ) );
+    }
+
+    // ---------- sytrf, sytrs
+    {
+        std::vector< scalar_t > A32( An ), A64( An ), B32( B ), B64( B );
+        std::vector< lapack_int > ipiv32( n );
+        std::vector< int64_t > ipiv64( n );
+        int64_t info32 = lapack::sytrf( uplo, n, &A32[0], ldan, &ipiv32[0] );
+        int64_t info64 = lapack::sytrf( uplo, n, &A64[0], ldan, &ipiv64[0] );
+        check( info32 == info64 && same_pivots( ipiv32, ipiv64 ), "sytrf" );
+        error = blas::max( error, max_diff( A32, A64 ) );
+
+        info32 = lapack::sytrs( uplo, n, nrhs, &A64[0], ldan, &ipiv32[0],
+                                &B32[0], ldb );
+        info64 = lapack::sytrs( uplo, n, nrhs, &A64[0], ldan, &ipiv64[0],
+                                &B64[0], ldb );
+        check( info32 == info64, "sytrs" );
+        error = blas::max( error, max_diff( B32, B64 ) );
+    }
+
+    // ---------- hetrf, hetrs (sytrf, sytrs for real)
+    {
+        std::vector< scalar_t > A32( An ), A64( An ), B32( B ), B64( B );
+        std::vector< lapack_int > ipiv32( n );
+        std::vector< int64_t > ipiv64( n );
+        int64_t info32 = lapack::hetrf( uplo, n, &A32[0], ldan, &ipiv32[0] );
+        int64_t info64 = lapack::hetrf( uplo, n, &A64[0], ldan, &ipiv64[0] );
+        check( info32 == info64 && same_pivots( ipiv32, ipiv64 ), "hetrf" );
+        error = blas::max( error, max_diff( A32, A64 ) );
+
+        info32 = lapack::hetrs( uplo, n, nrhs, &A64[0], ldan, &ipiv32[0],
+                                &B32[0], ldb );
+        info64 = lapack::hetrs( uplo, n, nrhs, &A64[0], ldan, &ipiv64[0],
+                                &B64[0], ldb );
+        check( info32 == info64, "hetrs" );
+        error = blas::max( error, max_diff( B32, B64 ) );
+    }
+
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    params.error() = error;
+    params.okay() = okay && (error < tol);
+
+    #endif  // LAPACK_ILP64
+}
+
+// -----------------------------------------------------------------------------
+void test_ipiv32( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_ipiv32_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_ipiv32_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_ipiv32_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_ipiv32_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -24,6 +24,8 @@ void test_posv_work( Params& params, bool run )
     int64_t nrhs = params.nrhs();
     int64_t align = params.align();
     int64_t verbose = params.verbose();
+    lapack::Method method = params.method();
+    int64_t nb = params.nb();
 
     real_t eps = std::numeric_limits< real_t >::epsilon();
     real_t tol = params.tol() * eps;
@@ -68,6 +70,11 @@ void test_posv_work( Params& params, bool run )
         printf( "B = " ); print_matrix( n, nrhs, &B_tst[0], ldb );
     }
 
+    // select implementation of lapack::posv
+    lapack::potrf_set_method( method );
+    if (method == lapack::Method::Native)
+        lapack::potrf_set_block_size( nb );
+
     // test error exits
     if (params.error_exit() == 'y') {
         using lapack::Uplo;
@@ -84,6 +91,7 @@ void test_posv_work( Params& params, bool run )
     int64_t info_tst = lapack::posv(
         uplo, n, nrhs, &A_tst[0], lda, &B_tst[0], ldb );
     time = testsweeper::get_wtime() - time;
+    lapack::potrf_set_method( lapack::Method::Vendor );
     if (info_tst != 0) {
         fprintf( stderr, "lapack::posv returned error %lld\n", llong( info_tst ) );
     }
@@ -23,6 +23,8 @@ void test_potrf_work( Params& params, bool run )
     int64_t n = params.dim.n();
     int64_t align = params.align();
     int64_t verbose = params.verbose();
+    lapack::Method method = params.method();
+    int64_t nb = params.nb();
     params.matrix.mark();
 
     real_t eps = std::numeric_limits< real_t >::epsilon();
@@ -57,6 +59,11 @@ void test_potrf_work( Params& params, bool run )
         printf( "A = " ); print_matrix( n, n, &A_tst[0], lda );
     }
 
+    // select implementation of lapack::potrf
+    lapack::potrf_set_method( method );
+    if (method == lapack::Method::Native)
+        lapack::potrf_set_block_size( nb );
+
     // test error exits
     if (params.error_exit() == 'y') {
         using lapack::Uplo;
@@ -70,6 +77,7 @@ void test_potrf_work( Params& params, bool run )
     double time = testsweeper::get_wtime();
     int64_t info_tst = lapack::potrf( uplo, n, &A_tst[0], lda );
     time = testsweeper::get_wtime() - time;
+    lapack::potrf_set_method( lapack::Method::Vendor );
     if (info_tst != 0) {
         fprintf( stderr, "lapack::potrf returned error %lld\n", llong( info_tst ) );
     }
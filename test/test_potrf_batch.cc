@@ -0,0 +1,168 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_potrf_batch_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.error2();
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+
+    std::vector< scalar_t > A_tst( size_A * batch );
+    std::vector< scalar_t > A_ref( size_A * batch );
+    std::vector< int64_t > info_tst( batch );
+
+    std::vector< scalar_t* > Aarray( batch );
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*size_A ], lda );
+        Aarray[ i ] = &A_tst[ i*size_A ];
+    }
+    A_ref = A_tst;
+    std::vector< scalar_t > A_orig = A_tst;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A n=%5lld, lda=%5lld, batch=%5lld\n",
+                llong( n ), llong( lda ), llong( batch ) );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        using lapack::Uplo;
+        assert_throw( lapack::potrf_batch( Uplo(0),  n, &Aarray[0], lda, &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::potrf_batch( uplo,    -1, &Aarray[0], lda, &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::potrf_batch( uplo,     n, &Aarray[0], n-1, &info_tst[0], batch ), lapack::Error );
+        assert_throw( lapack::potrf_batch( uplo,     n, &Aarray[0], lda, &info_tst[0],    -1 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::potrf_batch( uplo, n, &Aarray[0], lda, &info_tst[0], batch );
+    time = testsweeper::get_wtime() - time;
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0) {
+            fprintf( stderr, "lapack::potrf_batch returned error %lld for matrix %lld\n",
+                     llong( info_tst[ i ] ), llong( i ) );
+        }
+    }
+
+    params.time() = time;
+    double gflop = batch * lapack::Gflop< scalar_t >::potrf( n );
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference, looping over non-batched potrf
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            int64_t info_ref = lapack::potrf( uplo, n, &A_ref[ i*size_A ], lda );
+            if (info_ref != 0) {
+                fprintf( stderr, "lapack::potrf returned error %lld for matrix %lld\n",
+                         llong( info_ref ), llong( i ) );
+            }
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        // ---------- check error compared to reference
+        real_t error = rel_error( A_tst, A_ref );
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+
+    if (params.check() == 'y') {
+        // ---------- check solve, using strided potrs
+        // Relative backwards error = max_i ||b_i - A_i x_i|| / (n ||A_i|| ||x_i||).
+        int64_t ldb = roundup( blas::max( 1, n ), align );
+        int64_t idist = 1;
+        int64_t iseed[4] = { 0, 1, 2, 3 };
+        std::vector< scalar_t > B_tst( ldb * batch );
+        lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+        std::vector< scalar_t > B_ref = B_tst;
+
+        lapack::potrs_strided_batch(
+            uplo, n, 1, &A_tst[0], lda, size_A, &B_tst[0], ldb, ldb,
+            &info_tst[0], batch );
+
+        real_t error = 0;
+        for (int64_t i = 0; i < batch; ++i) {
+            if (info_tst[ i ] != 0)
+                continue;
+            scalar_t* Ai = &A_orig[ i*size_A ];
+            scalar_t* xi = &B_tst[ i*ldb ];
+            scalar_t* bi = &B_ref[ i*ldb ];
+            real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, Ai, lda );
+            real_t Xnorm = lapack::lange( lapack::Norm::One, n, 1, xi, ldb );
+            blas::hemv( blas::Layout::ColMajor, uplo, n,
+                        -1.0, Ai, lda, xi, 1, 1.0, bi, 1 );
+            real_t Rnorm = lapack::lange( lapack::Norm::One, n, 1, bi, ldb );
+            error = blas::max( error, Rnorm / (n * Anorm * Xnorm) );
+        }
+        params.error2() = error;
+        params.okay() = params.okay() && (error < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_potrf_batch( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_potrf_batch_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_batch_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_batch_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_batch_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
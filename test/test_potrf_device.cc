@@ -6,6 +6,7 @@
 #include "test.hh"
 #include "lapack.hh"
 #include "lapack/device.hh"
+#include "device_util.hh"
 #include "lapack/flops.hh"
 #include "print_matrix.hh"
 #include "error.hh"
@@ -41,8 +42,8 @@ void test_potrf_device_work( Params& params, bool run )
         return;
     }
 
-    if (blas::get_device_count() == 0) {
-        params.msg() = "skipping: no GPU devices or no GPU support";
+    if (! test_device::available()) {
+        params.msg() = "skipping: no GPU devices";
         return;
     }
 
@@ -58,9 +59,9 @@ void test_potrf_device_work( Params& params, bool run )
 
     // Allocate and copy to GPU.
     lapack::Queue queue( device );
-    scalar_t*        dA_tst = blas::device_malloc< scalar_t >( size_A, queue );
-    device_info_int* d_info = blas::device_malloc< device_info_int >( 1, queue );
-    blas::device_copy_matrix( n, n, A_tst.data(), lda, dA_tst, lda, queue );
+    scalar_t*        dA_tst = test_device::device_malloc< scalar_t >( size_A, queue );
+    device_info_int* d_info = test_device::device_malloc< device_info_int >( 1, queue );
+    test_device::device_copy_matrix( n, n, A_tst.data(), lda, dA_tst, lda, queue );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -95,8 +96,8 @@ void test_potrf_device_work( Params& params, bool run )
 
     // Copy result back to CPU.
     device_info_int info_tst;
-    blas::device_copy_matrix( n, n, dA_tst, lda, A_tst.data(), lda, queue );
-    blas::device_memcpy( &info_tst, d_info, 1, queue );
+    test_device::device_copy_matrix( n, n, dA_tst, lda, A_tst.data(), lda, queue );
+    test_device::device_memcpy( &info_tst, d_info, 1, queue );
     queue.sync();
 
     if (info_tst != 0) {
@@ -104,8 +105,8 @@ void test_potrf_device_work( Params& params, bool run )
     }
 
     // Cleanup GPU memory.
-    blas::device_free( dA_tst, queue );
-    blas::device_free( d_info, queue );
+    test_device::device_free( dA_tst, queue );
+    test_device::device_free( d_info, queue );
 
     if (verbose >= 2) {
         printf( "A_factor = " ); print_matrix( n, n, &A_tst[0], lda );
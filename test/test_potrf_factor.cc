@@ -0,0 +1,157 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_potrf_factor_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.error2();
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > B_ref( size_B );
+    std::vector< scalar_t > X_tst( size_B );
+
+    lapack::generate_matrix( params.matrix, n, n, &A[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_ref.size(), &B_ref[0] );
+    X_tst = B_ref;
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::CholeskyFactor< scalar_t >( uplo, -1, &A[0], lda ), lapack::Error );
+        assert_throw( lapack::CholeskyFactor< scalar_t >( uplo,  n, &A[0], n-1 ), lapack::Error );
+    }
+
+    // ---------- run test: factor once, solve with all columns at once
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::CholeskyFactor< scalar_t > LLt( uplo, n, &A[0], lda );
+    if (LLt.info() == 0)
+        LLt.solve( nrhs, &X_tst[0], ldb );
+    time = testsweeper::get_wtime() - time;
+    if (LLt.info() != 0) {
+        fprintf( stderr, "lapack::CholeskyFactor returned error %lld\n", llong( LLt.info() ) );
+    }
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::potrf( n )
+                 + lapack::Gflop< scalar_t >::potrs( n, nrhs );
+    params.gflops() = gflop / time;
+
+    if (params.check() == 'y' && LLt.info() == 0) {
+        // ---------- check error
+        // Relative backwards error = ||b - A x|| / (n * ||A|| * ||x||),
+        // for the batch solve and for column-by-column solves.
+        std::vector< scalar_t > X_vec = B_ref;
+        for (int64_t j = 0; j < nrhs; ++j)
+            LLt.solve( &X_vec[ j*ldb ] );
+
+        real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, &A[0], lda );
+        real_t error = 0;
+        for (auto* X : { &X_tst, &X_vec }) {
+            std::vector< scalar_t > R = B_ref;
+            blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo,
+                        n, nrhs,
+                        -1.0, &A[0], lda, &(*X)[0], ldb,
+                         1.0, &R[0], ldb );
+            real_t Rnorm = lapack::lange( lapack::Norm::One, n, nrhs, &R[0], ldb );
+            real_t Xnorm = lapack::lange( lapack::Norm::One, n, nrhs, &(*X)[0], ldb );
+            if (n > 0)
+                error = blas::max( error, Rnorm / (n * Anorm * Xnorm) );
+        }
+        params.error() = error;
+
+        // rcond should match pocon, as it calls pocon.
+        std::vector< scalar_t > LLt_ref = A;
+        lapack::potrf( uplo, n, &LLt_ref[0], lda );
+        real_t rcond_ref;
+        lapack::pocon( uplo, n, &LLt_ref[0], lda, Anorm, &rcond_ref );
+        real_t rcond_tst = LLt.rcond();
+        params.error2() = std::abs( rcond_tst - rcond_ref ) / rcond_ref;
+        params.okay() = (error < tol) && (params.error2() < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference, potrf and potrs
+        std::vector< scalar_t > LLt_ref = A;
+        std::vector< scalar_t > X_ref = B_ref;
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::potrf( uplo, n, &LLt_ref[0], lda );
+        if (info_ref == 0) {
+            lapack::potrs( uplo, n, nrhs, &LLt_ref[0], lda, &X_ref[0], ldb );
+        }
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::potrf returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_potrf_factor( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_potrf_factor_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_factor_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_factor_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_factor_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,159 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_potrf_ooc_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    int64_t bytes = size_A * sizeof( scalar_t );
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+
+    lapack::generate_matrix( params.matrix, n, n, &A_ref[0], lda );
+
+    // Factor with each storage backend; time the last, pread.
+    std::string path = (std::filesystem::temp_directory_path()
+                        / "lapackpp_potrf_ooc.bin").string();
+    double time = 0;
+    int64_t info_tst = 0;
+    real_t error = 0;
+    for (int backend = 0; backend < 2; ++backend) {
+        std::remove( path.c_str() );
+        std::shared_ptr< lapack::OocStorage > storage
+            = (backend == 0 ? lapack::mmap_storage( path, bytes )
+                            : lapack::pread_storage( path, bytes ));
+        storage->write( 0, bytes, &A_ref[0] );
+
+        // ---------- run test
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        info_tst = lapack::potrf_ooc< scalar_t >( uplo, n, *storage, lda, nb );
+        time = testsweeper::get_wtime() - time;
+        if (info_tst != 0) {
+            fprintf( stderr, "lapack::potrf_ooc returned error %lld\n", llong( info_tst ) );
+        }
+
+        storage->read( 0, bytes, &A_tst[0] );
+        storage = nullptr;
+        std::remove( path.c_str() );
+
+        if (params.check() == 'y') {
+            // ---------- check error
+            // Relative backwards error = ||b - Ax|| / (n * ||A|| * ||x||).
+            int64_t nrhs = 1;
+            int64_t ldb = roundup( blas::max( 1, n ), align );
+            size_t size_B = (size_t) ldb * nrhs;
+            std::vector< scalar_t > B_tst( size_B );
+            std::vector< scalar_t > B_ref( size_B );
+            int64_t idist = 1;
+            int64_t iseed[4] = { 0, 1, 2, 3 };
+            lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+            B_ref = B_tst;
+
+            int64_t info_potrs = lapack::potrs(
+                uplo, n, nrhs, &A_tst[0], lda, &B_tst[0], ldb );
+            if (info_potrs != 0) {
+                fprintf( stderr, "lapack::potrs returned error %lld\n", llong( info_potrs ) );
+            }
+
+            blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo,
+                        n, nrhs,
+                        -1.0, &A_ref[0], lda,
+                              &B_tst[0], ldb,
+                         1.0, &B_ref[0], ldb );
+
+            real_t err = lapack::lange( lapack::Norm::One, n, nrhs, &B_ref[0], ldb );
+            real_t Xnorm = lapack::lange( lapack::Norm::One, n, nrhs, &B_tst[0], ldb );
+            real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, &A_ref[0], lda );
+            error = blas::max( error, err / (n * Anorm * Xnorm) );
+        }
+    }
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::potrf( n );
+    params.gflops() = gflop / time;
+
+    if (params.check() == 'y') {
+        params.error() = error;
+        params.okay() = (info_tst == 0) && (error < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference, in memory
+        A_tst = A_ref;
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::potrf( uplo, n, &A_tst[0], lda );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::potrf returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_potrf_ooc( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_potrf_ooc_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_ooc_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_ooc_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_ooc_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
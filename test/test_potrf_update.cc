@@ -0,0 +1,197 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Returns || L L^H - A ||_1 / (n ||A||_1), or || U^H U - A ||_1 / (n ||A||_1),
+// for the factor in the uplo triangle of LLt. Only the uplo triangle of A
+// is referenced.
+template< typename scalar_t >
+blas::real_type< scalar_t > check_potrf_factor(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* LLt, int64_t ldl )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    if (n == 0)
+        return 0;
+
+    std::vector< scalar_t > F( lda * n, 0 ), R( lda * n );
+    lapack::lacpy( (uplo == lapack::Uplo::Lower ? lapack::MatrixType::Lower
+                                                : lapack::MatrixType::Upper),
+                   n, n, LLt, ldl, &F[0], lda );
+    lapack::lacpy( lapack::MatrixType::General, n, n, A, lda, &R[0], lda );
+    blas::herk( blas::Layout::ColMajor, uplo,
+                (uplo == lapack::Uplo::Lower ? blas::Op::NoTrans
+                                             : blas::Op::ConjTrans),
+                n, n, 1.0, &F[0], lda, -1.0, &R[0], lda );
+    real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, A, lda );
+    real_t Rnorm = lapack::lanhe( lapack::Norm::One, uplo, n, &R[0], lda );
+    return Rnorm / (n * Anorm);
+}
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_potrf_update_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    using blas::conj;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t k = params.dim.k();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.error2();
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldx = lda;
+    size_t size_A = (size_t) lda * n;
+    size_t size_X = (size_t) ldx * k;
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > L_tst( size_A );
+    std::vector< scalar_t > X( size_X );
+    std::vector< scalar_t > X_tmp( size_X );
+
+    lapack::generate_matrix( params.matrix, n, n, &A[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, X.size(), &X[0] );
+
+    // A_up = A + X X^H, in the uplo triangle.
+    std::vector< scalar_t > A_up = A;
+    blas::herk( blas::Layout::ColMajor, uplo, blas::Op::NoTrans, n, k,
+                1.0, &X[0], ldx, 1.0, &A_up[0], lda );
+
+    L_tst = A;
+    int64_t info = lapack::potrf( uplo, n, &L_tst[0], lda );
+    if (info != 0) {
+        fprintf( stderr, "lapack::potrf returned error %lld\n", llong( info ) );
+        return;
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::potrf_update( lapack::Uplo::General, n, k, &L_tst[0], lda, &X_tmp[0], ldx ), lapack::Error );
+        assert_throw( lapack::potrf_update( uplo, -1,  k, &L_tst[0], lda, &X_tmp[0], ldx ), lapack::Error );
+        assert_throw( lapack::potrf_update( uplo,  n, -1, &L_tst[0], lda, &X_tmp[0], ldx ), lapack::Error );
+        assert_throw( lapack::potrf_update( uplo,  n,  k, &L_tst[0], n-1, &X_tmp[0], ldx ), lapack::Error );
+        assert_throw( lapack::potrf_update( uplo,  n,  k, &L_tst[0], lda, &X_tmp[0], n-1 ), lapack::Error );
+        assert_throw( lapack::potrf_downdate( uplo, -1,  k, &L_tst[0], lda, &X_tmp[0], ldx ), lapack::Error );
+        assert_throw( lapack::potrf_downdate( uplo,  n,  k, &L_tst[0], n-1, &X_tmp[0], ldx ), lapack::Error );
+    }
+
+    // ---------- run test: update
+    X_tmp = X;
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::potrf_update( uplo, n, k, &L_tst[0], lda, &X_tmp[0], ldx );
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+
+    if (params.check() == 'y') {
+        // ---------- check error
+        // Update:   || L L^H - (A + X X^H) || / (n ||A + X X^H||).
+        // Downdate: subtracting X X^H again should give the factor of A.
+        real_t error = check_potrf_factor( uplo, n, &A_up[0], lda,
+                                           &L_tst[0], lda );
+
+        X_tmp = X;
+        int64_t info_dn = lapack::potrf_downdate( uplo, n, k, &L_tst[0], lda,
+                                                  &X_tmp[0], ldx );
+        if (info_dn != 0) {
+            fprintf( stderr, "lapack::potrf_downdate returned error %lld\n",
+                     llong( info_dn ) );
+        }
+        real_t error2 = check_potrf_factor( uplo, n, &A[0], lda,
+                                            &L_tst[0], lda );
+
+        // Downdating by the first column of L (row of U), so that
+        // A - x x^H is singular, must fail without changing the factor.
+        bool okay_fail = true;
+        if (n > 0) {
+            std::vector< scalar_t > L_save = L_tst;
+            std::vector< scalar_t > x( ldx );
+            for (int64_t i = 0; i < n; ++i) {
+                x[ i ] = (uplo == lapack::Uplo::Lower
+                          ? L_tst[ i ]
+                          : conj( L_tst[ i*lda ] ));
+            }
+            int64_t info_fail = lapack::potrf_downdate( uplo, n, 1,
+                                                        &L_tst[0], lda,
+                                                        &x[0], ldx );
+            okay_fail = (info_fail == 1 && L_tst == L_save);
+        }
+
+        params.error()  = error;
+        params.error2() = error2;
+        params.okay() = (error < tol) && (error2 < tol) && (info_dn == 0)
+                        && okay_fail;
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference, refactor A + X X^H with potrf
+        std::vector< scalar_t > L_ref = A_up;
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::potrf( uplo, n, &L_ref[0], lda );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::potrf returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_potrf_update( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_potrf_update_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_update_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_update_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_update_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -24,6 +24,8 @@ void test_potri_work( Params& params, bool run )
     int64_t n = params.dim.n();
     int64_t align = params.align();
     int64_t verbose = params.verbose();
+    lapack::Method method = params.method();
+    int64_t nb = params.nb();
     params.matrix.mark();
 
     real_t eps = std::numeric_limits< real_t >::epsilon();
@@ -63,6 +65,11 @@ void test_potri_work( Params& params, bool run )
         fprintf( stderr, "lapack::potrf returned error %lld\n", llong( info ) );
     }
 
+    // select implementation of lapack::potri
+    lapack::potrf_set_method( method );
+    if (method == lapack::Method::Native)
+        lapack::potrf_set_block_size( nb );
+
     // test error exits
     if (params.error_exit() == 'y') {
         using lapack::Uplo;
@@ -76,6 +83,7 @@ void test_potri_work( Params& params, bool run )
     double time = testsweeper::get_wtime();
     int64_t info_tst = lapack::potri( uplo, n, &A_tst[0], lda );
     time = testsweeper::get_wtime() - time;
+    lapack::potrf_set_method( lapack::Method::Vendor );
     if (info_tst != 0) {
         fprintf( stderr, "lapack::potri returned error %lld\n", llong( info_tst ) );
     }
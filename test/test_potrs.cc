@@ -24,6 +24,8 @@ void test_potrs_work( Params& params, bool run )
     int64_t nrhs = params.nrhs();
     int64_t align = params.align();
     int64_t verbose = params.verbose();
+    lapack::Method method = params.method();
+    int64_t nb = params.nb();
     params.matrix.mark();
 
     // mark non-standard output values
@@ -70,6 +72,11 @@ void test_potrs_work( Params& params, bool run )
         printf( "B = " ); print_matrix( n, nrhs, &B_tst[0], lda );
     }
 
+    // select implementation of lapack::potrs
+    lapack::potrf_set_method( method );
+    if (method == lapack::Method::Native)
+        lapack::potrf_set_block_size( nb );
+
     // test error exits
     if (params.error_exit() == 'y') {
         using lapack::Uplo;
@@ -85,6 +92,7 @@ void test_potrs_work( Params& params, bool run )
     double time = testsweeper::get_wtime();
     int64_t info_tst = lapack::potrs( uplo, n, nrhs, &A[0], lda, &B_tst[0], ldb );
     time = testsweeper::get_wtime() - time;
+    lapack::potrf_set_method( lapack::Method::Vendor );
     if (info_tst != 0) {
         fprintf( stderr, "lapack::potrs returned error %lld\n", llong( info_tst ) );
     }
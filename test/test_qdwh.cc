@@ -0,0 +1,177 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/polar.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <algorithm>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_qdwh_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // Constants
+    const scalar_t zero = 0.0;
+    const scalar_t one = 1.0;
+    const real_t   eps = std::numeric_limits< real_t >::epsilon();
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t rank = params.rank();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    real_t tol = params.tol() * eps;
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ortho();
+    params.error2();
+    params.error2.name( "H min eig" );
+
+    if (! run)
+        return;
+
+    if (m < n) {
+        params.msg() = "skipping: requires m >= n";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldh = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_H = (size_t) ldh * n;
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > U( size_A );
+    std::vector< scalar_t > H( size_H );
+
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+
+    // For rank r < n, A( :, r:n-1 ) = A( :, 0:r-1 ) B, with B random
+    // except its first column is zero, so A( :, r ) = 0.
+    if (rank >= 0 && rank < n) {
+        std::vector< scalar_t > B( blas::max( 1, rank * (n - rank) ) );
+        int64_t iseed[ 4 ] = { 0, 0, 0, 1 };
+        lapack::larnv( 1, iseed, B.size(), &B[0] );
+        std::fill( B.begin(), B.begin() + rank, zero );
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans,
+                    blas::Op::NoTrans, m, n - rank, rank,
+                    one,  &A[0], lda, &B[0], blas::max( 1, rank ),
+                    zero, &A[ rank*lda ], lda );
+    }
+    U = A;
+
+    if (verbose >= 1) {
+        printf( "\n" );
+        printf( "A m=%5lld, n=%5lld, lda=%5lld\n",
+                llong( m ), llong( n ), llong( lda ) );
+    }
+    if (verbose >= 2) {
+        printf( "A = " );
+        print_matrix( m, n, &A[0], lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::qdwh( -1,  n,  &U[0], lda, &H[0], ldh ), lapack::Error );
+        assert_throw( lapack::qdwh(  m, -1,  &U[0], lda, &H[0], ldh ), lapack::Error );
+        assert_throw( lapack::qdwh(  m, m+1, &U[0], lda, &H[0], ldh ), lapack::Error );
+        assert_throw( lapack::qdwh(  m,  n,  &U[0], m-1, &H[0], ldh ), lapack::Error );
+        assert_throw( lapack::qdwh(  m,  n,  &U[0], lda, &H[0], n-1 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::qdwh( m, n, &U[0], lda, &H[0], ldh );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::qdwh returned error %lld\n", llong( info_tst ) );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "U = " );
+        print_matrix( m, n, &U[0], lda );
+        printf( "H = " );
+        print_matrix( n, n, &H[0], ldh );
+    }
+
+    if (params.check() == 'y' && n > 0) {
+        // ---------- check error
+        // || A - U H ||_1 / (||A||_1 * m)
+        real_t Anorm = lapack::lange( lapack::Norm::One, m, n, &A[0], lda );
+        std::vector< scalar_t > R = A;
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans,
+                    blas::Op::NoTrans, m, n, n,
+                    -one, &U[0], lda, &H[0], ldh,
+                    one,  &R[0], lda );
+        real_t error = lapack::lange( lapack::Norm::One, m, n, &R[0], lda );
+        if (Anorm != 0)
+            error /= Anorm;
+        error /= m;
+
+        // || I - U^H U || / m
+        std::vector< scalar_t > I( n * n );
+        lapack::laset( lapack::MatrixType::General, n, n,
+                       0.0, 1.0, &I[0], n );
+        blas::herk( blas::Layout::ColMajor, lapack::Uplo::Upper,
+                    blas::Op::ConjTrans, n, m,
+                    -1.0, &U[0], lda, 1.0, &I[0], n );
+        real_t ortho = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                                      n, &I[0], n ) / m;
+
+        // H is positive semidefinite: lambda_min( H ) >= -tol ||A||_2,
+        // with ||A||_2 = lambda_max( H )
+        std::vector< real_t > Lambda( n );
+        std::vector< scalar_t > H2 = H;
+        lapack::heevd( lapack::Job::NoVec, lapack::Uplo::Lower, n,
+                       &H2[0], ldh, &Lambda[0] );
+        real_t error2 = 0;
+        if (Lambda[ n-1 ] > 0)
+            error2 = blas::max( -Lambda[ 0 ] / Lambda[ n-1 ], real_t( 0 ) );
+
+        params.error()  = error;
+        params.ortho()  = ortho;
+        params.error2() = error2;
+        params.okay() = (info_tst == 0) && (error < tol) && (ortho < tol)
+                        && (error2 < tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_qdwh( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_qdwh_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_qdwh_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_qdwh_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_qdwh_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
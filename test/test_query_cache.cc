@@ -0,0 +1,135 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/query_cache.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Checks the workspace query cache: repeated queries of the same shape hit,
+// new shapes miss, clear resets the entries and counters, and a disabled
+// cache neither counts nor stores queries.
+template< typename scalar_t >
+void test_query_cache_work( Params& params, bool run )
+{
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t verbose = params.verbose();
+
+    if (! run)
+        return;
+
+    if (m < 1 || n < 1) {
+        params.msg() = "skipping: requires m, n >= 1";
+        return;
+    }
+
+    // ---------- setup
+    const int64_t repeat = 3;
+    int64_t lda = m;
+    std::vector< scalar_t > A( lda * n );
+    std::vector< scalar_t > tau( blas::min( m, n ) );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, A.size(), &A[0] );
+
+    bool okay = true;
+    auto check = [&]( bool cond, char const* msg ) {
+        if (! cond) {
+            if (verbose >= 1)
+                printf( "failed: %s: hits %lld, misses %lld, size %lld\n",
+                        msg, llong( lapack::query_cache_hits() ),
+                        llong( lapack::query_cache_misses() ),
+                        llong( lapack::query_cache_size() ) );
+            okay = false;
+        }
+    };
+    auto counts = []( int64_t hits, int64_t misses, int64_t size ) {
+        return lapack::query_cache_hits() == hits
+            && lapack::query_cache_misses() == misses
+            && lapack::query_cache_size() == size;
+    };
+
+    bool enabled = lapack::query_cache_enabled();
+    double time = testsweeper::get_wtime();
+
+    // ---------- disabled: nothing counted or stored
+    lapack::query_cache_enable( false );
+    lapack::query_cache_clear();
+    check( ! lapack::query_cache_enabled(), "enabled after disable" );
+    size_t size_ref = 0;
+    lapack::geqrf_work_size_bytes( m, n, &A[0], lda, &tau[0], &size_ref );
+    check( counts( 0, 0, 0 ), "disabled query" );
+
+    // ---------- first query misses, repeated queries hit
+    lapack::query_cache_enable( true );
+    check( lapack::query_cache_enabled(), "not enabled" );
+    size_t size = 0;
+    lapack::geqrf_work_size_bytes( m, n, &A[0], lda, &tau[0], &size );
+    check( counts( 0, 1, 1 ) && size == size_ref, "first query" );
+    for (int64_t i = 1; i <= repeat; ++i) {
+        size = 0;
+        lapack::geqrf_work_size_bytes( m, n, &A[0], lda, &tau[0], &size );
+        check( counts( i, 1, 1 ) && size == size_ref, "repeated query" );
+    }
+
+    // ---------- another shape or routine misses
+    lapack::geqrf_work_size_bytes( m, n-1 > 0 ? n-1 : n+1, &A[0], lda,
+                                   &tau[0], &size );
+    check( counts( repeat, 2, 2 ), "new shape" );
+
+    // the allocating wrapper queries through the cache
+    lapack::gelqf( m, n, &A[0], lda, &tau[0] );
+    check( counts( repeat, 3, 3 ), "first gelqf" );
+    lapack::gelqf( m, n, &A[0], lda, &tau[0] );
+    check( counts( repeat + 1, 3, 3 ), "second gelqf" );
+
+    // ---------- clear resets entries and counters
+    lapack::query_cache_clear();
+    check( counts( 0, 0, 0 ), "clear" );
+    lapack::geqrf_work_size_bytes( m, n, &A[0], lda, &tau[0], &size );
+    check( counts( 0, 1, 1 ) && size == size_ref, "query after clear" );
+
+    // ---------- disabling keeps entries but skips the cache
+    lapack::query_cache_enable( false );
+    lapack::geqrf_work_size_bytes( m, n, &A[0], lda, &tau[0], &size );
+    check( counts( 0, 1, 1 ) && size == size_ref, "disabled keeps entries" );
+
+    time = testsweeper::get_wtime() - time;
+    lapack::query_cache_clear();
+    lapack::query_cache_enable( enabled );
+
+    params.time() = time;
+    params.okay() = okay;
+}
+
+// -----------------------------------------------------------------------------
+void test_query_cache( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_query_cache_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_query_cache_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_query_cache_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_query_cache_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,167 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_sturm_batch_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.error2();
+    params.error2.name( "count diff" );
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    // Matrices are interleaved; matrix b is scaled by 10^(6 (b % 5 - 2)),
+    // so the batch mixes tiny and huge matrices.
+    // Shift k of matrix b is between its eigenvalues k-1 and k.
+    int64_t nshift = n + 1;
+    int64_t ldd = roundup( blas::max( 1, batch ), align );
+    int64_t ldu = ldd;
+    int64_t ldc = ldd;
+
+    std::vector< real_t > diag( ldd * n );
+    std::vector< real_t > offd( ldd * blas::max( 1, n-1 ) );
+    std::vector< real_t > u( ldu * nshift );
+    std::vector< int64_t > count_tst( ldc * nshift );
+    std::vector< int64_t > count_ref( ldc * nshift );
+    std::vector< int64_t > count_expect( ldc * nshift );
+
+    int64_t idist = 2;  // uniform (-1, 1)
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    std::vector< real_t > D( n ), E( blas::max( 1, n-1 ) );
+    for (int64_t b = 0; b < batch; ++b) {
+        real_t scale = std::pow( real_t( 10 ), real_t( 6*(b % 5 - 2) ) );
+        lapack::larnv( idist, iseed, n,   &D[0] );
+        lapack::larnv( idist, iseed, n-1, &E[0] );
+        for (int64_t i = 0; i < n; ++i)
+            diag[ b + i*ldd ] = D[ i ] *= scale;
+        for (int64_t i = 0; i < n-1; ++i)
+            offd[ b + i*ldd ] = E[ i ] *= scale;
+
+        // Eigenvalues from sterf give the expected counts, at midpoints
+        // between well separated eigenvalues; others are marked -1.
+        if (n > 0) {
+            real_t tnorm = lapack::lanst( lapack::Norm::Max, n, &D[0], &E[0] );
+            lapack::sterf( n, &D[0], &E[0] );
+            u[ b ] = D[ 0 ] - tnorm;
+            count_expect[ b ] = 0;
+            for (int64_t k = 1; k < n; ++k) {
+                u[ b + k*ldu ] = (D[ k-1 ] + D[ k ]) / 2;
+                count_expect[ b + k*ldc ]
+                    = (D[ k ] - D[ k-1 ] > 100*n*eps*tnorm ? k : -1);
+            }
+            u[ b + n*ldu ] = D[ n-1 ] + tnorm;
+            count_expect[ b + n*ldc ] = n;
+        }
+        else {
+            u[ b ] = 0;
+            count_expect[ b ] = 0;
+        }
+    }
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "n=%5lld, ldd=%5lld, batch=%5lld, nshift=%5lld\n",
+                llong( n ), llong( ldd ), llong( batch ), llong( nshift ) );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::sturm_batch( -1, &diag[0], &offd[0], ldd, nshift, &u[0], ldu, &count_tst[0], ldc, batch ), lapack::Error );
+        assert_throw( lapack::sturm_batch(  n, &diag[0], &offd[0], ldd,     -1, &u[0], ldu, &count_tst[0], ldc, batch ), lapack::Error );
+        assert_throw( lapack::sturm_batch(  n, &diag[0], &offd[0], batch-1, nshift, &u[0], ldu, &count_tst[0], ldc, batch ), lapack::Error );
+        assert_throw( lapack::sturm_batch(  n, &diag[0], &offd[0], ldd, nshift, &u[0], batch-1, &count_tst[0], ldc, batch ), lapack::Error );
+        assert_throw( lapack::sturm_batch(  n, &diag[0], &offd[0], ldd, nshift, &u[0], ldu, &count_tst[0], batch-1, batch ), lapack::Error );
+        assert_throw( lapack::sturm_batch(  n, &diag[0], &offd[0], ldd, nshift, &u[0], ldu, &count_tst[0], ldc, -1 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::sturm_batch( n, &diag[0], &offd[0], ldd, nshift, &u[0], ldu,
+                         &count_tst[0], ldc, batch );
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference, looping over multi-shift sturm
+        std::vector< real_t > ub( nshift );
+        std::vector< int64_t > cb( nshift );
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t b = 0; b < batch; ++b) {
+            for (int64_t i = 0; i < n; ++i)
+                D[ i ] = diag[ b + i*ldd ];
+            for (int64_t i = 0; i < n-1; ++i)
+                E[ i ] = offd[ b + i*ldd ];
+            for (int64_t k = 0; k < nshift; ++k)
+                ub[ k ] = u[ b + k*ldu ];
+            lapack::sturm( n, &D[0], &E[0], nshift, &ub[0], &cb[0] );
+            for (int64_t k = 0; k < nshift; ++k)
+                count_ref[ b + k*ldc ] = cb[ k ];
+        }
+        time = testsweeper::get_wtime() - time;
+
+        params.ref_time() = time;
+
+        // ---------- check counts; same recurrence, so equal to the
+        // reference, and to the expected count where known
+        int64_t count_diff = 0, count_err = 0;
+        for (int64_t k = 0; k < nshift; ++k) {
+            for (int64_t b = 0; b < batch; ++b) {
+                int64_t c = count_tst[ b + k*ldc ];
+                int64_t c_expect = count_expect[ b + k*ldc ];
+                count_diff = blas::max( count_diff,
+                                        std::abs( c - count_ref[ b + k*ldc ] ) );
+                if (c_expect >= 0)
+                    count_err = blas::max( count_err, std::abs( c - c_expect ) );
+            }
+        }
+
+        params.error() = count_err;
+        params.error2() = count_diff;
+        params.okay() = (count_err == 0) && (count_diff == 0);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_sturm_batch( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_sturm_batch_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_sturm_batch_work< double >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
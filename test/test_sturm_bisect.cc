@@ -0,0 +1,165 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+template< typename scalar_t >
+void test_sturm_bisect_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t verbose = params.verbose();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    real_t  vl;  // = params.vl();
+    real_t  vu;  // = params.vu();
+    int64_t il;  // = params.il();
+    int64_t iu;  // = params.iu();
+    lapack::Range range;  // derived from vl,vu,il,iu
+    params.get_range( n, &range, &vl, &vu, &il, &iu );
+
+    // mark non-standard output values
+    params.ref_time();
+    params.error2();
+    params.error2.name( "count diff" );
+    params.msg();
+
+    if (! run)
+        return;
+
+    if (n == 0 || range == lapack::Range::Value) {
+        params.msg() = "skipping: requires n > 0 and il, iu range";
+        return;
+    }
+
+    // ---------- setup
+    int64_t m = iu - il + 1;
+    std::vector< real_t > diag( n );
+    std::vector< real_t > offd( blas::max( 1, n-1 ) );
+    std::vector< real_t > W_tst( blas::max( 1, m ) );
+    std::vector< real_t > W_ref( n );
+
+    int64_t idist = 2;  // uniform (-1, 1)
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, n,   &diag[0] );
+    lapack::larnv( idist, iseed, n-1, &offd[0] );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "n=%5lld, il=%5lld, iu=%5lld\n",
+                llong( n ), llong( il ), llong( iu ) );
+    }
+    if (verbose >= 2) {
+        printf( "diag = " ); print_vector( n,   &diag[0], 1 );
+        printf( "offd = " ); print_vector( n-1, &offd[0], 1 );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::sturm_bisect( -1, &diag[0], &offd[0], il, iu, &W_tst[0] ), lapack::Error );
+        assert_throw( lapack::sturm_bisect(  n, &diag[0], &offd[0],  0, iu, &W_tst[0] ), lapack::Error );
+        assert_throw( lapack::sturm_bisect(  n, &diag[0], &offd[0], il, n+1, &W_tst[0] ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::sturm_bisect( n, &diag[0], &offd[0], il, iu, &W_tst[0] );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::sturm_bisect returned error %lld\n", llong( info_tst ) );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "W = " ); print_vector( m, &W_tst[0], 1 );
+    }
+
+    if (params.check() == 'y' || params.ref() == 'y') {
+        // ---------- run reference, stevx uses stebz bisection
+        std::vector< real_t > D = diag;
+        std::vector< real_t > E = offd;
+        std::vector< int64_t > ifail( n );
+        real_t Z[1];
+        int64_t m_ref;
+        real_t abstol = 0;
+
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::stevx(
+            lapack::Job::NoVec, lapack::Range::Index, n, &D[0], &E[0],
+            vl, vu, il, iu, abstol, &m_ref, &W_ref[0], Z, 1, &ifail[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::stevx returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference
+        // Both are accurate to about eps ||T||.
+        real_t tnorm = lapack::lanst( lapack::Norm::Max, n, &diag[0], &offd[0] );
+        tnorm = blas::max( tnorm, std::abs( W_ref[ 0 ] ), std::abs( W_ref[ m_ref-1 ] ) );
+        real_t error = 0;
+        for (int64_t k = 0; k < m; ++k)
+            error = blas::max( error, std::abs( W_tst[ k ] - W_ref[ k ] ) );
+        error /= tnorm;
+
+        // ---------- check multi-shift sturm counts, at midpoints between
+        // well separated eigenvalues, against the expected count and
+        // single-shift sturm
+        std::vector< real_t > u;
+        std::vector< int64_t > count_expect;
+        for (int64_t k = 0; k < m-1; ++k) {
+            if (W_tst[ k+1 ] - W_tst[ k ] > 100*eps*tnorm) {
+                u.push_back( (W_tst[ k ] + W_tst[ k+1 ]) / 2 );
+                count_expect.push_back( il + k );
+            }
+        }
+        int64_t nshift = u.size();
+        std::vector< int64_t > count( nshift );
+        lapack::sturm( n, &diag[0], &offd[0], nshift, u.data(), count.data() );
+        int64_t count_diff = 0;
+        for (int64_t k = 0; k < nshift; ++k) {
+            int64_t count_ref = lapack::sturm( n, &diag[0], &offd[0], u[ k ] );
+            count_diff = blas::max( count_diff,
+                                    std::abs( count[ k ] - count_ref ),
+                                    std::abs( count[ k ] - count_expect[ k ] ) );
+        }
+
+        params.error() = error;
+        params.error2() = count_diff;
+        params.okay() = (error < tol) && (m_ref == m) && (count_diff == 0);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_sturm_bisect( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_sturm_bisect_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_sturm_bisect_work< double >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
@@ -0,0 +1,356 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/query_cache.hh"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// @return max | x[i] - y[i] | / max | y[i] |, or the absolute difference if
+// y is zero.
+template< typename T >
+blas::real_type< T > max_diff( std::vector< T > const& x,
+                               std::vector< T > const& y )
+{
+    using real_t = blas::real_type< T >;
+    real_t diff = 0, ymax = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        diff = blas::max( diff, std::abs( x[ i ] - y[ i ] ) );
+        ymax = blas::max( ymax, std::abs( y[ i ] ) );
+    }
+    return ymax > 0 ? diff / ymax : diff;
+}
+
+// -----------------------------------------------------------------------------
+// Checks the caller-supplied host workspace overloads against the
+// allocating overloads: each *_work_size_bytes query returns the same size
+// with and without the query cache, a workspace of exactly that size
+// suffices and gives the same result as the allocating overload,
+// and an empty workspace throws.
+template< typename scalar_t >
+void test_workspace_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    if (! run)
+        return;
+
+    if (m < 1 || n < 1 || nrhs < 1) {
+        params.msg() = "skipping: requires m, n, nrhs >= 1";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldan = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, blas::max( m, n ) ), align );
+    int64_t minmn = blas::min( m, n );
+    size_t size_A = (size_t) lda * n;
+    size_t size_An = (size_t) ldan * n;
+
+    // m-by-n general matrix and n-by-n matrix, read as Hermitian or
+    // symmetric in its uplo triangle.
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > An( size_An );
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+    lapack::generate_matrix( params.matrix, n, n, &An[0], ldan );
+    for (int64_t i = 0; i < n; ++i)
+        An[ i + i*ldan ] = std::real( An[ i + i*ldan ] );
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld, nrhs=%5lld\n",
+                llong( m ), llong( n ), llong( lda ), llong( nrhs ) );
+    }
+
+    bool okay = true;
+    auto check = [&]( bool cond, char const* routine, char const* msg ) {
+        if (! cond) {
+            if (verbose >= 1)
+                printf( "failed: %s: %s\n", routine, msg );
+            okay = false;
+        }
+    };
+
+    // Queries the workspace size without and with the query cache; runs
+    // with an empty workspace, which must throw, then with a workspace of
+    // exactly the queried size and with the allocating overload, which
+    // must agree on info.
+    auto run_both = [&]( char const* routine,
+                         auto query, auto run_work, auto run_alloc )
+    {
+        size_t work_size = 0, work_size2 = 0, work_size3 = 0;
+        bool cache = lapack::query_cache_enabled();
+        lapack::query_cache_enable( false );
+        query( &work_size );
+        lapack::query_cache_enable( true );
+        query( &work_size2 );
+        query( &work_size3 );  // from the cache
+        lapack::query_cache_enable( cache );
+        check( work_size > 0 && work_size == work_size2
+               && work_size == work_size3, routine, "query sizes differ" );
+        if (verbose >= 2)
+            printf( "%-8s %10lld bytes\n", routine, llong( work_size ) );
+
+        std::vector< char > work( work_size );
+        assert_throw( run_work( &work[0], 0 ), lapack::Error );
+
+        int64_t info_work  = run_work( &work[0], work_size );
+        int64_t info_alloc = run_alloc();
+        check( info_work == info_alloc, routine, "info differs" );
+    };
+
+    double time = testsweeper::get_wtime();
+    real_t error = 0;
+
+    // ---------- gelqf
+    {
+        std::vector< scalar_t > A1( A ), A2( A );
+        std::vector< scalar_t > tau1( minmn ), tau2( minmn );
+        run_both(
+            "gelqf",
+            [&]( size_t* size ) {
+                lapack::gelqf_work_size_bytes( m, n, &A1[0], lda, &tau1[0],
+                                               size );
+            },
+            [&]( void* work, size_t size ) {
+                return lapack::gelqf( m, n, &A1[0], lda, &tau1[0],
+                                      work, size );
+            },
+            [&]() {
+                return lapack::gelqf( m, n, &A2[0], lda, &tau2[0] );
+            } );
+        error = blas::max( error, max_diff( A1, A2 ) );
+        error = blas::max( error, max_diff( tau1, tau2 ) );
+    }
+
+    // ---------- gehrd
+    {
+        int64_t ilo = 1, ihi = n;
+        std::vector< scalar_t > A1( An ), A2( An );
+        std::vector< scalar_t > tau1( n ), tau2( n );
+        run_both(
+            "gehrd",
+            [&]( size_t* size ) {
+                lapack::gehrd_work_size_bytes( n, ilo, ihi, &A1[0], ldan,
+                                               &tau1[0], size );
+            },
+            [&]( void* work, size_t size ) {
+                return lapack::gehrd( n, ilo, ihi, &A1[0], ldan, &tau1[0],
+                                      work, size );
+            },
+            [&]() {
+                return lapack::gehrd( n, ilo, ihi, &A2[0], ldan, &tau2[0] );
+            } );
+        error = blas::max( error, max_diff( A1, A2 ) );
+        error = blas::max( error, max_diff( tau1, tau2 ) );
+    }
+
+    // ---------- hetrd (sytrd for real)
+    {
+        std::vector< scalar_t > A1( An ), A2( An );
+        std::vector< real_t > D1( n ), D2( n ), E1( n ), E2( n );
+        std::vector< scalar_t > tau1( n ), tau2( n );
+        run_both(
+            "hetrd",
+            [&]( size_t* size ) {
+                lapack::hetrd_work_size_bytes( uplo, n, &A1[0], ldan,
+                                               &D1[0], &E1[0], &tau1[0],
+                                               size );
+            },
+            [&]( void* work, size_t size ) {
+                return lapack::hetrd( uplo, n, &A1[0], ldan,
+                                      &D1[0], &E1[0], &tau1[0], work, size );
+            },
+            [&]() {
+                return lapack::hetrd( uplo, n, &A2[0], ldan,
+                                      &D2[0], &E2[0], &tau2[0] );
+            } );
+        error = blas::max( error, max_diff( A1, A2 ) );
+        error = blas::max( error, max_diff( D1, D2 ) );
+        error = blas::max( error, max_diff( E1, E2 ) );
+        error = blas::max( error, max_diff( tau1, tau2 ) );
+    }
+
+    // ---------- unmqr (ormqr for real), C = Q^H C with Q from geqrf of A
+    {
+        std::vector< scalar_t > QR( A ), tau( blas::max( 1, minmn ) );
+        lapack::geqrf( m, n, &QR[0], lda, &tau[0] );
+        lapack::Op trans = blas::is_complex< scalar_t >::value
+                         ? lapack::Op::ConjTrans : lapack::Op::Trans;
+        std::vector< scalar_t > C1( A ), C2( A );
+        run_both(
+            "unmqr",
+            [&]( size_t* size ) {
+                lapack::unmqr_work_size_bytes(
+                    lapack::Side::Left, trans, m, n, minmn,
+                    &QR[0], lda, &tau[0], &C1[0], lda, size );
+            },
+            [&]( void* work, size_t size ) {
+                return lapack::unmqr(
+                    lapack::Side::Left, trans, m, n, minmn,
+                    &QR[0], lda, &tau[0], &C1[0], lda, work, size );
+            },
+            [&]() {
+                return lapack::unmqr(
+                    lapack::Side::Left, trans, m, n, minmn,
+                    &QR[0], lda, &tau[0], &C2[0], lda );
+            } );
+        error = blas::max( error, max_diff( C1, C2 ) );
+    }
+
+    // ---------- gesvdx, all singular values and vectors
+    {
+        std::vector< scalar_t > A1( A ), A2( A );
+        std::vector< real_t > S1( blas::max( 1, minmn ) ), S2( S1 );
+        int64_t ldu = lda;
+        int64_t ldvt = roundup( blas::max( 1, minmn ), align );
+        std::vector< scalar_t > U1( ldu * blas::max( 1, minmn ) ), U2( U1 );
+        std::vector< scalar_t > VT1( ldvt * n ), VT2( VT1 );
+        int64_t nfound1 = 0, nfound2 = 0;
+        run_both(
+            "gesvdx",
+            [&]( size_t* size ) {
+                lapack::gesvdx_work_size_bytes(
+                    lapack::Job::Vec, lapack::Job::Vec, lapack::Range::All,
+                    m, n, &A1[0], lda, 0, 0, 0, 0, &nfound1, &S1[0],
+                    &U1[0], ldu, &VT1[0], ldvt, size );
+            },
+            [&]( void* work, size_t size ) {
+                return lapack::gesvdx(
+                    lapack::Job::Vec, lapack::Job::Vec, lapack::Range::All,
+                    m, n, &A1[0], lda, 0, 0, 0, 0, &nfound1, &S1[0],
+                    &U1[0], ldu, &VT1[0], ldvt, work, size );
+            },
+            [&]() {
+                return lapack::gesvdx(
+                    lapack::Job::Vec, lapack::Job::Vec, lapack::Range::All,
+                    m, n, &A2[0], lda, 0, 0, 0, 0, &nfound2, &S2[0],
+                    &U2[0], ldu, &VT2[0], ldvt );
+            } );
+        check( nfound1 == nfound2, "gesvdx", "nfound differs" );
+        error = blas::max( error, max_diff( S1, S2 ) );
+        error = blas::max( error, max_diff( U1, U2 ) );
+        error = blas::max( error, max_diff( VT1, VT2 ) );
+    }
+
+    // ---------- gelsd
+    {
+        std::vector< scalar_t > A1( A ), A2( A );
+        std::vector< scalar_t > B1( ldb * nrhs );
+        int64_t idist = 1;
+        int64_t iseed[4] = { 0, 1, 2, 3 };
+        lapack::larnv( idist, iseed, B1.size(), &B1[0] );
+        std::vector< scalar_t > B2( B1 );
+        std::vector< real_t > S1( blas::max( 1, minmn ) ), S2( S1 );
+        real_t rcond = -1;
+        int64_t rank1 = 0, rank2 = 0;
+        run_both(
+            "gelsd",
+            [&]( size_t* size ) {
+                lapack::gelsd_work_size_bytes(
+                    m, n, nrhs, &A1[0], lda, &B1[0], ldb, &S1[0], rcond,
+                    &rank1, size );
+            },
+            [&]( void* work, size_t size ) {
+                return lapack::gelsd(
+                    m, n, nrhs, &A1[0], lda, &B1[0], ldb, &S1[0], rcond,
+                    &rank1, work, size );
+            },
+            [&]() {
+                return lapack::gelsd(
+                    m, n, nrhs, &A2[0], lda, &B2[0], ldb, &S2[0], rcond,
+                    &rank2 );
+            } );
+        check( rank1 == rank2, "gelsd", "rank differs" );
+        error = blas::max( error, max_diff( B1, B2 ) );
+        error = blas::max( error, max_diff( S1, S2 ) );
+    }
+
+    // ---------- hetrf (sytrf for real) and sytrf
+    {
+        std::vector< scalar_t > A1( An ), A2( An );
+        std::vector< int64_t > ipiv1( n ), ipiv2( n );
+        run_both(
+            "hetrf",
+            [&]( size_t* size ) {
+                lapack::hetrf_work_size_bytes( uplo, n, &A1[0], ldan,
+                                               &ipiv1[0], size );
+            },
+            [&]( void* work, size_t size ) {
+                return lapack::hetrf( uplo, n, &A1[0], ldan, &ipiv1[0],
+                                      work, size );
+            },
+            [&]() {
+                return lapack::hetrf( uplo, n, &A2[0], ldan, &ipiv2[0] );
+            } );
+        check( ipiv1 == ipiv2, "hetrf", "ipiv differs" );
+        error = blas::max( error, max_diff( A1, A2 ) );
+
+        A1 = An;
+        A2 = An;
+        run_both(
+            "sytrf",
+            [&]( size_t* size ) {
+                lapack::sytrf_work_size_bytes( uplo, n, &A1[0], ldan,
+                                               &ipiv1[0], size );
+            },
+            [&]( void* work, size_t size ) {
+                return lapack::sytrf( uplo, n, &A1[0], ldan, &ipiv1[0],
+                                      work, size );
+            },
+            [&]() {
+                return lapack::sytrf( uplo, n, &A2[0], ldan, &ipiv2[0] );
+            } );
+        check( ipiv1 == ipiv2, "sytrf", "ipiv differs" );
+        error = blas::max( error, max_diff( A1, A2 ) );
+    }
+
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    params.error() = error;
+    params.okay() = okay && (error < tol);
+}
+
+// -----------------------------------------------------------------------------
+void test_workspace( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_workspace_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_workspace_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_workspace_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_workspace_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}